@@ -65,7 +65,8 @@ void multiply_connected(SystemTopology& sys, int copies,
 	}
 }
 
-void simulateCoupled(std::list<fs::path> filenames, Int copies, Int threads, Int seq = 0, Logger::Level logLevel = Logger::Level::off) {
+void simulateCoupled(std::list<fs::path> filenames, Int copies, Int threads, Int seq = 0,
+	Bool batched = false, Logger::Level logLevel = Logger::Level::off) {
 	String simName = "WSCC_9bus_coupled_" + std::to_string(copies)
 		+ "_" + std::to_string(threads) + "_" + std::to_string(seq);
 	Logger::setLogDir("logs/"+simName);
@@ -81,6 +82,7 @@ void simulateCoupled(std::list<fs::path> filenames, Int copies, Int threads, Int
 	sim.setTimeStep(0.0001);
 	sim.setFinalTime(0.5);
 	sim.setDomain(Domain::DP);
+	sim.doBatchedComponents(batched);
 	if (threads > 0)
 		sim.setScheduler(std::make_shared<OpenMPLevelScheduler>(threads));
 
@@ -99,6 +101,7 @@ void simulateCoupled(std::list<fs::path> filenames, Int copies, Int threads, Int
 	//}
 	//sim.addLogger(logger);
 
+	sim.doStepTimeRecording(true);
 	sim.run();
 	sim.logStepTimes(simName + "_step_times");
 }
@@ -123,5 +126,6 @@ int main(int argc, char *argv[]) {
 		<< Int(args.options["threads"]) << " threads, sequence number "
 		<< Int(args.options["seq"]) << std::endl;
 	simulateCoupled(filenames, Int(args.options["copies"]),
-		Int(args.options["threads"]), Int(args.options["seq"]), args.logLevel);
+		Int(args.options["threads"]), Int(args.options["seq"]),
+		args.options["batched"] != 0, args.logLevel);
 }
@@ -0,0 +1,137 @@
+/* Copyright 2017-2020 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <DPsim.h>
+
+using namespace DPsim;
+using namespace CPS::DP;
+using namespace CPS::DP::Ph1;
+
+// A ladder of line sections with shunt capacitors and loads, at the end of
+// which a load is switched on. The node voltages and component currents
+// computed with batched components have to be identical to those of the
+// components executing their own tasks.
+
+const Int numSections = 50;
+
+SystemTopology makeSystem(SimNode::List& nodes, CPS::SimPowerComp<Complex>::List& comps,
+	std::shared_ptr<Switch>& breaker) {
+	auto n0 = SimNode::make("n0");
+	nodes = { n0 };
+
+	auto vs = VoltageSource::make("vs");
+	vs->setParameters(Complex(10000, 0));
+	vs->connect(SimNode::List{ SimNode::GND, n0 });
+	SystemTopology sys(50, SystemNodeList{ n0 }, SystemComponentList{ vs });
+
+	for (Int i = 0; i < numSections; i++) {
+		String idx = std::to_string(i);
+		auto nMid = SimNode::make("n_mid_" + idx);
+		auto nEnd = SimNode::make("n_" + std::to_string(i + 1));
+
+		auto rLine = Resistor::make("r_line_" + idx);
+		rLine->setParameters(0.1);
+		auto lLine = Inductor::make("l_line_" + idx);
+		lLine->setParameters(0.001);
+		auto cShunt = Capacitor::make("c_shunt_" + idx);
+		cShunt->setParameters(1e-6);
+		auto rLoad = Resistor::make("r_load_" + idx);
+		rLoad->setParameters(5000. + 100. * i);
+
+		rLine->connect(SimNode::List{ nodes.back(), nMid });
+		lLine->connect(SimNode::List{ nMid, nEnd });
+		cShunt->connect(SimNode::List{ nEnd, SimNode::GND });
+		rLoad->connect(SimNode::List{ nEnd, SimNode::GND });
+
+		sys.addNodes(SystemNodeList{ nMid, nEnd });
+		sys.addComponents(SystemComponentList{ rLine, lLine, cShunt, rLoad });
+		nodes.push_back(nMid);
+		nodes.push_back(nEnd);
+		comps.insert(comps.end(), { rLine, lLine, cShunt, rLoad });
+	}
+
+	auto nStep = SimNode::make("n_step");
+	breaker = Switch::make("breaker");
+	breaker->setParameters(1e9, 0.001, false);
+	auto rStep = Resistor::make("r_step");
+	rStep->setParameters(500);
+	breaker->connect(SimNode::List{ nodes.back(), nStep });
+	rStep->connect(SimNode::List{ nStep, SimNode::GND });
+	sys.addNode(nStep);
+	sys.addComponents(SystemComponentList{ breaker, rStep });
+	nodes.push_back(nStep);
+
+	return sys;
+}
+
+/// Logs all compared values, which also keeps the scheduler from skipping
+/// the tasks that compute them
+DataLogger::Ptr makeLogger(const String& name, SimNode::List& nodes,
+	CPS::SimPowerComp<Complex>::List& comps) {
+	auto logger = DataLogger::make(name);
+	for (auto node : nodes)
+		logger->addAttribute(node->name() + ".v", node->attribute("v"));
+	for (auto comp : comps) {
+		logger->addAttribute(comp->name() + ".v_intf", comp->attribute("v_intf"));
+		logger->addAttribute(comp->name() + ".i_intf", comp->attribute("i_intf"));
+	}
+	return logger;
+}
+
+int main(int argc, char* argv[]) {
+	Real timeStep = 0.0001;
+	Real finalTime = 0.05;
+	String simName = "DP_Batched_Ladder";
+	Logger::setLogDir("logs/"+simName);
+
+	SimNode::List refNodes, batchedNodes;
+	CPS::SimPowerComp<Complex>::List refComps, batchedComps;
+	std::shared_ptr<Switch> refBreaker, batchedBreaker;
+	auto refSys = makeSystem(refNodes, refComps, refBreaker);
+	auto batchedSys = makeSystem(batchedNodes, batchedComps, batchedBreaker);
+
+	Simulation refSim(simName + "_ref", refSys, timeStep, finalTime);
+	refSim.addEvent(SwitchEvent::make(0.02, refBreaker, true));
+	refSim.addLogger(makeLogger(simName + "_ref", refNodes, refComps));
+
+	Simulation batchedSim(simName + "_batched", batchedSys, timeStep, finalTime);
+	batchedSim.doBatchedComponents(true);
+	batchedSim.addEvent(SwitchEvent::make(0.02, batchedBreaker, true));
+	batchedSim.addLogger(makeLogger(simName + "_batched", batchedNodes, batchedComps));
+
+	refSim.initialize();
+	batchedSim.initialize();
+
+	// The batch replaces the two tasks of each component by two tasks in total
+	UInt refTasks = refSim.solvers()[0]->getTasks().size();
+	UInt batchedTasks = batchedSim.solvers()[0]->getTasks().size();
+
+	// The batch has to do the same arithmetic as the components, so any
+	// difference is an error
+	UInt mismatches = 0;
+	while (refSim.time() < finalTime) {
+		refSim.step();
+		batchedSim.step();
+		for (UInt i = 0; i < refNodes.size(); i++) {
+			if (refNodes[i]->singleVoltage() != batchedNodes[i]->singleVoltage())
+				mismatches++;
+		}
+		for (UInt i = 0; i < refComps.size(); i++) {
+			if (refComps[i]->intfVoltage()(0, 0) != batchedComps[i]->intfVoltage()(0, 0)
+				|| refComps[i]->intfCurrent()(0, 0) != batchedComps[i]->intfCurrent()(0, 0))
+				mismatches++;
+		}
+	}
+	refSim.scheduler()->stop();
+	batchedSim.scheduler()->stop();
+
+	std::cout << "Solver tasks: " << refTasks << " unbatched, " << batchedTasks << " batched" << std::endl;
+	std::cout << "Mismatching values: " << mismatches << std::endl;
+
+	return (batchedTasks < refTasks && mismatches == 0) ? 0 : 1;
+}
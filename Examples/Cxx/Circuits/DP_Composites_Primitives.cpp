@@ -0,0 +1,214 @@
+/* Copyright 2017-2020 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <DPsim.h>
+
+using namespace DPsim;
+using namespace CPS::DP;
+
+// A slack feeds a PiLine, an RXLoad, an inverter and a transformer with a
+// load. The same circuit is built a second time from resistors, inductors,
+// capacitors and voltage sources only, with the transformer replaced by its
+// impedance and the load referred to the high voltage side. The composites
+// register their subcomponents with the solver, so each subcomponent has to
+// be stepped exactly once and the trajectories of both circuits have to
+// agree. The inverter runs without control, otherwise its controller would
+// have to be rebuilt from primitives as well, and its connection transformer
+// has a ratio of one.
+
+const Real Vnom = 1000.;
+const Real ratio = 2.;
+const Real Rline = 0.5, Lline = 0.002, Cline = 5e-6, Gline = 1e-6;
+const Real Pload = 20e3, Qload = 5e3;
+const Real Rtrafo = 0.2, Ltrafo = 0.005, Rload = 10.;
+const Real Lf = 0.002, Cf = 789.3e-6, Rf = 0.1, Rc = 0.1, Lconn = 0.001;
+const Real Pvsi = 10e3, Qvsi = 2e3;
+
+int main(int argc, char* argv[]) {
+	Real timeStep = 0.0001;
+	Real finalTime = 0.1;
+	String simName = "DP_Composites_Primitives";
+	Logger::setLogDir("logs/" + simName);
+	Real omega = 2. * PI * 50;
+
+	// Composites
+	auto n1 = SimNode::make("n1");
+	auto n2 = SimNode::make("n2");
+	auto n3 = SimNode::make("n3");
+
+	auto vs = Ph1::VoltageSource::make("vs");
+	vs->setParameters(Complex(Vnom, 0));
+	auto line = Ph1::PiLine::make("line");
+	line->setParameters(Rline, Lline, Cline, Gline);
+	auto load = Ph1::RXLoad::make("load");
+	load->setParameters(Pload, Qload, Vnom);
+	auto trafo = Ph1::Transformer::make("trafo", "trafo", Logger::Level::off, true);
+	trafo->setParameters(Vnom, Vnom / ratio, ratio, 0, Rtrafo, Ltrafo);
+	auto rload = Ph1::Resistor::make("rload");
+	rload->setParameters(Rload);
+	auto vsi = Ph1::AvVoltageSourceInverterDQ::make("vsi", "vsi", Logger::Level::off, true);
+	vsi->setParameters(omega, Vnom, Pvsi, Qvsi);
+	vsi->setControllerParameters(0.25, 0.2, 0.001, 0.008, 0.3, 1, omega);
+	vsi->setFilterParameters(Lf, Cf, Rf, Rc);
+	vsi->setTransformerParameters(Vnom, Vnom, 1, 0, 0, Lconn);
+	vsi->setInitialStateValues(Pvsi, Qvsi, 0, 0, 0, 0);
+	vsi->withControl(false);
+
+	vs->connect({ SimNode::GND, n1 });
+	line->connect({ n1, n2 });
+	load->connect({ n2 });
+	vsi->connect({ n2 });
+	trafo->connect({ n2, n3 });
+	rload->connect({ n3, SimNode::GND });
+
+	auto sys = SystemTopology(50, SystemNodeList{ n1, n2, n3 },
+		SystemComponentList{ vs, line, load, vsi, trafo, rload });
+	n1->setInitialVoltage(Complex(Vnom, 0));
+	n2->setInitialVoltage(Complex(Vnom, 0));
+	n3->setInitialVoltage(Complex(Vnom / ratio, 0));
+
+	Simulation sim(simName, sys, timeStep, finalTime);
+	auto logger = DataLogger::make(simName);
+	logger->addAttribute("v2", n2->attribute("v"));
+	logger->addAttribute("v3", n3->attribute("v"));
+	logger->addAttribute("i_vsi", vsi->attribute("i_intf"));
+	sim.addLogger(logger);
+	sim.initialize();
+
+	// Primitives, with the initial voltages of the virtual nodes of the
+	// composites, which are set during the initialization
+	auto p1 = SimNode::make("p1");
+	auto p2 = SimNode::make("p2");
+	auto pLine = SimNode::make("p_line");
+	auto pTrafoRes = SimNode::make("p_trafo_res");
+	auto pTrafo = SimNode::make("p_trafo");
+	auto pSrc = SimNode::make("p_src");
+	auto pFilter = SimNode::make("p_filter");
+	auto pCap = SimNode::make("p_cap");
+	auto pConn = SimNode::make("p_conn");
+	p1->setInitialVoltage(Complex(Vnom, 0));
+	p2->setInitialVoltage(Complex(Vnom, 0));
+	pLine->setInitialVoltage(line->virtualNode(0)->initialSingleVoltage());
+	pTrafo->setInitialVoltage(trafo->virtualNode(0)->initialSingleVoltage());
+	pTrafoRes->setInitialVoltage(trafo->virtualNode(2)->initialSingleVoltage());
+	pSrc->setInitialVoltage(vsi->virtualNode(0)->initialSingleVoltage());
+	pFilter->setInitialVoltage(vsi->virtualNode(1)->initialSingleVoltage());
+	pCap->setInitialVoltage(vsi->virtualNode(2)->initialSingleVoltage());
+	pConn->setInitialVoltage(vsi->virtualNode(3)->initialSingleVoltage());
+
+	auto pVs = Ph1::VoltageSource::make("p_vs");
+	pVs->setParameters(Complex(Vnom, 0));
+	pVs->connect({ SimNode::GND, p1 });
+
+	// PiLine with half of the capacitance and conductance at each end
+	auto lineRes = Ph1::Resistor::make("p_line_res");
+	lineRes->setParameters(Rline);
+	lineRes->connect({ p1, pLine });
+	auto lineInd = Ph1::Inductor::make("p_line_ind");
+	lineInd->setParameters(Lline);
+	lineInd->connect({ pLine, p2 });
+	auto lineCap0 = Ph1::Capacitor::make("p_line_cap0");
+	lineCap0->setParameters(Cline / 2.);
+	lineCap0->connect({ SimNode::GND, p1 });
+	auto lineCap1 = Ph1::Capacitor::make("p_line_cap1");
+	lineCap1->setParameters(Cline / 2.);
+	lineCap1->connect({ SimNode::GND, p2 });
+	auto lineCon0 = Ph1::Resistor::make("p_line_con0");
+	lineCon0->setParameters(2. / Gline);
+	lineCon0->connect({ SimNode::GND, p1 });
+	auto lineCon1 = Ph1::Resistor::make("p_line_con1");
+	lineCon1->setParameters(2. / Gline);
+	lineCon1->connect({ SimNode::GND, p2 });
+
+	// RXLoad
+	auto loadRes = Ph1::Resistor::make("p_load_res");
+	loadRes->setParameters(Vnom * Vnom / Pload);
+	loadRes->connect({ SimNode::GND, p2 });
+	auto loadInd = Ph1::Inductor::make("p_load_ind");
+	loadInd->setParameters(Vnom * Vnom / Qload / omega);
+	loadInd->connect({ SimNode::GND, p2 });
+
+	// Transformer with the load and the snubber referred to the primary side
+	auto trafoRes = Ph1::Resistor::make("p_trafo_res");
+	trafoRes->setParameters(Rtrafo);
+	trafoRes->connect({ p2, pTrafoRes });
+	auto trafoInd = Ph1::Inductor::make("p_trafo_ind");
+	trafoInd->setParameters(Ltrafo);
+	trafoInd->connect({ pTrafoRes, pTrafo });
+	auto trafoSnub = Ph1::Resistor::make("p_trafo_snub");
+	trafoSnub->setParameters(Vnom / ratio * 1e6 * ratio * ratio);
+	trafoSnub->connect({ pTrafo, SimNode::GND });
+	auto trafoLoad = Ph1::Resistor::make("p_trafo_load");
+	trafoLoad->setParameters(Rload * ratio * ratio);
+	trafoLoad->connect({ pTrafo, SimNode::GND });
+
+	// Inverter filter with a fixed source voltage and the connection
+	// transformer
+	auto vsiSrc = Ph1::VoltageSource::make("p_vsi_src");
+	vsiSrc->setParameters(vsi->virtualNode(0)->initialSingleVoltage());
+	vsiSrc->connect({ SimNode::GND, pSrc });
+	auto vsiRf = Ph1::Resistor::make("p_vsi_rf");
+	vsiRf->setParameters(Rf);
+	vsiRf->connect({ pSrc, pFilter });
+	auto vsiLf = Ph1::Inductor::make("p_vsi_lf");
+	vsiLf->setParameters(Lf);
+	vsiLf->connect({ pFilter, pCap });
+	auto vsiCf = Ph1::Capacitor::make("p_vsi_cf");
+	vsiCf->setParameters(Cf);
+	vsiCf->connect({ pCap, SimNode::GND });
+	auto vsiRc = Ph1::Resistor::make("p_vsi_rc");
+	vsiRc->setParameters(Rc);
+	vsiRc->connect({ pCap, pConn });
+	auto vsiConnInd = Ph1::Inductor::make("p_vsi_conn_ind");
+	vsiConnInd->setParameters(Lconn);
+	vsiConnInd->connect({ p2, pConn });
+	auto vsiConnSnub = Ph1::Resistor::make("p_vsi_conn_snub");
+	vsiConnSnub->setParameters(Vnom * 1e6);
+	vsiConnSnub->connect({ pConn, SimNode::GND });
+
+	auto sysPrim = SystemTopology(50,
+		SystemNodeList{ p1, p2, pLine, pTrafoRes, pTrafo, pSrc, pFilter, pCap, pConn },
+		SystemComponentList{ pVs, lineRes, lineInd, lineCap0, lineCap1, lineCon0, lineCon1,
+			loadRes, loadInd, trafoRes, trafoInd, trafoSnub, trafoLoad,
+			vsiSrc, vsiRf, vsiLf, vsiCf, vsiRc, vsiConnInd, vsiConnSnub });
+
+	Simulation simPrim(simName + "_Primitives", sysPrim, timeStep, finalTime);
+	auto loggerPrim = DataLogger::make(simName + "_Primitives");
+	loggerPrim->addAttribute("v2", p2->attribute("v"));
+	loggerPrim->addAttribute("v3", pTrafo->attribute("v"));
+	loggerPrim->addAttribute("i_vsi", vsiConnInd->attribute("i_intf"));
+	simPrim.addLogger(loggerPrim);
+	simPrim.initialize();
+
+	auto v2 = n2->attribute<MatrixComp>("v");
+	auto v3 = n3->attribute<MatrixComp>("v");
+	auto iVsi = vsi->attribute<MatrixComp>("i_intf");
+	auto v2Prim = p2->attribute<MatrixComp>("v");
+	auto v3Prim = pTrafo->attribute<MatrixComp>("v");
+	auto iVsiPrim = vsiConnInd->attribute<MatrixComp>("i_intf");
+
+	Real maxDiffV2 = 0, maxDiffV3 = 0, maxDiffI = 0, maxI = 0;
+	while (sim.time() < finalTime) {
+		sim.step();
+		simPrim.step();
+		maxDiffV2 = std::max(maxDiffV2, std::abs(v2->get()(0, 0) - v2Prim->get()(0, 0)));
+		// The primitive circuit has the load voltage referred to the primary side
+		maxDiffV3 = std::max(maxDiffV3, std::abs(v3->get()(0, 0) * ratio - v3Prim->get()(0, 0)));
+		maxDiffI = std::max(maxDiffI, std::abs(iVsi->get()(0, 0) - iVsiPrim->get()(0, 0)));
+		maxI = std::max(maxI, std::abs(iVsi->get()(0, 0)));
+	}
+	sim.scheduler()->stop();
+	simPrim.scheduler()->stop();
+
+	std::cout << "Maximum difference of the PiLine end voltage: " << maxDiffV2 << " V" << std::endl;
+	std::cout << "Maximum difference of the referred load voltage: " << maxDiffV3 << " V" << std::endl;
+	std::cout << "Maximum difference of the inverter current: " << maxDiffI << " A" << std::endl;
+
+	Real tol = 1e-6;
+	return (maxDiffV2 < tol * Vnom && maxDiffV3 < tol * Vnom && maxDiffI < tol * maxI) ? 0 : 1;
+}
@@ -0,0 +1,127 @@
+/* Copyright 2017-2020 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <cmath>
+#include <fstream>
+
+#include <DPsim.h>
+#include <dpsim/SequentialScheduler.h>
+#include <dpsim/ThreadLevelScheduler.h>
+#include <dpsim/ThreadListScheduler.h>
+#include <dpsim/ThreadCriticalPathScheduler.h>
+#include <dpsim/WorkStealingScheduler.h>
+#ifdef WITH_SHMEM
+  #include <dpsim/PthreadPoolScheduler.h>
+#endif
+
+using namespace DPsim;
+using namespace CPS::DP;
+using namespace CPS::DP::Ph1;
+
+// An RL circuit with a logger that only writes every fourth step, simulated
+// with each scheduler. Every scheduler has to write exactly the rows of the
+// steps that are multiples of the downsampling, and the logger has to do
+// the same when log() is called directly.
+
+const Real timeStep = 0.0001;
+const Int numSteps = 101;
+const UInt downsampling = 4;
+
+/// Number of rows in the log, or -1 if a row is not of a downsampled step
+Int checkRows(const String& name) {
+	std::ifstream file(CPS::Logger::logDir() + "/" + name + ".csv");
+	String line;
+	std::getline(file, line);
+	Int rows = 0;
+	while (std::getline(file, line)) {
+		Real time = std::stod(line.substr(0, line.find(',')));
+		if (std::lround(time / timeStep) % downsampling != 0)
+			return -1;
+		rows++;
+	}
+	return rows;
+}
+
+Int runSimulation(const String& name, std::shared_ptr<Scheduler> scheduler) {
+	auto n1 = SimNode::make("n1");
+	auto n2 = SimNode::make("n2");
+
+	auto vs = VoltageSource::make("vs");
+	vs->setParameters(Complex(10, 0));
+	auto r1 = Resistor::make("r_1");
+	r1->setParameters(5);
+	auto l1 = Inductor::make("l_1");
+	l1->setParameters(0.02);
+
+	vs->connect(SimNode::List{ SimNode::GND, n1 });
+	r1->connect(SimNode::List{ n1, n2 });
+	l1->connect(SimNode::List{ n2, SimNode::GND });
+
+	auto sys = SystemTopology(50, SystemNodeList{ n1, n2 }, SystemComponentList{ vs, r1, l1 });
+
+	auto logger = DataLogger::make(name, true, downsampling);
+	logger->addAttribute("v2", n2->attribute("v"));
+	logger->addAttribute("i", l1->attribute("i_intf"));
+
+	Simulation sim(name, sys, timeStep, numSteps * timeStep);
+	sim.setScheduler(scheduler);
+	sim.addLogger(logger);
+	sim.initialize();
+	for (Int step = 0; step < numSteps; step++)
+		sim.step();
+	sim.scheduler()->stop();
+	logger->close();
+
+	return checkRows(name);
+}
+
+Int logDirectly(const String& name) {
+	Real value = 0;
+	auto logger = DataLogger::make(name, true, downsampling);
+	logger->addAttribute("value", CPS::Attribute<Real>::make(&value));
+	for (Int step = 0; step < numSteps; step++) {
+		value = step;
+		logger->log(step * timeStep, step);
+	}
+	logger->close();
+
+	return checkRows(name);
+}
+
+int main(int argc, char* argv[]) {
+	String simName = "DP_Downsampled_Logger";
+	Logger::setLogDir("logs/"+simName);
+
+	std::vector<std::pair<String, std::shared_ptr<Scheduler>>> schedulers = {
+		{ "sequential", std::make_shared<SequentialScheduler>() },
+		{ "thread_level", std::make_shared<ThreadLevelScheduler>(2) },
+		{ "thread_list", std::make_shared<ThreadListScheduler>(2) },
+		{ "thread_critical_path", std::make_shared<ThreadCriticalPathScheduler>(2) },
+		{ "work_stealing", std::make_shared<WorkStealingScheduler>(2) },
+#ifdef WITH_OPENMP
+		{ "omp_level", std::make_shared<OpenMPLevelScheduler>(2) },
+#endif
+#ifdef WITH_SHMEM
+		{ "pthread_pool", std::make_shared<PthreadPoolScheduler>(2) },
+#endif
+	};
+
+	Int expectedRows = (numSteps + downsampling - 1) / downsampling;
+	Bool ok = true;
+	for (auto& scheduler : schedulers) {
+		Int rows = runSimulation(simName + "_" + scheduler.first, scheduler.second);
+		std::cout << scheduler.first << ": " << rows << " rows" << std::endl;
+		ok = ok && rows == expectedRows;
+	}
+	Int rows = logDirectly(simName + "_direct");
+	std::cout << "direct: " << rows << " rows" << std::endl;
+	ok = ok && rows == expectedRows;
+
+	std::cout << "Expected " << expectedRows << " rows" << std::endl;
+	return ok ? 0 : 1;
+}
@@ -0,0 +1,237 @@
+/* Copyright 2017-2020 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <DPsim.h>
+#include <dpsim/ThreadLevelScheduler.h>
+
+using namespace DPsim;
+
+// Simulates RL circuits in DP and EMT and a synchronous generator with a
+// fault in DP with the allocation check, so that the example fails if a task
+// allocates heap memory during the steps. The DP circuit is also simulated
+// with outputs that are pipelined on a separate thread, and with a breaker
+// that is handled by a low-rank update of the system matrix. Only built with
+// WITH_ALLOCATION_TRACKING.
+
+void runChecked(const String& name, SystemTopology& sys, CPS::Domain domain, Real timeStep,
+	DataLogger::Ptr logger, std::shared_ptr<Event> event = nullptr,
+	std::shared_ptr<Scheduler> scheduler = nullptr, Bool lowRankUpdates = false) {
+	Simulation sim(name, Logger::Level::info);
+	sim.setSystem(sys);
+	sim.setDomain(domain);
+	sim.setTimeStep(timeStep);
+	sim.setFinalTime(0.1);
+	sim.doAllocationCheck(true);
+	sim.addLogger(logger);
+	if (event)
+		sim.addEvent(event);
+	if (scheduler)
+		sim.setScheduler(scheduler);
+	sim.doLowRankSystemUpdates(lowRankUpdates);
+	sim.run();
+}
+
+void dpRLCircuit(Bool pipelineOutputs) {
+	using namespace CPS::DP;
+	auto n1 = SimNode::make("n1");
+	auto n2 = SimNode::make("n2");
+	auto n3 = SimNode::make("n3");
+
+	auto vs = Ph1::VoltageSource::make("vs");
+	vs->setParameters(Complex(10, 0));
+	auto r = Ph1::Resistor::make("r");
+	r->setParameters(1);
+	auto l = Ph1::Inductor::make("l");
+	l->setParameters(0.02);
+	auto c = Ph1::Capacitor::make("c");
+	c->setParameters(1e-3);
+	auto line = Ph1::PiLine::make("line");
+	line->setParameters(0.5, 0.01, 1e-6);
+	auto load = Ph1::Resistor::make("load");
+	load->setParameters(10);
+
+	vs->connect({ SimNode::GND, n1 });
+	r->connect({ n1, n2 });
+	l->connect({ n2, SimNode::GND });
+	c->connect({ n2, SimNode::GND });
+	line->connect({ n2, n3 });
+	load->connect({ n3, SimNode::GND });
+
+	auto sys = SystemTopology(50, SystemNodeList{ n1, n2, n3 },
+		SystemComponentList{ vs, r, l, c, line, load });
+
+	String name = pipelineOutputs ? "DP_RL_Pipelined" : "DP_RL";
+	auto logger = DataLogger::make(name);
+	logger->addAttribute("v2", n2->attribute("v"));
+	logger->addAttribute("il", l->attribute("i_intf"));
+
+	std::shared_ptr<ThreadLevelScheduler> scheduler;
+	if (pipelineOutputs) {
+		scheduler = std::make_shared<ThreadLevelScheduler>(2);
+		scheduler->doPipelineOutputs(true);
+	}
+	runChecked(name, sys, CPS::Domain::DP, 1e-4, logger, nullptr, scheduler);
+}
+
+void dpBreakerLowRank() {
+	using namespace CPS::DP;
+	auto n1 = SimNode::make("n1");
+	auto n2 = SimNode::make("n2");
+	auto n3 = SimNode::make("n3");
+
+	auto vs = Ph1::VoltageSource::make("vs");
+	vs->setParameters(Complex(10, 0));
+	auto r = Ph1::Resistor::make("r");
+	r->setParameters(1);
+	auto l = Ph1::Inductor::make("l");
+	l->setParameters(0.02);
+	auto breaker = Ph1::Switch::make("breaker");
+	breaker->setParameters(1e9, 0.001, false);
+	auto load = Ph1::Resistor::make("load");
+	load->setParameters(10);
+
+	vs->connect({ SimNode::GND, n1 });
+	r->connect({ n1, n2 });
+	l->connect({ n2, SimNode::GND });
+	breaker->connect({ n2, n3 });
+	load->connect({ n3, SimNode::GND });
+
+	auto sys = SystemTopology(50, SystemNodeList{ n1, n2, n3 },
+		SystemComponentList{ vs, r, l, breaker, load });
+
+	auto logger = DataLogger::make("DP_Breaker_LowRank");
+	logger->addAttribute("v3", n3->attribute("v"));
+	logger->addAttribute("i_breaker", breaker->attribute("i_intf"));
+
+	// Closing the breaker is handled by a correction of rank 4, which has
+	// to be computed and applied without allocations
+	runChecked("DP_Breaker_LowRank", sys, CPS::Domain::DP, 1e-4, logger,
+		SwitchEvent::make(0.05, breaker, true), nullptr, true);
+}
+
+void emtRLCircuit() {
+	using namespace CPS::EMT;
+	auto n1 = SimNode::make("n1", CPS::PhaseType::ABC);
+	auto n2 = SimNode::make("n2", CPS::PhaseType::ABC);
+	auto n3 = SimNode::make("n3", CPS::PhaseType::ABC);
+
+	auto vs = Ph3::VoltageSource::make("vs");
+	vs->setParameters(CPS::Math::singlePhaseVariableToThreePhase(Complex(10, 0)), 50);
+	auto r = Ph3::Resistor::make("r");
+	r->setParameters(CPS::Math::singlePhaseParameterToThreePhase(1));
+	auto l = Ph3::Inductor::make("l");
+	l->setParameters(CPS::Math::singlePhaseParameterToThreePhase(0.02));
+	auto c = Ph3::Capacitor::make("c");
+	c->setParameters(CPS::Math::singlePhaseParameterToThreePhase(1e-3));
+	auto line = Ph3::PiLine::make("line");
+	line->setParameters(CPS::Math::singlePhaseParameterToThreePhase(0.5),
+		CPS::Math::singlePhaseParameterToThreePhase(0.01), CPS::Math::singlePhaseParameterToThreePhase(1e-6));
+	auto load = Ph3::Resistor::make("load");
+	load->setParameters(CPS::Math::singlePhaseParameterToThreePhase(10));
+
+	vs->connect({ SimNode::GND, n1 });
+	r->connect({ n1, n2 });
+	l->connect({ n2, SimNode::GND });
+	c->connect({ n2, SimNode::GND });
+	line->connect({ n2, n3 });
+	load->connect({ n3, SimNode::GND });
+
+	auto sys = SystemTopology(50, SystemNodeList{ n1, n2, n3 },
+		SystemComponentList{ vs, r, l, c, line, load });
+
+	auto logger = DataLogger::make("EMT_RL");
+	logger->addAttribute("v2", n2->attribute("v"));
+	logger->addAttribute("il", l->attribute("i_intf"));
+
+	runChecked("EMT_RL", sys, CPS::Domain::EMT, 1e-4, logger);
+}
+
+void dpSynGenDq7odTrapezFault() {
+	using namespace CPS::DP;
+
+	// Machine parameters
+	Real nomPower = 555e6;
+	Real nomPhPhVoltRMS = 24e3;
+	Real nomFreq = 60;
+	Real nomFieldCurr = 1300;
+	Int poleNum = 2;
+	Real H = 3.7;
+	Real Rs = 0.003;
+	Real Ll = 0.15;
+	Real Lmd = 1.6599;
+	Real Lmq = 1.61;
+	Real Rfd = 0.0006;
+	Real Llfd = 0.1648;
+	Real Rkd = 0.0284;
+	Real Llkd = 0.1713;
+	Real Rkq1 = 0.0062;
+	Real Llkq1 = 0.7252;
+	Real Rkq2 = 0.0237;
+	Real Llkq2 = 0.125;
+
+	// Initialization parameters
+	Real initActivePower = 300e6;
+	Real initReactivePower = 0;
+	Real initMechPower = 300e6;
+	Real initTerminalVolt = 24000 / sqrt(3) * sqrt(2);
+	Real initVoltAngle = -PI / 2;
+	Real fieldVoltage = 7.0821;
+
+	auto initVoltN1 = std::vector<Complex>({
+		Complex(initTerminalVolt * cos(initVoltAngle), initTerminalVolt * sin(initVoltAngle)),
+		Complex(initTerminalVolt * cos(initVoltAngle - 2 * PI / 3), initTerminalVolt * sin(initVoltAngle - 2 * PI / 3)),
+		Complex(initTerminalVolt * cos(initVoltAngle + 2 * PI / 3), initTerminalVolt * sin(initVoltAngle + 2 * PI / 3)) });
+	auto n1 = SimNode::make("n1", CPS::PhaseType::ABC, initVoltN1);
+
+	auto gen = Ph3::SynchronGeneratorDQTrapez::make("SynGen");
+	gen->setParametersFundamentalPerUnit(nomPower, nomPhPhVoltRMS, nomFreq, poleNum, nomFieldCurr,
+		Rs, Ll, Lmd, Lmq, Rfd, Llfd, Rkd, Llkd, Rkq1, Llkq1, Rkq2, Llkq2, H,
+		initActivePower, initReactivePower, initTerminalVolt, initVoltAngle, fieldVoltage, initMechPower);
+	auto res = Ph3::SeriesResistor::make("R_load");
+	res->setParameters(1.92);
+	auto fault = Ph3::SeriesSwitch::make("Br_fault");
+	fault->setParameters(1e6, 0.001);
+	fault->open();
+
+	gen->connect({ n1 });
+	res->connect({ SimNode::GND, n1 });
+	fault->connect({ SimNode::GND, n1 });
+
+	auto sys = SystemTopology(60, SystemNodeList{ n1 }, SystemComponentList{ gen, res, fault });
+
+	auto logger = DataLogger::make("DP_SynGenDq7odTrapez");
+	logger->addAttribute("v1", n1->attribute("v"));
+	logger->addAttribute("i_gen", gen->attribute("i_intf"));
+	logger->addAttribute("wr_gen", gen->attribute("w_r"));
+
+	runChecked("DP_SynGenDq7odTrapez", sys, CPS::Domain::DP, 50e-6, logger,
+		SwitchEvent::make(0.05, fault, true));
+}
+
+int main(int argc, char* argv[]) {
+	Logger::setLogDir("logs/DP_EMT_AllocationCheck");
+
+	try {
+		dpRLCircuit(false);
+		dpRLCircuit(true);
+		dpBreakerLowRank();
+		emtRLCircuit();
+		dpSynGenDq7odTrapezFault();
+	}
+	catch (AllocationException& e) {
+		std::cerr << e.what() << std::endl;
+		return 1;
+	}
+	catch (CPS::SystemError& e) {
+		std::cerr << e.descr() << std::endl;
+		return 1;
+	}
+
+	std::cout << "No allocations during the steps" << std::endl;
+	return 0;
+}
@@ -0,0 +1,139 @@
+/* Copyright 2017-2020 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <DPsim.h>
+
+using namespace DPsim;
+using namespace CPS;
+
+// A meshed grid of 5x5 nodes whose nodes are added to the system in a
+// scrambled order, simulated in DP and EMT with the natural, RCM and AMD
+// node orderings. The node voltages have to be equal for all orderings in
+// every step. RCM must not increase the bandwidth and AMD must not increase
+// the fill of the node pattern compared to the natural order.
+
+const Int gridSize = 5;
+
+void setSource(std::shared_ptr<DP::Ph1::VoltageSource> vs) { vs->setParameters(Complex(100, 0)); }
+void setSource(std::shared_ptr<EMT::Ph1::VoltageSource> vs) { vs->setParameters(Complex(100, 0), 50); }
+
+template <typename VarType, typename VoltageSource, typename Resistor, typename Inductor>
+SystemTopology makeMesh() {
+	Int numNodes = gridSize * gridSize;
+	std::vector<typename SimNode<VarType>::Ptr> grid;
+	for (Int i = 0; i < gridSize; i++)
+		for (Int j = 0; j < gridSize; j++)
+			grid.push_back(SimNode<VarType>::make("n_" + std::to_string(i) + "_" + std::to_string(j)));
+
+	// 7 is coprime to the number of nodes, so every node is added once
+	SystemNodeList nodes;
+	for (Int k = 0; k < numNodes; k++)
+		nodes.push_back(grid[(7 * k) % numNodes]);
+
+	SystemComponentList comps;
+	auto vs = VoltageSource::make("vs");
+	setSource(vs);
+	vs->connect({ SimNode<VarType>::GND, grid[0] });
+	comps.push_back(vs);
+
+	for (Int i = 0; i < gridSize; i++) {
+		for (Int j = 0; j < gridSize; j++) {
+			String idx = std::to_string(i) + "_" + std::to_string(j);
+			auto node = grid[i * gridSize + j];
+
+			auto load = Resistor::make("r_load_" + idx);
+			load->setParameters(100. + i + j);
+			load->connect({ node, SimNode<VarType>::GND });
+			comps.push_back(load);
+
+			if (j + 1 < gridSize) {
+				auto line = Inductor::make("l_" + idx);
+				line->setParameters(0.001 * (1 + i));
+				line->connect({ node, grid[i * gridSize + j + 1] });
+				comps.push_back(line);
+			}
+			if (i + 1 < gridSize) {
+				auto line = Resistor::make("r_" + idx);
+				line->setParameters(0.5 * (1 + j));
+				line->connect({ node, grid[(i + 1) * gridSize + j] });
+				comps.push_back(line);
+			}
+		}
+	}
+
+	return SystemTopology(50, nodes, comps);
+}
+
+/// Maximum relative difference of the node voltages with RCM and AMD
+/// ordering to those with natural ordering
+template <typename VarType, typename VoltageSource, typename Resistor, typename Inductor>
+Real compareOrderings(const String& name, Domain domain, Bool& statisticsOk) {
+	Real timeStep = 0.0001;
+	Real finalTime = 0.02;
+
+	std::vector<NodeOrdering::Method> methods = {
+		NodeOrdering::Method::Natural, NodeOrdering::Method::RCM, NodeOrdering::Method::AMD };
+	std::vector<String> methodNames = { "natural", "rcm", "amd" };
+
+	std::vector<SystemTopology> systems;
+	std::vector<std::shared_ptr<Simulation>> sims;
+	for (UInt m = 0; m < methods.size(); m++) {
+		systems.push_back(makeMesh<VarType, VoltageSource, Resistor, Inductor>());
+		auto sim = std::make_shared<Simulation>(name + "_" + methodNames[m], systems.back(), timeStep, finalTime, domain);
+		sim->setNodeOrdering(methods[m]);
+		sim->initialize();
+		sims.push_back(sim);
+	}
+
+	Real maxDiff = 0;
+	while (sims[0]->time() < finalTime) {
+		for (auto sim : sims)
+			sim->step();
+		for (auto topoNode : systems[0].mNodes) {
+			VarType v = systems[0].node<SimNode<VarType>>(topoNode->name())->singleVoltage();
+			for (UInt m = 1; m < sims.size(); m++) {
+				VarType vOrdered = systems[m].node<SimNode<VarType>>(topoNode->name())->singleVoltage();
+				maxDiff = std::max(maxDiff, std::abs(v - vOrdered) / std::max(std::abs(v), 1.));
+			}
+		}
+	}
+	for (auto sim : sims)
+		sim->scheduler()->stop();
+
+	std::vector<std::shared_ptr<MnaSolver<VarType>>> solvers;
+	for (auto sim : sims)
+		solvers.push_back(std::dynamic_pointer_cast<MnaSolver<VarType>>(sim->solvers()[0]));
+	for (UInt m = 0; m < solvers.size(); m++) {
+		auto& stats = solvers[m]->nodeOrderStatistics();
+		std::cout << name << " " << methodNames[m] << ": bandwidth " << stats.bandwidth
+			<< ", fill " << stats.fill << std::endl;
+	}
+
+	auto& natural = solvers[0]->naturalOrderStatistics();
+	statisticsOk = solvers[0]->nodeOrderStatistics().bandwidth == natural.bandwidth
+		&& solvers[1]->nodeOrderStatistics().bandwidth <= natural.bandwidth
+		&& solvers[2]->nodeOrderStatistics().fill <= natural.fill;
+	std::cout << name << ": maximum relative voltage difference " << maxDiff << std::endl;
+	return maxDiff;
+}
+
+int main(int argc, char* argv[]) {
+	String simName = "DP_EMT_NodeOrdering";
+	Logger::setLogDir("logs/"+simName);
+
+	Bool dpStatistics, emtStatistics;
+	Real dpDiff = compareOrderings<Complex, DP::Ph1::VoltageSource, DP::Ph1::Resistor, DP::Ph1::Inductor>(
+		simName + "_DP", Domain::DP, dpStatistics);
+	Real emtDiff = compareOrderings<Real, EMT::Ph1::VoltageSource, EMT::Ph1::Resistor, EMT::Ph1::Inductor>(
+		simName + "_EMT", Domain::EMT, emtStatistics);
+
+	if (!dpStatistics || !emtStatistics)
+		std::cout << "Reordering increased the bandwidth or the fill" << std::endl;
+
+	return (dpStatistics && emtStatistics && dpDiff < 1e-9 && emtDiff < 1e-9) ? 0 : 1;
+}
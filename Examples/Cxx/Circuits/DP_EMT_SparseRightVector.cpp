@@ -0,0 +1,153 @@
+/* Copyright 2017-2020 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <functional>
+
+#include <DPsim.h>
+
+using namespace DPsim;
+using namespace CPS;
+
+// Circuits with the components that support sparse right side vector stamps
+// (inductors, capacitors and current sources in DP and EMT, three-phase
+// inductors and capacitors in EMT). Each is simulated with dense and with
+// sparse stamps, and the left side vectors have to be equal in every step.
+// With dense stamps, the "right_vector" attribute holds the stamp of a
+// component, with sparse stamps it stays empty.
+
+SystemTopology dpCircuit() {
+	auto n1 = DP::SimNode::make("n1");
+	auto n2 = DP::SimNode::make("n2");
+
+	auto cs = DP::Ph1::CurrentSource::make("cs");
+	cs->setParameters(Complex(10, 0));
+	auto r1 = DP::Ph1::Resistor::make("r_1");
+	r1->setParameters(1);
+	auto c1 = DP::Ph1::Capacitor::make("c_1");
+	c1->setParameters(0.001);
+	auto l1 = DP::Ph1::Inductor::make("l_1");
+	l1->setParameters(0.001);
+	auto r2 = DP::Ph1::Resistor::make("r_2");
+	r2->setParameters(1);
+
+	cs->connect(DP::SimNode::List{ DP::SimNode::GND, n1 });
+	r1->connect(DP::SimNode::List{ n1, DP::SimNode::GND });
+	c1->connect(DP::SimNode::List{ n1, n2 });
+	l1->connect(DP::SimNode::List{ n2, DP::SimNode::GND });
+	r2->connect(DP::SimNode::List{ n2, DP::SimNode::GND });
+
+	return SystemTopology(50, SystemNodeList{ n1, n2 }, SystemComponentList{ cs, r1, c1, l1, r2 });
+}
+
+SystemTopology emtCircuit() {
+	auto n1 = EMT::SimNode::make("n1");
+	auto n2 = EMT::SimNode::make("n2");
+
+	auto cs = EMT::Ph1::CurrentSource::make("cs");
+	cs->setParameters(Complex(10, 0), 50);
+	auto r1 = EMT::Ph1::Resistor::make("r_1");
+	r1->setParameters(1);
+	auto c1 = EMT::Ph1::Capacitor::make("c_1");
+	c1->setParameters(0.001);
+	auto l1 = EMT::Ph1::Inductor::make("l_1");
+	l1->setParameters(0.001);
+	auto r2 = EMT::Ph1::Resistor::make("r_2");
+	r2->setParameters(1);
+
+	cs->connect(EMT::SimNode::List{ EMT::SimNode::GND, n1 });
+	r1->connect(EMT::SimNode::List{ n1, EMT::SimNode::GND });
+	c1->connect(EMT::SimNode::List{ n1, n2 });
+	l1->connect(EMT::SimNode::List{ n2, EMT::SimNode::GND });
+	r2->connect(EMT::SimNode::List{ n2, EMT::SimNode::GND });
+
+	return SystemTopology(50, SystemNodeList{ n1, n2 }, SystemComponentList{ cs, r1, c1, l1, r2 });
+}
+
+SystemTopology emtPh3Circuit() {
+	auto n1 = EMT::SimNode::make("n1", PhaseType::ABC);
+	auto n2 = EMT::SimNode::make("n2", PhaseType::ABC);
+	auto n3 = EMT::SimNode::make("n3", PhaseType::ABC);
+
+	Matrix param = Matrix::Identity(3, 3);
+	auto vs = EMT::Ph3::VoltageSource::make("vs");
+	vs->setParameters(Math::singlePhaseVariableToThreePhase(Complex(10, 0)), 50);
+	auto r1 = EMT::Ph3::Resistor::make("r_1");
+	r1->setParameters(param);
+	auto l1 = EMT::Ph3::Inductor::make("l_1");
+	l1->setParameters(0.02 * param);
+	auto c1 = EMT::Ph3::Capacitor::make("c_1");
+	c1->setParameters(0.001 * param);
+	auto r2 = EMT::Ph3::Resistor::make("r_2");
+	r2->setParameters(2 * param);
+
+	vs->connect(EMT::SimNode::List{ EMT::SimNode::GND, n1 });
+	r1->connect(EMT::SimNode::List{ n1, n2 });
+	l1->connect(EMT::SimNode::List{ n2, n3 });
+	c1->connect(EMT::SimNode::List{ n3, EMT::SimNode::GND });
+	r2->connect(EMT::SimNode::List{ n3, EMT::SimNode::GND });
+
+	return SystemTopology(50, SystemNodeList{ n1, n2, n3 }, SystemComponentList{ vs, r1, l1, c1, r2 });
+}
+
+/// Size of the "right_vector" attribute of the component with the given name
+Matrix::Index rightVectorSize(SystemTopology& sys, const String& name) {
+	return sys.component<AttributeList>(name)->attribute<Matrix>("right_vector")->get().size();
+}
+
+/// Maximum relative difference of the left side vectors with dense and
+/// sparse right side vector stamps
+template <typename VarType>
+Real compareStamps(const String& name, std::function<SystemTopology()> makeSystem, Domain domain, Bool& attributesOk) {
+	Real timeStep = 0.0001;
+	Real finalTime = 0.05;
+
+	auto denseSys = makeSystem();
+	auto sparseSys = makeSystem();
+
+	Simulation denseSim(name + "_dense", denseSys, timeStep, finalTime, domain);
+	denseSim.doSparseRightVector(false);
+	Simulation sparseSim(name + "_sparse", sparseSys, timeStep, finalTime, domain);
+	sparseSim.doSparseRightVector(true);
+
+	denseSim.initialize();
+	sparseSim.initialize();
+
+	auto denseSolver = std::dynamic_pointer_cast<MnaSolver<VarType>>(denseSim.solvers()[0]);
+	auto sparseSolver = std::dynamic_pointer_cast<MnaSolver<VarType>>(sparseSim.solvers()[0]);
+
+	Real maxDiff = 0;
+	while (denseSim.time() < finalTime) {
+		denseSim.step();
+		sparseSim.step();
+		const Matrix& dense = denseSolver->leftSideVector();
+		const Matrix& sparse = sparseSolver->leftSideVector();
+		maxDiff = std::max(maxDiff, (dense - sparse).cwiseAbs().maxCoeff() / std::max(dense.cwiseAbs().maxCoeff(), 1.));
+	}
+	denseSim.scheduler()->stop();
+	sparseSim.scheduler()->stop();
+
+	attributesOk = rightVectorSize(denseSys, "l_1") > 0 && rightVectorSize(sparseSys, "l_1") == 0;
+	std::cout << name << ": maximum relative difference " << maxDiff << std::endl;
+	return maxDiff;
+}
+
+int main(int argc, char* argv[]) {
+	String simName = "DP_EMT_SparseRightVector";
+	Logger::setLogDir("logs/"+simName);
+
+	Bool dpAttributes, emtAttributes, emtPh3Attributes;
+	Real dpDiff = compareStamps<Complex>(simName + "_DP", dpCircuit, Domain::DP, dpAttributes);
+	Real emtDiff = compareStamps<Real>(simName + "_EMT", emtCircuit, Domain::EMT, emtAttributes);
+	Real emtPh3Diff = compareStamps<Real>(simName + "_EMT_Ph3", emtPh3Circuit, Domain::EMT, emtPh3Attributes);
+
+	Bool attributesOk = dpAttributes && emtAttributes && emtPh3Attributes;
+	if (!attributesOk)
+		std::cout << "Unexpected size of the right_vector attributes" << std::endl;
+
+	return (attributesOk && dpDiff < 1e-12 && emtDiff < 1e-12 && emtPh3Diff < 1e-12) ? 0 : 1;
+}
@@ -0,0 +1,126 @@
+/* Copyright 2017-2020 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <DPsim.h>
+#include <dpsim/ThreadLevelScheduler.h>
+
+using namespace DPsim;
+using namespace CPS::DP;
+using namespace CPS::DP::Ph1;
+
+// An inverter with harmonics feeds a filter and a grid, and a load is
+// connected by a switch during the simulation. The circuit is solved with
+// one solve task per frequency on several threads and with the solver for
+// all frequencies at once. The solve of a frequency only waits for the
+// pre-steps of its own frequency, so the node voltages of all frequencies
+// have to agree with the solution of the whole system before and after the
+// switch is closed.
+
+struct Circuit {
+	SystemTopology sys;
+	SimNode::List nodes;
+	std::shared_ptr<Switch> breaker;
+};
+
+Circuit makeCircuit(const Matrix& frequencies) {
+	auto n1 = SimNode::make("n1");
+	auto n2 = SimNode::make("n2");
+	auto n3 = SimNode::make("n3");
+	auto n4 = SimNode::make("n4");
+	auto n5 = SimNode::make("n5");
+
+	auto inv = Inverter::make("inv");
+	inv->setParameters(
+		std::vector<CPS::Int>{2,2,2,2},
+		std::vector<CPS::Int>{-3,-1,1,3},
+		360, 0.87, 0);
+	auto r1 = Resistor::make("r1");
+	r1->setParameters(0.1);
+	auto l1 = Inductor::make("l1");
+	l1->setParameters(600e-6);
+	auto c1 = Capacitor::make("c1");
+	c1->setParameters(10e-6);
+	auto r2 = Resistor::make("r2");
+	r2->setParameters(0.101);
+	auto l2 = Inductor::make("l2");
+	l2->setParameters(150e-6 + 0.001 / (2. * PI * 50.));
+	auto grid = VoltageSource::make("grid");
+	grid->setParameters(Complex(0, -311.1270));
+	auto breaker = Switch::make("breaker");
+	breaker->setParameters(1e9, 1e-3, false);
+	auto rLoad = Resistor::make("r_load");
+	rLoad->setParameters(5);
+	auto lLoad = Inductor::make("l_load");
+	lLoad->setParameters(0.005);
+
+	inv->connect({ n1 });
+	r1->connect({ n1, n2 });
+	l1->connect({ n2, n3 });
+	c1->connect({ SimNode::GND, n3 });
+	r2->connect({ n3, n4 });
+	l2->connect({ n4, n5 });
+	grid->connect({ SimNode::GND, n5 });
+	breaker->connect({ n3, n4 });
+	rLoad->connect({ n4, SimNode::GND });
+	lLoad->connect({ n4, SimNode::GND });
+
+	SimNode::List nodes{ n1, n2, n3, n4, n5 };
+	auto sys = SystemTopology(50, frequencies, SystemNodeList(nodes.begin(), nodes.end()),
+		SystemComponentList{ inv, r1, l1, c1, r2, l2, grid, breaker, rLoad, lLoad });
+	return { sys, nodes, breaker };
+}
+
+int main(int argc, char* argv[]) {
+	Real timeStep = 0.000001;
+	Real finalTime = 0.002;
+	String simName = "DP_FreqParallel_Switch";
+	Logger::setLogDir("logs/" + simName);
+
+	Matrix frequencies(5, 1);
+	frequencies << 50, 19850, 19950, 20050, 20150;
+
+	Circuit par = makeCircuit(frequencies);
+	Simulation parSim(simName + "_Parallel", par.sys, timeStep, finalTime);
+	parSim.doFrequencyParallelization(true);
+	parSim.setScheduler(std::make_shared<ThreadLevelScheduler>(2));
+	parSim.addEvent(SwitchEvent::make(0.001, par.breaker, true));
+	auto parLogger = DataLogger::make(simName + "_Parallel");
+	for (auto node : par.nodes)
+		parLogger->addAttribute(node->name() + ".v", node->attribute("v"));
+	parSim.addLogger(parLogger);
+
+	Circuit seq = makeCircuit(frequencies);
+	Simulation seqSim(simName + "_Sequential", seq.sys, timeStep, finalTime);
+	seqSim.doFrequencyParallelization(false);
+	seqSim.addEvent(SwitchEvent::make(0.001, seq.breaker, true));
+	auto seqLogger = DataLogger::make(simName + "_Sequential");
+	for (auto node : seq.nodes)
+		seqLogger->addAttribute(node->name() + ".v", node->attribute("v"));
+	seqSim.addLogger(seqLogger);
+
+	parSim.initialize();
+	seqSim.initialize();
+
+	Real maxDiff = 0, maxV = 0;
+	while (parSim.time() < finalTime) {
+		parSim.step();
+		seqSim.step();
+		for (UInt idx = 0; idx < par.nodes.size(); idx++) {
+			const MatrixComp& vPar = par.nodes[idx]->attribute<MatrixComp>("v")->get();
+			const MatrixComp& vSeq = seq.nodes[idx]->attribute<MatrixComp>("v")->get();
+			maxDiff = std::max(maxDiff, (vPar - vSeq).cwiseAbs().maxCoeff());
+			maxV = std::max(maxV, vSeq.cwiseAbs().maxCoeff());
+		}
+	}
+	parSim.scheduler()->stop();
+	seqSim.scheduler()->stop();
+
+	std::cout << "Maximum node voltage: " << maxV << " V" << std::endl;
+	std::cout << "Maximum difference of the node voltages: " << maxDiff << " V" << std::endl;
+	return maxDiff < 1e-6 * maxV ? 0 : 1;
+}
@@ -0,0 +1,128 @@
+/* Copyright 2017-2020 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <DPsim.h>
+
+using namespace DPsim;
+using namespace CPS::DP;
+using namespace CPS::DP::Ph1;
+
+// A source feeding four loads through breakers that pass through nine
+// switch states, with a cache of only three system matrices. The switch
+// states of the first breaker changes are evicted before they occur again
+// at the end. The voltages computed with lazily cached system matrices have
+// to match those of the precomputed matrices of all 2^4 switch states in
+// every step.
+
+const Int numBreakers = 4;
+const UInt cacheSize = 3;
+
+SystemTopology makeSystem(SimNode::List& nodes, std::vector<std::shared_ptr<Switch>>& breakers) {
+	auto n1 = SimNode::make("n1");
+	auto n2 = SimNode::make("n2");
+	nodes = { n1, n2 };
+
+	auto vs = VoltageSource::make("vs");
+	vs->setParameters(Complex(10000, 0));
+	auto rLine = Resistor::make("r_line");
+	rLine->setParameters(1);
+	auto lLine = Inductor::make("l_line");
+	lLine->setParameters(0.005);
+
+	vs->connect(SimNode::List{ SimNode::GND, n1 });
+	rLine->connect(SimNode::List{ n1, n2 });
+	lLine->connect(SimNode::List{ n2, SimNode::GND });
+
+	SystemTopology sys(50, SystemNodeList{ n1, n2 }, SystemComponentList{ vs, rLine, lLine });
+
+	for (Int i = 0; i < numBreakers; i++) {
+		String idx = std::to_string(i);
+		auto nLoad = SimNode::make("n_load_" + idx);
+		auto breaker = Switch::make("breaker_" + idx);
+		breaker->setParameters(1e9, 0.001, false);
+		auto rLoad = Resistor::make("r_load_" + idx);
+		rLoad->setParameters(50. * (i + 1));
+
+		breaker->connect(SimNode::List{ n2, nLoad });
+		rLoad->connect(SimNode::List{ nLoad, SimNode::GND });
+
+		sys.addNode(nLoad);
+		sys.addComponents(SystemComponentList{ breaker, rLoad });
+		nodes.push_back(nLoad);
+		breakers.push_back(breaker);
+	}
+
+	return sys;
+}
+
+void addBreakerEvents(Simulation& sim, std::vector<std::shared_ptr<Switch>>& breakers) {
+	// Switch states 0001, 0011, 0111, 1111, 1110, 1100, 1000, 0000, 0001
+	for (Int i = 0; i < numBreakers; i++)
+		sim.addEvent(SwitchEvent::make(0.005 * (i + 1), breakers[i], true));
+	for (Int i = 0; i < numBreakers; i++)
+		sim.addEvent(SwitchEvent::make(0.005 * (numBreakers + i + 1), breakers[i], false));
+	sim.addEvent(SwitchEvent::make(0.045, breakers[0], true));
+}
+
+int main(int argc, char* argv[]) {
+	Real timeStep = 0.0001;
+	Real finalTime = 0.06;
+	String simName = "DP_Lazy_Switches";
+	Logger::setLogDir("logs/"+simName);
+
+	SimNode::List precompNodes, lazyNodes;
+	std::vector<std::shared_ptr<Switch>> precompBreakers, lazyBreakers;
+	auto precompSys = makeSystem(precompNodes, precompBreakers);
+	auto lazySys = makeSystem(lazyNodes, lazyBreakers);
+
+	Simulation precompSim(simName + "_precomputed", precompSys, timeStep, finalTime);
+	addBreakerEvents(precompSim, precompBreakers);
+
+	Simulation lazySim(simName + "_lazy", lazySys, timeStep, finalTime);
+	lazySim.doLazySwitchedSystems(true, cacheSize);
+	lazySim.addExpectedSwitchState(std::bitset<SWITCH_NUM>("0011"));
+	addBreakerEvents(lazySim, lazyBreakers);
+
+	precompSim.initialize();
+	lazySim.initialize();
+	auto precompSolver = std::dynamic_pointer_cast<MnaSolver<Complex>>(precompSim.solvers()[0]);
+	auto lazySolver = std::dynamic_pointer_cast<MnaSolver<Complex>>(lazySim.solvers()[0]);
+	auto cacheEntries = lazySolver->attribute<Int>("switch_cache_size");
+	auto cacheHits = lazySolver->attribute<Int>("switch_cache_hits");
+	auto cacheMisses = lazySolver->attribute<Int>("switch_cache_misses");
+
+	Real maxDiff = 0;
+	Int maxCacheEntries = 0;
+	while (precompSim.time() < finalTime) {
+		precompSim.step();
+		lazySim.step();
+		for (UInt i = 0; i < precompNodes.size(); i++) {
+			Complex v = precompNodes[i]->singleVoltage();
+			maxDiff = std::max(maxDiff, std::abs(v - lazyNodes[i]->singleVoltage()) / std::max(std::abs(v), 1.));
+		}
+		maxCacheEntries = std::max(maxCacheEntries, cacheEntries->get());
+	}
+	precompSim.scheduler()->stop();
+	lazySim.scheduler()->stop();
+
+	// Inspecting the system matrix must not count as a cache lookup
+	Int hits = cacheHits->get();
+	Int misses = cacheMisses->get();
+	Real matrixDiff = Matrix(lazySolver->systemMatrix() - precompSolver->systemMatrix()).cwiseAbs().maxCoeff();
+	Bool lookupFree = hits == cacheHits->get() && misses == cacheMisses->get();
+
+	std::cout << "Cache hits: " << hits << ", misses: " << misses
+		<< ", maximum entries: " << maxCacheEntries << std::endl;
+	std::cout << "Maximum relative voltage difference: " << maxDiff << std::endl;
+	std::cout << "System matrix difference: " << matrixDiff << std::endl;
+
+	// 0011 is computed during initialization and found again. The states
+	// 0000 and 0001 are evicted before they occur again at the end.
+	Bool cacheOk = maxCacheEntries == static_cast<Int>(cacheSize) && misses == 8 && lookupFree;
+	return (cacheOk && maxDiff < 1e-9 && matrixDiff < 1e-9) ? 0 : 1;
+}
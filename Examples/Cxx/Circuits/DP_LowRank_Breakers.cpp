@@ -0,0 +1,147 @@
+/* Copyright 2017-2020 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <DPsim.h>
+
+using namespace DPsim;
+using namespace CPS::DP;
+using namespace CPS::DP::Ph1;
+
+// Low-rank updates with a maximum correction rank of 4. A breaker between
+// two nodes touches four columns of the real-valued DP system matrix, a
+// fault to ground two. Closing the first breaker and then the fault behind
+// it stays at rank 4, opening the breaker again leaves the rank 2 of the
+// fault, and closing a second breaker exceeds the maximum rank, so the
+// system matrix is refactorized. The voltages have to match those of the
+// solver with the factorizations of all switch states in every step, also
+// right after the refactorization.
+
+struct Breakers {
+	std::shared_ptr<Switch> breaker1, fault, breaker2;
+};
+
+SystemTopology makeSystem(SimNode::List& nodes, Breakers& breakers) {
+	auto n1 = SimNode::make("n1");
+	auto n2 = SimNode::make("n2");
+	auto n3 = SimNode::make("n3");
+	auto n4 = SimNode::make("n4");
+	nodes = { n1, n2, n3, n4 };
+
+	auto vs = VoltageSource::make("vs");
+	vs->setParameters(Complex(10000, 0));
+	auto rLine = Resistor::make("r_line");
+	rLine->setParameters(1);
+	auto lLine = Inductor::make("l_line");
+	lLine->setParameters(0.005);
+	auto rLoad3 = Resistor::make("r_load_3");
+	rLoad3->setParameters(50);
+	auto cLoad4 = Capacitor::make("c_load_4");
+	cLoad4->setParameters(0.0001);
+
+	breakers.breaker1 = Switch::make("breaker_1");
+	breakers.breaker1->setParameters(1e9, 0.001, false);
+	breakers.fault = Switch::make("fault");
+	breakers.fault->setParameters(1e9, 5, false);
+	breakers.breaker2 = Switch::make("breaker_2");
+	breakers.breaker2->setParameters(1e9, 0.001, false);
+
+	vs->connect(SimNode::List{ SimNode::GND, n1 });
+	rLine->connect(SimNode::List{ n1, n2 });
+	lLine->connect(SimNode::List{ n2, SimNode::GND });
+	breakers.breaker1->connect(SimNode::List{ n2, n3 });
+	rLoad3->connect(SimNode::List{ n3, SimNode::GND });
+	breakers.fault->connect(SimNode::List{ n3, SimNode::GND });
+	breakers.breaker2->connect(SimNode::List{ n2, n4 });
+	cLoad4->connect(SimNode::List{ n4, SimNode::GND });
+
+	return SystemTopology(50, SystemNodeList{ n1, n2, n3, n4 },
+		SystemComponentList{ vs, rLine, lLine, rLoad3, cLoad4,
+			breakers.breaker1, breakers.fault, breakers.breaker2 });
+}
+
+void setSwitches(Breakers& breakers, Bool breaker1, Bool fault, Bool breaker2) {
+	for (auto sw : { std::make_pair(breakers.breaker1, breaker1),
+			std::make_pair(breakers.fault, fault), std::make_pair(breakers.breaker2, breaker2) }) {
+		if (sw.second)
+			sw.first->close();
+		else
+			sw.first->open();
+	}
+}
+
+int main(int argc, char* argv[]) {
+	Real timeStep = 0.0001;
+	String simName = "DP_LowRank_Breakers";
+	Logger::setLogDir("logs/"+simName);
+
+	SimNode::List precompNodes, lowRankNodes;
+	Breakers precompBreakers, lowRankBreakers;
+	auto precompSys = makeSystem(precompNodes, precompBreakers);
+	auto lowRankSys = makeSystem(lowRankNodes, lowRankBreakers);
+
+	// Switch states (breaker 1, fault, breaker 2) and the expected rank,
+	// low-rank updates and refactorizations after each change
+	struct Change { Bool breaker1, fault, breaker2; Int rank, updates, refactorizations; };
+	std::vector<Change> changes = {
+		{ true,  false, false, 4, 1, 0 },
+		{ true,  true,  false, 4, 2, 0 },
+		{ false, true,  false, 2, 3, 0 },
+		{ false, true,  true,  0, 3, 1 },
+		{ false, false, true,  2, 4, 1 },
+	};
+	const Int stepsPerChange = 100;
+	Real finalTime = timeStep * stepsPerChange * (changes.size() + 1);
+
+	Simulation precompSim(simName + "_precomputed", precompSys, timeStep, finalTime);
+	Simulation lowRankSim(simName + "_lowrank", lowRankSys, timeStep, finalTime);
+	lowRankSim.doLowRankSystemUpdates(true, 4);
+
+	precompSim.initialize();
+	lowRankSim.initialize();
+	auto lowRankSolver = std::dynamic_pointer_cast<MnaSolver<Complex>>(lowRankSim.solvers()[0]);
+	auto rank = lowRankSolver->attribute<Int>("correction_rank");
+	auto updates = lowRankSolver->attribute<Int>("low_rank_updates");
+	auto refactorizations = lowRankSolver->attribute<Int>("refactorizations");
+
+	Real maxDiff = 0;
+	Bool countsMatch = true;
+	for (Int step = 0; precompSim.time() < finalTime; step++) {
+		Int change = step / stepsPerChange - 1;
+		if (step % stepsPerChange == 0 && change >= 0) {
+			setSwitches(precompBreakers, changes[change].breaker1, changes[change].fault, changes[change].breaker2);
+			setSwitches(lowRankBreakers, changes[change].breaker1, changes[change].fault, changes[change].breaker2);
+		}
+
+		precompSim.step();
+		lowRankSim.step();
+		for (UInt i = 0; i < precompNodes.size(); i++) {
+			Complex v = precompNodes[i]->singleVoltage();
+			maxDiff = std::max(maxDiff, std::abs(v - lowRankNodes[i]->singleVoltage()) / std::max(std::abs(v), 1.));
+		}
+
+		// The change is applied after the solution of its step
+		if (step % stepsPerChange == 0 && change >= 0) {
+			std::cout << "Change " << change << ": rank " << rank->get()
+				<< ", low-rank updates " << updates->get()
+				<< ", refactorizations " << refactorizations->get() << std::endl;
+			countsMatch = countsMatch && rank->get() == changes[change].rank
+				&& updates->get() == changes[change].updates
+				&& refactorizations->get() == changes[change].refactorizations;
+		}
+	}
+	precompSim.scheduler()->stop();
+	lowRankSim.scheduler()->stop();
+
+	std::cout << "Maximum relative voltage difference: " << maxDiff << std::endl;
+
+#ifdef WITH_SPARSE
+	// The symbolic analysis of the initialization is kept
+	countsMatch = countsMatch && lowRankSolver->attribute<Int>("pattern_analyses")->get() == 1;
+#endif
+	return (countsMatch && maxDiff < 1e-9) ? 0 : 1;
+}
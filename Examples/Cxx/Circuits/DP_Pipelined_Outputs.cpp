@@ -0,0 +1,91 @@
+/* Copyright 2017-2020 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <fstream>
+#include <sstream>
+
+#include <DPsim.h>
+#include <dpsim/ThreadLevelScheduler.h>
+
+using namespace DPsim;
+using namespace CPS::DP;
+using namespace CPS::DP::Ph1;
+
+// RL circuits that are simulated with the thread level scheduler, once with
+// the loggers executed in the steps and once on the output thread. The
+// written logs have to be identical.
+
+SystemTopology makeSystem(Int subnets, DataLogger::Ptr logger, DataLogger::Ptr downsampledLogger) {
+	SystemTopology sys(50);
+
+	for (Int i = 0; i < subnets; i++) {
+		String idx = std::to_string(i);
+		auto n1 = SimNode::make("n1_" + idx);
+		auto n2 = SimNode::make("n2_" + idx);
+
+		auto vs = VoltageSource::make("vs_" + idx);
+		vs->setParameters(Complex(10 + i, 0));
+		auto r1 = Resistor::make("r_1_" + idx);
+		r1->setParameters(5);
+		auto l1 = Inductor::make("l_1_" + idx);
+		l1->setParameters(0.02 * (i + 1));
+
+		vs->connect(SimNode::List{ SimNode::GND, n1 });
+		r1->connect(SimNode::List{ n1, n2 });
+		l1->connect(SimNode::List{ n2, SimNode::GND });
+
+		sys.addNodes(SystemNodeList{ n1, n2 });
+		sys.addComponents(SystemComponentList{ vs, r1, l1 });
+
+		logger->addAttribute("v2_" + idx, n2->attribute("v"));
+		logger->addAttribute("i_" + idx, l1->attribute("i_intf"));
+		downsampledLogger->addAttribute("v2_" + idx, n2->attribute("v"));
+	}
+
+	return sys;
+}
+
+String runSimulation(const String& name, Bool pipelineOutputs) {
+	Real timeStep = 0.0001;
+	Real finalTime = 0.05;
+	Int subnets = 4;
+
+	auto logger = DataLogger::make(name);
+	auto downsampledLogger = DataLogger::make(name + "_downsampled", true, 3);
+	auto sys = makeSystem(subnets, logger, downsampledLogger);
+
+	Simulation sim(name, sys, timeStep, finalTime);
+	auto scheduler = std::make_shared<ThreadLevelScheduler>(2);
+	scheduler->doPipelineOutputs(pipelineOutputs);
+	sim.setScheduler(scheduler);
+	sim.addLogger(logger);
+	sim.addLogger(downsampledLogger);
+	sim.run();
+
+	std::stringstream logs;
+	for (auto& suffix : { ".csv", "_downsampled.csv" }) {
+		std::ifstream file(CPS::Logger::logDir() + "/" + name + suffix);
+		logs << file.rdbuf();
+	}
+	return logs.str();
+}
+
+int main(int argc, char* argv[]) {
+	String simName = "DP_Pipelined_Outputs";
+	Logger::setLogDir("logs/"+simName);
+
+	String logsInSteps = runSimulation(simName + "_steps", false);
+	String logsPipelined = runSimulation(simName + "_pipelined", true);
+
+	if (logsInSteps.empty() || logsInSteps != logsPipelined) {
+		std::cout << "Logs with pipelined outputs differ" << std::endl;
+		return 1;
+	}
+	std::cout << "Logs with pipelined outputs are identical" << std::endl;
+	return 0;
+}
@@ -0,0 +1,178 @@
+/* Copyright 2017-2020 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <DPsim.h>
+
+using namespace DPsim;
+using namespace CPS;
+using namespace CPS::DP::Ph1;
+
+// Two loaded nodes coupled by a variable conductance that does not stamp
+// anything while it is zero. Connecting it adds entries outside of the known
+// sparsity pattern of the system matrix, changing its value is an in-place
+// update, and disconnecting it drops the entries from the stamp again. The
+// voltages of the solver that recomputes the system matrix have to match
+// those of the solver with precomputed matrices, where the conductance is
+// modelled by two switches in parallel.
+
+/// Conductance between two nodes that is stamped into the system matrix
+/// only when it is not zero
+class VariableConductance :
+	public MNAInterface,
+	public MNAVariableCompInterface,
+	public SimPowerComp<Complex>,
+	public SharedFactory<VariableConductance> {
+public:
+	VariableConductance(String name) : SimPowerComp<Complex>(name, name) {
+		mIntfVoltage = MatrixComp::Zero(1, 1);
+		mIntfCurrent = MatrixComp::Zero(1, 1);
+		setTerminalNumber(2);
+	}
+
+	void setConductance(Real conductance) {
+		mConductance = conductance;
+		mParameterChanged = true;
+	}
+
+	Bool hasParameterChanged() {
+		Bool changed = mParameterChanged;
+		mParameterChanged = false;
+		return changed;
+	}
+
+	void mnaApplySystemMatrixStamp(Matrix& systemMatrix) {
+		applySystemMatrixStamp(systemMatrix);
+	}
+
+	void mnaApplySystemMatrixStamp(SparseMatrixRow& systemMatrix) {
+		applySystemMatrixStamp(systemMatrix);
+	}
+
+private:
+	template <typename MatrixType>
+	void applySystemMatrixStamp(MatrixType& systemMatrix) {
+		if (mConductance == 0)
+			return;
+		UInt n0 = node(0)->matrixNodeIndex();
+		UInt n1 = node(1)->matrixNodeIndex();
+		Math::addToMatrixElement(systemMatrix, n0, n0, Complex(mConductance, 0));
+		Math::addToMatrixElement(systemMatrix, n1, n1, Complex(mConductance, 0));
+		Math::addToMatrixElement(systemMatrix, n0, n1, Complex(-mConductance, 0));
+		Math::addToMatrixElement(systemMatrix, n1, n0, Complex(-mConductance, 0));
+	}
+
+	Real mConductance = 0;
+	Bool mParameterChanged = false;
+};
+
+SystemTopology makeSystem(DP::SimNode::List& nodes, IdentifiedObject::List coupling) {
+	auto n1 = DP::SimNode::make("n1");
+	auto n2 = DP::SimNode::make("n2");
+	auto n3 = DP::SimNode::make("n3");
+	nodes = { n1, n2, n3 };
+
+	auto vs = VoltageSource::make("vs");
+	vs->setParameters(Complex(10000, 0));
+	auto rLine = Resistor::make("r_line");
+	rLine->setParameters(1);
+	auto lLine = Inductor::make("l_line");
+	lLine->setParameters(0.005);
+	auto rLoad2 = Resistor::make("r_load_2");
+	rLoad2->setParameters(50);
+	auto rLoad3 = Resistor::make("r_load_3");
+	rLoad3->setParameters(100);
+	auto cLoad3 = Capacitor::make("c_load_3");
+	cLoad3->setParameters(0.0001);
+
+	vs->connect(DP::SimNode::List{ DP::SimNode::GND, n1 });
+	rLine->connect(DP::SimNode::List{ n1, n2 });
+	lLine->connect(DP::SimNode::List{ n2, DP::SimNode::GND });
+	rLoad2->connect(DP::SimNode::List{ n2, DP::SimNode::GND });
+	rLoad3->connect(DP::SimNode::List{ n3, DP::SimNode::GND });
+	cLoad3->connect(DP::SimNode::List{ n3, DP::SimNode::GND });
+
+	SystemTopology sys(50, SystemNodeList{ n1, n2, n3 },
+		SystemComponentList{ vs, rLine, lLine, rLoad2, rLoad3, cLoad3 });
+	for (auto comp : coupling) {
+		std::dynamic_pointer_cast<SimPowerComp<Complex>>(comp)->connect(DP::SimNode::List{ n2, n3 });
+		sys.addComponent(comp);
+	}
+	return sys;
+}
+
+int main(int argc, char* argv[]) {
+	Real timeStep = 0.0001;
+	Real finalTime = 0.1;
+	String simName = "DP_SysRecomp_VariablePattern";
+	Logger::setLogDir("logs/"+simName);
+
+	// Conductance of 0.1 S and 0.05 S, and both in parallel. The open
+	// switches leave the coupled nodes almost isolated.
+	auto breakerA = Switch::make("breaker_a");
+	breakerA->setParameters(1e15, 10, false);
+	auto breakerB = Switch::make("breaker_b");
+	breakerB->setParameters(1e15, 20, false);
+	auto conductance = VariableConductance::make("g_var");
+
+	DP::SimNode::List precompNodes, recompNodes;
+	auto precompSys = makeSystem(precompNodes, { breakerA, breakerB });
+	auto recompSys = makeSystem(recompNodes, { conductance });
+
+	Simulation precompSim(simName + "_precomputed", precompSys, timeStep, finalTime);
+	Simulation recompSim(simName + "_recomp", recompSys, timeStep, finalTime);
+	recompSim.doSystemMatrixRecomputation(true);
+
+	precompSim.initialize();
+	recompSim.initialize();
+
+	Real maxDiff = 0;
+	Int step = 0;
+	while (recompSim.time() < finalTime) {
+		// Connect, change in place, disconnect and connect again without
+		// extending the pattern a second time
+		if (step == 200) {
+			breakerA->close();
+			conductance->setConductance(0.1);
+		} else if (step == 400) {
+			breakerB->close();
+			conductance->setConductance(0.15);
+		} else if (step == 600) {
+			breakerA->open();
+			breakerB->open();
+			conductance->setConductance(0);
+		} else if (step == 800) {
+			breakerB->close();
+			conductance->setConductance(0.05);
+		}
+
+		precompSim.step();
+		recompSim.step();
+		step++;
+		for (UInt i = 0; i < precompNodes.size(); i++) {
+			Complex v = precompNodes[i]->singleVoltage();
+			maxDiff = std::max(maxDiff, std::abs(v - recompNodes[i]->singleVoltage()) / std::max(std::abs(v), 1.));
+		}
+	}
+	precompSim.scheduler()->stop();
+	recompSim.scheduler()->stop();
+
+	auto recompSolver = std::dynamic_pointer_cast<MnaSolver<Complex>>(recompSim.solvers()[0]);
+	Int sysMatrixUpdates = recompSolver->attribute<Int>("sys_matrix_updates")->get();
+	Int patternAnalyses = recompSolver->attribute<Int>("pattern_analyses")->get();
+
+	std::cout << "System matrix recomputations: " << sysMatrixUpdates << std::endl;
+	std::cout << "Symbolic analyses: " << patternAnalyses << std::endl;
+	std::cout << "Maximum relative voltage difference: " << maxDiff << std::endl;
+
+	// Only the first connection extends the pattern of the initialization
+	Bool countsMatch = sysMatrixUpdates == 4;
+#ifdef WITH_SPARSE
+	countsMatch = countsMatch && patternAnalyses == 2;
+#endif
+	return (countsMatch && maxDiff < 1e-6) ? 0 : 1;
+}
@@ -0,0 +1,106 @@
+/* Copyright 2017-2020 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <DPsim.h>
+
+using namespace DPsim;
+using namespace CPS::DP;
+
+// An inverter connected to a slack through a line. The power controller of
+// the inverter is executed in every time step and, in a second simulation,
+// only in every fourth time step. Both have to agree on the trajectory of
+// the active power after the initial transient, which the controller only
+// samples every fourth step.
+
+const Real Vnom = 20e3;
+const Real VnomPV = 1500.;
+const Real Pref = 100e3;
+const Real Qref = 50e3;
+
+SystemTopology makeSystem(std::shared_ptr<Ph1::AvVoltageSourceInverterDQ>& vsi, UInt controlPeriod) {
+	auto n1 = SimNode::make("n1");
+	auto n2 = SimNode::make("n2");
+
+	auto extnet = Ph1::NetworkInjection::make("slack");
+	extnet->setParameters(Complex(Vnom, 0));
+
+	Real length = 5;
+	auto line = Ph1::PiLine::make("line");
+	line->setParameters(0.5 * length, 0.5 / 314 * length, 50e-6 / 314 * length);
+
+	vsi = Ph1::AvVoltageSourceInverterDQ::make("vsi", "vsi", Logger::Level::off, true);
+	vsi->setParameters(2 * PI * 50, VnomPV, Pref, Qref);
+	vsi->setControllerParameters(0.25, 0.2, 0.001, 0.008, 0.3, 1, 2 * PI * 50);
+	vsi->setFilterParameters(0.002, 789.3e-6, 0.1, 0.1);
+	vsi->setTransformerParameters(Vnom, VnomPV, Vnom / VnomPV, 0, 0, 0.928e-3);
+	vsi->setInitialStateValues(Pref, Qref, 0, 0, 0, 0);
+	vsi->setControlPeriod(controlPeriod);
+
+	extnet->connect({ n1 });
+	line->connect({ n1, n2 });
+	vsi->connect({ n2 });
+
+	auto sys = SystemTopology(50, SystemNodeList{ n1, n2 },
+		SystemComponentList{ extnet, line, vsi });
+	for (auto node : sys.mNodes)
+		node->setInitialVoltage(Complex(Vnom, 0));
+	return sys;
+}
+
+int main(int argc, char* argv[]) {
+	Real timeStep = 0.0001;
+	Real finalTime = 0.5;
+	String simName = "DP_VSI_ControlPeriod";
+	Logger::setLogDir("logs/" + simName);
+
+	std::shared_ptr<Ph1::AvVoltageSourceInverterDQ> vsiRef, vsiPeriod;
+	auto sysRef = makeSystem(vsiRef, 1);
+	auto sysPeriod = makeSystem(vsiPeriod, 4);
+
+	Simulation simRef(simName + "_1", sysRef, timeStep, finalTime);
+	auto loggerRef = DataLogger::make(simName + "_1");
+	loggerRef->addAttribute("powerctrl_states", vsiRef->attribute("powerctrl_states"));
+	loggerRef->addAttribute("v_intf", vsiRef->attribute("v_intf"));
+	simRef.addLogger(loggerRef);
+
+	Simulation simPeriod(simName + "_4", sysPeriod, timeStep, finalTime);
+	auto loggerPeriod = DataLogger::make(simName + "_4");
+	loggerPeriod->addAttribute("powerctrl_states", vsiPeriod->attribute("powerctrl_states"));
+	loggerPeriod->addAttribute("v_intf", vsiPeriod->attribute("v_intf"));
+	simPeriod.addLogger(loggerPeriod);
+
+	simRef.initialize();
+	simPeriod.initialize();
+
+	// The first state of the power controller is the filtered active power
+	auto statesRef = vsiRef->attribute<Matrix>("powerctrl_states");
+	auto statesPeriod = vsiPeriod->attribute<Matrix>("powerctrl_states");
+	Real transientTime = 0.05;
+	Real maxDiff = 0, maxPower = 0;
+	while (simRef.time() < finalTime) {
+		simRef.step();
+		simPeriod.step();
+		if (simRef.time() < transientTime)
+			continue;
+		maxPower = std::max(maxPower, std::abs(statesRef->get()(0, 0)));
+		maxDiff = std::max(maxDiff, std::abs(statesRef->get()(0, 0) - statesPeriod->get()(0, 0)));
+	}
+	simRef.scheduler()->stop();
+	simPeriod.scheduler()->stop();
+
+	std::cout << "Final active power: " << statesRef->get()(0, 0) << " W (period 1), "
+		<< statesPeriod->get()(0, 0) << " W (period 4)" << std::endl;
+	std::cout << "Maximum active power difference: " << maxDiff << " W" << std::endl;
+
+	// The inverter, its PLL and its power controller must not look up
+	// attributes by name within the steps
+	UInt lookups = CPS::AttributeList::LookupCheck::lookupCount();
+	std::cout << "Attribute lookups by name during the steps: " << lookups << std::endl;
+
+	return (maxDiff < 0.01 * maxPower && lookups == 0) ? 0 : 1;
+}
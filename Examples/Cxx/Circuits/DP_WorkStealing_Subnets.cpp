@@ -0,0 +1,89 @@
+/* Copyright 2017-2020 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <DPsim.h>
+#include <dpsim/WorkStealingScheduler.h>
+
+using namespace DPsim;
+using namespace CPS::DP;
+using namespace CPS::DP::Ph1;
+
+// Independent RL circuits that are solved by one MNA solver each. The voltages
+// computed with the work-stealing scheduler have to match the sequential ones.
+
+SystemTopology makeSystem(Int subnets, SimNode::List& nodes) {
+	SystemTopology sys(50);
+
+	for (Int i = 0; i < subnets; i++) {
+		String idx = std::to_string(i);
+		auto n1 = SimNode::make("n1_" + idx);
+		auto n2 = SimNode::make("n2_" + idx);
+
+		auto vs = VoltageSource::make("vs_" + idx);
+		vs->setParameters(Complex(10 + i, 0));
+		auto r1 = Resistor::make("r_1_" + idx);
+		r1->setParameters(5);
+		auto l1 = Inductor::make("l_1_" + idx);
+		l1->setParameters(0.02 * (i + 1));
+
+		vs->connect(SimNode::List{ SimNode::GND, n1 });
+		r1->connect(SimNode::List{ n1, n2 });
+		l1->connect(SimNode::List{ n2, SimNode::GND });
+
+		sys.addNodes(SystemNodeList{ n1, n2 });
+		sys.addComponents(SystemComponentList{ vs, r1, l1 });
+		nodes.push_back(n2);
+	}
+
+	return sys;
+}
+
+/// Maximum difference of the voltages computed sequentially and with the
+/// given scheduler
+Real compareVoltages(const String& simName, std::shared_ptr<WorkStealingScheduler> scheduler, Int subnets) {
+	Real timeStep = 0.0001;
+	Real finalTime = 0.02;
+
+	SimNode::List seqNodes, wsNodes;
+	auto seqSys = makeSystem(subnets, seqNodes);
+	auto wsSys = makeSystem(subnets, wsNodes);
+
+	Simulation seqSim(simName + "_seq", seqSys, timeStep, finalTime);
+	Simulation wsSim(simName + "_ws", wsSys, timeStep, finalTime);
+	wsSim.setScheduler(scheduler);
+
+	seqSim.initialize();
+	wsSim.initialize();
+
+	Real maxDiff = 0;
+	while (seqSim.time() < finalTime) {
+		seqSim.step();
+		wsSim.step();
+		for (Int i = 0; i < subnets; i++)
+			maxDiff = std::max(maxDiff, std::abs(seqNodes[i]->singleVoltage() - wsNodes[i]->singleVoltage()));
+	}
+	seqSim.scheduler()->stop();
+	wsSim.scheduler()->stop();
+	return maxDiff;
+}
+
+int main(int argc, char* argv[]) {
+	Int threads = 4;
+	String simName = "DP_WorkStealing_Subnets";
+	Logger::setLogDir("logs/"+simName);
+
+	// The scheduler is reused for a second simulation with fewer subnets, so
+	// its schedule must only contain the tasks of that simulation
+	auto scheduler = std::make_shared<WorkStealingScheduler>(threads, String(), true);
+	Real maxDiff = compareVoltages(simName, scheduler, 16);
+	Real maxDiffReused = compareVoltages(simName + "_reused", scheduler, 8);
+
+	std::cout << "Maximum voltage difference: " << maxDiff << ", with the reused scheduler: "
+		<< maxDiffReused << std::endl;
+	return (maxDiff > 1e-9 || maxDiffReused > 1e-9) ? 1 : 0;
+}
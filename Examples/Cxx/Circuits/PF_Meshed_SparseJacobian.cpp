@@ -0,0 +1,187 @@
+/* Copyright 2017-2020 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <DPsim.h>
+#include <dpsim/PFSolverPowerPolar.h>
+
+using namespace DPsim;
+using namespace CPS;
+
+// A meshed grid of four buses with a slack, two PQ buses and a PV bus. The
+// power flow is solved with the sparse Jacobian of the Newton-Raphson solver
+// and with the previous dense assembly of the Jacobian, in which every
+// entry is computed from the admittance matrix. The converged voltages and
+// the number of iterations have to be equal.
+
+/// Solver with the dense Jacobian assembly as reference
+class DenseJacobianPFSolver : public PFSolverPowerPolar {
+public:
+	DenseJacobianPFSolver(String name, SystemTopology system) :
+		PFSolverPowerPolar(name, system, 1, Logger::Level::info) {
+		doPowerFlowInit(false);
+	}
+
+	void solve() {
+		initialize();
+		for (auto task : getTasks())
+			task->execute(0, 0);
+	}
+
+protected:
+	void createJacobianPattern() {
+		std::vector<Eigen::Triplet<Real>> entries;
+		for (UInt a = 0; a < mNumUnknowns; a++)
+			for (UInt b = 0; b < mNumUnknowns; b++)
+				entries.emplace_back(a, b, 0.);
+		mJ.setFromTriplets(entries.begin(), entries.end());
+	}
+
+	void calculateJacobian() {
+		UInt npqpv = mNumPQBuses + mNumPVBuses;
+		Real val;
+		UInt k, j;
+
+		mJ.coeffs().setZero();
+
+		//J1
+		for (UInt a = 0; a < npqpv; a++) {
+			k = mPQPVBusIndices[a];
+			mJ.coeffRef(a, a) = -Q(k) - B(k, k) * sol_V.coeff(k) * sol_V.coeff(k);
+			for (UInt b = 0; b < npqpv; b++) {
+				if (b != a) {
+					j = mPQPVBusIndices[b];
+					val = sol_V.coeff(k) * sol_V.coeff(j)
+						* (G(k, j) * sin(sol_D.coeff(k) - sol_D.coeff(j))
+						- B(k, j) * cos(sol_D.coeff(k) - sol_D.coeff(j)));
+					mJ.coeffRef(a, b) = val;
+				}
+			}
+		}
+
+		//J2
+		for (UInt a = 0; a < npqpv; a++) {
+			k = mPQPVBusIndices[a];
+			if (a < mNumPQBuses)
+				mJ.coeffRef(a, a + npqpv) = P(k) + G(k, k) * sol_V.coeff(k) * sol_V.coeff(k);
+			for (UInt b = 0; b < mNumPQBuses; b++) {
+				if (b != a) {
+					j = mPQPVBusIndices[b];
+					val = sol_V.coeff(k) * sol_V.coeff(j)
+						* (G(k, j) * cos(sol_D.coeff(k) - sol_D.coeff(j))
+						+ B(k, j) * sin(sol_D.coeff(k) - sol_D.coeff(j)));
+					mJ.coeffRef(a, b + npqpv) = val;
+				}
+			}
+		}
+
+		//J3
+		for (UInt a = 0; a < mNumPQBuses; a++) {
+			k = mPQPVBusIndices[a];
+			mJ.coeffRef(a + npqpv, a) = P(k) - G(k, k) * sol_V.coeff(k) * sol_V.coeff(k);
+			for (UInt b = 0; b < npqpv; b++) {
+				if (b != a) {
+					j = mPQPVBusIndices[b];
+					val = sol_V.coeff(k) * sol_V.coeff(j)
+						* (G(k, j) * cos(sol_D.coeff(k) - sol_D.coeff(j))
+						+ B(k, j) * sin(sol_D.coeff(k) - sol_D.coeff(j)));
+					mJ.coeffRef(a + npqpv, b) = -val;
+				}
+			}
+		}
+
+		//J4
+		for (UInt a = 0; a < mNumPQBuses; a++) {
+			k = mPQPVBusIndices[a];
+			mJ.coeffRef(a + npqpv, a + npqpv) = Q(k) - B(k, k) * sol_V.coeff(k) * sol_V.coeff(k);
+			for (UInt b = 0; b < mNumPQBuses; b++) {
+				if (b != a) {
+					j = mPQPVBusIndices[b];
+					val = sol_V.coeff(k) * sol_V.coeff(j)
+						* (G(k, j) * sin(sol_D.coeff(k) - sol_D.coeff(j))
+						- B(k, j) * cos(sol_D.coeff(k) - sol_D.coeff(j)));
+					mJ.coeffRef(a + npqpv, b + npqpv) = val;
+				}
+			}
+		}
+	}
+};
+
+SystemTopology makeSystem() {
+	Real Vnom = 20e3;
+
+	auto n1 = SimNode<Complex>::make("n1", PhaseType::Single);
+	auto n2 = SimNode<Complex>::make("n2", PhaseType::Single);
+	auto n3 = SimNode<Complex>::make("n3", PhaseType::Single);
+	auto n4 = SimNode<Complex>::make("n4", PhaseType::Single);
+
+	auto extnet = SP::Ph1::NetworkInjection::make("Slack");
+	extnet->setParameters(Vnom);
+	extnet->setBaseVoltage(Vnom);
+	extnet->modifyPowerFlowBusType(PowerflowBusType::VD);
+	extnet->connect({ n1 });
+
+	auto gen = SP::Ph1::SynchronGenerator::make("Gen");
+	gen->setParameters(10e6, Vnom, 4e6, 1.01 * Vnom, PowerflowBusType::PV);
+	gen->setBaseVoltage(Vnom);
+	gen->connect({ n4 });
+
+	auto load2 = SP::Ph1::Load::make("Load2");
+	load2->setParameters(5e6, 2e6, Vnom);
+	load2->modifyPowerFlowBusType(PowerflowBusType::PQ);
+	load2->connect({ n2 });
+
+	auto load3 = SP::Ph1::Load::make("Load3");
+	load3->setParameters(3e6, 1e6, Vnom);
+	load3->modifyPowerFlowBusType(PowerflowBusType::PQ);
+	load3->connect({ n3 });
+
+	SystemComponentList comps = { extnet, gen, load2, load3 };
+
+	// Ring n1-n2-n3-n4 with a chord from n1 to n3, n2 and n4 are not connected
+	std::vector<std::pair<SimNode<Complex>::Ptr, SimNode<Complex>::Ptr>> branches = {
+		{ n1, n2 }, { n2, n3 }, { n3, n4 }, { n4, n1 }, { n1, n3 } };
+	for (UInt i = 0; i < branches.size(); i++) {
+		auto line = SP::Ph1::PiLine::make("Line" + std::to_string(i));
+		line->setParameters(0.4 + 0.1 * i, 0.004 + 0.001 * i, 0);
+		line->setBaseVoltage(Vnom);
+		line->connect({ branches[i].first, branches[i].second });
+		comps.push_back(line);
+	}
+
+	return SystemTopology(50, SystemNodeList{ n1, n2, n3, n4 }, comps);
+}
+
+int main(int argc, char* argv[]) {
+	String simName = "PF_Meshed_SparseJacobian";
+	Logger::setLogDir("logs/" + simName);
+
+	auto sparseSys = makeSystem();
+	Simulation sim(simName, sparseSys, 1, 1, Domain::SP, Solver::Type::NRP);
+	sim.doPowerFlowInit(false);
+	sim.run();
+	auto sparseSolver = std::dynamic_pointer_cast<PFSolver>(sim.solvers()[0]);
+
+	auto denseSys = makeSystem();
+	DenseJacobianPFSolver denseSolver(simName + "_dense", denseSys);
+	denseSolver.solve();
+
+	Real maxDiff = 0;
+	for (auto topoNode : sparseSys.mNodes) {
+		Complex v = sparseSys.node<SimNode<Complex>>(topoNode->name())->singleVoltage();
+		Complex vDense = denseSys.node<SimNode<Complex>>(topoNode->name())->singleVoltage();
+		std::cout << topoNode->name() << ": " << std::abs(v) << " V, " << std::arg(v) << " rad" << std::endl;
+		maxDiff = std::max(maxDiff, std::abs(v - vDense) / std::abs(vDense));
+	}
+
+	std::cout << "Iterations sparse: " << sparseSolver->iterations()
+		<< ", dense: " << denseSolver.iterations() << std::endl;
+	std::cout << "Maximum relative voltage difference: " << maxDiff << std::endl;
+
+	Bool converged = sparseSolver->converged() && denseSolver.converged();
+	return (converged && sparseSolver->iterations() == denseSolver.iterations() && maxDiff < 1e-10) ? 0 : 1;
+}
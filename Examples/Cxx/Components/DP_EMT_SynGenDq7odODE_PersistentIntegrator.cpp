@@ -0,0 +1,200 @@
+/* Copyright 2017-2020 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+// Regression test of the persistent ODE integrator: the generator states of
+// a three-phase fault simulated with an integrator that is reinitialized in
+// each step have to match the states obtained with an integrator that is
+// recreated in each step.
+
+#include <DPsim.h>
+
+using namespace DPsim;
+
+// Define machine parameters in per unit
+Real nomPower = 555e6;
+Real nomPhPhVoltRMS = 24e3;
+Real nomFreq = 60;
+Real nomFieldCurr = 1300;
+Int poleNum = 2;
+Real H = 3.7;
+Real Rs = 0.003;
+Real Ll = 0.15;
+Real Lmd = 1.6599;
+Real Lmq = 1.61;
+Real Rfd = 0.0006;
+Real Llfd = 0.1648;
+Real Rkd = 0.0284;
+Real Llkd = 0.1713;
+Real Rkq1 = 0.0062;
+Real Llkq1 = 0.7252;
+Real Rkq2 = 0.0237;
+Real Llkq2 = 0.125;
+// Initialization parameters
+Real initActivePower = 300e6;
+Real initReactivePower = 0;
+Real initMechPower = 300e6;
+Real initTerminalVolt = 24000 / sqrt(3) * sqrt(2);
+Real initVoltAngle = -PI / 2;
+Real fieldVoltage = 7.0821;
+
+// Define grid parameters
+// resistance for 300 MW output
+Real Rload = 1.92;
+Real BreakerOpen = 1e6;
+Real BreakerClosed = 0.001;
+
+// Initial node voltage
+auto initVoltN1 = std::vector<Complex>({
+	Complex(initTerminalVolt * cos(initVoltAngle),
+		initTerminalVolt * sin(initVoltAngle)),
+	Complex(initTerminalVolt * cos(initVoltAngle - 2 * PI / 3),
+		initTerminalVolt * sin(initVoltAngle - 2 * PI / 3)),
+	Complex(initTerminalVolt * cos(initVoltAngle + 2 * PI / 3),
+		initTerminalVolt * sin(initVoltAngle + 2 * PI / 3)) });
+
+/// Runs the simulation and returns the generator states after each step
+std::vector<Matrix> simulate(Simulation& sim, CPS::AttributeList::Ptr gen, Real finalTime) {
+	std::vector<Matrix> states;
+	auto odeState = gen->attribute<Matrix>("ode_post_state");
+
+	sim.initialize();
+	while (sim.step() < finalTime)
+		states.push_back(odeState->get());
+
+	return states;
+}
+
+std::vector<Matrix> DP_SynGenDq7odODE_ThreePhFault(Real timeStep, Real finalTime, Bool persistent) {
+	String simName = "DP_SynGenDq7odODE_PersistentIntegrator" + String(persistent ? "_Persistent" : "_Recreated");
+	Logger::setLogDir("logs/"+simName);
+
+	// Nodes
+	auto n1 = CPS::DP::SimNode::make("n1", PhaseType::ABC, initVoltN1);
+
+	// Components
+	auto gen = CPS::DP::Ph3::SynchronGeneratorDQODE::make("SynGen");
+	gen->setParametersFundamentalPerUnit(
+		nomPower, nomPhPhVoltRMS, nomFreq, poleNum, nomFieldCurr,
+		Rs, Ll, Lmd, Lmq, Rfd, Llfd, Rkd, Llkd, Rkq1, Llkq1, Rkq2, Llkq2, H,
+		initActivePower, initReactivePower, initTerminalVolt,
+		initVoltAngle, fieldVoltage, initMechPower);
+
+	auto res = CPS::DP::Ph3::SeriesResistor::make("R_load");
+	res->setParameters(Rload);
+
+	auto fault = CPS::DP::Ph3::SeriesSwitch::make("Br_fault");
+	fault->setParameters(BreakerOpen, BreakerClosed);
+	fault->open();
+
+	// Connections
+	gen->connect({n1});
+	res->connect({CPS::DP::SimNode::GND, n1});
+	fault->connect({CPS::DP::SimNode::GND, n1});
+
+	auto sys = SystemTopology(60, SystemNodeList{n1}, SystemComponentList{gen, res, fault});
+
+	Simulation sim(simName, Logger::Level::info);
+	sim.setSystem(sys);
+	sim.setTimeStep(timeStep);
+	sim.setFinalTime(finalTime);
+	sim.setDomain(Domain::DP);
+	sim.doPersistentODEIntegrator(persistent);
+
+	// Events
+	auto sw1 = SwitchEvent::make(0.1, fault, true);
+	sim.addEvent(sw1);
+	auto sw2 = SwitchEvent::make(0.2, fault, false);
+	sim.addEvent(sw2);
+
+	return simulate(sim, gen, finalTime);
+}
+
+std::vector<Matrix> EMT_SynGenDq7odODE_ThreePhFault(Real timeStep, Real finalTime, Bool persistent) {
+	String simName = "EMT_SynGenDq7odODE_PersistentIntegrator" + String(persistent ? "_Persistent" : "_Recreated");
+	Logger::setLogDir("logs/"+simName);
+
+	// Nodes
+	auto n1 = CPS::EMT::SimNode::make("n1", PhaseType::ABC, initVoltN1);
+
+	// Components
+	auto gen = CPS::EMT::Ph3::SynchronGeneratorDQODE::make("SynGen");
+	gen->setParametersFundamentalPerUnit(
+		nomPower, nomPhPhVoltRMS, nomFreq, poleNum, nomFieldCurr,
+		Rs, Ll, Lmd, Lmq, Rfd, Llfd, Rkd, Llkd, Rkq1, Llkq1, Rkq2, Llkq2, H,
+		initActivePower, initReactivePower, initTerminalVolt,
+		initVoltAngle, fieldVoltage, initMechPower);
+
+	auto res = CPS::EMT::Ph3::SeriesResistor::make("R_load");
+	res->setParameters(Rload);
+
+	auto fault = CPS::EMT::Ph3::SeriesSwitch::make("Br_fault");
+	fault->setParameters(BreakerOpen, BreakerClosed);
+	fault->open();
+
+	// Connections
+	gen->connect({n1});
+	res->connect({CPS::EMT::SimNode::GND, n1});
+	fault->connect({CPS::EMT::SimNode::GND, n1});
+
+	auto sys = SystemTopology(60, SystemNodeList{n1}, SystemComponentList{gen, res, fault});
+
+	Simulation sim(simName, Logger::Level::info);
+	sim.setSystem(sys);
+	sim.setTimeStep(timeStep);
+	sim.setFinalTime(finalTime);
+	sim.setDomain(Domain::EMT);
+	sim.doPersistentODEIntegrator(persistent);
+
+	// Events
+	auto sw1 = SwitchEvent::make(0.1, fault, true);
+	sim.addEvent(sw1);
+	auto sw2 = SwitchEvent::make(0.2, fault, false);
+	sim.addEvent(sw2);
+
+	return simulate(sim, gen, finalTime);
+}
+
+/// Returns the maximum deviation of the states relative to the largest reference state
+Real maxRelativeDeviation(const std::vector<Matrix>& reference, const std::vector<Matrix>& states) {
+	if (reference.size() != states.size())
+		return std::numeric_limits<Real>::infinity();
+
+	Real maxDeviation = 0;
+	for (UInt step = 0; step < reference.size(); step++) {
+		Real scale = std::max(reference[step].cwiseAbs().maxCoeff(), 1.);
+		Real deviation = (reference[step] - states[step]).cwiseAbs().maxCoeff() / scale;
+		if (!std::isfinite(deviation))
+			return std::numeric_limits<Real>::infinity();
+		maxDeviation = std::max(maxDeviation, deviation);
+	}
+	return maxDeviation;
+}
+
+int main(int argc, char* argv[]) {
+
+	Real finalTime = 0.3;
+	Real timeStep = 0.00005;
+	// The integrator tolerances are 1e-6 relative and 1e-10 absolute
+	Real tolerance = 1e-4;
+
+	Real devDP = maxRelativeDeviation(
+		DP_SynGenDq7odODE_ThreePhFault(timeStep, finalTime, false),
+		DP_SynGenDq7odODE_ThreePhFault(timeStep, finalTime, true));
+	Real devEMT = maxRelativeDeviation(
+		EMT_SynGenDq7odODE_ThreePhFault(timeStep, finalTime, false),
+		EMT_SynGenDq7odODE_ThreePhFault(timeStep, finalTime, true));
+
+	std::cout << "Maximum relative state deviation DP: " << devDP
+		<< ", EMT: " << devEMT << std::endl;
+
+	if (devDP > tolerance || devEMT > tolerance) {
+		std::cerr << "Persistent integrator deviates from the recreated integrator" << std::endl;
+		return 1;
+	}
+	return 0;
+}
@@ -95,4 +95,11 @@ int main(int argc, char* argv[]) {
 	sim.addLogger(logger);
 
 	sim.run();
+
+	// The models must not look up attributes by name within the steps
+	if (CPS::AttributeList::LookupCheck::lookupCount() != 0) {
+		std::cout << "Attributes were looked up by name during the steps" << std::endl;
+		return 1;
+	}
+	return 0;
 }
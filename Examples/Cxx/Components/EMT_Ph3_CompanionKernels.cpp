@@ -0,0 +1,136 @@
+/* Copyright 2017-2020 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <chrono>
+#include <iostream>
+
+#include <DPsim.h>
+
+using namespace DPsim;
+using namespace CPS;
+using namespace CPS::EMT::Ph3;
+
+// Step cost of the three-phase inductor companion model: The update of the
+// history current, the right side vector stamp and the voltage and current
+// update with dynamically sized matrices as in the original model, compared
+// to the fixed size kernels of CompanionKernels. The results of both have to
+// be equal up to rounding, whether the kernels use AVX2 or not.
+
+struct DynamicInductor {
+	Matrix equivCond = Matrix::Zero(3, 3);
+	Matrix equivCurrent = Matrix::Zero(3, 1);
+	Matrix voltage = Matrix::Zero(3, 1);
+	Matrix current = Matrix::Zero(3, 1);
+	Matrix::Index node0, node1;
+
+	void preStep(SparseVector& rightVector) {
+		equivCurrent = equivCond * voltage + current;
+		for (Matrix::Index k = 0; k < 3; k++) {
+			Math::setVectorElement(rightVector, node0 + k, equivCurrent(k, 0));
+			Math::setVectorElement(rightVector, node1 + k, -equivCurrent(k, 0));
+		}
+	}
+
+	void postStep(const Matrix& leftVector) {
+		voltage = Matrix::Zero(3, 1);
+		for (Matrix::Index k = 0; k < 3; k++)
+			voltage(k, 0) = Math::realFromVectorElement(leftVector, node1 + k) - Math::realFromVectorElement(leftVector, node0 + k);
+		current = equivCond * voltage + equivCurrent;
+	}
+};
+
+struct FixedInductor {
+	Matrix3 equivCond = Matrix3::Zero();
+	Vector3 equivCurrent = Vector3::Zero();
+	Matrix voltage = Matrix::Zero(3, 1);
+	Matrix current = Matrix::Zero(3, 1);
+	CompanionKernels::NodeIndices nodes;
+	CompanionKernels::VectorEntries entries;
+
+	void preStep() {
+		CompanionKernels::multiplyAdd(equivCond, voltage.data(), current.data(), 1., equivCurrent.data());
+		CompanionKernels::stampCurrent(entries, equivCurrent.data());
+	}
+
+	void postStep(const Matrix& leftVector) {
+		CompanionKernels::terminalVoltage(leftVector, nodes, voltage.data());
+		CompanionKernels::multiplyAdd(equivCond, voltage.data(), equivCurrent.data(), 1., current.data());
+	}
+};
+
+int main(int argc, char* argv[]) {
+	Int numComps = 1000;
+	Int numSteps = 1000;
+
+	CommandLineArgs args(argc, argv);
+	if (args.options.find("comps") != args.options.end())
+		numComps = args.options["comps"];
+	if (args.options.find("steps") != args.options.end())
+		numSteps = args.options["steps"];
+
+	// Each inductor connects two three-phase nodes of its own
+	Matrix::Index rows = 6 * numComps;
+	Matrix leftVector = Matrix::Random(rows, 1);
+	Matrix inductance(3, 3);
+	inductance <<
+		0.10, 0.02, 0.02,
+		0.02, 0.10, 0.02,
+		0.02, 0.02, 0.10;
+	Real timeStep = 50e-6;
+
+	std::vector<DynamicInductor> dynComps(numComps);
+	std::vector<SparseVector> dynVectors(numComps, SparseVector(rows));
+	std::vector<FixedInductor> fixComps(numComps);
+	std::vector<SparseVector> fixVectors(numComps, SparseVector(rows));
+	for (Int c = 0; c < numComps; c++) {
+		dynComps[c].node0 = 6 * c;
+		dynComps[c].node1 = 6 * c + 3;
+		dynComps[c].equivCond = timeStep / 2. * inductance.inverse();
+
+		for (Int k = 0; k < 6; k++)
+			fixComps[c].nodes[k] = 6 * c + k;
+		fixComps[c].equivCond = dynComps[c].equivCond;
+		fixComps[c].entries = CompanionKernels::vectorEntries(fixVectors[c], fixComps[c].nodes);
+	}
+
+	auto start = std::chrono::steady_clock::now();
+	for (Int step = 0; step < numSteps; step++) {
+		for (Int c = 0; c < numComps; c++)
+			dynComps[c].preStep(dynVectors[c]);
+		for (Int c = 0; c < numComps; c++)
+			dynComps[c].postStep(leftVector);
+	}
+	std::chrono::duration<Real, std::nano> dynTime = std::chrono::steady_clock::now() - start;
+
+	start = std::chrono::steady_clock::now();
+	for (Int step = 0; step < numSteps; step++) {
+		for (Int c = 0; c < numComps; c++)
+			fixComps[c].preStep();
+		for (Int c = 0; c < numComps; c++)
+			fixComps[c].postStep(leftVector);
+	}
+	std::chrono::duration<Real, std::nano> fixTime = std::chrono::steady_clock::now() - start;
+
+	Real maxDiff = 0;
+	for (Int c = 0; c < numComps; c++) {
+		Real scale = std::max(dynComps[c].current.cwiseAbs().maxCoeff(), 1.);
+		maxDiff = std::max(maxDiff, (dynComps[c].current - fixComps[c].current).cwiseAbs().maxCoeff() / scale);
+		maxDiff = std::max(maxDiff, (Matrix(dynVectors[c]) - Matrix(fixVectors[c])).cwiseAbs().maxCoeff() / scale);
+	}
+
+#if defined(__AVX2__) && defined(__FMA__)
+	std::cout << "Kernels: AVX2" << std::endl;
+#else
+	std::cout << "Kernels: scalar" << std::endl;
+#endif
+	std::cout << "Dynamic size: " << dynTime.count() / (numComps * numSteps) << " ns per component step" << std::endl;
+	std::cout << "Fixed size:   " << fixTime.count() / (numComps * numSteps) << " ns per component step" << std::endl;
+	std::cout << "Max. relative difference: " << maxDiff << std::endl;
+
+	return maxDiff < 1e-10 ? 0 : 1;
+}
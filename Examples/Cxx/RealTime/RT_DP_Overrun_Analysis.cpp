@@ -0,0 +1,149 @@
+/* Copyright 2017-2020 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <set>
+#include <thread>
+
+#include <DPsim.h>
+
+using namespace DPsim;
+using namespace CPS::DP;
+using namespace CPS::DP::Ph1;
+
+// An RL circuit with a resistor that has an additional task, which is
+// executed in every second step and is deliberately slow in a few of them.
+// The step time statistics and the overrun analysis have to report the slow
+// steps and attribute them to this task, but not the steps in which it was
+// skipped.
+
+const UInt slowPeriod = 2;
+
+class SlowTask : public CPS::Task {
+public:
+	SlowTask(String name, std::set<Int> slowSteps, std::chrono::milliseconds delay) :
+		Task(name), mSlowSteps(slowSteps), mDelay(delay) {
+		setPeriod(slowPeriod);
+		mModifiedAttributes.push_back(Scheduler::external);
+	}
+
+	void execute(Real time, Int timeStepCount) {
+		if (mSlowSteps.count(timeStepCount))
+			std::this_thread::sleep_for(mDelay);
+	}
+
+private:
+	std::set<Int> mSlowSteps;
+	std::chrono::milliseconds mDelay;
+};
+
+class SlowResistor : public Resistor {
+public:
+	SlowResistor(String name, std::shared_ptr<SlowTask> task) :
+		Resistor(name), mSlowTask(task) { }
+
+	void mnaInitialize(Real omega, Real timeStep, CPS::Attribute<Matrix>::Ptr leftVector) {
+		Resistor::mnaInitialize(omega, timeStep, leftVector);
+		mMnaTasks.push_back(mSlowTask);
+	}
+
+private:
+	std::shared_ptr<SlowTask> mSlowTask;
+};
+
+SystemTopology makeSystem(std::shared_ptr<SlowTask> task, DataLogger::Ptr logger) {
+	auto n1 = SimNode::make("n1");
+	auto n2 = SimNode::make("n2");
+
+	auto vs = VoltageSource::make("v_s");
+	vs->setParameters(Complex(1000, 0));
+	auto r = std::make_shared<SlowResistor>("r_slow", task);
+	r->setParameters(1);
+	auto l = Inductor::make("l_load");
+	l->setParameters(0.01);
+
+	vs->connect({ SimNode::GND, n1 });
+	r->connect({ n1, n2 });
+	l->connect({ n2, SimNode::GND });
+
+	logger->addAttribute("v2", n2->attribute("v"));
+
+	return SystemTopology(50, SystemNodeList{ n1, n2 }, SystemComponentList{ vs, r, l });
+}
+
+Real attributeValue(Simulation& sim, const String& name) {
+	return sim.attribute<Real>(name)->getByValue();
+}
+
+/// Steps a simulation and looks for the outlier task after a slow step and
+/// after the following step, in which the slow task is skipped
+Bool checkOutliers(const String& simName) {
+	Int slowStep = 10;
+	auto delay = std::chrono::milliseconds(5);
+	auto task = std::make_shared<SlowTask>("r_slow.Slow", std::set<Int>{ slowStep }, delay);
+	auto logger = DataLogger::make(simName);
+	auto sys = makeSystem(task, logger);
+
+	Simulation sim(simName, sys, 0.001, 0.1);
+	sim.doOverrunAnalysis(true);
+	sim.addLogger(logger);
+	sim.initialize();
+
+	while (sim.timeStepCount() <= slowStep)
+		sim.step();
+	CPS::Task* slowOutlier = sim.scheduler()->lastStepOutlier(slowStep);
+	sim.step();
+	CPS::Task* skippedOutlier = sim.scheduler()->lastStepOutlier(slowStep + 1);
+	sim.scheduler()->stop();
+
+	Real delaySeconds = std::chrono::duration<Real>(delay).count();
+	Real maxStep = attributeValue(sim, "step_time_max");
+	Real medianStep = attributeValue(sim, "step_time_p50");
+
+	std::cout << "Outlier in the slow step: " << (slowOutlier ? slowOutlier->toString() : "none") << std::endl;
+	std::cout << "Outlier in the next step: " << (skippedOutlier ? skippedOutlier->toString() : "none") << std::endl;
+	std::cout << "Step time max: " << maxStep << " s, p50: " << medianStep << " s" << std::endl;
+
+	return slowOutlier == task.get() && skippedOutlier && skippedOutlier != task.get()
+		&& maxStep >= delaySeconds && medianStep < delaySeconds;
+}
+
+/// Runs a real-time simulation in which each slow step overruns the timer
+std::map<String, UInt> runRealTime(const String& simName, Bool overrunAnalysis, std::set<Int> slowSteps) {
+	auto task = std::make_shared<SlowTask>("r_slow.Slow", slowSteps, std::chrono::milliseconds(10));
+	auto logger = DataLogger::make(simName);
+	auto sys = makeSystem(task, logger);
+
+	RealTimeSimulation sim(simName, sys, 0.002, 0.2, CPS::Domain::DP,
+		Solver::Type::MNA, Logger::Level::info);
+	sim.doOverrunAnalysis(overrunAnalysis);
+	sim.addLogger(logger);
+	sim.run(std::chrono::milliseconds(100));
+
+	return sim.overrunTasks();
+}
+
+int main(int argc, char* argv[]) {
+	String simName = "RT_DP_Overrun_Analysis";
+	Logger::setLogDir("logs/"+simName);
+
+	Bool outliersOk = checkOutliers(simName + "_steps");
+
+	std::set<Int> slowSteps = { 20, 40, 60, 80 };
+	auto overruns = runRealTime(simName + "_rt", true, slowSteps);
+	auto overrunsOff = runRealTime(simName + "_rt_off", false, slowSteps);
+
+	for (auto& pair : overruns)
+		std::cout << "Overruns caused by " << pair.first << ": " << pair.second << std::endl;
+
+	// Every slow step overruns and the slow task must not be blamed for other
+	// overruns. Without the analysis, the overruns are not attributed.
+	Bool overrunsOk = overruns.count("r_slow.Slow") && overruns["r_slow.Slow"] == slowSteps.size()
+		&& overrunsOff.empty();
+
+	return (outliersOk && overrunsOk) ? 0 : 1;
+}
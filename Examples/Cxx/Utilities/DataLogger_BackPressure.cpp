@@ -0,0 +1,88 @@
+/* Copyright 2017-2020 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+#include <DPsim.h>
+
+using namespace DPsim;
+
+// Logs rows with many columns into a ring buffer of a few rows, so that the
+// asynchronous writer cannot keep up with the formatting. Block has to write
+// every row, Drop and Report have to write the rows that were not counted
+// by droppedRows() in order, and only Report prints the number of dropped
+// rows when the logger is closed.
+
+const UInt numRows = 5000;
+const UInt numColumns = 100;
+
+struct Result {
+	std::size_t dropped;
+	std::size_t written;
+	Bool ordered;
+	String report;
+};
+
+Result logRows(const String& name, DataLogger::BackPressure backPressure) {
+	std::vector<Real> values(numColumns);
+	auto logger = DataLogger::make(name);
+	for (UInt col = 0; col < numColumns; col++)
+		logger->addAttribute("c" + std::to_string(col), CPS::Attribute<Real>::make(&values[col]));
+	logger->doAsyncWrite(true, 4, backPressure);
+
+	// The report of dropped rows goes to std::cerr
+	std::stringstream report;
+	auto cerrBuf = std::cerr.rdbuf(report.rdbuf());
+	for (UInt row = 0; row < numRows; row++) {
+		for (UInt col = 0; col < numColumns; col++)
+			values[col] = row + col;
+		logger->log(row * 1e-3, row);
+	}
+	logger->close();
+	std::cerr.rdbuf(cerrBuf);
+
+	Result result = { logger->droppedRows(), 0, true, report.str() };
+
+	std::ifstream file(CPS::Logger::logDir() + "/" + name + ".csv");
+	String line;
+	std::getline(file, line);
+	Real lastTime = -1;
+	while (std::getline(file, line)) {
+		Real time = std::stod(line.substr(0, line.find(',')));
+		if (time <= lastTime)
+			result.ordered = false;
+		lastTime = time;
+		result.written++;
+	}
+	return result;
+}
+
+int main(int argc, char* argv[]) {
+	String simName = "DataLogger_BackPressure";
+	Logger::setLogDir("logs/" + simName);
+
+	Result block = logRows(simName + "_Block", DataLogger::BackPressure::Block);
+	Result drop = logRows(simName + "_Drop", DataLogger::BackPressure::Drop);
+	Result report = logRows(simName + "_Report", DataLogger::BackPressure::Report);
+
+	std::cout << "Block: " << block.written << " rows written, " << block.dropped << " dropped" << std::endl;
+	std::cout << "Drop: " << drop.written << " rows written, " << drop.dropped << " dropped" << std::endl;
+	std::cout << "Report: " << report.written << " rows written, " << report.dropped << " dropped, report: "
+		<< report.report;
+
+	Bool blockOk = block.written == numRows && block.dropped == 0 && block.ordered
+		&& block.report.empty();
+	Bool dropOk = drop.dropped > 0 && drop.written + drop.dropped == numRows && drop.ordered
+		&& drop.report.empty();
+	Bool reportOk = report.dropped > 0 && report.written + report.dropped == numRows && report.ordered
+		&& report.report.find("dropped " + std::to_string(report.dropped) + " rows") != String::npos;
+
+	return (blockOk && dropOk && reportOk) ? 0 : 1;
+}
@@ -0,0 +1,158 @@
+/* Copyright 2017-2020 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+#include <DPsim.h>
+
+using namespace DPsim;
+
+// Logs real, integer and matrix coefficient columns in the CSV and in the
+// binary format, synchronously and with the asynchronous writer. The binary
+// file is read back: its header has to name the same columns as the CSV
+// header, and its records have to hold the exact logged values, which the
+// CSV file has to match up to its printed precision.
+
+const UInt numRows = 1000;
+
+/// Column names and rows of a logged file
+struct Table {
+	std::vector<String> names;
+	std::vector<std::vector<Real>> rows;
+};
+
+Real expectedValue(UInt row, UInt col) {
+	switch (col) {
+		case 0: return row * 1e-3;
+		case 1: return row * 0.25 - 100;
+		case 2: return static_cast<Real>(3 * row);
+		case 3: return row / 8.;
+		default: return -1. * row;
+	}
+}
+
+void logRows(const String& name, DataLogger::Format format, Bool async) {
+	Real real = 0;
+	Int integer = 0;
+	Matrix matrix = Matrix::Zero(2, 1);
+
+	auto logger = DataLogger::make(name, true, 1, format);
+	logger->addAttribute("real", CPS::Attribute<Real>::make(&real));
+	logger->addAttribute("integer", CPS::Attribute<Int>::make(&integer));
+	logger->addAttribute("matrix", std::static_pointer_cast<CPS::MatrixRealAttribute>(
+		CPS::Attribute<Matrix>::make(&matrix)));
+	// The binary records are written in many small blocks
+	logger->setBufferSize(1000);
+	logger->doAsyncWrite(async, 16);
+
+	for (UInt row = 0; row < numRows; row++) {
+		real = expectedValue(row, 1);
+		integer = static_cast<Int>(expectedValue(row, 2));
+		matrix(0, 0) = expectedValue(row, 3);
+		matrix(1, 0) = expectedValue(row, 4);
+		logger->log(expectedValue(row, 0), row);
+	}
+	logger->close();
+}
+
+Table readCsv(const String& name) {
+	Table table;
+	std::ifstream file(CPS::Logger::logDir() + "/" + name + ".csv");
+	String line, cell;
+
+	std::getline(file, line);
+	std::stringstream header(line);
+	while (std::getline(header, cell, ',')) {
+		cell.erase(0, cell.find_first_not_of(' '));
+		table.names.push_back(cell);
+	}
+	while (std::getline(file, line)) {
+		std::stringstream values(line);
+		std::vector<Real> row;
+		while (std::getline(values, cell, ','))
+			row.push_back(std::stod(cell));
+		table.rows.push_back(row);
+	}
+	return table;
+}
+
+/// Reads a binary log, the table is empty if the header is invalid
+Table readBinary(const String& name) {
+	Table table;
+	std::ifstream file(CPS::Logger::logDir() + "/" + name + ".bin", std::ios::binary);
+
+	char magic[8];
+	uint32_t version, numColumns;
+	file.read(magic, sizeof(magic));
+	file.read(reinterpret_cast<char*>(&version), sizeof(version));
+	file.read(reinterpret_cast<char*>(&numColumns), sizeof(numColumns));
+	if (!file || std::memcmp(magic, "DPSIMBIN", sizeof(magic)) != 0 || version != 1)
+		return table;
+
+	for (uint32_t col = 0; col < numColumns; col++) {
+		uint32_t length;
+		file.read(reinterpret_cast<char*>(&length), sizeof(length));
+		String columnName(length, '\0');
+		file.read(&columnName[0], length);
+		table.names.push_back(columnName);
+	}
+
+	std::vector<Real> row(numColumns);
+	while (file.read(reinterpret_cast<char*>(row.data()), numColumns * sizeof(Real)))
+		table.rows.push_back(row);
+	return table;
+}
+
+/// Compares the binary with the CSV log and the logged values
+Bool compareLogs(const String& name) {
+	Table csv = readCsv(name);
+	Table binary = readBinary(name);
+
+	Bool namesOk = !binary.names.empty() && binary.names == csv.names;
+	Bool sizesOk = binary.rows.size() == numRows && csv.rows.size() == numRows;
+	Real binaryDiff = 0, csvDiff = 0;
+	for (UInt row = 0; sizesOk && row < numRows; row++) {
+		if (binary.rows[row].size() != binary.names.size() || csv.rows[row].size() != csv.names.size()) {
+			sizesOk = false;
+			break;
+		}
+		for (UInt col = 0; col < binary.names.size(); col++) {
+			// The logger sorts the columns by name
+			Real expected = expectedValue(row,
+				binary.names[col] == "time" ? 0 :
+				binary.names[col] == "real" ? 1 :
+				binary.names[col] == "integer" ? 2 :
+				binary.names[col] == "matrix_0" ? 3 : 4);
+			binaryDiff = std::max(binaryDiff, std::abs(binary.rows[row][col] - expected));
+			csvDiff = std::max(csvDiff, std::abs(csv.rows[row][col] - binary.rows[row][col]));
+		}
+	}
+
+	std::cout << name << ": " << binary.rows.size() << " binary and " << csv.rows.size()
+		<< " CSV rows, maximum difference to the logged values " << binaryDiff
+		<< ", to the CSV values " << csvDiff << std::endl;
+	return namesOk && sizesOk && binaryDiff == 0 && csvDiff < 1e-6;
+}
+
+int main(int argc, char* argv[]) {
+	String simName = "DataLogger_Binary";
+	Logger::setLogDir("logs/" + simName);
+
+	Bool ok = true;
+	for (Bool async : { false, true }) {
+		String name = simName + (async ? "_async" : "_sync");
+		logRows(name, DataLogger::Format::CSV, async);
+		logRows(name, DataLogger::Format::Binary, async);
+		ok = compareLogs(name) && ok;
+	}
+	return ok ? 0 : 1;
+}
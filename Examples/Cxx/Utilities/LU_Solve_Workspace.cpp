@@ -0,0 +1,97 @@
+/* Copyright 2017-2020 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <cstring>
+#include <iostream>
+
+#include <DPsim.h>
+#include <dpsim/LUSolveWorkspace.h>
+
+using namespace DPsim;
+
+// Solves systems whose LU factorization has supernodes with several columns
+// with LUSolveWorkspace and with SparseLU::solve. The workspace mirrors the
+// forward substitution of Eigen, so the solutions have to be bitwise
+// identical. A difference means that the mirrored code is out of date.
+
+/// Dense diagonal blocks that are coupled in a chain, so that the columns of
+/// each block form a supernode
+CPS::SparseMatrix makeMatrix(Int blocks, Int blockSize) {
+	Int n = blocks * blockSize;
+	std::vector<Eigen::Triplet<Real>> entries;
+	for (Int b = 0; b < blocks; b++) {
+		for (Int i = 0; i < blockSize; i++) {
+			for (Int j = 0; j < blockSize; j++) {
+				Int row = b * blockSize + i, col = b * blockSize + j;
+				Real value = (i == j) ? 4. * blockSize : -1. / (1 + i + 2 * j);
+				entries.emplace_back(row, col, value);
+			}
+		}
+		if (b + 1 < blocks) {
+			entries.emplace_back(b * blockSize, (b + 1) * blockSize, -0.5);
+			entries.emplace_back((b + 1) * blockSize, b * blockSize, -0.3);
+		}
+	}
+	CPS::SparseMatrix mat(n, n);
+	mat.setFromTriplets(entries.begin(), entries.end());
+	mat.makeCompressed();
+	return mat;
+}
+
+/// Number of supernodes of L with more than one column
+Int wideSupernodes(const CPS::LUFactorizedSparse& lu) {
+	const auto& L = lu.matrixL().m_mapL;
+	Int count = 0;
+	for (Int k = 0; k <= L.nsuper(); k++) {
+		if (L.supToCol()[k + 1] - L.supToCol()[k] > 1)
+			count++;
+	}
+	return count;
+}
+
+/// Number of right side vectors for which the solutions differ
+Int compareSolutions(LUSolveWorkspace& workspace, Int blocks, Int blockSize) {
+	CPS::SparseMatrix mat = makeMatrix(blocks, blockSize);
+	CPS::LUFactorizedSparse lu;
+	lu.analyzePattern(mat);
+	lu.factorize(mat);
+	if (lu.info() != Eigen::Success) {
+		std::cout << "Factorization failed" << std::endl;
+		return -1;
+	}
+
+	Int supernodes = wideSupernodes(lu);
+	std::cout << mat.rows() << " rows, " << supernodes << " supernodes with several columns" << std::endl;
+	if (supernodes == 0)
+		return -1;
+
+	Int mismatches = 0;
+	for (Int k = 0; k < 5; k++) {
+		Matrix b(mat.rows(), 1);
+		for (Int i = 0; i < b.rows(); i++)
+			b(i, 0) = std::sin(1. + i * (k + 1)) * 1000.;
+
+		Matrix x;
+		workspace.solve(lu, b, x);
+		Matrix ref = lu.solve(b);
+		if (x.rows() != ref.rows() || std::memcmp(x.data(), ref.data(), sizeof(Real) * ref.size()) != 0)
+			mismatches++;
+	}
+	return mismatches;
+}
+
+int main(int argc, char* argv[]) {
+	LUSolveWorkspace workspace;
+
+	// The second system has another size, so the buffers are reallocated
+	Int mismatches = compareSolutions(workspace, 20, 6);
+	Int resizedMismatches = compareSolutions(workspace, 7, 9);
+
+	std::cout << "Mismatching solutions: " << mismatches << ", after resize: " << resizedMismatches << std::endl;
+	return (mismatches == 0 && resizedMismatches == 0) ? 0 : 1;
+}
@@ -0,0 +1,179 @@
+/* Copyright 2017-2020 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <algorithm>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <set>
+
+#include <DPsim.h>
+#include <dpsim/ThreadLevelScheduler.h>
+
+using namespace DPsim;
+using namespace CPS::DP;
+
+// Simulates an RL circuit with tracing on two threads and reads the Chrome
+// trace back. Each scheduler thread has to be named by a metadata event, and
+// each task has to have exactly one slice in every step on a named thread.
+// With a trace buffer smaller than the number of task executions of a thread,
+// only the executions of the last steps are kept, exactly as many as fit into
+// the buffer.
+
+const Int numSteps = 50;
+const UInt wrappedEventsPerThread = 16;
+
+/// Event of the trace, the step is -1 for metadata events
+struct TraceEvent {
+	String phase;
+	String name;
+	Int tid;
+	Int step;
+};
+
+/// Value of a key in an event, which the trace writes as one object per line
+String jsonValue(const String& line, const String& key) {
+	String pattern = "\"" + key + "\":";
+	size_t pos = line.find(pattern);
+	if (pos == String::npos)
+		return String();
+	pos += pattern.size();
+	if (line[pos] == '"')
+		return line.substr(pos + 1, line.find('"', pos + 1) - pos - 1);
+	return line.substr(pos, line.find_first_of(",}", pos) - pos);
+}
+
+std::vector<TraceEvent> readTrace(const String& filename) {
+	std::vector<TraceEvent> events;
+	std::ifstream file(filename);
+	String line;
+	while (std::getline(file, line)) {
+		String phase = jsonValue(line, "ph");
+		if (phase.empty())
+			continue;
+		String step = jsonValue(line, "step");
+		events.push_back({ phase, jsonValue(line, "name"),
+			std::stoi(jsonValue(line, "tid")), step.empty() ? -1 : std::stoi(step) });
+	}
+	return events;
+}
+
+SystemTopology makeSystem(DataLogger::Ptr logger) {
+	auto n1 = SimNode::make("n1");
+	auto n2 = SimNode::make("n2");
+
+	auto vs = Ph1::VoltageSource::make("vs");
+	vs->setParameters(Complex(10, 0));
+	auto r = Ph1::Resistor::make("r");
+	r->setParameters(1);
+	auto l = Ph1::Inductor::make("l");
+	l->setParameters(0.02);
+	auto load = Ph1::Resistor::make("load");
+	load->setParameters(10);
+
+	vs->connect({ SimNode::GND, n1 });
+	r->connect({ n1, n2 });
+	l->connect({ n2, SimNode::GND });
+	load->connect({ n2, SimNode::GND });
+
+	logger->addAttribute("v2", n2->attribute("v"));
+	logger->addAttribute("il", l->attribute("i_intf"));
+
+	return SystemTopology(50, SystemNodeList{ n1, n2 }, SystemComponentList{ vs, r, l, load });
+}
+
+std::vector<TraceEvent> runTraced(const String& name, std::shared_ptr<Scheduler> scheduler, UInt eventsPerThread) {
+	String traceFile = CPS::Logger::logDir() + "/" + name + ".json";
+	auto logger = DataLogger::make(name);
+	Simulation sim(name, makeSystem(logger), 1e-4, numSteps * 1e-4);
+	sim.addLogger(logger);
+	scheduler->doTracing(traceFile, eventsPerThread);
+	sim.setScheduler(scheduler);
+
+	sim.initialize();
+	for (Int step = 0; step < numSteps; step++)
+		sim.step();
+	sim.scheduler()->stop();
+	logger->close();
+
+	return readTrace(traceFile);
+}
+
+/// Checks that every thread is named and that each task has one slice per step
+Bool checkComplete(const String& name, const std::vector<TraceEvent>& events, Int threads) {
+	std::set<Int> namedThreads;
+	std::set<String> tasks;
+	std::map<Int, std::multiset<String>> steps;
+	Bool ok = true;
+	for (auto& event : events) {
+		if (event.phase == "M") {
+			ok = ok && event.name == "thread_name";
+			namedThreads.insert(event.tid);
+		} else {
+			ok = ok && event.phase == "X";
+			tasks.insert(event.name);
+			steps[event.step].insert(event.name);
+		}
+	}
+	for (auto& event : events)
+		ok = ok && namedThreads.count(event.tid) == 1;
+
+	ok = ok && namedThreads.size() == static_cast<size_t>(threads)
+		&& steps.size() == static_cast<size_t>(numSteps) && !tasks.empty();
+	for (auto& step : steps)
+		ok = ok && step.second == std::multiset<String>(tasks.begin(), tasks.end());
+
+	std::cout << name << ": " << tasks.size() << " tasks in " << steps.size()
+		<< " steps on " << namedThreads.size() << " threads" << std::endl;
+	return ok;
+}
+
+/// Checks that each thread kept only the slices of its last task executions
+Bool checkWrapped(const String& name, const std::vector<TraceEvent>& events) {
+	std::map<Int, std::vector<Int>> threadSteps;
+	for (auto& event : events) {
+		if (event.phase == "X")
+			threadSteps[event.tid].push_back(event.step);
+	}
+
+	// Each thread executes at least one task per step, so that its buffer
+	// is full. The kept slices are in the order of their execution and
+	// end with the last step.
+	Bool ok = !threadSteps.empty();
+	for (auto& thread : threadSteps) {
+		auto& steps = thread.second;
+		ok = ok && steps.size() == wrappedEventsPerThread
+			&& std::is_sorted(steps.begin(), steps.end()) && steps.back() == numSteps - 1
+			&& steps.front() >= numSteps - static_cast<Int>(wrappedEventsPerThread);
+		std::cout << name << ": thread " << thread.first << " kept " << steps.size()
+			<< " slices of the steps " << steps.front() << " to " << steps.back() << std::endl;
+	}
+	return ok;
+}
+
+int main(int argc, char* argv[]) {
+	String simName = "Scheduler_Trace";
+	Logger::setLogDir("logs/" + simName);
+
+	std::vector<std::pair<String, std::function<std::shared_ptr<Scheduler>()>>> schedulers = {
+		{ "thread_level", []() { return std::make_shared<ThreadLevelScheduler>(2); } },
+#ifdef WITH_OPENMP
+		{ "omp_level", []() { return std::make_shared<OpenMPLevelScheduler>(2); } },
+#endif
+	};
+
+	Bool ok = true;
+	for (auto& scheduler : schedulers) {
+		String name = simName + "_" + scheduler.first;
+		ok = checkComplete(name, runTraced(name, scheduler.second(), 1 << 16), 2) && ok;
+		name += "_wrapped";
+		ok = checkWrapped(name, runTraced(name, scheduler.second(), wrappedEventsPerThread)) && ok;
+	}
+	return ok ? 0 : 1;
+}
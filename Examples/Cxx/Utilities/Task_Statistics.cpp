@@ -0,0 +1,165 @@
+/* Copyright 2017-2020 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <random>
+
+#include <DPsim.h>
+
+using namespace DPsim;
+
+// Adds a known set of execution times to the task statistics and checks the
+// mean, standard deviation, minimum and maximum against their exact values
+// and the quantiles against the exact order statistics within the relative
+// error of the histogram. The statistics of some tasks are then written to a
+// measurement file and read back for each statistic a scheduler can use as
+// the task cost, also from a file in the old format with only the mean.
+
+typedef std::chrono::nanoseconds ns;
+
+/// Relative error of the histogram buckets
+const Real histogramError = 1. / (1 << LatencyHistogram::SubBucketBits);
+
+/// Task that is only used as a key of the measurements
+class NamedTask : public CPS::Task {
+public:
+	NamedTask(String name) : Task(name) {}
+	void execute(Real time, Int timeStepCount) {}
+};
+
+/// Scheduler that exposes the measurement functions
+class MeasurementScheduler : public Scheduler {
+public:
+	void createSchedule(const CPS::Task::List& tasks, const Edges& inEdges, const Edges& outEdges) {}
+	void step(Real time, Int timeStepCount) {}
+
+	using Scheduler::initMeasurements;
+	using Scheduler::updateMeasurement;
+	using Scheduler::writeMeasurements;
+	using Scheduler::readMeasurements;
+};
+
+Bool checkHistogramBuckets() {
+	// Every value lies in the bucket it is counted in, and the upper bound
+	// of the bucket is at most the relative error above it
+	Bool ok = true;
+	for (std::uint64_t value = 0; value < (1ULL << 20); value = value * 9 / 8 + 1) {
+		UInt idx = LatencyHistogram::bucketIndex(value);
+		std::uint64_t bound = LatencyHistogram::bucketUpperBound(idx);
+		ok = ok && bound >= value && bound <= value * (1 + histogramError)
+			&& LatencyHistogram::bucketIndex(bound) == idx
+			&& (idx == 0 || LatencyHistogram::bucketUpperBound(idx - 1) < value);
+	}
+	std::cout << "Histogram buckets: " << (ok ? "ok" : "failed") << std::endl;
+	return ok;
+}
+
+Bool checkStatistics() {
+	// Execution times of 1 to n ns in random order
+	const UInt n = 10000;
+	std::vector<std::int64_t> values(n);
+	for (UInt i = 0; i < n; i++)
+		values[i] = i + 1;
+	std::shuffle(values.begin(), values.end(), std::mt19937(42));
+
+	TaskStatistics stats;
+	for (auto value : values)
+		stats.add(ns(value));
+
+	Real mean = (n + 1) / 2.;
+	Real stddev = std::sqrt(n * (n + 1.) / 12);
+	Bool ok = stats.count() == n
+		&& std::abs(std::chrono::duration_cast<ns>(stats.mean()).count() - mean) <= 0.5
+		&& std::abs(stats.stddev() - stddev) < 1e-6 * stddev
+		&& std::chrono::duration_cast<ns>(stats.min()).count() == 1
+		&& std::chrono::duration_cast<ns>(stats.max()).count() == n
+		&& std::chrono::duration_cast<ns>(stats.last()).count() == values.back();
+	std::cout << "Mean " << stats.mean().count() << ", stddev " << stats.stddev()
+		<< " (exact " << mean << ", " << stddev << ")" << std::endl;
+
+	for (Real q : { 0.0, 0.1, 0.5, 0.9, 0.99, 0.999, 1.0 }) {
+		// The value with the rank ceil(q n) of the sorted values
+		Real exact = std::max(std::ceil(q * n), 1.);
+		Real quantile = std::chrono::duration_cast<ns>(stats.quantile(q)).count();
+		std::cout << "Quantile " << q << ": " << quantile << " (exact " << exact << ")" << std::endl;
+		ok = ok && quantile >= exact && quantile <= exact * (1 + histogramError);
+	}
+
+	// Small values are counted exactly
+	TaskStatistics small;
+	for (std::int64_t value : { 3, 1, 4, 1, 5, 9, 2, 6 })
+		small.add(ns(value));
+	ok = ok && small.quantile(0.5) == ns(3) && small.quantile(0.75) == ns(5)
+		&& small.quantile(1) == ns(9) && small.min() == ns(1) && small.max() == ns(9);
+
+	return ok;
+}
+
+Bool checkMeasurementFiles() {
+	MeasurementScheduler scheduler;
+	CPS::Task::List tasks = {
+		std::make_shared<NamedTask>("fast"),
+		std::make_shared<NamedTask>("slow"),
+		std::make_shared<NamedTask>("spiky")
+	};
+	scheduler.initMeasurements(tasks);
+
+	// Different distributions, so that the statistics differ from each other
+	for (Int step = 0; step < 2000; step++) {
+		scheduler.updateMeasurement(tasks[0].get(), ns(100 + step % 7), step);
+		scheduler.updateMeasurement(tasks[1].get(), ns(50000 + 13 * step), step);
+		scheduler.updateMeasurement(tasks[2].get(), ns(step % 100 == 0 ? 1000000 : 2000 + step % 50), step);
+	}
+
+	String filename = CPS::Logger::logDir() + "/measurements.csv";
+	scheduler.writeMeasurements(filename);
+
+	// A file of an older version with only the mean of each task
+	String oldFilename = CPS::Logger::logDir() + "/measurements_mean.csv";
+	std::ofstream oldFile(oldFilename);
+	oldFile << "fast,104" << std::endl << "slow,63000" << std::endl;
+	oldFile.close();
+
+	typedef Scheduler::MeasurementStatistic Statistic;
+	Bool ok = true;
+	for (auto statistic : { Statistic::Mean, Statistic::P50, Statistic::P99, Statistic::P999, Statistic::Max }) {
+		scheduler.setMeasurementStatistic(statistic);
+
+		std::unordered_map<String, Scheduler::TaskTime::rep> measurements;
+		scheduler.readMeasurements(filename, measurements);
+		for (auto task : tasks) {
+			const TaskStatistics& stats = scheduler.getMeasurementStatistics(task);
+			Scheduler::TaskTime expected =
+				statistic == Statistic::P50 ? stats.quantile(0.5) :
+				statistic == Statistic::P99 ? stats.quantile(0.99) :
+				statistic == Statistic::P999 ? stats.quantile(0.999) :
+				statistic == Statistic::Max ? stats.max() : stats.mean();
+			ok = ok && measurements.size() == tasks.size()
+				&& measurements.at(task->toString()) == expected.count();
+		}
+
+		std::unordered_map<String, Scheduler::TaskTime::rep> oldMeasurements;
+		scheduler.readMeasurements(oldFilename, oldMeasurements);
+		ok = ok && oldMeasurements.size() == 2
+			&& oldMeasurements.at("fast") == 104 && oldMeasurements.at("slow") == 63000;
+	}
+	std::cout << "Measurement files: " << (ok ? "ok" : "failed") << std::endl;
+	return ok;
+}
+
+int main(int argc, char* argv[]) {
+	Logger::setLogDir("logs/Task_Statistics");
+	fs::create_directories(Logger::logDir());
+
+	Bool ok = checkHistogramBuckets();
+	ok = checkStatistics() && ok;
+	ok = checkMeasurementFiles() && ok;
+	return ok ? 0 : 1;
+}
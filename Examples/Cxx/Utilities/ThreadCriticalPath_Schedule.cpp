@@ -0,0 +1,121 @@
+/* Copyright 2017-2020 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <thread>
+
+#include <DPsim.h>
+#include <dpsim/ThreadCriticalPathScheduler.h>
+
+using namespace DPsim;
+
+// Schedules small task graphs with known costs on two threads with the
+// critical path scheduler and executes one step, in which each task records
+// the thread it runs on. The tasks are named component.task like those of
+// the components.
+//
+// Fork: a.pre (10) -> b.x (2), c.x (1) -> d.post (10)
+//   Without synchronization cost, b.x and c.x run on different threads and
+//   the makespan is 22. A synchronization cost of 100 serialises the cheap
+//   fork on one thread with a makespan of 23.
+//
+// Component: x.pre (5), y.x (2), x.post (1) without dependencies
+//   Without synchronization cost, x.post starts on the thread of y.x and
+//   the makespan is 5. With a cost of 4, moving x.post away from the thread
+//   of x.pre costs more than waiting for it, so both run on the same thread
+//   with a makespan of 6.
+
+/// Task that depends on the results of other tasks and records the thread
+/// it is executed on
+class GraphTask : public CPS::Task {
+public:
+	typedef std::shared_ptr<GraphTask> Ptr;
+
+	GraphTask(String name, std::vector<Ptr> before = {}) :
+		Task(name), mResult(CPS::Attribute<Real>::make(&mValue)) {
+		for (auto task : before)
+			mAttributeDependencies.push_back(task->mResult);
+		mModifiedAttributes.push_back(mResult);
+		// Every task is needed, so that none is dropped from the schedule
+		mModifiedAttributes.push_back(Scheduler::external);
+	}
+
+	void execute(Real time, Int timeStepCount) {
+		mThread = std::this_thread::get_id();
+	}
+
+	std::thread::id thread() const { return mThread; }
+
+private:
+	Real mValue = 0;
+	CPS::Attribute<Real>::Ptr mResult;
+	std::thread::id mThread;
+};
+
+/// Schedules the tasks with the given costs and synchronization cost,
+/// executes one step and returns the predicted makespan
+Real runSchedule(const std::vector<GraphTask::Ptr>& graph, const std::map<String, Int>& costs, Real syncCost) {
+	String costFile = CPS::Logger::logDir() + "/costs.csv";
+	std::ofstream os(costFile);
+	for (auto& cost : costs)
+		os << cost.first << "," << cost.second << std::endl;
+	os.close();
+
+	ThreadCriticalPathScheduler scheduler(2, String(), costFile, false, syncCost);
+	CPS::Task::List tasks(graph.begin(), graph.end());
+	Scheduler::Edges inEdges, outEdges;
+	scheduler.resolveDeps(tasks, inEdges, outEdges);
+	scheduler.createSchedule(tasks, inEdges, outEdges);
+	scheduler.step(0, 0);
+	scheduler.stop();
+	return scheduler.predictedMakespan();
+}
+
+Bool checkFork(Real syncCost, Bool serialised, Real makespan) {
+	auto pre = std::make_shared<GraphTask>("a.pre");
+	auto left = std::make_shared<GraphTask>("b.x", std::vector<GraphTask::Ptr>{ pre });
+	auto right = std::make_shared<GraphTask>("c.x", std::vector<GraphTask::Ptr>{ pre });
+	auto post = std::make_shared<GraphTask>("d.post", std::vector<GraphTask::Ptr>{ left, right });
+
+	Real predicted = runSchedule({ pre, left, right, post },
+		{ { "a.pre", 10 }, { "b.x", 2 }, { "c.x", 1 }, { "d.post", 10 } }, syncCost);
+
+	Bool sameThread = left->thread() == right->thread();
+	std::cout << "Fork with synchronization cost " << syncCost << ": predicted makespan "
+		<< predicted << ", fork " << (sameThread ? "serialised" : "parallel") << std::endl;
+	return predicted == makespan && sameThread == serialised
+		&& pre->thread() == left->thread() && post->thread() == pre->thread();
+}
+
+Bool checkComponent(Real syncCost, Bool sameThread, Real makespan) {
+	auto pre = std::make_shared<GraphTask>("x.pre");
+	auto other = std::make_shared<GraphTask>("y.x");
+	auto post = std::make_shared<GraphTask>("x.post");
+
+	Real predicted = runSchedule({ pre, other, post },
+		{ { "x.pre", 5 }, { "y.x", 2 }, { "x.post", 1 } }, syncCost);
+
+	Bool componentThread = pre->thread() == post->thread();
+	std::cout << "Component with synchronization cost " << syncCost << ": predicted makespan "
+		<< predicted << ", tasks on " << (componentThread ? "one thread" : "two threads") << std::endl;
+	return predicted == makespan && componentThread == sameThread
+		&& pre->thread() != other->thread();
+}
+
+int main(int argc, char* argv[]) {
+	Logger::setLogDir("logs/ThreadCriticalPath_Schedule");
+	fs::create_directories(Logger::logDir());
+
+	Bool ok = checkFork(0, false, 22);
+	ok = checkFork(100, true, 23) && ok;
+	ok = checkComponent(0, false, 5) && ok;
+	ok = checkComponent(4, true, 6) && ok;
+	return ok ? 0 : 1;
+}
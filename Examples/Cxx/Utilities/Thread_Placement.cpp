@@ -0,0 +1,108 @@
+/* Copyright 2017-2020 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <algorithm>
+#include <iostream>
+#include <set>
+#include <stdexcept>
+
+#include <DPsim.h>
+#include <dpsim/ThreadPlacement.h>
+
+using namespace DPsim;
+
+// Parses valid and invalid core lists and computes the core sets of each
+// placement policy for more threads than the process may run on, so that
+// the policies have to wrap around. The sets are checked against the NUMA
+// nodes of the host, which form a single node without NUMA information.
+
+typedef ThreadPlacement::Policy Policy;
+
+Bool checkParse(const String& list, const std::vector<Int>& expected) {
+	Bool ok = ThreadPlacement::parseCpuList(list) == expected;
+	std::cout << "\"" << list << "\": " << (ok ? "ok" : "failed") << std::endl;
+	return ok;
+}
+
+Bool checkParseError(const String& list) {
+	Bool thrown = false;
+	try {
+		ThreadPlacement::parseCpuList(list);
+	} catch (std::invalid_argument&) {
+		thrown = true;
+	}
+	std::cout << "\"" << list << "\": " << (thrown ? "rejected" : "accepted") << std::endl;
+	return thrown;
+}
+
+/// Index of the NUMA node of a core, or -1
+Int nodeOf(const std::vector<std::vector<Int>>& nodes, Int cpu) {
+	for (UInt node = 0; node < nodes.size(); node++) {
+		if (std::find(nodes[node].begin(), nodes[node].end(), cpu) != nodes[node].end())
+			return node;
+	}
+	return -1;
+}
+
+int main(int argc, char* argv[]) {
+	Bool ok = checkParse("0-3,8,10-11", { 0, 1, 2, 3, 8, 10, 11 });
+	ok = checkParse(" 1 , 4-5 ", { 1, 4, 5 }) && ok;
+	ok = checkParse("", {}) && ok;
+	for (String list : { "3-1", "a", "1-", "-1", "1-2x", "0,b-3" })
+		ok = checkParseError(list) && ok;
+
+	auto allowed = ThreadPlacement::allowedCpus();
+	auto nodes = ThreadPlacement::numaNodes();
+	std::set<Int> nodeCpus;
+	for (auto& node : nodes)
+		nodeCpus.insert(node.begin(), node.end());
+	ok = ok && !nodes.empty() && nodeCpus == std::set<Int>(allowed.begin(), allowed.end());
+	std::cout << allowed.size() << " allowed cores on " << nodes.size() << " NUMA nodes" << std::endl;
+
+	const Int threads = 2 * allowed.size() + 1;
+	const Int numNodes = nodes.size();
+
+	// Not pinned
+	for (auto& set : ThreadPlacement().cpuSets(threads))
+		ok = ok && set.empty();
+
+	// Explicit cores are used in the given order, also those that are not
+	// allowed, which fails when the placement is applied
+	auto explicitSets = ThreadPlacement::explicitCores({ 5, 2 }).cpuSets(threads);
+	for (Int i = 0; i < threads; i++)
+		ok = ok && explicitSets[i] == std::vector<Int>{ i % 2 == 0 ? 5 : 2 };
+
+	// Consecutive cores of one node after the other, then from the start
+	std::vector<Int> compactOrder;
+	for (auto& node : nodes)
+		compactOrder.insert(compactOrder.end(), node.begin(), node.end());
+	auto compactSets = ThreadPlacement(Policy::Compact).cpuSets(threads);
+	for (Int i = 0; i < threads; i++)
+		ok = ok && compactSets[i] == std::vector<Int>{ compactOrder[i % compactOrder.size()] };
+
+	// Alternating nodes, different cores until the smallest node is used up
+	auto scatterSets = ThreadPlacement(Policy::Scatter).cpuSets(threads);
+	UInt smallestNode = allowed.size();
+	for (auto& node : nodes)
+		smallestNode = std::min<UInt>(smallestNode, node.size());
+	std::set<Int> scatterCpus;
+	for (Int i = 0; i < threads; i++) {
+		ok = ok && scatterSets[i].size() == 1 && nodeOf(nodes, scatterSets[i][0]) == i % numNodes;
+		if (i < numNodes * static_cast<Int>(smallestNode))
+			ok = ok && scatterCpus.insert(scatterSets[i][0]).second;
+	}
+	ok = ok && scatterSets[0] == scatterSets[numNodes * nodes[0].size()];
+
+	// All cores of one node per thread
+	auto numaSets = ThreadPlacement(Policy::NumaNode).cpuSets(threads);
+	for (Int i = 0; i < threads; i++)
+		ok = ok && numaSets[i] == nodes[i % numNodes];
+
+	std::cout << "Core sets of " << threads << " threads: " << (ok ? "ok" : "failed") << std::endl;
+	return ok ? 0 : 1;
+}
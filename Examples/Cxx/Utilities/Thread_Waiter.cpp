@@ -0,0 +1,101 @@
+/* Copyright 2017-2020 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <thread>
+
+#include <DPsim.h>
+
+using namespace DPsim;
+
+// Waits on counters and barriers with waiters of different spin budgets,
+// while another thread increments the counter or arrives at the barrier
+// after a delay. A waiter with a budget of 0 has to block in every wait
+// that is not satisfied right away, a waiter with a negative budget must
+// never block, and every wait has to return once the other thread woke it.
+// A lost wake-up hangs the example.
+
+const Int numRounds = 20;
+const std::chrono::milliseconds delay(2);
+
+void printStatistics(const String& name, const WaitStatistics& stats) {
+	std::cout << name << ": " << stats.immediate << " immediate, " << stats.spinHits
+		<< " spin hits, " << stats.blocks << " blocks" << std::endl;
+}
+
+/// Waits for each increment of a counter by another thread
+WaitStatistics waitForCounter(Int spinBudget) {
+	Counter counter;
+	Waiter waiter(spinBudget);
+
+	std::thread incrementer([&counter]() {
+		for (Int round = 0; round < numRounds; round++) {
+			std::this_thread::sleep_for(delay);
+			counter.inc();
+		}
+	});
+	for (Int round = 1; round <= numRounds; round++)
+		counter.wait(round, waiter);
+	incrementer.join();
+
+	// The counter is already at the value
+	counter.wait(numRounds, waiter);
+	return waiter.statistics();
+}
+
+/// Passes a barrier with another thread that arrives late, returns the
+/// statistics of the waiter of the early thread
+WaitStatistics waitAtBarrier(Int spinBudget, Bool& synchronized) {
+	Barrier barrier(2);
+	std::atomic<Int> arrivals(0);
+	Waiter waiter(spinBudget);
+
+	std::thread late([&barrier, &arrivals]() {
+		Waiter waiter(0);
+		for (Int round = 0; round < numRounds; round++) {
+			std::this_thread::sleep_for(delay);
+			arrivals++;
+			barrier.wait(waiter);
+		}
+	});
+	synchronized = true;
+	for (Int round = 1; round <= numRounds; round++) {
+		barrier.wait(waiter);
+		// The late thread arrived before the barrier was released
+		synchronized = synchronized && arrivals.load() >= round;
+	}
+	late.join();
+	return waiter.statistics();
+}
+
+int main(int argc, char* argv[]) {
+	WaitStatistics blocking = waitForCounter(0);
+	printStatistics("Counter, budget 0", blocking);
+	// A late wake-up of the waiting thread may find the next increment
+	// already done, so only the sum of the waits is known exactly
+	Bool ok = blocking.blocks > 0 && blocking.spinHits == 0
+		&& blocking.immediate + blocking.blocks == numRounds + 1;
+
+	WaitStatistics spinning = waitForCounter(-1);
+	printStatistics("Counter, unlimited spinning", spinning);
+	ok = ok && spinning.blocks == 0 && spinning.spinHits > 0
+		&& spinning.immediate + spinning.spinHits == numRounds + 1;
+
+	Bool synchronized;
+	WaitStatistics barrierBlocking = waitAtBarrier(0, synchronized);
+	printStatistics("Barrier, budget 0", barrierBlocking);
+	ok = ok && synchronized && barrierBlocking.blocks > 0 && barrierBlocking.spinHits == 0;
+
+	WaitStatistics barrierSpinning = waitAtBarrier(-1, synchronized);
+	printStatistics("Barrier, unlimited spinning", barrierSpinning);
+	ok = ok && synchronized && barrierSpinning.blocks == 0;
+
+	return ok ? 0 : 1;
+}
@@ -96,6 +96,14 @@ def map_scheduler(sched_string, size=0):
             sched_args['use_condition_variable'] = True
         elif s == 'tasktype':
             sched_args['sort_task_types'] = True
+        elif s == 'pin':
+            sched_args['pin_threads'] = True
+        elif s in ('compact', 'scatter', 'numa'):
+            sched_args['placement'] = s
+        elif s == 'mlock':
+            sched_args['lock_memory'] = True
+        elif s in ('p50', 'p99', 'p99.9', 'max'):
+            sched_args['in_measurement_statistic'] = s
     return (scheduler, sched_args)
 
 def do_meas(instance, size=0):
@@ -30,6 +30,9 @@ if __name__ == '__main__':
         'thread_level meas',
         'thread_list',
         'thread_list meas',
+        'thread_critical_path meas',
+        'work_stealing',
+        'work_stealing pin',
     ]
     size = 1
     #size = 20
@@ -64,6 +64,11 @@ class YamlItem(pytest.Item):
         else:
             raise AttributeError('Test is missing mandatory "cmd" attribute')
 
+        # Examples of optional features are skipped if they are not built
+        if 'skip_missing' in spec and spec['skip_missing'] and \
+           not os.path.exists(os.path.join(self.cwd, self.cmd)):
+            self.add_marker(pytest.mark.skip(reason='%s is not built' % self.cmd))
+
     def runtest(self):
         cp = subprocess.run([self.cmd] + self.args,
             cwd = self.cwd,
@@ -0,0 +1,31 @@
+/* Copyright 2017-2020 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+
+#include <dpsim/Definitions.h>
+
+namespace DPsim {
+	/// Counts the heap allocations of each thread.
+	///
+	/// With WITH_ALLOCATION_TRACKING on glibc, the library replaces malloc,
+	/// calloc, realloc and the aligned allocation functions with versions
+	/// that count the call in a thread-local counter before calling the glibc
+	/// implementation. operator new and Eigen allocate through malloc, so
+	/// they are counted as well. Without tracking, the count is always 0.
+	class AllocationTracker {
+	public:
+		/// True if the replaced allocation functions are in use, which is
+		/// checked with a test allocation
+		static Bool available();
+		/// Number of allocations of the calling thread so far
+		static std::uint64_t threadAllocations();
+	};
+}
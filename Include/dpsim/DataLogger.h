@@ -8,7 +8,10 @@
 
 #pragma once
 
+#include <algorithm>
+#include <atomic>
 #include <map>
+#include <thread>
 #include <iostream>
 #include <fstream>
 #include <experimental/filesystem>
@@ -16,6 +19,7 @@ namespace fs = std::experimental::filesystem;
 
 #include <dpsim/Definitions.h>
 #include <dpsim/Scheduler.h>
+#include <dpsim/Waiter.h>
 #include <cps/PtrFactory.h>
 #include <cps/Attribute.h>
 #include <cps/SimNode.h>
@@ -25,28 +29,143 @@ namespace DPsim {
 
 	class DataLogger : public SharedFactory<DataLogger> {
 
+	public:
+		/// File formats of the logged data
+		///
+		/// CSV writes one formatted line per time step.
+		/// Binary writes a header with the column names followed by one record
+		/// of raw doubles per time step:
+		///   char[8]  magic "DPSIMBIN"
+		///   uint32   format version
+		///   uint32   number of columns, including the time column
+		///   per column: uint32 name length, name characters
+		///   per time step: float64 value of each column
+		/// All numbers are stored in the byte order of the host.
+		enum class Format { CSV, Binary };
+
+		/// Behaviour of the asynchronous writer if its ring buffer is full
+		///
+		/// Block waits until the writer thread has written a row.
+		/// Drop discards the row and counts it.
+		/// Report discards and counts the row and reports the number of
+		/// discarded rows when the logger is closed.
+		enum class BackPressure { Block, Drop, Report };
+
 	protected:
 		std::ofstream mLogFile;
 		String mName;
 		Bool mEnabled;
 		UInt mDownsampling;
+		Format mFormat = Format::CSV;
 		fs::path mFilename;
 
 		std::map<String, CPS::AttributeBase::Ptr> mAttributes;
 
+		/// Attribute of a logged column
+		struct Column {
+			/// Matrix coefficient that is read directly from the matrix storage
+			CPS::MatrixViewAttribute::Ptr view;
+			CPS::Attribute<Real>::Ptr real;
+			CPS::Attribute<Int>::Ptr integer;
+		};
+		/// Columns in the order of the header, without the time column
+		std::vector<Column> mColumns;
+		/// True if the columns are resolved and the header is written
+		Bool mStarted = false;
+		/// Number of values per row, including the time
+		UInt mRowSize = 0;
+		/// Row of the synchronous writer
+		std::vector<Real> mRow;
+		/// Records of the binary format that are written to the file at once
+		std::vector<Real> mBuffer;
+		/// Number of values in the buffer
+		UInt mBufferFill = 0;
+		/// Size of the buffer in bytes
+		UInt mBufferSize = 1 << 20;
+
+		// #### Asynchronous writer ####
+		/// Copy rows into a ring buffer that is written by a separate thread
+		Bool mAsync = false;
+		///
+		BackPressure mBackPressure = BackPressure::Block;
+		/// Number of rows in the ring buffer
+		UInt mRingCapacity = 4096;
+		/// Preallocated rows of the ring buffer
+		std::vector<Real> mRing;
+		/// Number of rows pushed by the logging task
+		std::atomic<std::size_t> mRingHead { 0 };
+		/// Number of rows written by the writer thread
+		std::atomic<std::size_t> mRingTail { 0 };
+		/// Set to stop the writer thread after the ring buffer is drained
+		std::atomic<Bool> mStopWriter { false };
+		/// Number of rows discarded because the ring buffer was full
+		std::atomic<std::size_t> mDroppedRows { 0 };
+		/// Number of buffered rows at which the logging task wakes the
+		/// writer, so that the writer is not woken for each row
+		std::size_t mWakeFill = 1;
+		/// Changed by the logging task when the writer has rows to write or
+		/// has to stop, and the number of writers blocked on it
+		std::atomic<Int> mPushEvents { 0 };
+		std::atomic<Int> mPushWaiters { 0 };
+		/// Changed by the writer when it has freed rows, and the number of
+		/// logging tasks blocked on it
+		std::atomic<Int> mWriteEvents { 0 };
+		std::atomic<Int> mWriteWaiters { 0 };
+		/// The writer blocks right away, it is not latency critical
+		Waiter mWriterWaiter { 0 };
+		/// The logging task spins briefly if the ring buffer is full
+		Waiter mLoggerWaiter { 10000 };
+		///
+		std::thread mWriter;
+
 		void logDataLine(Real time, Real data);
 		void logDataLine(Real time, const Matrix& data);
 		void logDataLine(Real time, const MatrixComp& data);
 
+		/// Writes the header with the column names
+		void writeHeader();
+		/// Reads the time and the current attribute values into a row
+		void readRow(Real time, Real *row);
+		/// Writes a row to the file or the buffer of the binary format
+		void writeRow(const Real *row);
+		/// Copies the current attribute values into the ring buffer
+		void pushRow(Real time);
+		/// Drains the ring buffer until the writer is stopped
+		void runWriter();
+		/// Stops the writer thread after the ring buffer is drained
+		void stopWriter();
+		/// Writes the buffered records to the file
+		void flush();
+
 	public:
 		typedef std::shared_ptr<DataLogger> Ptr;
 		typedef std::vector<DataLogger::Ptr> List;
 
 		DataLogger(Bool enabled = true);
-		DataLogger(String name, Bool enabled = true, UInt downsampling = 1);
+		DataLogger(String name, Bool enabled = true, UInt downsampling = 1,
+			Format format = Format::CSV);
+		/// Writes the buffered records before the file is closed
+		~DataLogger() { close(); }
 
 		void open();
 		void close();
+		/// Resolves the columns, writes the header and starts the writer thread,
+		/// so that the logging task only copies values. Called by
+		/// Simulation::initialize, otherwise by the first log call. Does
+		/// nothing if the logger is already started.
+		void start();
+		/// Set the size of the write buffer of the binary format in bytes
+		void setBufferSize(UInt bytes) { mBufferSize = bytes; }
+		/// Write the rows from a separate thread. The logging task only copies
+		/// the attribute values into a ring buffer with the given number of rows.
+		void doAsyncWrite(Bool value, UInt capacity = 4096,
+			BackPressure backPressure = BackPressure::Block) {
+			mAsync = value;
+			mRingCapacity = std::max<UInt>(capacity, 1);
+			mBackPressure = backPressure;
+		}
+		/// Number of rows discarded by the asynchronous writer
+		std::size_t droppedRows() const { return mDroppedRows; }
 		void reopen() {
 			close();
 			open();
@@ -84,6 +203,8 @@ namespace DPsim {
 					mAttributeDependencies.push_back(attr.second);
 				}
 				mModifiedAttributes.push_back(Scheduler::external);
+				setPeriod(logger.mDownsampling);
+				mOutputOnly = true;
 			}
 
 			void execute(Real time, Int timeStepCount);
@@ -8,6 +8,8 @@
 
 #pragma once
 
+#include <stdexcept>
+
 #include <cps/Definitions.h>
 
 namespace DPsim {
@@ -28,4 +30,12 @@ namespace DPsim {
 
 	class SolverException { };
 	class UnsupportedSolverException { };
+
+	/// Thrown by Simulation::step if a task allocated heap memory during the
+	/// step while the allocation check is enabled
+	class AllocationException : public std::runtime_error {
+	public:
+		AllocationException(const String& tasks) :
+			std::runtime_error("Heap allocations during the simulation step in " + tasks) { }
+	};
 }
@@ -39,6 +39,8 @@ namespace DPsim {
 			CPS::LUFactorized luFactorization;
 			/// List of all right side vector contributions
 			std::vector<const Matrix*> rightVectorStamps;
+			/// Right side vector attributes the subnet solve depends on
+			CPS::AttributeBase::List rightVectorAttributes;
 			/// Left-side vector of the subnet AFTER complete step
 			CPS::Attribute<Matrix>::Ptr leftVector;
 		};
@@ -93,6 +95,7 @@ namespace DPsim {
 		void createTearMatrices(UInt totalSize);
 
 		void initComponents();
+		void collectRightVectorStamp(Subnet& net, const CPS::MNAInterface::Ptr& comp);
 
 		void initMatrices();
 		void applyTearComponentStamp(UInt compIdx);
@@ -100,7 +103,8 @@ namespace DPsim {
 		void log(Real time);
 
 	public:
-		DiakopticsSolver(String name, CPS::SystemTopology system, CPS::IdentifiedObject::List tearComponents, Real timeStep, CPS::Logger::Level logLevel);
+		DiakopticsSolver(String name, CPS::SystemTopology system, CPS::IdentifiedObject::List tearComponents, Real timeStep, CPS::Logger::Level logLevel,
+			NodeOrdering::Method nodeOrdering = NodeOrdering::Method::Natural);
 
 		CPS::Task::List getTasks();
 
@@ -108,11 +112,7 @@ namespace DPsim {
 		public:
 			SubnetSolveTask(DiakopticsSolver<VarType>& solver, UInt net) :
 				Task(solver.mName + ".SubnetSolve_" + std::to_string(net)), mSolver(solver), mSubnet(solver.mSubnets[net]) {
-				for (auto it : mSubnet.components) {
-					if (it->template attribute<Matrix>("right_vector")->get().size() != 0) {
-						mAttributeDependencies.push_back(it->attribute("right_vector"));
-					}
-				}
+				mAttributeDependencies = mSubnet.rightVectorAttributes;
 				mModifiedAttributes.push_back(solver.attribute("old_left_vector"));
 			}
 
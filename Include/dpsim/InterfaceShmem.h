@@ -75,6 +75,7 @@ namespace DPsim {
 				for (auto attr : intf.mImportAttrs) {
 					mModifiedAttributes.push_back(attr);
 				}
+				setPeriod(intf.mDownsampling);
 			}
 
 			void execute(Real time, Int timeStepCount);
@@ -91,6 +92,8 @@ namespace DPsim {
 					mAttributeDependencies.push_back(attr);
 				}
 				mModifiedAttributes.push_back(Scheduler::external);
+				setPeriod(intf.mDownsampling);
+				mOutputOnly = true;
 			}
 
 			void execute(Real time, Int timeStepCount);
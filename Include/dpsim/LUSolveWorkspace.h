@@ -0,0 +1,38 @@
+/* Copyright 2017-2020 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#pragma once
+
+#include <dpsim/Definitions.h>
+
+namespace DPsim {
+	/// \brief Buffers to solve with an LU factorization without heap allocations
+	///
+	/// Eigen's SparseLU::solve allocates a work vector for the forward
+	/// substitution and a mask for the in-place permutations on every call.
+	/// The workspace keeps both in buffers that are only reallocated if the
+	/// size of the system changes and does the same operations otherwise,
+	/// so the solution is identical. This relies on the internals of
+	/// SparseLU, other Eigen versions than 3.4 fall back to SparseLU::solve.
+	class LUSolveWorkspace {
+	public:
+		/// x = A^-1 * b for a single right side vector b, where lu is the
+		/// factorization of A. b and x must not alias.
+		void solve(const CPS::LUFactorizedSparse& lu, const Matrix& b, Matrix& x);
+		/// Dense factorizations solve without allocations by themselves
+		void solve(const CPS::LUFactorized& lu, const Matrix& b, Matrix& x) {
+			x = lu.solve(b);
+		}
+
+	private:
+		/// Permuted right side vector, overwritten by the permuted solution
+		Matrix mPermuted;
+		/// Products of the off-diagonal blocks of the supernodes of L
+		Matrix mWork;
+	};
+}
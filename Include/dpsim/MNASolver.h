@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include <array>
 #include <iostream>
 #include <vector>
 #include <list>
@@ -17,6 +18,7 @@
 #include <dpsim/Config.h>
 #include <dpsim/Solver.h>
 #include <dpsim/DataLogger.h>
+#include <dpsim/LUSolveWorkspace.h>
 #include <cps/AttributeList.h>
 #include <cps/Solver/MNASwitchInterface.h>
 #include <cps/Solver/MNAVariableCompInterface.h>
@@ -82,11 +84,22 @@ namespace DPsim {
 		CPS::SimSignalComp::List mSimSignalComps;
 		/// System matrix A that is modified by matrix stamps
 		std::bitset<SWITCH_NUM> mCurrentSwitchStatus;
+		/// Switch status of each frequency in frequency-parallel mode. Each
+		/// solve task only updates its own entry.
+		std::vector< std::bitset<SWITCH_NUM> > mCurrentSwitchStatusHarm;
 		/// Source vector of known quantities
 		Matrix mRightSideVector;
 		std::vector<Matrix> mRightSideVectorHarm;
 		/// List of all right side vector contributions
 		std::vector<const Matrix*> mRightVectorStamps;
+		/// List of all sparse right side vector contributions
+		std::vector<const CPS::SparseVector*> mRightVectorStampsSparse;
+		/// Request sparse right side vector stamps from components that support them
+		Bool mSparseRightVector = true;
+		/// Right side vector attributes the solve tasks depend on
+		CPS::AttributeBase::List mRightVectorAttributes;
+		/// Right side vector attributes the solve task of each frequency depends on
+		std::vector<CPS::AttributeBase::List> mRightVectorAttributesHarm;
 		/// Solution vector of unknown quantities
 		Matrix mLeftSideVector;
 		std::vector<Matrix> mLeftSideVectorHarm;
@@ -96,14 +109,44 @@ namespace DPsim {
 		MAT_TYPE mBaseSystemMatrix;
 		/// Map of system matrices where the key is the bitset describing the switch states
 		std::unordered_map< std::bitset<SWITCH_NUM>, MAT_TYPE > mSwitchedMatrices;
-		std::unordered_map< std::bitset<SWITCH_NUM>, std::vector<Matrix> > mSwitchedMatricesHarm;
+		/// Map of the system matrices of all frequencies in frequency-parallel mode
+		std::unordered_map< std::bitset<SWITCH_NUM>, std::vector<MAT_TYPE> > mSwitchedMatricesHarm;
 #ifdef WITH_SPARSE
 		/// Map of LU factorizations related to the system matrices
 		std::unordered_map< std::bitset<SWITCH_NUM>, CPS::LUFactorizedSparse > mLuFactorizations;
+		std::unordered_map< std::bitset<SWITCH_NUM>, std::vector<CPS::LUFactorizedSparse> > mLuFactorizationsHarm;
 #else
 		std::unordered_map< std::bitset<SWITCH_NUM>, CPS::LUFactorized > mLuFactorizations;
-#endif
 		std::unordered_map< std::bitset<SWITCH_NUM>, std::vector<CPS::LUFactorized> > mLuFactorizationsHarm;
+#endif
+		/// Buffers to solve with the factorizations without allocations
+		LUSolveWorkspace mLuSolveWorkspace;
+
+		// #### Lazy computation of switched system matrices ####
+		/// Activates the computation of switch state dependent system matrices on first use
+		/// instead of precomputing the matrices of all switch state combinations
+		Bool mLazySwitchedSystems = false;
+		/// Maximum number of cached system matrices and LU factorizations in lazy mode
+		UInt mSwitchedSystemCacheSize = 32;
+		/// Switch states whose system matrices are computed during initialization in lazy mode
+		std::vector< std::bitset<SWITCH_NUM> > mExpectedSwitchStates;
+		/// Cached switch states, ordered from most to least recently used
+		std::list< std::bitset<SWITCH_NUM> > mSwitchedSystemLru;
+		/// Position of each cached switch state in the least recently used list
+		std::unordered_map< std::bitset<SWITCH_NUM>, std::list< std::bitset<SWITCH_NUM> >::iterator > mSwitchedSystemLruPos;
+		/// Number of switch state lookups that were served from the cache
+		Int mSwitchedSystemCacheHits = 0;
+		/// Number of switch state lookups that required a new LU factorization
+		Int mSwitchedSystemCacheMisses = 0;
+		/// Number of cached system matrices
+		Int mSwitchedSystemCacheEntries = 0;
+
+		// #### Batched execution of components ####
+		/// Executes single frequency DP inductors, capacitors and resistors
+		/// in batches instead of with tasks per component
+		Bool mBatchedComponents = false;
+		/// Replaces the components that support batched execution by batches
+		void batchComponents();
 
 		// #### Attributes related to switching ####
 		/// Index of the next switching event
@@ -112,6 +155,16 @@ namespace DPsim {
 		std::vector<SwitchConfiguration> mSwitchEvents;
 		/// Collects the status of switches to select correct system matrix
 		void updateSwitchStatus();
+		/// Entries of the system matrix stamp of each switch when open (0) and closed (1)
+		std::vector< std::array<std::vector<Eigen::Triplet<Real>>, 2> > mSwitchStamps;
+		/// Stamps each switch in both states once to collect mSwitchStamps,
+		/// so that solvers can apply switch changes without stamping again.
+		/// The switch parameters must not change afterwards.
+		void captureSwitchStamps();
+		/// Stamps the system matrix for the given switch state and computes its LU factorization
+		void createSwitchedSystem(const std::bitset<SWITCH_NUM>& status);
+		/// Makes sure that the system matrix for the given switch state is cached in lazy mode
+		void useSwitchedSystem(const std::bitset<SWITCH_NUM>& status);
 
 		// #### Attributes related to logging ####
 		/// Last simulation time step when log was updated
@@ -123,6 +176,13 @@ namespace DPsim {
 
 		/// Initialization of individual components
 		void initializeComponents();
+		/// Registers the dense or sparse right side vector of a component and its subcomponents
+		void collectRightVectorStamp(const CPS::MNAInterface::Ptr& comp);
+		/// Registers the right side vector of a component and its subcomponents
+		/// with the attributes of each frequency in frequency-parallel mode
+		void collectRightVectorStampHarm(const CPS::MNAInterface::Ptr& comp);
+		/// Sums up the right side vector contributions of all components
+		void assembleRightSideVector();
 		/// Initialization of system matrices and source vector
 		virtual void initializeSystem();
 		/// Initialization of system matrices and source vector
@@ -133,6 +193,10 @@ namespace DPsim {
 		void identifyTopologyObjects();
 		/// Assign simulation node index according to index in the vector.
 		void assignMatrixNodeIndices();
+		/// Sparsity statistics of the nodes in the order of the system
+		NodeOrdering::Statistics mNaturalOrderStatistics;
+		/// Sparsity statistics of the nodes in the order of the assigned indices
+		NodeOrdering::Statistics mNodeOrderStatistics;
 		/// Collects virtual nodes inside components.
 		/// The MNA algorithm handles these nodes in the same way as network nodes.
 		void collectVirtualNodes();
@@ -148,6 +212,8 @@ namespace DPsim {
 		// #### Scheduler Task Methods ####
 		/// Solves system for single frequency
 		virtual void solve(Real time, Int timeStepCount);
+		/// Updates the node voltages from the left side vector
+		void updateNodeVoltages();
 		/// Solves system for multiple frequencies
 		void solveWithHarmonics(Real time, Int timeStepCount, Int freqIdx);
 		/// Logs left and right vector
@@ -174,10 +240,44 @@ namespace DPsim {
 		Matrix& rightSideVector() { return mRightSideVector; }
 		///
 		virtual CPS::Task::List getTasks();
-		///
+		/// System matrix of the current switch state. Does not compute or
+		/// touch cached matrices, so in lazy mode the matrix of a switch state
+		/// that was not solved yet may be missing.
 		MAT_TYPE& systemMatrix() {
-			return mSwitchedMatrices[mCurrentSwitchStatus];
+			auto it = mSwitchedMatrices.find(mCurrentSwitchStatus);
+			if (it == mSwitchedMatrices.end())
+				throw CPS::SystemError("No system matrix for switch state " + mCurrentSwitchStatus.to_string() + ".");
+			return it->second;
+		}
+
+		/// Sparsity statistics of the node pattern in the order of the system nodes
+		const NodeOrdering::Statistics& naturalOrderStatistics() const { return mNaturalOrderStatistics; }
+		/// Sparsity statistics of the node pattern in the order set by setNodeOrdering
+		const NodeOrdering::Statistics& nodeOrderStatistics() const { return mNodeOrderStatistics; }
+
+		// #### Lazy computation of switched system matrices ####
+		/// Computes system matrices only for switch states that actually occur and keeps
+		/// the most recently used cacheSize of them instead of precomputing all 2^n states
+		void doLazySwitchedSystems(Bool value, UInt cacheSize = 32);
+		/// Adds a switch state whose system matrix is computed during initialization.
+		/// Bit i of the state corresponds to the i-th switch of the system.
+		void addExpectedSwitchState(std::bitset<SWITCH_NUM> state) {
+			mExpectedSwitchStates.push_back(state);
 		}
+		/// Number of cached system matrices in lazy mode
+		UInt switchedSystemCacheSize() const { return mSwitchedSystemCacheEntries; }
+		/// Ratio of switch state lookups during simulation that did not require a new factorization
+		Real switchedSystemCacheHitRate() const;
+
+		// #### Batched execution of components ####
+		/// Groups components of the same type to update their states in one
+		/// task and loop per type. Only used for a single frequency without
+		/// frequency parallelization.
+		void doBatchedComponents(Bool value) { mBatchedComponents = value; }
+		/// Components that support it stamp their right side vector contribution
+		/// into a sparse vector instead of a dense one. Their "right_vector"
+		/// attributes are empty then.
+		void doSparseRightVector(Bool value) { mSparseRightVector = value; }
 
 		// #### MNA Solver Tasks ####
 		///
@@ -186,10 +286,7 @@ namespace DPsim {
 			SolveTask(MnaSolver<VarType>& solver) :
 				Task(solver.mName + ".Solve"), mSolver(solver) {
 
-				for (auto it : solver.mMNAComponents) {
-					if (it->template attribute<Matrix>("right_vector")->get().size() != 0)
-						mAttributeDependencies.push_back(it->attribute("right_vector"));
-				}
+				mAttributeDependencies = solver.mRightVectorAttributes;
 				for (auto node : solver.mNodes) {
 					mModifiedAttributes.push_back(node->attribute("v"));
 				}
@@ -206,18 +303,13 @@ namespace DPsim {
 		class SolveTaskHarm : public CPS::Task {
 		public:
 			SolveTaskHarm(MnaSolver<VarType>& solver, UInt freqIdx) :
-				Task(solver.mName + ".Solve"), mSolver(solver), mFreqIdx(freqIdx) {
+				Task(solver.mName + ".SolveHarm" + std::to_string(freqIdx)), mSolver(solver), mFreqIdx(freqIdx) {
 
-				for (auto it : solver.mMNAComponents) {
-					if (it->template attribute<Matrix>("right_vector")->get().size() != 0)
-						mAttributeDependencies.push_back(it->attribute("right_vector"));
-				}
+				mAttributeDependencies = solver.mRightVectorAttributesHarm[freqIdx];
 				for (auto node : solver.mNodes) {
 					mModifiedAttributes.push_back(node->attribute("v"));
 				}
-				for(Int freq = 0; freq < solver.mSystem.mFrequencies.size(); freq++) {
-					mModifiedAttributes.push_back(solver.attribute("left_vector_"+std::to_string(freq)));
-				}
+				mModifiedAttributes.push_back(solver.attribute("left_vector_"+std::to_string(freqIdx)));
 			}
 
 			void execute(Real time, Int timeStepCount) { mSolver.solveWithHarmonics(time, timeStepCount, mFreqIdx); }
@@ -234,6 +326,7 @@ namespace DPsim {
 				Task(solver.mName + ".Log"), mSolver(solver) {
 				mAttributeDependencies.push_back(solver.attribute("left_vector"));
 				mModifiedAttributes.push_back(Scheduler::external);
+				mOutputOnly = true;
 			}
 
 			void execute(Real time, Int timeStepCount) { mSolver.log(time, timeStepCount); }
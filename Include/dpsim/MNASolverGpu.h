@@ -65,10 +65,7 @@ namespace DPsim {
 			SolveTask(MnaSolverGpu<VarType>& solver) :
 				Task(solver.mName + ".Solve"), mSolver(solver) {
 
-				for (auto it : solver.mMNAComponents) {
-					if (it->template attribute<Matrix>("right_vector")->get().size() != 0)
-						mAttributeDependencies.push_back(it->attribute("right_vector"));
-				}
+				mAttributeDependencies = solver.mRightVectorAttributes;
 				for (auto node : solver.mNodes) {
 					mModifiedAttributes.push_back(node->attribute("v"));
 				}
@@ -87,6 +84,7 @@ namespace DPsim {
 				Task(solver.mName + ".Log"), mSolver(solver) {
 				mAttributeDependencies.push_back(solver.attribute("left_vector"));
 				mModifiedAttributes.push_back(Scheduler::external);
+				mOutputOnly = true;
 			}
 
 			void execute(Real time, Int timeStepCount) { mSolver.log(time, timeStepCount); }
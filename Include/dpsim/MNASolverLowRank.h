@@ -0,0 +1,111 @@
+/* Copyright 2017-2020 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#pragma once
+
+#include <dpsim/MNASolver.h>
+
+namespace DPsim {
+	/// Solver class using Modified Nodal Analysis (MNA) that handles changes
+	/// of switches and variable components as low-rank corrections.
+	///
+	/// The LU factorization of the system matrix A0 is kept when switches or
+	/// variable components change. The difference A - A0 to the actual system
+	/// matrix is applied during the solution using the Sherman-Morrison-Woodbury
+	/// formula. The difference is built from the stamps of the switches that
+	/// changed, captured during the initialization, and the changed entries of
+	/// the variable components, without stamping the whole system matrix. It is
+	/// only refactorized if the number of columns touched by the difference
+	/// exceeds the maximum rank.
+	template <typename VarType>
+	class MnaSolverLowRank : public MnaSolver<VarType> {
+	protected:
+		/// Maximum rank of the correction before the system matrix is refactorized
+		UInt mMaxCorrectionRank = 8;
+		/// Switch status of the current system matrix
+		std::bitset<SWITCH_NUM> mStampedSwitchStatus;
+		/// Switch status of the factorized system matrix A0
+		std::bitset<SWITCH_NUM> mFactorizedSwitchStatus;
+		/// Set if a variable component has changed since its last stamp
+		Bool mVariableCompsChanged = false;
+		/// Stamps of the variable components with their current parameters
+		CPS::SparseMatrixRow mVariableStamp;
+		/// Stamps of the variable components in A0, with the same pattern as mVariableStamp
+		CPS::SparseMatrixRow mFactorizedVariableStamp;
+		/// System matrix A0 the LU factorization was computed for
+		MAT_TYPE mFactorizedSystemMatrix;
+#ifdef WITH_SPARSE
+		/// LU factorization of A0
+		CPS::LUFactorizedSparse mLuFactorization;
+		/// System matrix the symbolic analysis of the LU factorization was computed for
+		MAT_TYPE mAnalyzedSystemMatrix;
+#else
+		CPS::LUFactorized mLuFactorization;
+#endif
+		/// Columns in which the actual system matrix differs from A0, the
+		/// first mCorrectionRank entries are used
+		std::vector<UInt> mCorrectionColumns;
+		/// Number of correction columns
+		Int mCorrectionRank = 0;
+		/// Difference to A0 in the correction columns U, one column per correction column
+		Matrix mCorrection;
+		/// Factorized system matrix applied to the correction Z = A0^-1 U
+		Matrix mCorrectionSolution;
+		/// Buffers for the solution of one column of Z
+		Matrix mCorrectionColumn;
+		Matrix mCorrectionColumnSolution;
+		/// Capacitance matrix I + V^T Z, the rows and columns beyond the rank
+		/// are those of the identity so that its size does not change
+		Matrix mCapacitance;
+		/// LU factorization of the capacitance matrix
+		CPS::LUFactorized mCapacitanceLu;
+		/// Entries of the uncorrected solution in the correction columns
+		Matrix mCorrectionRhs;
+		/// Solution of the capacitance matrix for mCorrectionRhs
+		Matrix mCorrectionWeights;
+		/// Number of system matrix changes handled by low-rank corrections
+		Int mNumLowRankUpdates = 0;
+		/// Number of system matrix changes that required a refactorization
+		Int mNumRefactorizations = 0;
+		/// Number of symbolic analyses of the system matrix
+		Int mNumPatternAnalyses = 0;
+
+		/// Initialization of system matrices and source vector
+		virtual void initializeSystem() override;
+		/// Stamps the variable components into mVariableStamp
+		void stampVariableComps();
+		/// Assembles and factorizes the actual system matrix and drops the correction
+		void refactorize();
+#ifdef WITH_SPARSE
+		/// Computes the symbolic analysis of the LU factorization for the pattern of the matrix
+		void analyzePattern(const MAT_TYPE& matrix);
+#endif
+		/// Adds an entry of the difference to A0 to the correction. Returns
+		/// false if this exceeds the maximum rank.
+		Bool addCorrectionEntry(UInt row, UInt col, Real value);
+		/// Recomputes the correction from the changed switches and variable
+		/// components or refactorizes the system matrix
+		void updateSystemMatrix(Real time);
+		/// Returns true if a switch or a variable component has changed
+		Bool hasSystemChanged();
+		/// Solves the system with the factorized matrix and the low-rank correction
+		virtual void solve(Real time, Int timeStepCount) override;
+
+	public:
+		///
+		MnaSolverLowRank(String name,
+			CPS::Domain domain = CPS::Domain::DP,
+			CPS::Logger::Level logLevel = CPS::Logger::Level::info);
+		///
+		virtual ~MnaSolverLowRank() { };
+		///
+		virtual CPS::Task::List getTasks() override;
+		/// Sets the maximum rank of the correction before refactorizing
+		void setMaxCorrectionRank(UInt rank) { mMaxCorrectionRank = rank; }
+	};
+}
@@ -23,9 +23,29 @@ namespace DPsim {
 		// #### Dynamic matrix recomputation ####
 		/// Flag that initiates recomputation of system matrix
 		Bool mUpdateSysMatrix;
+		/// Number of system matrix recomputations
+		Int mNumSysMatrixUpdates = 0;
+		/// Accumulated wall clock time of system matrix recomputations [s]
+		Real mSysMatrixUpdateTime = 0;
+		/// Number of symbolic analyses of the system matrix
+		Int mNumPatternAnalyses = 0;
 		/// Recomputes systems matrix
 		void updateSystemMatrix(Real time);
-		/// Collects the status of variable MNA elements to decide if system matrix has to be recomputed
+		/// Switch status the system matrix was stamped for
+		std::bitset<SWITCH_NUM> mStampedSwitchStatus;
+		/// Stamps the variable elements into the system matrix
+		void stampVariableElements();
+		/// Adds the captured stamps of the switches in their current status to the system matrix
+		void stampSwitches();
+#ifdef WITH_SPARSE
+		/// Adds explicit zeros to the base matrix so that its sparsity pattern covers the given matrix
+		void extendBasePattern(const SparseMatrix& matrix);
+		/// Moves the values of the given matrix to the sparsity pattern of the
+		/// base matrix, which is extended if necessary. Stamps may add entries
+		/// or drop explicit zeros. Returns true if the base pattern was extended.
+		Bool applyBasePattern(SparseMatrix& matrix);
+#endif
+		/// Collects the status of variable MNA elements and switches to decide if system matrix has to be recomputed
 		void updateVariableCompStatus();
 		/// Initialization of system matrices and source vector
 		void initializeSystemWithDynamicMatrix();
@@ -47,10 +67,7 @@ namespace DPsim {
 			SolveTask(MnaSolverSysRecomp<VarType>& solver) :
 				Task(solver.mName + ".Solve"), mSolver(solver) {
 
-				for (auto it : solver.mMNAComponents) {
-					if (it->template attribute<Matrix>("right_vector")->get().size() != 0)
-						mAttributeDependencies.push_back(it->attribute("right_vector"));
-				}
+				mAttributeDependencies = solver.mRightVectorAttributes;
 				for (auto node : solver.mNodes) {
 					mModifiedAttributes.push_back(node->attribute("v"));
 				}
@@ -69,6 +86,7 @@ namespace DPsim {
 				Task(solver.mName + ".Log"), mSolver(solver) {
 				mAttributeDependencies.push_back(solver.attribute("left_vector"));
 				mModifiedAttributes.push_back(Scheduler::external);
+				mOutputOnly = true;
 			}
 
 			void execute(Real time, Int timeStepCount) { mSolver.log(time, timeStepCount); }
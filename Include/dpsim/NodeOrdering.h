@@ -0,0 +1,129 @@
+/* Copyright 2017-2020 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#pragma once
+
+#include <vector>
+#include <set>
+#include <unordered_map>
+
+#include <dpsim/Definitions.h>
+#include <cps/Logger.h>
+#include <cps/SimPowerComp.h>
+
+namespace DPsim {
+	/// Fill-reducing ordering of the nodes of an MNA system.
+	///
+	/// The nodes form an undirected graph in which all nodes of a component,
+	/// including its virtual nodes, are connected with each other. This is
+	/// the sparsity pattern of the system matrix on node level.
+	class NodeOrdering {
+	public:
+		/// Ordering methods
+		enum class Method { Natural, RCM, AMD };
+
+		/// Sparsity statistics of the node adjacency pattern for a given order
+		struct Statistics {
+			/// Maximum distance of a non-zero entry from the diagonal
+			UInt bandwidth = 0;
+			/// Number of non-zero entries
+			UInt nnz = 0;
+			/// Number of entries created during an elimination without pivoting
+			UInt fill = 0;
+		};
+
+		///
+		NodeOrdering(UInt numNodes) : mAdjacency(numNodes) { }
+
+		/// Connects all given nodes with each other
+		void addClique(const std::vector<UInt>& nodes);
+		/// Returns the node indices in the order computed by the given method
+		std::vector<UInt> order(Method method) const;
+		/// Computes the sparsity statistics if the nodes are numbered in the given order
+		Statistics statistics(const std::vector<UInt>& order) const;
+
+		/// Returns the order of the nodes computed by the given method and
+		/// logs the sparsity statistics before and after reordering. The
+		/// statistics are also stored in natural and reordered if given.
+		template <typename VarType>
+		static std::vector<UInt> compute(Method method,
+			const typename CPS::SimNode<VarType>::List& nodes,
+			const typename CPS::SimPowerComp<VarType>::List& components,
+			CPS::Logger::Log log,
+			Statistics* natural = nullptr, Statistics* reordered = nullptr);
+
+	private:
+		/// Reverse Cuthill-McKee ordering to reduce the bandwidth
+		std::vector<UInt> reverseCuthillMcKee() const;
+		/// Approximate minimum degree ordering to reduce the fill
+		std::vector<UInt> approximateMinimumDegree() const;
+
+		/// Adjacent nodes of each node
+		std::vector< std::set<UInt> > mAdjacency;
+	};
+
+	template <typename VarType>
+	std::vector<UInt> NodeOrdering::compute(Method method,
+		const typename CPS::SimNode<VarType>::List& nodes,
+		const typename CPS::SimPowerComp<VarType>::List& components,
+		CPS::Logger::Log log,
+		Statistics* natural, Statistics* reordered) {
+
+		std::vector<UInt> naturalOrder(nodes.size());
+		for (UInt idx = 0; idx < nodes.size(); idx++)
+			naturalOrder[idx] = idx;
+
+		if (method == Method::Natural && !natural && !reordered)
+			return naturalOrder;
+
+		std::unordered_map<CPS::SimNode<VarType>*, UInt> nodeIndices;
+		for (UInt idx = 0; idx < nodes.size(); idx++)
+			nodeIndices[nodes[idx].get()] = idx;
+
+		NodeOrdering graph(static_cast<UInt>(nodes.size()));
+
+		// Connect the nodes and virtual nodes of each component and its subcomponents
+		std::vector<typename CPS::SimPowerComp<VarType>::Ptr> pending(components.begin(), components.end());
+		while (!pending.empty()) {
+			auto comp = pending.back();
+			pending.pop_back();
+
+			std::vector<UInt> clique;
+			for (auto terminal : comp->terminals()) {
+				if (!terminal || !terminal->node())
+					continue;
+				auto it = nodeIndices.find(terminal->node().get());
+				if (it != nodeIndices.end())
+					clique.push_back(it->second);
+			}
+			for (auto& virtualNode : comp->virtualNodes()) {
+				auto it = nodeIndices.find(virtualNode.get());
+				if (it != nodeIndices.end())
+					clique.push_back(it->second);
+			}
+			graph.addClique(clique);
+
+			for (auto subComp : comp->subComponents())
+				pending.push_back(subComp);
+		}
+
+		std::vector<UInt> order = method == Method::Natural ? naturalOrder : graph.order(method);
+		Statistics before = graph.statistics(naturalOrder);
+		Statistics after = graph.statistics(order);
+
+		log->info("Node ordering: {} nodes, {} non-zeros", nodes.size(), before.nnz);
+		log->info("Bandwidth before / after reordering: {} / {}", before.bandwidth, after.bandwidth);
+		log->info("Predicted fill before / after reordering: {} / {}", before.fill, after.fill);
+
+		if (natural)
+			*natural = before;
+		if (reordered)
+			*reordered = after;
+		return order;
+	}
+}
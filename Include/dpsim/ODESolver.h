@@ -59,6 +59,12 @@ namespace DPsim {
 		/// Linear solver object (implicit solver)
 		SUNLinearSolver LS = NULL; */
 
+		/// Keep the integrator memory across time steps and reinitialize it
+		/// with the current state instead of recreating it in each step
+		Bool mPersistentIntegrator = false;
+		/// Size of the last internal step, used as initial step of the next time step
+		realtype mLastInternalStep = 0;
+
 		/// reusable error-checking flag
 		int mFlag;
 
@@ -74,6 +80,12 @@ namespace DPsim {
 		                           N_Vector tmp1, N_Vector tmp2, N_Vector tmp3);
 		int Jacobian(realtype t, N_Vector y, N_Vector fy, SUNMatrix J,
 		             N_Vector tmp1, N_Vector tmp2, N_Vector tmp3);
+		/// Allocates the integrator memory and linear solver for an initial time
+		void createIntegrator(Real initial_time);
+		/// Resets the integrator memory to the current state at an initial time
+		void reinitIntegrator(Real initial_time);
+		/// Frees the integrator memory and linear solver
+		void freeIntegrator();
 		/// ARKode- standard error detection function; in DAE-solver not detection function is used -> for efficiency purposes?
 		int check_flag(void *flagvalue, const std::string funcname, int opt);
 
@@ -101,6 +113,8 @@ namespace DPsim {
 			return CPS::Task::List{std::make_shared<SolveTask>(*this)};
 		}
 
+		/// Reuse the integrator memory across time steps
+		void doPersistentIntegrator(Bool value) { mPersistentIntegrator = value; }
 		/// Initialize ARKode-solve_environment
 		void initialize();
 		/// Solve system for the current time
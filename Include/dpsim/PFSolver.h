@@ -42,12 +42,16 @@ namespace DPsim {
         std::vector<CPS::UInt> mVDBusIndices;
         /// Vector with indices of both PQ and PV buses
         std::vector<CPS::UInt> mPQPVBusIndices;
+        /// Position of each bus in the vector of PQ and PV buses, -1 for VD buses
+        std::vector<CPS::Int> mPQPVBusPositions;
 
         /// Admittance matrix
         CPS::SparseMatrixCompRow mY;
 
-        /// Jacobian matrix
-        CPS::Matrix mJ;
+        /// Jacobian matrix with a fixed sparsity pattern
+        CPS::SparseMatrix mJ;
+        /// LU factorization of the Jacobian, the symbolic analysis is reused
+        CPS::LUFactorizedSparse mJLu;
         /// Solution vector
         CPS::Vector mX;
 	    /// Vector of mismatch values
@@ -91,6 +95,8 @@ namespace DPsim {
         virtual void generateInitialSolution(Real time, bool keep_last_solution = false) = 0;
         /// Calculate mismatch
         virtual void calculateMismatch() = 0;
+        /// Create the sparsity pattern of the Jacobian
+        virtual void createJacobianPattern() = 0;
         /// Calculate the Jacobian
         virtual void calculateJacobian() = 0;
         /// Update solution in each iteration
@@ -140,6 +146,10 @@ namespace DPsim {
         void setVDNode(CPS::String name);
         /// Allows to modify the powerflow bus type of a specific component
         void modifyPowerFlowBusComponent(CPS::String name, CPS::PowerflowBusType powerFlowBusType);
+        /// Number of iterations of the last solution
+        CPS::UInt iterations() const { return mIterations; }
+        /// Whether the last solution converged
+        CPS::Bool converged() const { return isConverged; }
 
         class SolveTask : public CPS::Task {
 		public:
@@ -33,6 +33,8 @@ namespace DPsim {
         // Core methods
         /// Generate initial solution for current time step
         void generateInitialSolution(Real time, bool keep_last_solution = false);
+        /// Create the sparsity pattern of the Jacobian from the admittance matrix
+        void createJacobianPattern();
         /// Calculate the Jacobian
         void calculateJacobian();
         /// Update solution in each iteration
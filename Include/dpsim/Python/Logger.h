@@ -37,12 +37,14 @@ namespace Python {
 		static int init(Logger *self, PyObject *args, PyObject *kwds);
 		static PyObject* newfunc(PyTypeObject *type, PyObject *args, PyObject *kwds);
 		static PyObject* logAttribute(Logger *self, PyObject *args, PyObject *kwargs);
+		static PyObject* droppedRows(Logger *self, PyObject *args);
 
 		static PyMethodDef methods[];
 		static PyMemberDef members[];
 		static PyTypeObject type;
 		static const char* doc;
 		static const char* docLogAttribute;
+		static const char* docDroppedRows;
 	};
 }
 }
@@ -107,6 +107,9 @@ namespace Python {
 		static PyObject* time(Simulation *self, void *ctx);
 		static PyObject* finalTime(Simulation *self, void *ctx);
 		static PyObject* avgStepTime(Simulation *self, void *ctx);
+		static PyObject* stepTimeStats(Simulation *self, void *ctx);
+		static PyObject* stepTimeHistogram(Simulation *self, void *ctx);
+		static PyObject* overrunTasks(Simulation *self, void *ctx);
 
 		static const char *doc;
 		static const char *docStart;
@@ -122,6 +125,9 @@ namespace Python {
 		static const char *docSetScheduler;
 		static const char *docState;
 		static const char *docName;
+		static const char *docStepTimeStats;
+		static const char *docStepTimeHistogram;
+		static const char *docOverrunTasks;
 		static PyMethodDef methods[];
 		static PyGetSetDef getset[];
 		static PyTypeObject type;
@@ -18,6 +18,10 @@
 
 namespace DPsim {
 	/// Extending Simulation class by real-time functionality.
+	///
+	/// With doOverrunAnalysis, the task execution times are measured, so that
+	/// each timer overrun can be attributed to the task that exceeded its
+	/// mean execution time the most.
 	class RealTimeSimulation : public Simulation {
 
 	protected:
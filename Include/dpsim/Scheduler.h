@@ -10,7 +10,11 @@
 
 #include <cps/Task.h>
 
+#include <dpsim/AllocationTracker.h>
 #include <dpsim/Definitions.h>
+#include <dpsim/TaskStatistics.h>
+#include <dpsim/TaskTracer.h>
+#include <dpsim/Waiter.h>
 #include <cps/Logger.h>
 
 #include <atomic>
@@ -19,6 +23,7 @@
 #include <deque>
 #include <mutex>
 #include <unordered_map>
+#include <unordered_set>
 
 namespace DPsim {
 	// TODO extend / subclass
@@ -31,6 +36,9 @@ namespace DPsim {
 		typedef std::unordered_map<CPS::Task::Ptr, std::deque<CPS::Task::Ptr>> Edges;
 		/// Time measurement for the task execution
 		typedef std::chrono::steady_clock::duration TaskTime;
+		/// Statistic of the measured execution times that measurement-driven
+		/// schedulers use as the cost of a task
+		enum class MeasurementStatistic { Mean, P50, P99, P999, Max };
 
 		///
 		Scheduler(CPS::Logger::Level logLevel = CPS::Logger::Level::off) :
@@ -52,6 +60,9 @@ namespace DPsim {
 		virtual void step(Real time, Int timeStepCount) = 0;
 		/// Called on simulation stop to reliably clean up e.g. running helper threads
 		virtual void stop() {}
+		/// Waits until the output tasks of the last step are done, for
+		/// schedulers that execute them concurrently with the next step
+		virtual void finishOutputs() {}
 
 		/// Helper function that resolves the task-attribute dependencies to task-task dependencies
 		/// and inserts a root task
@@ -66,6 +77,43 @@ namespace DPsim {
 		TaskTime getAveragedMeasurement(CPS::Task::Ptr task) {
 			return getAveragedMeasurement(task.get());
 		}
+		/// Execution time statistics of a task, empty if it was not measured
+		const TaskStatistics& getMeasurementStatistics(CPS::Task::Ptr task) {
+			return mMeasurements[task.get()];
+		}
+		/// Measure the execution times of the tasks even without an output
+		/// measurement file. Must be set before the schedule is created.
+		void doTaskTimeMeasurement(Bool value) { mMeasureTaskTimes = value; }
+		/// Task whose execution time in the given step exceeded its mean the
+		/// most, or nullptr if no measured task was executed in the step.
+		/// Pipelined output tasks are not considered, because they may still
+		/// be running.
+		CPS::Task* lastStepOutlier(Int timeStepCount, TaskStatistics const** stats = nullptr);
+		/// Record the start and end of each task execution per thread and write
+		/// them to a Chrome trace file when the scheduler is stopped. Only the
+		/// last eventsPerThread executions of each thread are kept.
+		/// Must be set before the schedule is created.
+		void doTracing(CPS::String filename, UInt eventsPerThread = 1 << 16) {
+			mTraceFile = filename;
+			mTraceEventsPerThread = eventsPerThread;
+		}
+		/// Count the heap allocations of each task. This requires a build with
+		/// WITH_ALLOCATION_TRACKING, see AllocationTracker::available.
+		/// Must be set before the schedule is created.
+		void doAllocationTracking(Bool value) { mTrackAllocations = value; }
+		/// Number of heap allocations of each task since the schedule was
+		/// created or the counts were reset. Output tasks that are still
+		/// running add to the counts until finishOutputs returns.
+		const std::unordered_map<CPS::Task*, std::uint64_t>& taskAllocations() const { return mAllocations; }
+		/// Set the allocation counts of all tasks to 0
+		void resetTaskAllocations() {
+			for (auto& pair : mAllocations)
+				pair.second = 0;
+		}
+		/// Set the statistic that is read from the input measurement file
+		void setMeasurementStatistic(MeasurementStatistic statistic) {
+			mMeasurementStatistic = statistic;
+		}
 
 		/// Root task that has a dependency on the external attribute
 		/// which means that it should not be removed from the task graph
@@ -89,31 +137,86 @@ namespace DPsim {
 
 		void initMeasurements(const CPS::Task::List& tasks);
 		/// Not thread-safe for multiple calls with same task, but should only
-		/// be called once for each task in each step anyway
-		void updateMeasurement(CPS::Task* task, TaskTime time);
-		/// Write measurement data to file
+		/// be called once for each task in each step anyway.
+		/// Tasks must be registered with initMeasurements first, so that
+		/// concurrent calls for different tasks do not modify the map.
+		void updateMeasurement(CPS::Task* task, TaskTime time, Int timeStepCount);
+		/// Write the execution time distribution of each task to file.
+		/// The file has one line per task with the columns
+		///   task,mean,count,stddev,min,max,p50,p99,p99.9
+		/// in the unit of TaskTime. The non-empty histogram buckets are written
+		/// to filename + ".hist" with the columns task,upper_bound,count.
 		void writeMeasurements(CPS::String filename);
-		/// Read measurement data from file to use it for the scheduling
+		/// Read measurement data from file to use it for the scheduling.
+		/// The selected statistic is read, or the single value of files that
+		/// only contain the mean.
 		void readMeasurements(CPS::String filename, std::unordered_map<CPS::String, TaskTime::rep>& measurements);
 		///
 		TaskTime getAveragedMeasurement(CPS::Task* task);
 
+		/// Create the trace buffers if tracing is enabled
+		void initTracing(Int threads);
+		/// Write the trace file if tracing is enabled
+		void writeTrace();
+		/// True if the task executions have to be timed or their allocations counted
+		Bool timeTasks() const { return mMeasureTaskTimes || mTracer != nullptr || mTrackAllocations; }
+		/// Record a timed task execution for the measurements and the trace
+		void recordTask(Int thread, CPS::Task* task, TaskTracer::TimePoint start, TaskTracer::TimePoint end, Int timeStepCount) {
+			if (mMeasureTaskTimes)
+				updateMeasurement(task, end-start, timeStepCount);
+			if (mTracer)
+				mTracer->record(thread, task, start, end, timeStepCount);
+		}
+		/// Execute a task and record its execution time and allocations if
+		/// timeTasks() is true
+		void executeTimedTask(Int thread, CPS::Task* task, Real time, Int timeStepCount) {
+			std::uint64_t allocations = AllocationTracker::threadAllocations();
+			auto start = std::chrono::steady_clock::now();
+			task->execute(time, timeStepCount);
+			auto end = std::chrono::steady_clock::now();
+			if (mTrackAllocations)
+				mAllocations.at(task) += AllocationTracker::threadAllocations() - allocations;
+			recordTask(thread, task, start, end, timeStepCount);
+		}
+
 		///
 		CPS::Task::Ptr mRoot;
 		/// Log level
 		CPS::Logger::Level mLogLevel;
 		/// Logger
 		CPS::Logger::Log mSLog;
+		///
+		MeasurementStatistic mMeasurementStatistic = MeasurementStatistic::Mean;
+		/// Measure the task execution times, set by the schedulers if an
+		/// output measurement file is given
+		Bool mMeasureTaskTimes = false;
+		/// Count the allocations of the tasks
+		Bool mTrackAllocations = false;
+		///
+		std::unique_ptr<TaskTracer> mTracer;
+		///
+		CPS::String mTraceFile;
+		///
+		UInt mTraceEventsPerThread = 0;
+		/// Tasks that are executed concurrently with the following step, e.g.
+		/// pipelined outputs, so their measurements must not be read during
+		/// the simulation
+		std::unordered_set<CPS::Task*> mPipelinedTasks;
 	private:
-		// TODO more sophisticated measurement method might be necessary for
-		// longer simulations (risk of high memory requirements and integer
-		// overflow)
-		std::unordered_map<CPS::Task*, std::vector<TaskTime>> mMeasurements;
+		/// Streaming execution time statistics of each task
+		std::unordered_map<CPS::Task*, TaskStatistics> mMeasurements;
+		/// Time step of the last measurement of each task
+		std::unordered_map<CPS::Task*, Int> mMeasuredSteps;
+		/// Heap allocations of each task
+		std::unordered_map<CPS::Task*, std::uint64_t> mAllocations;
 	};
 
 	/// A barrier is used to synchronize threads. Threads running into the barrier
 	/// have to wait until the barrier state is released when a defined number
 	/// of threads reaches the barrier.
+	///
+	/// Waiting threads either block on a condition variable, spin or use a
+	/// Waiter, which spins for a limited time before blocking.
 	class Barrier {
 	public:
 		/// Constructor without parameters is forbidden.
@@ -121,7 +224,7 @@ namespace DPsim {
 		/// Limit sets the number of threads that need to reach the barrier
 		/// to release it.
 		Barrier(Int limit, Bool useCondition = false) :
-			mLimit(limit), mCount(0), mGeneration(0), mUseCondition(useCondition) {}
+			mLimit(limit), mCount(0), mGeneration(0), mWaiters(0), mUseCondition(useCondition) {}
 
 		/// Blocks until |limit| calls have been made, at which point all threads
 		/// return. Provides synchronization, i.e. all writes from before this call
@@ -148,14 +251,29 @@ namespace DPsim {
 				// and the fetch needs to be an acquire anyway, so use acq_rel instead of acquire.
 				// (This generates the same code on x86.)
 				if (mCount.fetch_add(1, std::memory_order_acq_rel) == mLimit-1) {
-					mCount.store(0, std::memory_order_relaxed);
-					mGeneration.fetch_add(1, std::memory_order_release);
+					release();
 				} else {
 					while (mGeneration.load(std::memory_order_acquire) == gen);
 				}
 			}
 		}
 
+		/// Like wait, but uses the given waiter of the calling thread unless
+		/// the barrier uses a condition variable.
+		void wait(Waiter& waiter) {
+			if (mUseCondition) {
+				wait();
+				return;
+			}
+
+			Int gen = mGeneration.load(std::memory_order_acquire);
+			if (mCount.fetch_add(1, std::memory_order_acq_rel) == mLimit-1) {
+				release();
+			} else {
+				waiter.wait(mGeneration, mWaiters, [gen](Int value) { return value != gen; });
+			}
+		}
+
 		/// Increases the barrier counter like wait does, but does not wait for it to
 		/// reach the limit (so this does not provide any synchronization with
 		/// other threads). Can be used to eliminate unnecessary waits if
@@ -172,20 +290,26 @@ namespace DPsim {
 				}
 			} else {
 				// No release here, as this call does not provide any synchronization anyway.
-				if (mCount.fetch_add(1, std::memory_order_acquire) == mLimit-1) {
-					mCount.store(0, std::memory_order_relaxed);
-					mGeneration.fetch_add(1, std::memory_order_release);
-				}
+				if (mCount.fetch_add(1, std::memory_order_acquire) == mLimit-1)
+					release();
 			}
 		}
 
 	private:
+		void release() {
+			mCount.store(0, std::memory_order_relaxed);
+			mGeneration.fetch_add(1, std::memory_order_seq_cst);
+			Waiter::wake(mGeneration, mWaiters);
+		}
+
 		/// Barrier limit which has to be reached before the barrier is released.
 		Int mLimit;
 		/// Barrier counter which is tested against limit
 		std::atomic<Int> mCount;
 		/// Allows multiple use of the barrier
 		std::atomic<Int> mGeneration;
+		/// Number of threads blocked on the generation
+		std::atomic<Int> mWaiters;
 		Bool mUseCondition;
 
 		std::mutex mMutex;
@@ -204,17 +328,28 @@ namespace DPsim {
 
 	class Counter {
 	public:
-		Counter() : mValue(0) {}
+		Counter() : mValue(0), mWaiters(0) {}
 
 		void inc() {
-			mValue.fetch_add(1, std::memory_order_release);
+			mValue.fetch_add(1, std::memory_order_seq_cst);
+			Waiter::wake(mValue, mWaiters);
 		}
 
+		/// Waits until the counter has reached at least the given value
 		void wait(Int value) {
-			while (mValue.load(std::memory_order_acquire) != value);
+			while (mValue.load(std::memory_order_acquire) < value);
 		}
 
+		/// Like wait, but uses the given waiter of the calling thread
+		void wait(Int value, Waiter& waiter) {
+			waiter.wait(mValue, mWaiters, [value](Int current) { return current >= value; });
+		}
+
+		Int value() const { return mValue.load(std::memory_order_acquire); }
+
 	private:
 		std::atomic<Int> mValue;
+		/// Number of threads blocked on the value
+		std::atomic<Int> mWaiters;
 	};
 }
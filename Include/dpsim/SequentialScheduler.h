@@ -21,7 +21,9 @@ namespace DPsim {
 		SequentialScheduler(String outMeasurementFile = String(),
 			CPS::Logger::Level logLevel = CPS::Logger::Level::info)
 			: Scheduler(logLevel),
-			mOutMeasurementFile(outMeasurementFile) { }
+			mOutMeasurementFile(outMeasurementFile) {
+			mMeasureTaskTimes = !outMeasurementFile.empty();
+		}
 
 		void createSchedule(const CPS::Task::List& tasks, const Edges& inEdges, const Edges& outEdges);
 		void step(Real time, Int timeStepCount);
@@ -8,11 +8,13 @@
 
 #pragma once
 
+#include <map>
 #include <vector>
 
 #include <dpsim/Config.h>
 #include <dpsim/DataLogger.h>
 #include <dpsim/Solver.h>
+#include <dpsim/MNASolver.h>
 #include <dpsim/Scheduler.h>
 #include <dpsim/Event.h>
 #include <cps/Definitions.h>
@@ -52,8 +54,20 @@ namespace DPsim {
 		// #### Logging ####
 		/// Simulation log level
 		CPS::Logger::Level mLogLevel;
-		/// (Real) time needed for the timesteps
+		/// (Real) time needed for the timesteps, only recorded if enabled
 		std::vector<Real> mStepTimes;
+		/// Record the time of every step in mStepTimes
+		Bool mRecordStepTimes = false;
+		/// Distribution of the step times with a fixed memory footprint
+		TaskStatistics mStepTimeStatistics;
+		/// Measure the task times to find the task that caused an overrun
+		Bool mOverrunAnalysis = false;
+		/// Number of overruns per task that exceeded its mean the most
+		std::map<String, UInt> mOverrunTasks;
+		/// Fail the step if a task allocates heap memory
+		Bool mAllocationCheck = false;
+		/// Number of steps that may allocate before the check starts
+		Int mAllocationCheckWarmup = 1;
 
 		// #### Solver Settings ####
 		///
@@ -66,6 +80,26 @@ namespace DPsim {
 		Bool mPowerFlowInit = false;
 		/// Enable recomputation of system matrix during simulation
 		Bool mSystemMatrixRecomputation = false;
+		/// Ordering of the nodes before matrix indices are assigned
+		NodeOrdering::Method mNodeOrdering = NodeOrdering::Method::Natural;
+		/// Handle changes of switches and variable components as low-rank
+		/// corrections of the factorized system matrix
+		Bool mLowRankSystemUpdates = false;
+		/// Maximum rank of the low-rank correction before refactorizing
+		UInt mMaxCorrectionRank = 8;
+		/// Compute switch state dependent system matrices on first use
+		Bool mLazySwitchedSystems = false;
+		/// Maximum number of cached switch state dependent system matrices
+		UInt mSwitchedSystemCacheSize = 32;
+		/// Execute inductors, capacitors and resistors in batches
+		Bool mBatchedComponents = false;
+		/// Use sparse right side vector stamps of the components in MNA solvers
+		Bool mSparseRightVector = true;
+		/// Switch states whose system matrices are computed during initialization
+		std::vector< std::bitset<SWITCH_NUM> > mExpectedSwitchStates;
+		/// Keep one ARKode integrator per ODE solver and reinitialize it in
+		/// each step instead of recreating it
+		Bool mPersistentODEIntegrator = false;
 
 		/// Determines if the network should be split
 		/// into subnetworks at decoupling lines.
@@ -138,6 +172,8 @@ namespace DPsim {
 		void createMNASolver();
 		/// Prepare schedule for simulation
 		void prepSchedule();
+		/// Throw an AllocationException if a task allocated in the last step
+		void checkAllocations();
 
 	public:
 		/// Simulation logger
@@ -187,6 +223,34 @@ namespace DPsim {
 		void doFrequencyParallelization(Bool value) { mFreqParallel = value; }
 		///
 		void doSystemMatrixRecomputation(Bool value) { mSystemMatrixRecomputation = value; }
+		/// Reorder the nodes to reduce the fill-in and bandwidth of the system matrices
+		void setNodeOrdering(NodeOrdering::Method ordering) { mNodeOrdering = ordering; }
+		/// Apply changes of switches and variable components as low-rank corrections
+		/// and only refactorize the system matrix if the rank exceeds maxRank
+		void doLowRankSystemUpdates(Bool value, UInt maxRank = 8) {
+			mLowRankSystemUpdates = value;
+			mMaxCorrectionRank = maxRank;
+		}
+		/// Compute system matrices only for switch states that occur and cache
+		/// the most recently used ones instead of precomputing all switch states
+		void doLazySwitchedSystems(Bool value, UInt cacheSize = 32) {
+			mLazySwitchedSystems = value;
+			mSwitchedSystemCacheSize = cacheSize;
+		}
+		/// Update the states of single frequency DP inductors, capacitors and
+		/// resistors in one task per solver instead of tasks per component
+		void doBatchedComponents(Bool value) { mBatchedComponents = value; }
+		/// Let components that support it stamp their right side vector
+		/// contribution into a sparse vector, enabled by default. The
+		/// "right_vector" attributes of these components are then empty, so
+		/// disable it to read or log them.
+		void doSparseRightVector(Bool value) { mSparseRightVector = value; }
+		/// Reuse the ARKode integrator of ODE solvers across time steps
+		void doPersistentODEIntegrator(Bool value) { mPersistentODEIntegrator = value; }
+		/// Add a switch state that is computed during initialization in lazy mode
+		void addExpectedSwitchState(std::bitset<SWITCH_NUM> state) {
+			mExpectedSwitchStates.push_back(state);
+		}
 
 		// #### Initialization ####
 		/// activate steady state initialization
@@ -218,8 +282,28 @@ namespace DPsim {
 		void addLogger(DataLogger::Ptr logger) {
 			mLoggers.push_back(logger);
 		}
-		/// Write step time measurements to log file
+		/// Keep the time of every step in addition to the step time statistics
+		void doStepTimeRecording(Bool value) { mRecordStepTimes = value; }
+		/// Write the recorded step times to a log file and the step time
+		/// statistics to the simulation log
 		void logStepTimes(String logName);
+		/// Measure the task execution times in each step, so that overruns
+		/// can be attributed to a task. Must be set before initialization.
+		void doOverrunAnalysis(Bool value) { mOverrunAnalysis = value; }
+		/// Count the task that exceeded its mean execution time the most in
+		/// the last step as the cause of an overrun. Only tasks that were
+		/// executed in the last step are considered.
+		void recordOverrun();
+		/// Count the heap allocations of the tasks and throw an
+		/// AllocationException from step if a task allocated after the first
+		/// warmupSteps steps. Requires a build with WITH_ALLOCATION_TRACKING,
+		/// otherwise initialization throws a SystemError. Must be set before
+		/// initialization. Pipelined outputs are waited for after each step,
+		/// so that they are checked in their own step.
+		void doAllocationCheck(Bool value, Int warmupSteps = 1) {
+			mAllocationCheck = value;
+			mAllocationCheckWarmup = warmupSteps;
+		}
 
 #ifdef WITH_SHMEM
 		///
@@ -242,6 +326,9 @@ namespace DPsim {
 		Real timeStep() const { return mTimeStep; }
 		DataLogger::List& loggers() { return mLoggers; }
 		std::shared_ptr<Scheduler> scheduler() { return mScheduler; }
+		Solver::List& solvers() { return mSolvers; }
 		std::vector<Real>& stepTimes() { return mStepTimes; }
+		const TaskStatistics& stepTimeStatistics() const { return mStepTimeStatistics; }
+		const std::map<String, UInt>& overrunTasks() const { return mOverrunTasks; }
 	};
 }
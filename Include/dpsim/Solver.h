@@ -14,6 +14,7 @@
 
 #include <dpsim/Definitions.h>
 #include <dpsim/Config.h>
+#include <dpsim/NodeOrdering.h>
 #include <cps/Logger.h>
 #include <cps/SystemTopology.h>
 #include <cps/Task.h>
@@ -38,6 +39,8 @@ namespace DPsim {
 		Real mTimeStep;
 		/// Activates parallelized computation of frequencies
 		Bool mFrequencyParallel = false;
+		/// Ordering of the nodes before matrix indices are assigned
+		NodeOrdering::Method mNodeOrdering = NodeOrdering::Method::Natural;
 
 		// #### Initialization ####
 		/// steady state initialization time limit
@@ -77,6 +80,10 @@ namespace DPsim {
 		void doFrequencyParallelization(Bool freqParallel) {
 			mFrequencyParallel = freqParallel;
 		}
+		/// Reorder the nodes to reduce the fill-in and bandwidth of the system matrix
+		void setNodeOrdering(NodeOrdering::Method ordering) {
+			mNodeOrdering = ordering;
+		}
 		///
 		virtual void setSystem(CPS::SystemTopology system) {}
 
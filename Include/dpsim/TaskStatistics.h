@@ -0,0 +1,88 @@
+/* Copyright 2017-2020 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+
+#include <dpsim/Definitions.h>
+
+namespace DPsim {
+	/// Histogram of durations in nanoseconds with a fixed number of buckets
+	/// (HDR histogram).
+	///
+	/// Values below 2^SubBucketBits are counted exactly. Above, each power of
+	/// two is split into 2^SubBucketBits buckets, so the relative error of a
+	/// quantile is below 2^-SubBucketBits. Values from 2^MaxExponent ns on
+	/// (about 18 minutes) are counted in the last bucket.
+	class LatencyHistogram {
+	public:
+		static constexpr UInt SubBucketBits = 5;
+		static constexpr UInt MaxExponent = 40;
+		static constexpr UInt NumBuckets = (MaxExponent - SubBucketBits + 1) << SubBucketBits;
+
+		LatencyHistogram() { reset(); }
+
+		void reset();
+		void add(std::uint64_t value) { mCounts[bucketIndex(value)]++; }
+
+		/// Number of values in each bucket
+		const std::array<std::uint64_t, NumBuckets>& counts() const { return mCounts; }
+		/// Highest value of the bucket that contains the given quantile (0 to 1)
+		/// of count values
+		std::uint64_t quantile(Real q, std::uint64_t count) const;
+
+		static UInt bucketIndex(std::uint64_t value);
+		/// Highest value that is counted in the given bucket
+		static std::uint64_t bucketUpperBound(UInt idx);
+
+	private:
+		std::array<std::uint64_t, NumBuckets> mCounts;
+	};
+
+	/// Execution time statistics of a task with a fixed memory footprint.
+	/// All values are accumulated in nanoseconds.
+	///
+	/// A statistics object is not synchronized. Each object must only be
+	/// updated by one thread at a time, e.g. by the thread that executes the
+	/// task in the current step.
+	class TaskStatistics {
+	public:
+		typedef std::chrono::steady_clock::duration Duration;
+
+		TaskStatistics() { reset(); }
+
+		void reset();
+		void add(Duration time);
+
+		std::uint64_t count() const { return mCount; }
+		Duration mean() const;
+		/// Sample variance in squared nanoseconds
+		Real variance() const;
+		Real stddev() const;
+		Duration min() const;
+		Duration max() const;
+		/// Most recently added value
+		Duration last() const;
+		/// Quantile (0 to 1) with the resolution of the histogram, at most max()
+		Duration quantile(Real q) const;
+		const LatencyHistogram& histogram() const { return mHistogram; }
+
+	private:
+		std::uint64_t mCount;
+		/// Running mean and sum of squared deviations (Welford)
+		Real mMean;
+		Real mM2;
+		std::int64_t mMin;
+		std::int64_t mMax;
+		std::int64_t mLast;
+		LatencyHistogram mHistogram;
+	};
+}
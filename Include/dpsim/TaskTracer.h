@@ -0,0 +1,64 @@
+/* Copyright 2017-2020 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <dpsim/Definitions.h>
+#include <cps/Task.h>
+
+namespace DPsim {
+	/// Records the task executions of each scheduler thread.
+	///
+	/// Each thread writes into its own preallocated ring buffer, so recording
+	/// needs neither locks nor allocations. If a buffer is full, the oldest
+	/// events of the thread are overwritten. The buffers must only be read
+	/// after the threads have finished, e.g. when the scheduler is stopped.
+	class TaskTracer {
+	public:
+		typedef std::chrono::steady_clock::time_point TimePoint;
+
+		/// Trace event of a task execution
+		struct Event {
+			CPS::Task* task;
+			TimePoint start;
+			TimePoint end;
+			Int timeStepCount;
+		};
+
+		TaskTracer(Int threads, UInt eventsPerThread);
+
+		/// Must only be called by the given thread
+		void record(Int thread, CPS::Task* task, TimePoint start, TimePoint end, Int timeStepCount) {
+			ThreadBuffer& buffer = *mBuffers[thread];
+			buffer.events[buffer.count & mMask] = { task, start, end, timeStepCount };
+			buffer.count++;
+		}
+
+		/// Write the events in the Chrome trace event format (JSON), which can
+		/// be opened in chrome://tracing and the Perfetto UI. Each scheduler
+		/// thread is shown as a separate thread with one slice per task.
+		void writeChromeTrace(String filename) const;
+
+	private:
+		struct ThreadBuffer {
+			std::vector<Event> events;
+			/// Number of recorded events, including overwritten ones
+			std::uint64_t count = 0;
+		};
+
+		std::vector<std::unique_ptr<ThreadBuffer>> mBuffers;
+		UInt mMask;
+		/// Time of the creation, which is the origin of the trace
+		TimePoint mStart;
+	};
+}
@@ -0,0 +1,55 @@
+/* Copyright 2017-2020 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#pragma once
+
+#include <dpsim/ThreadScheduler.h>
+
+namespace DPsim {
+	/// Critical path list scheduler that accounts for the cost of
+	/// synchronization between threads.
+	///
+	/// Ready tasks are scheduled in the order of their bottom level, i.e. the
+	/// longest path to the end of the step including the synchronization costs.
+	/// Each task is placed on the thread where it can start first. A dependency
+	/// on a task of another thread delays the start by the synchronization cost.
+	/// Moving a task away from the thread of other tasks of the same component
+	/// (e.g. pre-step and post-step) is penalized by the same cost to keep the
+	/// component state in the cache of one core.
+	///
+	/// The costs are read from the input measurement file, otherwise each task
+	/// has a cost of 1. The synchronization cost is given in the same unit.
+	class ThreadCriticalPathScheduler : public ThreadScheduler {
+	public:
+		ThreadCriticalPathScheduler(Int threads = 1, String outMeasurementFile = String(),
+			String inMeasurementFile = String(), Bool useConditionVariables = false,
+			Real syncCost = 0, ThreadPlacement placement = ThreadPlacement());
+
+		void createSchedule(const CPS::Task::List& tasks, const Edges& inEdges, const Edges& outEdges);
+		void step(Real time, Int timeStepCount);
+		/// Logs the predicted and the measured makespan and appends them to
+		/// the output measurement file as comments:
+		///   # predicted_makespan,value
+		///   # measured_makespan,mean,count,p50,p99,max
+		void stop();
+
+		/// Makespan of the schedule in the unit of the task costs
+		Real predictedMakespan() const { return mPredictedMakespan; }
+		/// Measured duration of the steps
+		const TaskStatistics& measuredMakespan() const { return mMeasuredMakespan; }
+
+	private:
+		/// Component of a task, which is the task name up to the last dot
+		static String componentName(const CPS::Task::Ptr& task);
+
+		String mInMeasurementFile;
+		Real mSyncCost;
+		Real mPredictedMakespan = 0;
+		TaskStatistics mMeasuredMakespan;
+	};
+}
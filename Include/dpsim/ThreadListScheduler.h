@@ -13,7 +13,7 @@
 namespace DPsim {
 	class ThreadListScheduler : public ThreadScheduler {
 	public:
-		ThreadListScheduler(Int threads = 1, String outMeasurementFile = String(), String inMeasurementFile = String(), Bool useConditionVariables = false);
+		ThreadListScheduler(Int threads = 1, String outMeasurementFile = String(), String inMeasurementFile = String(), Bool useConditionVariables = false, ThreadPlacement placement = ThreadPlacement());
 
 		void createSchedule(const CPS::Task::List& tasks, const Edges& inEdges, const Edges& outEdges);
 
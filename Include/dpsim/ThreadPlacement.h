@@ -0,0 +1,100 @@
+/* Copyright 2017-2020 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#pragma once
+
+#include <thread>
+#include <vector>
+
+#include <dpsim/Definitions.h>
+
+namespace DPsim {
+	/// Placement of the threads of a scheduler on the cores of the host,
+	/// optionally with real-time priority and locked memory.
+	///
+	/// The NUMA topology is read from sysfs. Only the cores the process is
+	/// allowed to run on are used. Placement, priority and memory locking
+	/// are only supported on Linux; failures are logged and otherwise
+	/// ignored, e.g. if the process lacks the permission for SCHED_FIFO.
+	class ThreadPlacement {
+	public:
+		enum class Policy {
+			/// The threads are not pinned
+			None,
+			/// Thread i is pinned to the i-th core of the given core list
+			Explicit,
+			/// Threads are pinned to consecutive cores, filling one NUMA node
+			/// after the other
+			Compact,
+			/// Threads are pinned to cores of alternating NUMA nodes
+			Scatter,
+			/// Thread i may run on all cores of the i-th NUMA node
+			NumaNode
+		};
+
+		/// Scheduling state of a thread, used to restore the calling thread
+		struct ThreadState {
+			std::vector<Int> cpus;
+			Int policy = 0;
+			Int priority = 0;
+		};
+
+		ThreadPlacement(Policy policy = Policy::None, std::vector<Int> cores = std::vector<Int>(),
+			Int priority = 0, Bool lockMemory = false);
+
+		/// Threads are pinned to the cores in the given order
+		static ThreadPlacement explicitCores(std::vector<Int> cores) {
+			return ThreadPlacement(Policy::Explicit, cores);
+		}
+
+		/// Set a SCHED_FIFO priority (1 to 99) for the threads. A priority
+		/// of 0 keeps the default scheduling policy. Spinning threads do not
+		/// yield their core, so without a spin budget (see
+		/// ThreadScheduler::setSpinBudget) each thread needs a core of its own.
+		void setPriority(Int priority) { mPriority = priority; }
+		/// Lock all current and future memory of the process (mlockall)
+		/// before the threads are started to avoid page faults.
+		void setLockMemory(Bool value) { mLockMemory = value; }
+
+		Policy policy() const { return mPolicy; }
+		Int priority() const { return mPriority; }
+		Bool lockMemory() const { return mLockMemory; }
+		/// True if the placement changes anything about the threads
+		Bool isDefault() const { return mPolicy == Policy::None && mPriority == 0 && !mLockMemory; }
+
+		/// Cores that each of the given number of threads may run on. An
+		/// empty set means that the thread is not pinned.
+		std::vector<std::vector<Int>> cpuSets(Int threads) const;
+
+		/// Applies a core set from cpuSets and the priority to a thread.
+		/// Returns false if any of the settings failed.
+		Bool apply(std::thread::native_handle_type thread, const std::vector<Int>& cpus) const;
+		Bool applyToCurrentThread(const std::vector<Int>& cpus) const;
+		/// Locks the memory of the process if requested.
+		/// Returns false if locking failed.
+		Bool applyMemoryLock() const;
+
+		static ThreadState currentThreadState();
+		static void restoreCurrentThreadState(const ThreadState& state);
+
+		/// Parses a core list in the format of the Linux cpulist files,
+		/// e.g. "0-3,8,10-11"
+		static std::vector<Int> parseCpuList(const String& list);
+		/// Cores the process may run on
+		static std::vector<Int> allowedCpus();
+		/// Allowed cores of each NUMA node with at least one allowed core.
+		/// Without NUMA information, all cores form a single node.
+		static std::vector<std::vector<Int>> numaNodes();
+
+	private:
+		Policy mPolicy;
+		std::vector<Int> mCores;
+		Int mPriority;
+		Bool mLockMemory;
+	};
+}
@@ -9,31 +9,71 @@
 #pragma once
 
 #include <dpsim/Scheduler.h>
+#include <dpsim/ThreadPlacement.h>
 
+#include <atomic>
+#include <memory>
 #include <thread>
 #include <vector>
 
 namespace DPsim {
 	class ThreadScheduler : public Scheduler {
 	public:
-		ThreadScheduler(Int threads, String outMeasurementFile, Bool useConditionVariable);
+		/// The placement applies to the worker threads and, from the first
+		/// step until stop, to the thread that calls step, which executes the
+		/// schedule of thread 0. The output thread is not placed.
+		ThreadScheduler(Int threads, String outMeasurementFile, Bool useConditionVariable,
+			ThreadPlacement placement = ThreadPlacement());
 		virtual ~ThreadScheduler();
 
 		void step(Real time, Int timeStepCount);
 		virtual void stop();
+		void finishOutputs();
+
+		/// Run the output-only tasks (see CPS::Task::isOutputOnly) on an
+		/// additional thread, so that the outputs of a step overlap with the
+		/// next step. The tasks of the next step that modify the attributes
+		/// read by an output task wait until the output task is done. Must be
+		/// set before the schedule is created.
+		///
+		/// Attributes that are changed between the steps, e.g. by events,
+		/// are not protected.
+		void doPipelineOutputs(Bool value) { mPipelineOutputs = value; }
+
+		/// Time in nanoseconds that the threads spin when waiting for other
+		/// threads before they block (see Waiter). A negative budget spins
+		/// without a limit, which has the lowest latency but keeps all
+		/// threads busy, e.g. between the steps of a real-time simulation.
+		/// Must be set before the schedule is created.
+		void setSpinBudget(Int nanoseconds) { mSpinBudget = nanoseconds; }
+		/// Sum of the wait statistics of all threads. Must only be called
+		/// while no step is running.
+		WaitStatistics waitStatistics() const;
 
 	protected:
 		void finishSchedule(const Edges& inEdges);
 		void scheduleTask(int thread, CPS::Task::Ptr task);
 
 		Int mNumThreads;
+		String mOutMeasurementFile;
 
 	private:
 		void doStep(Int scheduleIdx);
 		static void threadFunction(ThreadScheduler* sched, Int idx);
+		void doOutputs(Int step);
+		static void outputThreadFunction(ThreadScheduler* sched);
 
-		String mOutMeasurementFile;
 		Barrier mStartBarrier;
+		Int mSpinBudget = -1;
+		/// Waiter of each thread, including the output thread
+		std::vector<std::unique_ptr<Waiter>> mWaiters;
+
+		ThreadPlacement mPlacement;
+		/// Cores of each thread according to the placement
+		std::vector<std::vector<Int>> mCpuSets;
+		/// State of the calling thread before it was placed in the first step
+		ThreadPlacement::ThreadState mCallerState;
+		Bool mCallerPlaced = false;
 
 		std::vector<std::thread> mThreads;
 
@@ -42,9 +82,29 @@ namespace DPsim {
 			CPS::Task* task;
 			Counter endCounter;
 			std::vector<Counter*> reqCounters;
+			/// Counters of the output tasks of the previous step that read
+			/// the attributes modified by this task
+			std::vector<Counter*> prevReqCounters;
 		};
 		std::vector<ScheduleEntry*> mSchedules;
 
+		// #### Pipelined output tasks ####
+		Bool mPipelineOutputs = false;
+		CPS::Task::List mTempOutputSchedule;
+		ScheduleEntry* mOutputSchedule = nullptr;
+		std::thread mOutputThread;
+		/// Time and time step count of the last two steps. The output thread
+		/// lags behind by at most one step.
+		struct StepInfo {
+			Real time;
+			Int timeStepCount;
+		};
+		StepInfo mOutputSteps[2];
+		/// Number of steps started by the main thread, which the output
+		/// thread waits for. Stop increments it once more to wake the thread.
+		Counter mStartedSteps;
+		std::atomic<Bool> mStopOutputs { false };
+
 		Bool mJoining = false;
 		Real mTime = 0;
 		Int mTimeStepCount = 0;
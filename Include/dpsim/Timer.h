@@ -62,8 +62,9 @@ namespace DPsim {
 		/// Stop real-time timer
 		void stop();
 
-		/// Suspend thread execution until next tick
-		void sleep();
+		/// Suspend thread execution until next tick.
+		/// Returns the number of ticks that were missed since the last call.
+		uint64_t sleep();
 
 		// Getter
 		const long long& overruns() {
@@ -0,0 +1,110 @@
+/* Copyright 2017-2020 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+#include <dpsim/Definitions.h>
+
+namespace DPsim {
+	/// Counters of the waits of a Waiter
+	struct WaitStatistics {
+		/// Waits for a condition that was already true
+		std::uint64_t immediate = 0;
+		/// Waits that ended while spinning
+		std::uint64_t spinHits = 0;
+		/// Waits that exhausted the spin budget and blocked
+		std::uint64_t blocks = 0;
+
+		void add(const WaitStatistics& other) {
+			immediate += other.immediate;
+			spinHits += other.spinHits;
+			blocks += other.blocks;
+		}
+	};
+
+	/// Waits for a condition on an atomic word by spinning with a pause
+	/// instruction for a limited time and blocking on a futex afterwards.
+	///
+	/// The spin budget is given in nanoseconds and converted to a number of
+	/// pause instructions, which is calibrated once per process. A negative
+	/// budget spins without a limit, a budget of 0 blocks right away.
+	/// Without futexes (i.e. not on Linux), the thread yields instead of
+	/// blocking.
+	///
+	/// Each thread uses its own waiter, so the statistics are not
+	/// synchronized. A word is shared with a count of blocked waiters, which
+	/// the waking thread checks to skip the system call if nobody blocks.
+	class Waiter {
+	public:
+		Waiter(Int spinBudget = -1);
+
+		/// Waits until done(word) is true. The word must be changed with
+		/// memory_order_seq_cst and be followed by wake().
+		template <typename Predicate>
+		void wait(std::atomic<Int>& word, std::atomic<Int>& waiters, Predicate done) {
+			Int value = word.load(std::memory_order_acquire);
+			if (done(value)) {
+				mStatistics.immediate++;
+				return;
+			}
+
+			for (std::int64_t i = 0; mSpinIterations < 0 || i < mSpinIterations; i++) {
+				pause();
+				value = word.load(std::memory_order_acquire);
+				if (done(value)) {
+					mStatistics.spinHits++;
+					return;
+				}
+			}
+
+			mStatistics.blocks++;
+			while (true) {
+				waiters.fetch_add(1, std::memory_order_seq_cst);
+				value = word.load(std::memory_order_seq_cst);
+				if (!done(value))
+					block(word, value);
+				waiters.fetch_sub(1, std::memory_order_relaxed);
+				if (done(word.load(std::memory_order_acquire)))
+					return;
+			}
+		}
+
+		/// Wakes all threads that are blocked on the word
+		static void wake(std::atomic<Int>& word, std::atomic<Int>& waiters) {
+			if (waiters.load(std::memory_order_seq_cst) > 0)
+				wakeAll(word);
+		}
+
+		static void pause() {
+#if defined(__x86_64__) || defined(__i386__)
+			__builtin_ia32_pause();
+#elif defined(__aarch64__)
+			asm volatile("yield");
+#endif
+		}
+
+		/// Number of pause instructions per microsecond
+		static Real pausesPerMicrosecond();
+
+		Int spinBudget() const { return mSpinBudget; }
+		const WaitStatistics& statistics() const { return mStatistics; }
+		void resetStatistics() { mStatistics = WaitStatistics(); }
+
+	private:
+		/// Blocks while the word has the given value, or returns spuriously
+		static void block(std::atomic<Int>& word, Int value);
+		static void wakeAll(std::atomic<Int>& word);
+
+		Int mSpinBudget;
+		std::int64_t mSpinIterations;
+		WaitStatistics mStatistics;
+	};
+}
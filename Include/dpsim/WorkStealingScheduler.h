@@ -0,0 +1,105 @@
+/* Copyright 2017-2020 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#pragma once
+
+#include <dpsim/Scheduler.h>
+#include <dpsim/ThreadPlacement.h>
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace DPsim {
+	/// Dynamic scheduler that executes each task as soon as its dependencies
+	/// are done.
+	///
+	/// The task graph is flattened into index arrays once in createSchedule.
+	/// In each step, the dependency counters are reset, the tasks without
+	/// dependencies are distributed between the threads and every thread
+	/// executes the tasks of its own deque. Tasks that become ready are pushed
+	/// to the deque of the thread that finished their last dependency. Idle
+	/// threads steal tasks from the deques of other threads.
+	class WorkStealingScheduler : public Scheduler {
+	public:
+		/// The calling thread is used as the first of the given threads. If
+		/// pinThreads is set, the additional threads are pinned to one core
+		/// each with the compact ThreadPlacement.
+		WorkStealingScheduler(Int threads = 1, String outMeasurementFile = String(),
+			Bool pinThreads = false);
+		virtual ~WorkStealingScheduler();
+
+		void createSchedule(const CPS::Task::List& tasks, const Edges& inEdges, const Edges& outEdges);
+		void step(Real time, Int timeStepCount);
+		void stop();
+
+	private:
+		/// Lock-free deque of task indices (Chase-Lev). Only the owning thread
+		/// pushes and pops at the bottom, other threads steal from the top.
+		/// Each task is pushed at most once per step, so the capacity is fixed
+		/// to the number of tasks and the deque is reset between steps.
+		class TaskDeque {
+		public:
+			static constexpr Int empty = -1;
+
+			void resize(UInt capacity);
+			void reset();
+			void push(Int task);
+			Int pop();
+			Int steal();
+
+		private:
+			std::unique_ptr<std::atomic<Int>[]> mTasks;
+			UInt mMask = 0;
+			std::atomic<Int> mTop { 0 };
+			/// Keeps the indices written by the owner and the thieves on separate cache lines
+			char mPadding[64];
+			std::atomic<Int> mBottom { 0 };
+		};
+
+		void doStep(Int thread);
+		void executeTask(Int thread, Int task);
+		/// Pushes the successors whose last pending dependency is the given task
+		void releaseSuccessors(Int thread, Int task);
+		static void threadFunction(WorkStealingScheduler* sched, Int idx);
+		/// Stops the additional threads if they are running
+		void joinThreads();
+
+		Int mNumThreads;
+		String mOutMeasurementFile;
+		ThreadPlacement mPlacement;
+
+		// #### Flattened task graph ####
+		/// Tasks in topological order
+		std::vector<CPS::Task*> mTasks;
+		/// Successors of task i are mSuccessors[mSuccessorOffsets[i]] to
+		/// mSuccessors[mSuccessorOffsets[i+1]-1]
+		std::vector<UInt> mSuccessorOffsets;
+		std::vector<Int> mSuccessors;
+		/// Number of dependencies of each task
+		std::vector<Int> mInDegrees;
+		/// Tasks without dependencies
+		std::vector<Int> mRootTasks;
+		/// Tasks that are not executed in every step
+		std::vector<Int> mPeriodicTasks;
+		/// Number of dependencies of each task that are not yet done in this step
+		std::unique_ptr<std::atomic<Int>[]> mPendingDeps;
+		/// Number of tasks that are not yet done in this step
+		std::atomic<Int> mRemainingTasks { 0 };
+
+		std::unique_ptr<TaskDeque[]> mDeques;
+		std::vector<std::thread> mThreads;
+		Barrier mStartBarrier;
+		Barrier mEndBarrier;
+
+		Bool mJoining = false;
+		Real mTime = 0;
+		Int mTimeStepCount = 0;
+	};
+}
@@ -0,0 +1,113 @@
+/* Copyright 2017-2020 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <dpsim/AllocationTracker.h>
+#include <dpsim/Config.h>
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdlib>
+
+#if defined(WITH_ALLOCATION_TRACKING) && defined(__GLIBC__)
+  #define DPSIM_TRACK_ALLOCATIONS
+#endif
+
+using namespace DPsim;
+
+#ifdef DPSIM_TRACK_ALLOCATIONS
+
+// The counter is accessed by malloc itself, so it must not need an
+// allocation on first use, as dynamic TLS of a shared library would.
+static thread_local std::uint64_t allocations __attribute__((tls_model("initial-exec"))) = 0;
+
+// The definitions have to match the noexcept declarations of glibc
+extern "C" {
+	void* __libc_malloc(std::size_t size);
+	void* __libc_calloc(std::size_t count, std::size_t size);
+	void* __libc_realloc(void* ptr, std::size_t size);
+	void* __libc_memalign(std::size_t alignment, std::size_t size);
+	void* __libc_valloc(std::size_t size);
+	void* __libc_pvalloc(std::size_t size);
+
+	void* malloc(std::size_t size) noexcept {
+		allocations++;
+		return __libc_malloc(size);
+	}
+
+	void* calloc(std::size_t count, std::size_t size) noexcept {
+		allocations++;
+		return __libc_calloc(count, size);
+	}
+
+	void* realloc(void* ptr, std::size_t size) noexcept {
+		allocations++;
+		return __libc_realloc(ptr, size);
+	}
+
+	void* memalign(std::size_t alignment, std::size_t size) noexcept {
+		allocations++;
+		return __libc_memalign(alignment, size);
+	}
+
+	void* aligned_alloc(std::size_t alignment, std::size_t size) noexcept {
+		allocations++;
+		return __libc_memalign(alignment, size);
+	}
+
+	int posix_memalign(void** ptr, std::size_t alignment, std::size_t size) noexcept {
+		if (alignment % sizeof(void*) != 0 || (alignment & (alignment - 1)) != 0)
+			return EINVAL;
+		allocations++;
+		void* mem = __libc_memalign(alignment, size);
+		if (!mem && size != 0)
+			return ENOMEM;
+		*ptr = mem;
+		return 0;
+	}
+
+	void* valloc(std::size_t size) noexcept {
+		allocations++;
+		return __libc_valloc(size);
+	}
+
+	void* pvalloc(std::size_t size) noexcept {
+		allocations++;
+		return __libc_pvalloc(size);
+	}
+}
+
+Bool AllocationTracker::available() {
+	// The replacements only take precedence over glibc if the library is
+	// linked into the executable, not if it is loaded with dlopen, e.g. by
+	// Python. So check once that an allocation moves the counter.
+	static const Bool counting = []() {
+		std::uint64_t before = allocations;
+		// Keeps the compiler from removing the allocation
+		void* (*volatile allocate)(std::size_t) = std::malloc;
+		void* mem = allocate(1);
+		std::free(mem);
+		return allocations != before;
+	}();
+	return counting;
+}
+
+std::uint64_t AllocationTracker::threadAllocations() {
+	return allocations;
+}
+
+#else
+
+Bool AllocationTracker::available() {
+	return false;
+}
+
+std::uint64_t AllocationTracker::threadAllocations() {
+	return 0;
+}
+
+#endif
@@ -6,6 +6,8 @@
  * file, You can obtain one at https://mozilla.org/MPL/2.0/.
  *********************************************************************************/
 
+#include <algorithm>
+#include <cstdint>
 #include <iomanip>
 
 #include <dpsim/DataLogger.h>
@@ -20,14 +22,16 @@ DataLogger::DataLogger(Bool enabled) :
 	mLogFile.setstate(std::ios_base::badbit);
 }
 
-DataLogger::DataLogger(String name, Bool enabled, UInt downsampling) :
+DataLogger::DataLogger(String name, Bool enabled, UInt downsampling, Format format) :
 	mName(name),
 	mEnabled(enabled),
-	mDownsampling(downsampling) {
+	mDownsampling(downsampling),
+	mFormat(format) {
 	if (!mEnabled)
 		return;
 
-	mFilename = CPS::Logger::logDir() + "/" + name + ".csv";
+	mFilename = CPS::Logger::logDir() + "/" + name
+		+ (mFormat == Format::Binary ? ".bin" : ".csv");
 
 	if (mFilename.has_parent_path() && !fs::exists(mFilename.parent_path()))
 		fs::create_directory(mFilename.parent_path());
@@ -36,7 +40,15 @@ DataLogger::DataLogger(String name, Bool enabled, UInt downsampling) :
 }
 
 void DataLogger::open() {
-	mLogFile = std::ofstream(mFilename, std::ios_base::out|std::ios_base::trunc);
+	auto mode = std::ios_base::out|std::ios_base::trunc;
+	if (mFormat == Format::Binary)
+		mode |= std::ios_base::binary;
+
+	mStarted = false;
+	mBufferFill = 0;
+	mDroppedRows = 0;
+
+	mLogFile = std::ofstream(mFilename, mode);
 	if (!mLogFile.is_open()) {
 		// TODO: replace by exception
 		std::cerr << "Cannot open log file " << mFilename << std::endl;
@@ -45,9 +57,177 @@ void DataLogger::open() {
 }
 
 void DataLogger::close() {
+	stopWriter();
+	flush();
 	mLogFile.close();
 }
 
+void DataLogger::flush() {
+	if (mBufferFill == 0 || !mLogFile.is_open())
+		return;
+
+	mLogFile.write(reinterpret_cast<const char*>(mBuffer.data()), mBufferFill * sizeof(Real));
+	mBufferFill = 0;
+}
+
+void DataLogger::start() {
+	if (mStarted || !mEnabled)
+		return;
+
+	mColumns.clear();
+	for (auto it : mAttributes) {
+		Column column;
+		column.view = std::dynamic_pointer_cast<CPS::MatrixViewAttribute>(it.second);
+		column.real = std::dynamic_pointer_cast<CPS::Attribute<Real>>(it.second);
+		column.integer = std::dynamic_pointer_cast<CPS::Attribute<Int>>(it.second);
+		if (!column.real && !column.integer)
+			throw CPS::InvalidAttributeException();
+		mColumns.push_back(column);
+	}
+	mRowSize = static_cast<UInt>(mColumns.size() + 1);
+	mRow.resize(mRowSize);
+
+	if (mFormat == Format::Binary) {
+		// The buffer holds a whole number of records
+		UInt numRecords = std::max<UInt>(1, mBufferSize / (mRowSize * sizeof(Real)));
+		mBuffer.resize(numRecords * mRowSize);
+		mBufferFill = 0;
+	}
+
+	writeHeader();
+	mStarted = true;
+
+	if (mAsync) {
+		mRing.resize(static_cast<std::size_t>(mRingCapacity) * mRowSize);
+		mRingHead = 0;
+		mRingTail = 0;
+		mStopWriter = false;
+		mWakeFill = std::max<std::size_t>(1, mRingCapacity / 4);
+		mWriter = std::thread(&DataLogger::runWriter, this);
+	}
+}
+
+void DataLogger::writeHeader() {
+	if (mFormat == Format::CSV) {
+		mLogFile << std::right << std::setw(14) << "time";
+		for (auto it : mAttributes)
+			mLogFile << ", " << std::right << std::setw(13) << it.first;
+		mLogFile << '\n';
+		return;
+	}
+
+	const char magic[8] = { 'D', 'P', 'S', 'I', 'M', 'B', 'I', 'N' };
+	const uint32_t version = 1;
+	const uint32_t numColumns = static_cast<uint32_t>(mRowSize);
+
+	mLogFile.write(magic, sizeof(magic));
+	mLogFile.write(reinterpret_cast<const char*>(&version), sizeof(version));
+	mLogFile.write(reinterpret_cast<const char*>(&numColumns), sizeof(numColumns));
+
+	auto writeName = [this](const String& name) {
+		const uint32_t length = static_cast<uint32_t>(name.size());
+		mLogFile.write(reinterpret_cast<const char*>(&length), sizeof(length));
+		mLogFile.write(name.data(), length);
+	};
+	writeName("time");
+	for (auto it : mAttributes)
+		writeName(it.first);
+}
+
+void DataLogger::readRow(Real time, Real *row) {
+	*row++ = time;
+	for (auto& column : mColumns) {
+		if (column.view)
+			*row++ = column.view->read();
+		else if (column.real)
+			*row++ = column.real->getByValue();
+		else
+			*row++ = static_cast<Real>(column.integer->getByValue());
+	}
+}
+
+void DataLogger::writeRow(const Real *row) {
+	if (mFormat == Format::Binary) {
+		if (mBufferFill + mRowSize > mBuffer.size())
+			flush();
+		std::copy_n(row, mRowSize, mBuffer.data() + mBufferFill);
+		mBufferFill += mRowSize;
+		return;
+	}
+
+	mLogFile << std::scientific << std::right << std::setw(14) << row[0];
+	for (UInt col = 0; col < mColumns.size(); col++) {
+		const Real value = row[col + 1];
+		mLogFile << ", " << std::right << std::setw(13)
+			<< (mColumns[col].integer ? std::to_string(static_cast<Int>(value)) : std::to_string(value));
+	}
+	mLogFile << '\n';
+}
+
+void DataLogger::pushRow(Real time) {
+	std::size_t head = mRingHead.load(std::memory_order_relaxed);
+	auto hasSpace = [this, head](Int) {
+		return head - mRingTail.load(std::memory_order_acquire) < mRingCapacity;
+	};
+
+	if (!hasSpace(0)) {
+		if (mBackPressure != BackPressure::Block) {
+			mDroppedRows++;
+			return;
+		}
+		mLoggerWaiter.wait(mWriteEvents, mWriteWaiters, hasSpace);
+	}
+
+	readRow(time, &mRing[(head % mRingCapacity) * mRowSize]);
+	mRingHead.store(head + 1, std::memory_order_release);
+
+	// A stale tail overestimates the fill, which only causes a spurious wakeup
+	if (head + 1 - mRingTail.load(std::memory_order_acquire) >= mWakeFill) {
+		mPushEvents.fetch_add(1, std::memory_order_seq_cst);
+		Waiter::wake(mPushEvents, mPushWaiters);
+	}
+}
+
+void DataLogger::runWriter() {
+	std::size_t tail = mRingTail.load(std::memory_order_relaxed);
+	auto ready = [this, &tail](Int) {
+		return mRingHead.load(std::memory_order_acquire) - tail >= mWakeFill
+			|| mStopWriter.load(std::memory_order_acquire);
+	};
+
+	while (true) {
+		mWriterWaiter.wait(mPushEvents, mPushWaiters, ready);
+
+		// Rows pushed before the stop request are written before stopping
+		Bool stop = mStopWriter.load(std::memory_order_acquire);
+		std::size_t head = mRingHead.load(std::memory_order_acquire);
+		for (; tail != head; tail++) {
+			writeRow(&mRing[(tail % mRingCapacity) * mRowSize]);
+			mRingTail.store(tail + 1, std::memory_order_release);
+		}
+
+		mWriteEvents.fetch_add(1, std::memory_order_seq_cst);
+		Waiter::wake(mWriteEvents, mWriteWaiters);
+		if (stop)
+			break;
+	}
+}
+
+void DataLogger::stopWriter() {
+	if (!mWriter.joinable())
+		return;
+
+	mStopWriter = true;
+	mPushEvents.fetch_add(1, std::memory_order_seq_cst);
+	Waiter::wake(mPushEvents, mPushWaiters);
+	mWriter.join();
+
+	if (mBackPressure == BackPressure::Report && mDroppedRows > 0) {
+		std::cerr << "Logger " << mName << " dropped " << mDroppedRows
+			<< " rows because the writer could not keep up" << std::endl;
+	}
+}
+
 void DataLogger::setColumnNames(std::vector<String> names) {
 	if (mLogFile.tellp() == std::ofstream::pos_type(0)) {
 		mLogFile << std::right << std::setw(14) << "time";
@@ -128,20 +308,22 @@ void DataLogger::logEMTNodeValues(Real time, const Matrix& data) {
 }
 
 void DataLogger::log(Real time, Int timeStepCount) {
+	// The logger task has the downsampling as its period, but log may also
+	// be called directly
 	if (!mEnabled || !(timeStepCount % mDownsampling == 0))
 		return;
 
-	if (mLogFile.tellp() == std::ofstream::pos_type(0)) {
-		mLogFile << std::right << std::setw(14) << "time";
-		for (auto it : mAttributes)
-			mLogFile << ", " << std::right << std::setw(13) << it.first;
-		mLogFile << '\n';
+	// Loggers that are not added to a simulation are started on first use
+	if (!mStarted)
+		start();
+
+	if (mAsync) {
+		pushRow(time);
+		return;
 	}
 
-	mLogFile << std::scientific << std::right << std::setw(14) << time;
-	for (auto it : mAttributes)
-		mLogFile << ", " << std::right << std::setw(13) << it.second->toString();
-	mLogFile << '\n';
+	readRow(time, mRow.data());
+	writeRow(mRow.data());
 }
 
 void DataLogger::Step::execute(Real time, Int timeStepCount) {
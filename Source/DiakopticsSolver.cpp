@@ -22,9 +22,10 @@ namespace DPsim {
 template <typename VarType>
 DiakopticsSolver<VarType>::DiakopticsSolver(String name,
 	SystemTopology system, IdentifiedObject::List tearComponents,
-	Real timeStep, Logger::Level logLevel) :
+	Real timeStep, Logger::Level logLevel, NodeOrdering::Method nodeOrdering) :
 	Solver(name, logLevel) {
 	mTimeStep = timeStep;
+	mNodeOrdering = nodeOrdering;
 
 	// Raw source and solution vector logging
 	mLeftVectorLog = std::make_shared<DataLogger>(name + "_LeftVector", logLevel != CPS::Logger::Level::off);
@@ -143,8 +144,15 @@ void DiakopticsSolver<VarType>::collectVirtualNodes(int net) {
 
 template <typename VarType>
 void DiakopticsSolver<VarType>::assignMatrixNodeIndices(int net) {
+	typename SimPowerComp<VarType>::List powerComps;
+	for (auto comp : mSubnets[net].components) {
+		auto pComp = std::dynamic_pointer_cast<SimPowerComp<VarType>>(comp);
+		if (pComp) powerComps.push_back(pComp);
+	}
+	std::vector<UInt> nodeOrder = NodeOrdering::compute<VarType>(mNodeOrdering, mSubnets[net].nodes, powerComps, mSLog);
+
 	UInt matrixNodeIndexIdx = 0;
-	for (UInt idx = 0; idx < mSubnets[net].nodes.size(); idx++) {
+	for (UInt idx : nodeOrder) {
 		auto& node = mSubnets[net].nodes[idx];
 
 		node->setMatrixNodeIndex(0, matrixNodeIndexIdx);
@@ -254,10 +262,7 @@ void DiakopticsSolver<VarType>::initComponents() {
 		// Initialize MNA specific parts of components.
 		for (auto comp : mSubnets[net].components) {
 			comp->mnaInitialize(mSystem.mSystemOmega, mTimeStep, mSubnets[net].leftVector);
-			const Matrix& stamp = comp->template attribute<Matrix>("right_vector")->get();
-			if (stamp.size() != 0) {
-				mSubnets[net].rightVectorStamps.push_back(&stamp);
-			}
+			collectRightVectorStamp(mSubnets[net], comp);
 		}
 	}
 	// Initialize signal components.
@@ -265,6 +270,18 @@ void DiakopticsSolver<VarType>::initComponents() {
 		comp->initialize(mSystem.mSystemOmega, mTimeStep);
 }
 
+template <typename VarType>
+void DiakopticsSolver<VarType>::collectRightVectorStamp(Subnet& net, const CPS::MNAInterface::Ptr& comp) {
+	const Matrix& stamp = comp->template attribute<Matrix>("right_vector")->get();
+	if (stamp.size() != 0)
+		net.rightVectorStamps.push_back(&stamp);
+	if (stamp.size() != 0 || !comp->mnaSubComponents().empty())
+		net.rightVectorAttributes.push_back(comp->attribute("right_vector"));
+
+	for (auto subComp : comp->mnaSubComponents())
+		collectRightVectorStamp(net, subComp);
+}
+
 template <typename VarType>
 void DiakopticsSolver<VarType>::initMatrices() {
 	for (auto& net : mSubnets) {
@@ -145,13 +145,11 @@ void InterfaceShmem::writeValues() {
 }
 
 void InterfaceShmem::PreStep::execute(Real time, Int timeStepCount) {
-	if (timeStepCount % mIntf.mDownsampling == 0)
-		mIntf.readValues(mIntf.mSync);
+	mIntf.readValues(mIntf.mSync);
 }
 
 void InterfaceShmem::PostStep::execute(Real time, Int timeStepCount) {
-	if (timeStepCount % mIntf.mDownsampling == 0)
-		mIntf.writeValues();
+	mIntf.writeValues();
 }
 
 Attribute<Int>::Ptr InterfaceShmem::importInt(UInt idx) {
@@ -243,6 +241,21 @@ void InterfaceShmem::exportInt(Attribute<Int>::Ptr attr, UInt idx) {
 }
 
 void InterfaceShmem::exportReal(Attribute<Real>::Ptr attr, UInt idx) {
+	// Matrix coefficients are read directly from the matrix storage
+	auto view = std::dynamic_pointer_cast<MatrixViewAttribute>(attr);
+	if (view) {
+		addExport([view, idx](Sample *smp) {
+			if (idx >= smp->capacity)
+				throw std::out_of_range("not enough space in allocated sample");
+			if (idx >= smp->length)
+				smp->length = idx + 1;
+
+			smp->data[idx].f = view->read();
+		});
+		mExportAttrs.push_back(attr);
+		return;
+	}
+
 	addExport([attr, idx](Sample *smp) {
 		if (idx >= smp->capacity)
 			throw std::out_of_range("not enough space in allocated sample");
@@ -0,0 +1,79 @@
+/* Copyright 2017-2020 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <dpsim/LUSolveWorkspace.h>
+
+using namespace DPsim;
+
+// The forward substitution below depends on the internals of SparseLU and has
+// only been verified for Eigen 3.4. Other versions use SparseLU::solve, which
+// gives correct results but allocates on every call.
+#if EIGEN_VERSION_AT_LEAST(3,4,0) && !EIGEN_VERSION_AT_LEAST(3,5,0)
+#define WITH_LU_SOLVE_WORKSPACE
+#endif
+
+void LUSolveWorkspace::solve(const CPS::LUFactorizedSparse& lu, const Matrix& b, Matrix& x) {
+#ifndef WITH_LU_SOLVE_WORKSPACE
+	x = lu.solve(b);
+#else
+	typedef CPS::LUFactorizedSparse::SCMatrix SupernodalMatrix;
+	typedef Eigen::Map<const Matrix, 0, Eigen::OuterStride<>> ConstBlock;
+	typedef Eigen::Map<Matrix, 0, Eigen::OuterStride<>> Block;
+
+	const Matrix::Index n = b.rows();
+	if (mPermuted.rows() != n) {
+		mPermuted.resize(n, 1);
+		mWork = Matrix::Zero(n, 1);
+	}
+	mPermuted = lu.rowsPermutation() * b;
+
+	// Forward substitution with the supernodal L, as in
+	// MappedSuperNodalMatrix::solveInPlace of Eigen 3.4
+	// (Eigen/src/SparseLU/SparseLU_SupernodalMatrix.h) but with mWork.
+	// Only extend the version range above after LU_Solve_Workspace checked
+	// that the solutions are bitwise identical to SparseLU::solve.
+	const SupernodalMatrix& L = lu.matrixL().m_mapL;
+	const Real* values = L.valuePtr();
+	Real* v = mPermuted.data();
+	for (Matrix::Index k = 0; k <= L.nsuper(); k++) {
+		const Matrix::Index fsupc = L.supToCol()[k];
+		const Matrix::Index istart = L.rowIndexPtr()[fsupc];
+		const Matrix::Index nsupr = L.rowIndexPtr()[fsupc + 1] - istart;
+		const Matrix::Index nsupc = L.supToCol()[k + 1] - fsupc;
+		const Matrix::Index nrow = nsupr - nsupc;
+
+		if (nsupc == 1) {
+			SupernodalMatrix::InnerIterator it(L, fsupc);
+			// Skip the diagonal element
+			++it;
+			for (; it; ++it)
+				v[it.row()] -= v[fsupc] * it.value();
+		}
+		else {
+			const Matrix::Index luptr = L.colIndexPtr()[fsupc];
+			const Matrix::Index lda = L.colIndexPtr()[fsupc + 1] - luptr;
+
+			ConstBlock diag(&values[luptr], nsupc, nsupc, Eigen::OuterStride<>(lda));
+			Block u(&v[fsupc], nsupc, 1, Eigen::OuterStride<>(n));
+			u = diag.triangularView<Eigen::UnitLower>().solve(u);
+
+			ConstBlock offDiag(&values[luptr + nsupc], nrow, nsupc, Eigen::OuterStride<>(lda));
+			mWork.topRows(nrow).noalias() = offDiag * u;
+
+			Matrix::Index iptr = istart + nsupc;
+			for (Matrix::Index i = 0; i < nrow; i++, iptr++) {
+				v[L.rowIndex()[iptr]] -= mWork(i, 0);
+				mWork(i, 0) = 0;
+			}
+		}
+	}
+
+	lu.matrixU().solveInPlace(mPermuted);
+	x = lu.colsPermutation().inverse() * mPermuted;
+#endif
+}
@@ -9,6 +9,7 @@
 
 #include <dpsim/MNASolver.h>
 #include <dpsim/SequentialScheduler.h>
+#include <cps/DP/DP_Ph1_PassiveBatch.h>
 
 using namespace DPsim;
 using namespace CPS;
@@ -22,6 +23,25 @@ MnaSolver<VarType>::MnaSolver(String name, CPS::Domain domain, CPS::Logger::Leve
 	// Raw source and solution vector logging
 	mLeftVectorLog = std::make_shared<DataLogger>(name + "_LeftVector", logLevel != CPS::Logger::Level::off);
 	mRightVectorLog = std::make_shared<DataLogger>(name + "_RightVector", logLevel != CPS::Logger::Level::off);
+
+	addAttribute<Int>("switch_cache_size", &mSwitchedSystemCacheEntries, Flags::read);
+	addAttribute<Int>("switch_cache_hits", &mSwitchedSystemCacheHits, Flags::read);
+	addAttribute<Int>("switch_cache_misses", &mSwitchedSystemCacheMisses, Flags::read);
+}
+
+template <typename VarType>
+void MnaSolver<VarType>::doLazySwitchedSystems(Bool value, UInt cacheSize) {
+	if (cacheSize < 1)
+		throw SystemError("Switched system cache needs to hold at least one system matrix.");
+
+	mLazySwitchedSystems = value;
+	mSwitchedSystemCacheSize = cacheSize;
+}
+
+template <typename VarType>
+Real MnaSolver<VarType>::switchedSystemCacheHitRate() const {
+	Int lookups = mSwitchedSystemCacheHits + mSwitchedSystemCacheMisses;
+	return lookups > 0 ? static_cast<Real>(mSwitchedSystemCacheHits) / lookups : 0;
 }
 
 template <typename VarType>
@@ -45,6 +65,19 @@ void MnaSolver<VarType>::initialize() {
 	// We need to differentiate between power and signal components and
 	// ground nodes should be ignored.
 	identifyTopologyObjects();
+	if (mLazySwitchedSystems && (mSwitches.size() == 0 || mFrequencyParallel)) {
+		mSLog->info("Lazy switched system computation is only used for systems with switches "
+			"and without frequency parallelization.");
+		mLazySwitchedSystems = false;
+	}
+	if (mBatchedComponents && mDomain != CPS::Domain::DP) {
+		mSLog->info("Batched components are only used in the DP domain.");
+		mBatchedComponents = false;
+	}
+	if (mBatchedComponents && (mFrequencyParallel || mSystem.mFrequencies.size() > 1)) {
+		mSLog->info("Batched components are only used for a single frequency.");
+		mBatchedComponents = false;
+	}
 	// These steps complete the network information.
 	collectVirtualNodes();
 	assignMatrixNodeIndices();
@@ -94,6 +127,24 @@ void MnaSolver<VarType>::initialize() {
 	mSLog->flush();
 }
 
+template <>
+void MnaSolver<Complex>::batchComponents() {
+	auto batch = DP::Ph1::PassiveBatch::make(mName + ".PassiveBatch");
+	CPS::MNAInterface::List unbatched;
+	for (auto comp : mMNAComponents) {
+		if (!batch->add(comp))
+			unbatched.push_back(comp);
+	}
+	if (batch->size() == 0)
+		return;
+
+	batch->mnaInitialize(mSystem.mSystemOmega, mTimeStep, attribute<Matrix>("left_vector"));
+	unbatched.push_back(batch);
+	mMNAComponents = unbatched;
+	mSLog->info("Batched {:d} inductors, {:d} capacitors and {:d} resistors",
+		batch->numInductors(), batch->numCapacitors(), batch->numResistors());
+}
+
 template <>
 void MnaSolver<Real>::initializeComponents() {
 	mSLog->info("-- Initialize components from power flow");
@@ -110,14 +161,17 @@ void MnaSolver<Real>::initializeComponents() {
 
 	// Initialize MNA specific parts of components.
 	for (auto comp : mMNAComponents) {
+		comp->mnaSetSparseRightVector(mSparseRightVector);
 		comp->mnaInitialize(mSystem.mSystemOmega, mTimeStep, attribute<Matrix>("left_vector"));
-		const Matrix& stamp = comp->template attribute<Matrix>("right_vector")->get();
-		if (stamp.size() != 0) {
-			mRightVectorStamps.push_back(&stamp);
-		}
+		collectRightVectorStamp(comp);
 	}
-	for (auto comp : mSwitches)
+	// Switches can be composites with storage elements, e.g. RXLoadSwitch,
+	// whose subcomponents have right side vector stamps
+	for (auto comp : mMNAIntfSwitches) {
+		comp->mnaSetSparseRightVector(mSparseRightVector);
 		comp->mnaInitialize(mSystem.mSystemOmega, mTimeStep, attribute<Matrix>("left_vector"));
+		collectRightVectorStamp(comp);
+	}
 }
 
 template <>
@@ -138,13 +192,15 @@ void MnaSolver<Complex>::initializeComponents() {
 
 	mSLog->info("-- Initialize MNA properties of components");
 	if (mFrequencyParallel) {
+		mRightVectorAttributesHarm.resize(mSystem.mFrequencies.size());
 		// Initialize MNA specific parts of components.
 		for (auto comp : mMNAComponents) {
 			// Initialize MNA specific parts of components.
 			comp->mnaInitializeHarm(mSystem.mSystemOmega, mTimeStep, mLeftVectorHarmAttributes);
-			const Matrix& stamp = comp->template attribute<Matrix>("right_vector")->get();
-			if (stamp.size() != 0) mRightVectorStamps.push_back(&stamp);
+			collectRightVectorStampHarm(comp);
 		}
+		for (auto comp : mSwitches)
+			comp->mnaInitializeHarm(mSystem.mSystemOmega, mTimeStep, mLeftVectorHarmAttributes);
 		// Initialize nodes
 		for (UInt nodeIdx = 0; nodeIdx < mNodes.size(); nodeIdx++) {
 			mNodes[nodeIdx]->mnaInitializeHarm(mLeftVectorHarmAttributes);
@@ -153,17 +209,69 @@ void MnaSolver<Complex>::initializeComponents() {
 	else {
 		// Initialize MNA specific parts of components.
 		for (auto comp : mMNAComponents) {
+			comp->mnaSetSparseRightVector(mSparseRightVector);
 			comp->mnaInitialize(mSystem.mSystemOmega, mTimeStep, attribute<Matrix>("left_vector"));
-			const Matrix& stamp = comp->template attribute<Matrix>("right_vector")->get();
-			if (stamp.size() != 0) {
-				mRightVectorStamps.push_back(&stamp);
-			}
 		}
-		for (auto comp : mSwitches)
+		// The batches take over the state of initialized components
+		if (mBatchedComponents)
+			batchComponents();
+		for (auto comp : mMNAComponents)
+			collectRightVectorStamp(comp);
+		// Switches can be composites with storage elements, e.g.
+		// RXLoadSwitch, whose subcomponents have right side vector stamps
+		for (auto comp : mMNAIntfSwitches) {
+			comp->mnaSetSparseRightVector(mSparseRightVector);
 			comp->mnaInitialize(mSystem.mSystemOmega, mTimeStep, attribute<Matrix>("left_vector"));
+			collectRightVectorStamp(comp);
+		}
 	}
 }
 
+template <typename VarType>
+void MnaSolver<VarType>::collectRightVectorStamp(const CPS::MNAInterface::Ptr& comp) {
+	const Matrix& stamp = comp->template attribute<Matrix>("right_vector")->get();
+	if (stamp.size() != 0)
+		mRightVectorStamps.push_back(&stamp);
+	else if (comp->mnaHasSparseRightVector())
+		mRightVectorStampsSparse.push_back(&comp->mnaRightVectorSparse());
+
+	// A composite component without a stamp of its own may still update its
+	// subcomponents in its pre-step, which has to finish before the solve
+	if (stamp.size() != 0 || comp->mnaHasSparseRightVector() || !comp->mnaSubComponents().empty())
+		mRightVectorAttributes.push_back(comp->attribute("right_vector"));
+
+	for (auto subComp : comp->mnaSubComponents())
+		collectRightVectorStamp(subComp);
+}
+
+template <typename VarType>
+void MnaSolver<VarType>::collectRightVectorStampHarm(const CPS::MNAInterface::Ptr& comp) {
+	const Matrix& stamp = comp->template attribute<Matrix>("right_vector")->get();
+	if (stamp.size() != 0)
+		mRightVectorStamps.push_back(&stamp);
+
+	// Components with one pre-step per frequency provide an attribute for
+	// each column of their stamp, the others update all columns at once
+	if (stamp.size() != 0 || !comp->mnaSubComponents().empty()) {
+		const auto& harmAttributes = comp->mnaRightVectorHarmAttributes();
+		for (UInt freq = 0; freq < mRightVectorAttributesHarm.size(); freq++)
+			mRightVectorAttributesHarm[freq].push_back(harmAttributes.empty()
+				? comp->attribute("right_vector") : harmAttributes[freq]);
+	}
+
+	for (auto subComp : comp->mnaSubComponents())
+		collectRightVectorStampHarm(subComp);
+}
+
+template <typename VarType>
+void MnaSolver<VarType>::assembleRightSideVector() {
+	mRightSideVector.setZero();
+	for (auto stamp : mRightVectorStamps)
+		mRightSideVector += *stamp;
+	for (auto stamp : mRightVectorStampsSparse)
+		mRightSideVector += *stamp;
+}
+
 template <typename VarType>
 void MnaSolver<VarType>::initializeSystem() {
 	mSLog->info("-- Initialize MNA system matrices and source vector");
@@ -183,22 +291,52 @@ void MnaSolver<VarType>::initializeSystem() {
 
 template <typename VarType>
 void MnaSolver<VarType>::initializeSystemWithParallelFrequencies() {
-	// iterate over all possible switch state combinations
-	for (std::size_t i = 0; i < (1ULL << mSwitches.size()); i++) {
-		for(Int freq = 0; freq < mSystem.mFrequencies.size(); freq++)
-			mSwitchedMatricesHarm[std::bitset<SWITCH_NUM>(i)][freq].setZero();
+	Int numFreqs = static_cast<Int>(mSystem.mFrequencies.size());
+	Int numSystems = static_cast<Int>(1ULL << mSwitches.size());
+
+	// Stamp the systems of all switch state combinations and frequencies
+	for (Int i = 0; i < numSystems; i++) {
+		std::bitset<SWITCH_NUM> status(i);
+		// Sparse LU factorizations are neither copyable nor movable
+		mLuFactorizationsHarm.emplace(std::piecewise_construct,
+			std::forward_as_tuple(status), std::forward_as_tuple(numFreqs));
+
+		for (Int freq = 0; freq < numFreqs; freq++) {
+			Matrix sys = Matrix::Zero(2*mNumMatrixNodeIndices, 2*mNumMatrixNodeIndices);
+			for (auto comp : mMNAComponents)
+				comp->mnaApplySystemMatrixStampHarm(sys, freq);
+			for (UInt sw = 0; sw < mSwitches.size(); sw++)
+				mSwitches[sw]->mnaApplySwitchSystemMatrixStampHarm(sys, status[sw], freq);
+#ifdef WITH_SPARSE
+			mSwitchedMatricesHarm[status][freq] = sys.sparseView();
+#else
+			mSwitchedMatricesHarm[status][freq] = sys;
+#endif
+		}
 	}
 
-	for(Int freq = 0; freq < mSystem.mFrequencies.size(); freq++) {
-		// Create system matrix if no switches were added
-		// TODO add case for switches and possibly merge with no harmonics
-		for (auto comp : mMNAComponents)
-			comp->mnaApplySystemMatrixStampHarm(mSwitchedMatricesHarm[std::bitset<SWITCH_NUM>(0)][freq], freq);
+	// The factorizations are independent of each other
+#ifdef WITH_OPENMP
+	#pragma omp parallel for schedule(dynamic)
+#endif
+	for (Int idx = 0; idx < numSystems * numFreqs; idx++) {
+		std::bitset<SWITCH_NUM> status(idx / numFreqs);
+		Int freq = idx % numFreqs;
+		auto& sys = mSwitchedMatricesHarm.at(status)[freq];
+		auto& lu = mLuFactorizationsHarm.at(status)[freq];
+#ifdef WITH_SPARSE
+		lu.analyzePattern(sys);
+		lu.factorize(sys);
+#else
+		lu.compute(sys);
+#endif
+	}
 
-		mLuFactorizationsHarm[std::bitset<SWITCH_NUM>(0)].push_back(
-			Eigen::PartialPivLU<Matrix>(mSwitchedMatricesHarm[std::bitset<SWITCH_NUM>(0)][freq]));
+	updateSwitchStatus();
+	mCurrentSwitchStatusHarm.assign(numFreqs, mCurrentSwitchStatus);
 
-		// Initialize source vector
+	// Initialize source vector
+	for (Int freq = 0; freq < numFreqs; freq++) {
 		for (auto comp : mMNAComponents)
 			comp->mnaApplyRightSideVectorStampHarm(mRightSideVectorHarm[freq], freq);
 	}
@@ -206,10 +344,9 @@ void MnaSolver<VarType>::initializeSystemWithParallelFrequencies() {
 
 template <typename VarType>
 void MnaSolver<VarType>::initializeSystemWithPrecomputedMatrices() {
-	// iterate over all possible switch state combinations
-	for (std::size_t i = 0; i < (1ULL << mSwitches.size()); i++) {
-		mSwitchedMatrices[std::bitset<SWITCH_NUM>(i)].setZero();
-	}
+	// iterate over all created switch state combinations
+	for (auto& sys : mSwitchedMatrices)
+		sys.second.setZero();
 
 	if (mSwitches.size() < 1) {
 		// Create system matrix if no switches were added
@@ -230,21 +367,33 @@ void MnaSolver<VarType>::initializeSystemWithPrecomputedMatrices() {
 		mLuFactorizations[std::bitset<SWITCH_NUM>(0)] = Eigen::PartialPivLU<Matrix>(mSwitchedMatrices[std::bitset<SWITCH_NUM>(0)]);
 #endif
 	}
+	else if (mLazySwitchedSystems) {
+		// Drop system matrices of a previous initialization, e.g. steady-state initialization
+		mSwitchedMatrices.clear();
+		mLuFactorizations.clear();
+		mSwitchedSystemLru.clear();
+		mSwitchedSystemLruPos.clear();
+
+		// Only generate the system matrices of the expected and the initial switch state
+		if (mExpectedSwitchStates.size() > mSwitchedSystemCacheSize)
+			mSLog->warn("More expected switch states ({:d}) than cache entries ({:d})",
+				mExpectedSwitchStates.size(), mSwitchedSystemCacheSize);
+		for (auto& state : mExpectedSwitchStates) {
+			if ((state >> mSwitches.size()).any())
+				throw SystemError("Expected switch state " + state.to_string() + " refers to non-existing switches.");
+			useSwitchedSystem(state);
+		}
+		updateSwitchStatus();
+		useSwitchedSystem(mCurrentSwitchStatus);
+
+		// Only count lookups during the simulation
+		mSwitchedSystemCacheHits = 0;
+		mSwitchedSystemCacheMisses = 0;
+	}
 	else {
 		// Generate switching state dependent system matrices
-		for (auto& sys : mSwitchedMatrices) {
-			for (auto comp : mMNAComponents)
-				comp->mnaApplySystemMatrixStamp(sys.second);
-			for (UInt i = 0; i < mSwitches.size(); i++)
-				mSwitches[i]->mnaApplySwitchSystemMatrixStamp(sys.second, sys.first[i]);
-			// Compute LU-factorization for system matrix
-#ifdef WITH_SPARSE
-			mLuFactorizations[sys.first].analyzePattern(sys.second);
-			mLuFactorizations[sys.first].factorize(sys.second);
-#else
-			mLuFactorizations[sys.first] = Eigen::PartialPivLU<Matrix>(sys.second);
-#endif
-		}
+		for (auto& sys : mSwitchedMatrices)
+			createSwitchedSystem(sys.first);
 		updateSwitchStatus();
 	}
 
@@ -269,6 +418,83 @@ void MnaSolver<VarType>::updateSwitchStatus() {
 	}
 }
 
+template <typename VarType>
+void MnaSolver<VarType>::captureSwitchStamps() {
+	// The stamps only touch a few entries, which are read from a dense
+	// matrix once during the initialization
+	Matrix stamp = Matrix::Zero(mBaseSystemMatrix.rows(), mBaseSystemMatrix.cols());
+	mSwitchStamps.resize(mSwitches.size());
+	for (UInt i = 0; i < mSwitches.size(); i++) {
+		for (UInt closed = 0; closed < 2; closed++) {
+			auto& entries = mSwitchStamps[i][closed];
+			entries.clear();
+			stamp.setZero();
+			mSwitches[i]->mnaApplySwitchSystemMatrixStamp(stamp, closed == 1);
+			for (Matrix::Index row = 0; row < stamp.rows(); row++) {
+				for (Matrix::Index col = 0; col < stamp.cols(); col++) {
+					if (stamp(row, col) != 0)
+						entries.emplace_back(row, col, stamp(row, col));
+				}
+			}
+		}
+	}
+}
+
+template <typename VarType>
+void MnaSolver<VarType>::createSwitchedSystem(const std::bitset<SWITCH_NUM>& status) {
+	auto& sys = mSwitchedMatrices[status];
+	if (mLazySwitchedSystems) {
+		sys.resize(mBaseSystemMatrix.rows(), mBaseSystemMatrix.cols());
+		sys.setZero();
+	}
+
+	for (auto comp : mMNAComponents)
+		comp->mnaApplySystemMatrixStamp(sys);
+	for (UInt i = 0; i < mSwitches.size(); i++)
+		mSwitches[i]->mnaApplySwitchSystemMatrixStamp(sys, status[i]);
+	// Compute LU-factorization for system matrix
+#ifdef WITH_SPARSE
+	mLuFactorizations[status].analyzePattern(sys);
+	mLuFactorizations[status].factorize(sys);
+#else
+	mLuFactorizations[status] = Eigen::PartialPivLU<Matrix>(sys);
+#endif
+}
+
+template <typename VarType>
+void MnaSolver<VarType>::useSwitchedSystem(const std::bitset<SWITCH_NUM>& status) {
+	// Fast path: switch states rarely change between steps
+	if (!mSwitchedSystemLru.empty() && mSwitchedSystemLru.front() == status) {
+		mSwitchedSystemCacheHits++;
+		return;
+	}
+
+	auto pos = mSwitchedSystemLruPos.find(status);
+	if (pos != mSwitchedSystemLruPos.end()) {
+		mSwitchedSystemCacheHits++;
+		mSwitchedSystemLru.splice(mSwitchedSystemLru.begin(), mSwitchedSystemLru, pos->second);
+		return;
+	}
+
+	mSwitchedSystemCacheMisses++;
+	if (mSwitchedSystemLru.size() >= mSwitchedSystemCacheSize) {
+		auto evicted = mSwitchedSystemLru.back();
+		mSLog->debug("Evict system matrix for switch state {:s}", evicted.to_string());
+		mSwitchedMatrices.erase(evicted);
+		mLuFactorizations.erase(evicted);
+		mSwitchedSystemLruPos.erase(evicted);
+		mSwitchedSystemLru.pop_back();
+	}
+
+	createSwitchedSystem(status);
+	mSwitchedSystemLru.push_front(status);
+	mSwitchedSystemLruPos[status] = mSwitchedSystemLru.begin();
+	mSwitchedSystemCacheEntries = mSwitchedSystemLru.size();
+
+	mSLog->info("Computed system matrix for switch state {:s} ({:d} cached, hit rate {:.3f})",
+		status.to_string(), mSwitchedSystemCacheEntries, switchedSystemCacheHitRate());
+}
+
 template <typename VarType>
 void MnaSolver<VarType>::identifyTopologyObjects() {
 	for (auto baseNode : mSystem.mNodes) {
@@ -308,8 +534,17 @@ void MnaSolver<VarType>::identifyTopologyObjects() {
 
 template <typename VarType>
 void MnaSolver<VarType>::assignMatrixNodeIndices() {
+	typename SimPowerComp<VarType>::List powerComps;
+	for (auto comp : mSystem.mComponents) {
+		auto pComp = std::dynamic_pointer_cast<SimPowerComp<VarType>>(comp);
+		if (pComp) powerComps.push_back(pComp);
+	}
+	std::vector<UInt> nodeOrder = NodeOrdering::compute<VarType>(mNodeOrdering, mNodes, powerComps, mSLog,
+		&mNaturalOrderStatistics, &mNodeOrderStatistics);
+
 	UInt matrixNodeIndexIdx = 0;
-	for (UInt idx = 0; idx < mNodes.size(); idx++) {
+	mNumNetMatrixNodeIndices = 0;
+	for (UInt idx : nodeOrder) {
 		mNodes[idx]->setMatrixNodeIndex(0, matrixNodeIndexIdx);
 		mSLog->info("Assigned index {} to phase A of node {}", matrixNodeIndexIdx, idx);
 		matrixNodeIndexIdx++;
@@ -321,7 +556,8 @@ void MnaSolver<VarType>::assignMatrixNodeIndices() {
 			mSLog->info("Assigned index {} to phase B of node {}", matrixNodeIndexIdx, idx);
 			matrixNodeIndexIdx++;
 		}
-		if (idx == mNumNetNodes-1) mNumNetMatrixNodeIndices = matrixNodeIndexIdx;
+		if (idx < mNumNetNodes)
+			mNumNetMatrixNodeIndices += mNodes[idx]->phaseType() == CPS::PhaseType::ABC ? 3 : 1;
 	}
 	// Total number of network nodes is matrixNodeIndexIdx + 1
 	mNumMatrixNodeIndices = matrixNodeIndexIdx;
@@ -359,13 +595,16 @@ void MnaSolver<Real>::createEmptySystemMatrix() {
 	if (mSwitches.size() > SWITCH_NUM)
 		throw SystemError("Too many Switches.");
 
+	// In lazy mode, the switched system matrices are created on first use
+	std::size_t numSystems = mLazySwitchedSystems ? 0 : (1ULL << mSwitches.size());
+
 #ifdef WITH_SPARSE
-	for (std::size_t i = 0; i < (1ULL << mSwitches.size()); i++)
+	for (std::size_t i = 0; i < numSystems; i++)
 		mSwitchedMatrices[std::bitset<SWITCH_NUM>(i)].resize(mNumMatrixNodeIndices, mNumMatrixNodeIndices);
 
 	mBaseSystemMatrix.resize(mNumMatrixNodeIndices, mNumMatrixNodeIndices);
 #else
-	for (std::size_t i = 0; i < (1ULL << mSwitches.size()); i++)
+	for (std::size_t i = 0; i < numSystems; i++)
 		mSwitchedMatrices[std::bitset<SWITCH_NUM>(i)] = Matrix::Zero(mNumMatrixNodeIndices, mNumMatrixNodeIndices);
 
 	mBaseSystemMatrix = Matrix::Zero(mNumMatrixNodeIndices, mNumMatrixNodeIndices);
@@ -378,15 +617,14 @@ void MnaSolver<Complex>::createEmptySystemMatrix() {
 		throw SystemError("Too many Switches.");
 
 	if (mFrequencyParallel) {
-		for (UInt i = 0; i < std::pow(2,mSwitches.size()); i++) {
-			for(Int freq = 0; freq < mSystem.mFrequencies.size(); freq++) {
-				mSwitchedMatricesHarm[std::bitset<SWITCH_NUM>(i)].push_back(
-					Matrix::Zero(2*(mNumMatrixNodeIndices), 2*(mNumMatrixNodeIndices)));
-			}
-		}
+		// The matrices are stamped and stored when the system is initialized
+		for (std::size_t i = 0; i < (1ULL << mSwitches.size()); i++)
+			mSwitchedMatricesHarm[std::bitset<SWITCH_NUM>(i)].resize(mSystem.mFrequencies.size());
 	}
 	else {
-		for (std::size_t i = 0; i < (1ULL << mSwitches.size()); i++) {
+		// In lazy mode, the switched system matrices are created on first use
+		std::size_t numSystems = mLazySwitchedSystems ? 0 : (1ULL << mSwitches.size());
+		for (std::size_t i = 0; i < numSystems; i++) {
 #ifdef WITH_SPARSE
 			mSwitchedMatrices[std::bitset<SWITCH_NUM>(i)].resize(2*(mNumMatrixNodeIndices + mNumHarmMatrixNodeIndices), 2*(mNumMatrixNodeIndices + mNumHarmMatrixNodeIndices));
 #else
@@ -457,7 +695,6 @@ void MnaSolver<VarType>::steadyStateInitialization() {
 	Real time = 0;
 	Real maxDiff = 1.0;
 	Real max = 1.0;
-	Matrix diff = Matrix::Zero(2 * mNumNodes, 1);
 	Matrix prevLeftSideVector = Matrix::Zero(2 * mNumNodes, 1);
 
 	mSLog->info("Time step is {:f}s for steady-state initialization", initTimeStep);
@@ -517,10 +754,9 @@ void MnaSolver<VarType>::steadyStateInitialization() {
 		time = time + initTimeStep;
 		timeStepCount++;
 
-		// Calculate difference
-		diff = prevLeftSideVector - mLeftSideVector;
+		// Calculate difference without a temporary vector
+		maxDiff = (prevLeftSideVector - mLeftSideVector).lpNorm<Eigen::Infinity>();
 		prevLeftSideVector = mLeftSideVector;
-		maxDiff = diff.lpNorm<Eigen::Infinity>();
 		max = mLeftSideVector.lpNorm<Eigen::Infinity>();
 		// If difference is smaller than some epsilon, break
 		if ((maxDiff / max) < mSteadStIniAccLimit)
@@ -571,20 +807,17 @@ Task::List MnaSolver<VarType>::getTasks() {
 
 template <typename VarType>
 void MnaSolver<VarType>::solve(Real time, Int timeStepCount) {
-	// Reset source vector
-	mRightSideVector.setZero();
-
 	// Add together the right side vector (computed by the components'
 	// pre-step tasks)
-	for (auto stamp : mRightVectorStamps)
-		mRightSideVector += *stamp;
+	assembleRightSideVector();
+
+	if (mLazySwitchedSystems)
+		useSwitchedSystem(mCurrentSwitchStatus);
 
 	if (mSwitchedMatrices.size() > 0)
-		mLeftSideVector = mLuFactorizations[mCurrentSwitchStatus].solve(mRightSideVector);
+		mLuSolveWorkspace.solve(mLuFactorizations[mCurrentSwitchStatus], mRightSideVector, mLeftSideVector);
 
-	// TODO split into separate task? (dependent on x, updating all v attributes)
-	for (UInt nodeIdx = 0; nodeIdx < mNumNetNodes; nodeIdx++)
-		mNodes[nodeIdx]->mnaUpdateVoltage(mLeftSideVector);
+	updateNodeVoltages();
 
 	if (!mIsInInitialization)
 		updateSwitchStatus();
@@ -592,6 +825,13 @@ void MnaSolver<VarType>::solve(Real time, Int timeStepCount) {
 	// Components' states will be updated by the post-step tasks
 }
 
+template <typename VarType>
+void MnaSolver<VarType>::updateNodeVoltages() {
+	// TODO split into separate task? (dependent on x, updating all v attributes)
+	for (UInt nodeIdx = 0; nodeIdx < mNumNetNodes; nodeIdx++)
+		mNodes[nodeIdx]->mnaUpdateVoltage(mLeftSideVector);
+}
+
 template <typename VarType>
 void MnaSolver<VarType>::solveWithHarmonics(Real time, Int timeStepCount, Int freqIdx) {
 	mRightSideVectorHarm[freqIdx].setZero();
@@ -600,7 +840,15 @@ void MnaSolver<VarType>::solveWithHarmonics(Real time, Int timeStepCount, Int fr
 	for (auto stamp : mRightVectorStamps)
 		mRightSideVectorHarm[freqIdx] += stamp->col(freqIdx);
 
-	mLeftSideVectorHarm[freqIdx] =	mLuFactorizationsHarm[mCurrentSwitchStatus][freqIdx].solve(mRightSideVectorHarm[freqIdx]);
+	// The map is only read here, since operator[] may insert it is not safe
+	// to call from the concurrent solve tasks
+	auto& status = mCurrentSwitchStatusHarm[freqIdx];
+	mLeftSideVectorHarm[freqIdx] = mLuFactorizationsHarm.at(status)[freqIdx].solve(mRightSideVectorHarm[freqIdx]);
+
+	// The solve tasks of the frequencies run concurrently, so each one keeps
+	// its own copy of the switch status for the next step
+	for (UInt i = 0; i < mSwitches.size(); i++)
+		status.set(i, mSwitches[i]->mnaIsClosed());
 }
 
 template <typename VarType>
@@ -621,11 +869,13 @@ void MnaSolver<VarType>::log(Real time, Int timeStepCount) {
 template <typename VarType>
 void MnaSolver<VarType>::logSystemMatrices() {
 	if (mFrequencyParallel) {
-		for (UInt i = 0; i < mSwitchedMatricesHarm[std::bitset<SWITCH_NUM>(0)].size(); i++) {
+		if (mSwitches.size() > 0)
+			mSLog->info("Initial switch status: {:s}", mCurrentSwitchStatus.to_string());
+		for (UInt i = 0; i < mSwitchedMatricesHarm[mCurrentSwitchStatus].size(); i++) {
 			mSLog->info("System matrix for frequency: {:d} \n{:s}", i,
-				Logger::matrixToString(mSwitchedMatricesHarm[std::bitset<SWITCH_NUM>(0)][i]));
+				Logger::matrixToString(Matrix(mSwitchedMatricesHarm[mCurrentSwitchStatus][i])));
 			//mSLog->info("LU decomposition for frequency: {:d} \n{:s}", i,
-			//	Logger::matrixToString(mLuFactorizationsHarm[std::bitset<SWITCH_NUM>(0)][i].matrixLU()));
+			//	Logger::matrixToString(mLuFactorizationsHarm[mCurrentSwitchStatus][i].matrixLU()));
 		}
 
 		for (UInt i = 0; i < mRightSideVectorHarm.size(); i++)
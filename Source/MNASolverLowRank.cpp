@@ -0,0 +1,294 @@
+/* Copyright 2017-2020 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <algorithm>
+
+#include <dpsim/MNASolverLowRank.h>
+
+using namespace DPsim;
+using namespace CPS;
+
+namespace {
+	/// Returns true if both compressed matrices have the same sparsity pattern
+	Bool hasSamePattern(const SparseMatrixRow& a, const SparseMatrixRow& b) {
+		return a.rows() == b.rows() && a.nonZeros() == b.nonZeros()
+			&& std::equal(a.outerIndexPtr(), a.outerIndexPtr() + a.outerSize() + 1, b.outerIndexPtr())
+			&& std::equal(a.innerIndexPtr(), a.innerIndexPtr() + a.nonZeros(), b.innerIndexPtr());
+	}
+}
+
+namespace DPsim {
+
+template <typename VarType>
+MnaSolverLowRank<VarType>::MnaSolverLowRank(String name,
+	CPS::Domain domain, CPS::Logger::Level logLevel) :
+	MnaSolver<VarType>(name, domain, logLevel) {
+
+	// System matrices are not precomputed for all switch states
+	this->mLazySwitchedSystems = true;
+
+	this->template addAttribute<Int>("low_rank_updates", &mNumLowRankUpdates, Flags::read);
+	this->template addAttribute<Int>("refactorizations", &mNumRefactorizations, Flags::read);
+	this->template addAttribute<Int>("pattern_analyses", &mNumPatternAnalyses, Flags::read);
+	this->template addAttribute<Int>("correction_rank", &mCorrectionRank, Flags::read);
+}
+
+template <typename VarType>
+void MnaSolverLowRank<VarType>::initializeSystem() {
+	this->mSLog->info("-- Initialize MNA system matrices and source vector");
+	this->mRightSideVector.setZero();
+
+	this->mSLog->info("Number of switches: {}"
+		"\nNumber of variable elements: {}"
+		"\nMaximum correction rank: {}",
+		this->mSwitches.size(),
+		this->mVariableComps.size(),
+		mMaxCorrectionRank);
+
+	// Base matrix with only static elements
+	this->mBaseSystemMatrix.setZero();
+	for (auto comp : this->mMNAComponents)
+		comp->mnaApplySystemMatrixStamp(this->mBaseSystemMatrix);
+
+	// Changes of switches and variable components are applied from their stamps
+	Matrix::Index size = this->mBaseSystemMatrix.rows();
+	this->captureSwitchStamps();
+	mVariableStamp.resize(size, size);
+	mFactorizedVariableStamp.resize(size, size);
+	stampVariableComps();
+
+#ifdef WITH_SPARSE
+	// The base matrix gets explicit zeros for the entries of the switches and
+	// variable components, so that refactorizations keep the sparsity pattern
+	for (auto& stamps : this->mSwitchStamps) {
+		for (auto& entries : stamps) {
+			for (auto& entry : entries)
+				this->mBaseSystemMatrix.coeffRef(entry.row(), entry.col());
+		}
+	}
+	for (Eigen::Index row = 0; row < mVariableStamp.outerSize(); row++) {
+		for (SparseMatrixRow::InnerIterator it(mVariableStamp, row); it; ++it)
+			this->mBaseSystemMatrix.coeffRef(it.row(), it.col());
+	}
+	this->mBaseSystemMatrix.makeCompressed();
+#endif
+
+	// Buffers of the correction, so that updates do not allocate
+	mCorrectionColumns.assign(mMaxCorrectionRank, 0);
+	mCorrection = Matrix::Zero(size, mMaxCorrectionRank);
+	mCorrectionSolution = Matrix::Zero(size, mMaxCorrectionRank);
+	mCorrectionColumn = Matrix::Zero(size, 1);
+	mCorrectionColumnSolution = Matrix::Zero(size, 1);
+	mCapacitance = Matrix::Identity(mMaxCorrectionRank, mMaxCorrectionRank);
+	mCapacitanceLu.compute(mCapacitance);
+	mCorrectionRhs = Matrix::Zero(mMaxCorrectionRank, 1);
+	mCorrectionWeights = Matrix::Zero(mMaxCorrectionRank, 1);
+
+	// The symbolic analysis and fill-reducing ordering of the first
+	// factorization are kept as long as the pattern does not change
+	this->updateSwitchStatus();
+	mStampedSwitchStatus = this->mCurrentSwitchStatus;
+	refactorize();
+
+	// Initialize source vector for debugging
+	for (auto comp : this->mMNAComponents)
+		comp->mnaApplyRightSideVectorStamp(this->mRightSideVector);
+}
+
+template <typename VarType>
+void MnaSolverLowRank<VarType>::stampVariableComps() {
+	// Stamps into the pattern of the previous stamps are written in place
+	mVariableStamp.makeCompressed();
+	mVariableStamp.coeffs().setZero();
+	for (auto comp : this->mMNAIntfVariableComps)
+		comp->mnaApplySystemMatrixStamp(mVariableStamp);
+	mVariableStamp.makeCompressed();
+
+	// New entries and entries a stamp dropped become explicit zeros in both
+	// matrices, so that they can be compared entry by entry
+	if (!hasSamePattern(mVariableStamp, mFactorizedVariableStamp)) {
+		for (Eigen::Index row = 0; row < mVariableStamp.outerSize(); row++) {
+			for (SparseMatrixRow::InnerIterator it(mVariableStamp, row); it; ++it)
+				mFactorizedVariableStamp.coeffRef(it.row(), it.col());
+		}
+		for (Eigen::Index row = 0; row < mFactorizedVariableStamp.outerSize(); row++) {
+			for (SparseMatrixRow::InnerIterator it(mFactorizedVariableStamp, row); it; ++it)
+				mVariableStamp.coeffRef(it.row(), it.col());
+		}
+		mVariableStamp.makeCompressed();
+		mFactorizedVariableStamp.makeCompressed();
+	}
+}
+
+template <typename VarType>
+void MnaSolverLowRank<VarType>::refactorize() {
+	// Actual system matrix from the base matrix and the stamps
+	mFactorizedSystemMatrix = this->mBaseSystemMatrix;
+	for (UInt i = 0; i < this->mSwitches.size(); i++) {
+		for (auto& entry : this->mSwitchStamps[i][mStampedSwitchStatus[i]])
+			Math::addToMatrixElement(mFactorizedSystemMatrix, entry.row(), entry.col(), entry.value());
+	}
+	for (Eigen::Index row = 0; row < mVariableStamp.outerSize(); row++) {
+		for (SparseMatrixRow::InnerIterator it(mVariableStamp, row); it; ++it)
+			Math::addToMatrixElement(mFactorizedSystemMatrix, it.row(), it.col(), it.value());
+	}
+#ifdef WITH_SPARSE
+	// Only new entries in the stamps of variable components change the pattern
+	mFactorizedSystemMatrix.makeCompressed();
+	if (!hasSamePattern(mFactorizedSystemMatrix, mAnalyzedSystemMatrix)) {
+		this->mSLog->info("Sparsity pattern of system matrix changed");
+		analyzePattern(mFactorizedSystemMatrix);
+	}
+	mLuFactorization.factorize(mFactorizedSystemMatrix);
+#else
+	mLuFactorization.compute(mFactorizedSystemMatrix);
+#endif
+
+	mFactorizedSwitchStatus = mStampedSwitchStatus;
+	std::copy_n(mVariableStamp.valuePtr(), mVariableStamp.nonZeros(), mFactorizedVariableStamp.valuePtr());
+	mCorrection.leftCols(mCorrectionRank).setZero();
+	mCorrectionRank = 0;
+}
+
+#ifdef WITH_SPARSE
+template <typename VarType>
+void MnaSolverLowRank<VarType>::analyzePattern(const MAT_TYPE& matrix) {
+	mAnalyzedSystemMatrix = matrix;
+	mAnalyzedSystemMatrix.makeCompressed();
+	mLuFactorization.analyzePattern(mAnalyzedSystemMatrix);
+	mNumPatternAnalyses++;
+}
+#endif
+
+template <typename VarType>
+Bool MnaSolverLowRank<VarType>::hasSystemChanged() {
+	for (auto varElem : this->mVariableComps) {
+		if (varElem->hasParameterChanged())
+			mVariableCompsChanged = true;
+	}
+
+	this->updateSwitchStatus();
+	return mVariableCompsChanged || this->mCurrentSwitchStatus != mStampedSwitchStatus;
+}
+
+template <typename VarType>
+Bool MnaSolverLowRank<VarType>::addCorrectionEntry(UInt row, UInt col, Real value) {
+	Int pos = 0;
+	while (pos < mCorrectionRank && mCorrectionColumns[pos] != col)
+		pos++;
+	if (pos == mCorrectionRank) {
+		if (mCorrectionRank == static_cast<Int>(mMaxCorrectionRank))
+			return false;
+		mCorrectionColumns[pos] = col;
+		mCorrectionRank++;
+	}
+	mCorrection(row, pos) += value;
+	return true;
+}
+
+template <typename VarType>
+void MnaSolverLowRank<VarType>::updateSystemMatrix(Real time) {
+	if (mVariableCompsChanged) {
+		stampVariableComps();
+		mVariableCompsChanged = false;
+	}
+	mStampedSwitchStatus = this->mCurrentSwitchStatus;
+
+	// The difference to A0 consists of the stamps of the switches whose
+	// state differs from A0 and the changed entries of the variable components.
+	// It is represented as U V^T, where V^T selects the correction columns
+	// and U holds the difference in these columns.
+	mCorrection.leftCols(mCorrectionRank).setZero();
+	mCorrectionRank = 0;
+	Bool fits = true;
+	for (UInt i = 0; fits && i < this->mSwitches.size(); i++) {
+		if (mStampedSwitchStatus[i] == mFactorizedSwitchStatus[i])
+			continue;
+		for (auto& entry : this->mSwitchStamps[i][mStampedSwitchStatus[i]])
+			fits = fits && addCorrectionEntry(entry.row(), entry.col(), entry.value());
+		for (auto& entry : this->mSwitchStamps[i][mFactorizedSwitchStatus[i]])
+			fits = fits && addCorrectionEntry(entry.row(), entry.col(), -entry.value());
+	}
+	const Real* values = mVariableStamp.valuePtr();
+	const Real* factorizedValues = mFactorizedVariableStamp.valuePtr();
+	for (Eigen::Index row = 0; fits && row < mVariableStamp.outerSize(); row++) {
+		for (auto k = mVariableStamp.outerIndexPtr()[row]; fits && k < mVariableStamp.outerIndexPtr()[row + 1]; k++) {
+			if (values[k] != factorizedValues[k])
+				fits = addCorrectionEntry(row, mVariableStamp.innerIndexPtr()[k], values[k] - factorizedValues[k]);
+		}
+	}
+
+	if (!fits) {
+		this->mSLog->info("Refactorize system matrix at {} (correction rank above {})", time, mMaxCorrectionRank);
+		refactorize();
+		mNumRefactorizations++;
+		return;
+	}
+
+	// The system matrix equals A0 again
+	if (mCorrectionRank == 0)
+		return;
+
+	// Z = A0^-1 U
+	for (Int i = 0; i < mCorrectionRank; i++) {
+		mCorrectionColumn = mCorrection.col(i);
+		this->mLuSolveWorkspace.solve(mLuFactorization, mCorrectionColumn, mCorrectionColumnSolution);
+		mCorrectionSolution.col(i) = mCorrectionColumnSolution;
+	}
+
+	// Capacitance matrix I + V^T Z
+	mCapacitance.setIdentity();
+	for (Int i = 0; i < mCorrectionRank; i++)
+		mCapacitance.row(i).head(mCorrectionRank) += mCorrectionSolution.row(mCorrectionColumns[i]).head(mCorrectionRank);
+	mCapacitanceLu.compute(mCapacitance);
+
+	mNumLowRankUpdates++;
+	this->mSLog->debug("Low-rank update of system matrix at {} (correction rank {})", time, mCorrectionRank);
+}
+
+template <typename VarType>
+void MnaSolverLowRank<VarType>::solve(Real time, Int timeStepCount) {
+	// Add together the right side vector (computed by the components'
+	// pre-step tasks)
+	this->assembleRightSideVector();
+
+	// Sherman-Morrison-Woodbury: x = x0 - Z (I + V^T Z)^-1 V^T x0 with x0 = A0^-1 b
+	this->mLuSolveWorkspace.solve(mLuFactorization, this->mRightSideVector, this->mLeftSideVector);
+	if (mCorrectionRank > 0) {
+		for (Int i = 0; i < mCorrectionRank; i++)
+			mCorrectionRhs(i, 0) = this->mLeftSideVector(mCorrectionColumns[i], 0);
+		// The capacitance matrix keeps its size, so the solution is written
+		// into the preallocated buffer
+		mCorrectionWeights = mCapacitanceLu.solve(mCorrectionRhs);
+		this->mLeftSideVector.noalias() -= mCorrectionSolution.leftCols(mCorrectionRank)
+			* mCorrectionWeights.topRows(mCorrectionRank);
+	}
+
+	this->updateNodeVoltages();
+
+	if (!this->mIsInInitialization && hasSystemChanged())
+		updateSystemMatrix(time);
+
+	// Components' states will be updated by the post-step tasks
+}
+
+template <typename VarType>
+Task::List MnaSolverLowRank<VarType>::getTasks() {
+	Task::List l = MnaSolver<VarType>::getTasks();
+
+	for (auto comp : this->mMNAIntfVariableComps) {
+		for (auto task : comp->mnaTasks())
+			l.push_back(task);
+	}
+	return l;
+}
+
+}
+
+template class DPsim::MnaSolverLowRank<Real>;
+template class DPsim::MnaSolverLowRank<Complex>;
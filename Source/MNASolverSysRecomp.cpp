@@ -7,6 +7,9 @@
  * file, You can obtain one at https://mozilla.org/MPL/2.0/.
  *********************************************************************************/
 
+#include <algorithm>
+#include <chrono>
+
 #include <dpsim/MNASolverSysRecomp.h>
 
 using namespace DPsim;
@@ -17,7 +20,12 @@ namespace DPsim {
 template <typename VarType>
 MnaSolverSysRecomp<VarType>::MnaSolverSysRecomp(String name,
 	CPS::Domain domain, CPS::Logger::Level logLevel) :
-    MnaSolver<VarType>(name, domain, logLevel) { }
+    MnaSolver<VarType>(name, domain, logLevel) {
+
+	this->template addAttribute<Int>("sys_matrix_updates", &mNumSysMatrixUpdates, Flags::read);
+	this->template addAttribute<Real>("sys_matrix_update_time", &mSysMatrixUpdateTime, Flags::read);
+	this->template addAttribute<Int>("pattern_analyses", &mNumPatternAnalyses, Flags::read);
+}
 
 template <typename VarType>
 void MnaSolverSysRecomp<VarType>::initializeSystem() {
@@ -25,33 +33,60 @@ void MnaSolverSysRecomp<VarType>::initializeSystem() {
 	this->mRightSideVector.setZero();
 
 	this->mSLog->info("Number of variable Elements: {}"
+		"\nNumber of switches: {}"
 		"\nNumber of MNA components: {}",
 		this->mVariableComps.size(),
+		this->mSwitches.size(),
 		this->mMNAComponents.size());
 
+	auto& sysMatrix = this->mSwitchedMatrices[std::bitset<SWITCH_NUM>(0)];
+	sysMatrix.setZero();
+
 	this->mSLog->info("Stamping MNA fixed components");
 	for (auto comp : this->mMNAComponents) {
 		// Do not stamp variable elements yet
 		auto varcomp = std::dynamic_pointer_cast<MNAVariableCompInterface>(comp);
 		if (varcomp) continue;
- 		comp->mnaApplySystemMatrixStamp(this->mSwitchedMatrices[std::bitset<SWITCH_NUM>(0)]);
-		auto idObj = std::dynamic_pointer_cast<IdentifiedObject>(comp);
+ 		comp->mnaApplySystemMatrixStamp(sysMatrix);
 	}
 
 	// Save base matrix with only static elements
 	this->mSLog->info("Save base matrix");
-	this->mBaseSystemMatrix = this->mSwitchedMatrices[std::bitset<SWITCH_NUM>(0)];
+	this->mBaseSystemMatrix = sysMatrix;
 
-	// Now stamp variable elements
-	this->mSLog->info("Stamping variable elements");
-	for (auto varElem : this->mMNAIntfVariableComps) {
-		varElem->mnaApplySystemMatrixStamp(this->mSwitchedMatrices[std::bitset<SWITCH_NUM>(0)]);
+	// Switch changes are applied from their stamps in both states
+	this->captureSwitchStamps();
+
+#ifdef WITH_SPARSE
+	// The base matrix gets the sparsity pattern of the complete system matrix
+	// so that updates can overwrite the values in place
+	SparseMatrix varMatrix(sysMatrix.rows(), sysMatrix.cols());
+	for (auto varElem : this->mMNAIntfVariableComps)
+		varElem->mnaApplySystemMatrixStamp(varMatrix);
+	for (auto& stamps : this->mSwitchStamps) {
+		for (auto& entries : stamps) {
+			for (auto& entry : entries)
+				varMatrix.coeffRef(entry.row(), entry.col());
+		}
 	}
+	extendBasePattern(varMatrix);
+	sysMatrix = this->mBaseSystemMatrix;
+#endif
+
+	// Now stamp variable elements and switches
+	this->mSLog->info("Stamping variable elements");
+	stampVariableElements();
+	this->updateSwitchStatus();
+	stampSwitches();
+
 #ifdef WITH_SPARSE
-	this->mLuFactorizations[std::bitset<SWITCH_NUM>(0)].analyzePattern(this->mSwitchedMatrices[std::bitset<SWITCH_NUM>(0)]);
-	this->mLuFactorizations[std::bitset<SWITCH_NUM>(0)].factorize(this->mSwitchedMatrices[std::bitset<SWITCH_NUM>(0)]);
+	// Symbolic analysis and fill-reducing ordering are only computed once
+	applyBasePattern(sysMatrix);
+	this->mLuFactorizations[std::bitset<SWITCH_NUM>(0)].analyzePattern(sysMatrix);
+	mNumPatternAnalyses++;
+	this->mLuFactorizations[std::bitset<SWITCH_NUM>(0)].factorize(sysMatrix);
 #else
-	this->mLuFactorizations[std::bitset<SWITCH_NUM>(0)] = Eigen::PartialPivLU<Matrix>(this->mSwitchedMatrices[std::bitset<SWITCH_NUM>(0)]);
+	this->mLuFactorizations[std::bitset<SWITCH_NUM>(0)] = Eigen::PartialPivLU<Matrix>(sysMatrix);
 #endif
 	// Initialize source vector for debugging
 	for (auto comp : this->mMNAComponents) {
@@ -59,6 +94,60 @@ void MnaSolverSysRecomp<VarType>::initializeSystem() {
 	}
 }
 
+template <typename VarType>
+void MnaSolverSysRecomp<VarType>::stampVariableElements() {
+	for (auto comp : this->mMNAIntfVariableComps) {
+		comp->mnaApplySystemMatrixStamp(this->mSwitchedMatrices[std::bitset<SWITCH_NUM>(0)]);
+		auto idObj = std::dynamic_pointer_cast<IdentifiedObject>(comp);
+		this->mSLog->debug("Updating {:s} {:s} in system matrix (variabel component)",
+			idObj->type(), idObj->name());
+	}
+}
+
+template <typename VarType>
+void MnaSolverSysRecomp<VarType>::stampSwitches() {
+	// The entries are part of the base pattern, so they are added in place
+	auto& sysMatrix = this->mSwitchedMatrices[std::bitset<SWITCH_NUM>(0)];
+	for (UInt i = 0; i < this->mSwitches.size(); i++) {
+		for (auto& entry : this->mSwitchStamps[i][this->mCurrentSwitchStatus[i]])
+			Math::addToMatrixElement(sysMatrix, entry.row(), entry.col(), entry.value());
+	}
+	mStampedSwitchStatus = this->mCurrentSwitchStatus;
+}
+
+#ifdef WITH_SPARSE
+template <typename VarType>
+void MnaSolverSysRecomp<VarType>::extendBasePattern(const SparseMatrix& matrix) {
+	for (Eigen::Index row = 0; row < matrix.outerSize(); row++) {
+		for (SparseMatrix::InnerIterator it(matrix, row); it; ++it)
+			this->mBaseSystemMatrix.coeffRef(it.row(), it.col());
+	}
+	this->mBaseSystemMatrix.makeCompressed();
+}
+
+template <typename VarType>
+Bool MnaSolverSysRecomp<VarType>::applyBasePattern(SparseMatrix& matrix) {
+	auto& base = this->mBaseSystemMatrix;
+	matrix.makeCompressed();
+	if (matrix.nonZeros() == base.nonZeros()
+		&& std::equal(base.outerIndexPtr(), base.outerIndexPtr() + base.outerSize() + 1, matrix.outerIndexPtr())
+		&& std::equal(base.innerIndexPtr(), base.innerIndexPtr() + base.nonZeros(), matrix.innerIndexPtr()))
+		return false;
+
+	auto baseNonZeros = base.nonZeros();
+	extendBasePattern(matrix);
+
+	SparseMatrix values = matrix;
+	matrix = base;
+	matrix.coeffs().setZero();
+	for (Eigen::Index row = 0; row < values.outerSize(); row++) {
+		for (SparseMatrix::InnerIterator it(values, row); it; ++it)
+			matrix.coeffRef(it.row(), it.col()) = it.value();
+	}
+	return base.nonZeros() != baseNonZeros;
+}
+#endif
+
 template <typename VarType>
 void MnaSolverSysRecomp<VarType>::updateVariableCompStatus() {
 	for (auto varElem : this->mVariableComps) {
@@ -70,47 +159,68 @@ void MnaSolverSysRecomp<VarType>::updateVariableCompStatus() {
 			break;
 		}
 	}
+
+	this->updateSwitchStatus();
+	if (this->mCurrentSwitchStatus != mStampedSwitchStatus) {
+		this->mSLog->info("Switch status changed to {:s} -> Update System Matrix",
+			this->mCurrentSwitchStatus.to_string());
+		mUpdateSysMatrix = true;
+	}
 }
 
 template <typename VarType>
 void MnaSolverSysRecomp<VarType>::updateSystemMatrix(Real time) {
-	this->mSLog->info("Updating System Matrix at {}\n", time);
-	// Start from base matrix
-	this->mSwitchedMatrices[std::bitset<SWITCH_NUM>(0)] = this->mBaseSystemMatrix;
+	auto start = std::chrono::steady_clock::now();
+	auto& sysMatrix = this->mSwitchedMatrices[std::bitset<SWITCH_NUM>(0)];
 
-	// Create system matrix with changed variable elements
-	for (auto comp : this->mMNAIntfVariableComps) {
-		comp->mnaApplySystemMatrixStamp(this->mSwitchedMatrices[std::bitset<SWITCH_NUM>(0)]);
-		auto idObj = std::dynamic_pointer_cast<IdentifiedObject>(comp);
-		this->mSLog->debug("Updating {:s} {:s} in system matrix (variabel component)",
-			idObj->type(), idObj->name());
-	}
 #ifdef WITH_SPARSE
-	this->mLuFactorizations[std::bitset<SWITCH_NUM>(0)].analyzePattern(this->mSwitchedMatrices[std::bitset<SWITCH_NUM>(0)]);
-	this->mLuFactorizations[std::bitset<SWITCH_NUM>(0)].factorize(this->mSwitchedMatrices[std::bitset<SWITCH_NUM>(0)]);
+	// Start from base matrix by overwriting the values in place,
+	// the sparsity pattern of both matrices is identical. The stamps of
+	// variable elements with a sparse stamp and of the switches are added
+	// in place as well.
+	std::copy_n(this->mBaseSystemMatrix.valuePtr(), this->mBaseSystemMatrix.nonZeros(), sysMatrix.valuePtr());
+	stampVariableElements();
+	stampSwitches();
+
+	// Only needs to move the values if a stamp added an entry or replaced
+	// the matrix with a dense stamp
+	if (applyBasePattern(sysMatrix)) {
+		// A variable element stamped a new entry, so the symbolic analysis is outdated
+		this->mSLog->info("Sparsity pattern of system matrix changed at {}", time);
+		this->mLuFactorizations[std::bitset<SWITCH_NUM>(0)].analyzePattern(sysMatrix);
+		mNumPatternAnalyses++;
+	}
+	this->mLuFactorizations[std::bitset<SWITCH_NUM>(0)].factorize(sysMatrix);
 #else
-	this->mLuFactorizations[std::bitset<SWITCH_NUM>(0)] = Eigen::PartialPivLU<Matrix>(this->mSwitchedMatrices[std::bitset<SWITCH_NUM>(0)]);
+	// Start from base matrix
+	sysMatrix = this->mBaseSystemMatrix;
+	stampVariableElements();
+	stampSwitches();
+	this->mLuFactorizations[std::bitset<SWITCH_NUM>(0)] = Eigen::PartialPivLU<Matrix>(sysMatrix);
 #endif
 	mUpdateSysMatrix = false;
+
+	Real duration = std::chrono::duration<Real>(std::chrono::steady_clock::now() - start).count();
+	mNumSysMatrixUpdates++;
+	mSysMatrixUpdateTime += duration;
+	this->mSLog->info("Updated System Matrix at {} in {:.6f} s (average {:.6f} s)\n",
+		time, duration, mSysMatrixUpdateTime / mNumSysMatrixUpdates);
 }
 
 template <typename VarType>
 void MnaSolverSysRecomp<VarType>::solve(Real time, Int timeStepCount) {
-	// Reset source vector
-	this->mRightSideVector.setZero();
 	mUpdateSysMatrix = false;
 
 	// Add together the right side vector (computed by the components'
 	// pre-step tasks)
-	for (auto stamp : this->mRightVectorStamps)
-		this->mRightSideVector += *stamp;
+	this->assembleRightSideVector();
 
+	// The system matrix is recomputed for switch changes, so it is always
+	// stored for the switch status 0
 	if (this->mSwitchedMatrices.size() > 0)
-		this->mLeftSideVector = this->mLuFactorizations[this->mCurrentSwitchStatus].solve(this->mRightSideVector);
+		this->mLuSolveWorkspace.solve(this->mLuFactorizations[std::bitset<SWITCH_NUM>(0)], this->mRightSideVector, this->mLeftSideVector);
 
-	// TODO split into separate task? (dependent on x, updating all v attributes)
-	for (UInt nodeIdx = 0; nodeIdx < this->mNumNetNodes; nodeIdx++)
-		this->mNodes[nodeIdx]->mnaUpdateVoltage(this->mLeftSideVector);
+	this->updateNodeVoltages();
 
 	if (!this->mIsInInitialization) {
 		updateVariableCompStatus();
@@ -133,6 +243,10 @@ Task::List MnaSolverSysRecomp<VarType>::getTasks() {
 		for (auto task : comp->mnaTasks())
 			l.push_back(task);
 	}
+	for (auto comp : this->mMNAIntfSwitches) {
+		for (auto task : comp->mnaTasks())
+			l.push_back(task);
+	}
 	for (auto node : this->mNodes) {
 		for (auto task : node->mnaTasks())
 			l.push_back(task);
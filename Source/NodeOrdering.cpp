@@ -0,0 +1,142 @@
+/* Copyright 2017-2020 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <algorithm>
+#include <deque>
+
+#include <Eigen/OrderingMethods>
+
+#include <dpsim/NodeOrdering.h>
+
+using namespace DPsim;
+
+void NodeOrdering::addClique(const std::vector<UInt>& nodes) {
+	for (auto i : nodes) {
+		for (auto j : nodes) {
+			if (i != j)
+				mAdjacency[i].insert(j);
+		}
+	}
+}
+
+std::vector<UInt> NodeOrdering::order(Method method) const {
+	switch (method) {
+	case Method::RCM:
+		return reverseCuthillMcKee();
+	case Method::AMD:
+		return approximateMinimumDegree();
+	default:
+		std::vector<UInt> natural(mAdjacency.size());
+		for (UInt idx = 0; idx < natural.size(); idx++)
+			natural[idx] = idx;
+		return natural;
+	}
+}
+
+std::vector<UInt> NodeOrdering::reverseCuthillMcKee() const {
+	UInt numNodes = static_cast<UInt>(mAdjacency.size());
+	auto lessDegree = [this](UInt a, UInt b) {
+		return mAdjacency[a].size() < mAdjacency[b].size();
+	};
+
+	// Each connected part of the graph starts at its node with the lowest degree
+	std::vector<UInt> startNodes(numNodes);
+	for (UInt idx = 0; idx < numNodes; idx++)
+		startNodes[idx] = idx;
+	std::stable_sort(startNodes.begin(), startNodes.end(), lessDegree);
+
+	std::vector<UInt> order;
+	order.reserve(numNodes);
+	std::vector<Bool> visited(numNodes, false);
+	std::deque<UInt> queue;
+	std::vector<UInt> neighbours;
+
+	for (auto start : startNodes) {
+		if (visited[start])
+			continue;
+
+		visited[start] = true;
+		queue.push_back(start);
+		while (!queue.empty()) {
+			UInt node = queue.front();
+			queue.pop_front();
+			order.push_back(node);
+
+			neighbours.clear();
+			for (auto neighbour : mAdjacency[node]) {
+				if (!visited[neighbour]) {
+					visited[neighbour] = true;
+					neighbours.push_back(neighbour);
+				}
+			}
+			std::stable_sort(neighbours.begin(), neighbours.end(), lessDegree);
+			queue.insert(queue.end(), neighbours.begin(), neighbours.end());
+		}
+	}
+
+	std::reverse(order.begin(), order.end());
+	return order;
+}
+
+std::vector<UInt> NodeOrdering::approximateMinimumDegree() const {
+	Eigen::Index numNodes = static_cast<Eigen::Index>(mAdjacency.size());
+
+	std::vector< Eigen::Triplet<Real> > entries;
+	for (Eigen::Index row = 0; row < numNodes; row++) {
+		entries.emplace_back(row, row, 1.);
+		for (auto col : mAdjacency[row])
+			entries.emplace_back(row, col, 1.);
+	}
+	CPS::SparseMatrix pattern(numNodes, numNodes);
+	pattern.setFromTriplets(entries.begin(), entries.end());
+
+	// The inverse permutation lists the original nodes in their new order
+	Eigen::PermutationMatrix<Eigen::Dynamic, Eigen::Dynamic, int> inversePerm;
+	Eigen::AMDOrdering<int> amd;
+	amd(pattern, inversePerm);
+
+	std::vector<UInt> order(numNodes);
+	for (Eigen::Index idx = 0; idx < numNodes; idx++)
+		order[idx] = inversePerm.indices()[idx];
+	return order;
+}
+
+NodeOrdering::Statistics NodeOrdering::statistics(const std::vector<UInt>& order) const {
+	UInt numNodes = static_cast<UInt>(mAdjacency.size());
+	Statistics stats;
+
+	std::vector<UInt> position(numNodes);
+	for (UInt idx = 0; idx < numNodes; idx++)
+		position[order[idx]] = idx;
+
+	// Adjacency of the reordered pattern
+	std::vector< std::set<UInt> > adjacency(numNodes);
+	for (UInt node = 0; node < numNodes; node++) {
+		for (auto neighbour : mAdjacency[node]) {
+			UInt row = position[node], col = position[neighbour];
+			adjacency[row].insert(col);
+			stats.bandwidth = std::max(stats.bandwidth, row > col ? row - col : col - row);
+		}
+		stats.nnz += static_cast<UInt>(mAdjacency[node].size()) + 1;
+	}
+
+	// Symbolic elimination: eliminating a node connects all of its remaining neighbours
+	for (UInt pivot = 0; pivot < numNodes; pivot++) {
+		auto first = adjacency[pivot].upper_bound(pivot);
+		for (auto i = first; i != adjacency[pivot].end(); ++i) {
+			for (auto j = std::next(i); j != adjacency[pivot].end(); ++j) {
+				if (adjacency[*i].insert(*j).second) {
+					adjacency[*j].insert(*i);
+					stats.fill += 2;
+				}
+			}
+		}
+	}
+
+	return stats;
+}
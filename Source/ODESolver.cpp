@@ -112,19 +112,7 @@ int ODESolver::Jacobian(realtype t, N_Vector y, N_Vector fy, SUNMatrix J,
 	return 0;
 }
 
-Real ODESolver::step(Real initial_time) {
-	// Not absolutely necessary; realtype by default double (same as Real)
-	realtype T0 = (realtype) initial_time;
-	realtype Tf = (realtype) initial_time+mTimestep;
-
-	/// Number of integration steps
-	long int nst;
-	/// Number of error test fails
-	long int netf;
-
-	mComponent->attribute<Matrix>("ode_post_state")->set(mComponent->attribute<Matrix>("ode_pre_state")->get());
-
-	// Better allocate the arkode memory here to prevent numerical problems
+void ODESolver::createIntegrator(Real initial_time) {
 	mArkode_mem= ARKodeCreate();
 	 if (check_flag(mArkode_mem, "ARKodeCreate", 0))
 		mFlag=1;
@@ -164,7 +152,63 @@ Real ODESolver::step(Real initial_time) {
 	mFlag = ARKodeSStolerances(mArkode_mem, reltol, abstol);
 	if (check_flag(&mFlag, "ARKodeSStolerances", 1))
 		mFlag=1;
+}
 
+void ODESolver::reinitIntegrator(Real initial_time) {
+	// The inputs of the state space function (e.g. the terminal voltages)
+	// change between the time steps, so the integrator has to restart from
+	// the current state. The memory, tolerances and the linear solver are kept.
+	if (mImplicitIntegration)
+		mFlag = ARKodeReInit(mArkode_mem, NULL, &ODESolver::StateSpaceWrapper, initial_time, mStates);
+	else
+		mFlag = ARKodeReInit(mArkode_mem, &ODESolver::StateSpaceWrapper, NULL, initial_time, mStates);
+	if (check_flag(&mFlag, "ARKodeReInit", 1)) throw CPS::Exception();
+
+	// Continue with the step size of the previous time step instead of
+	// estimating it again
+	if (mLastInternalStep > 0) {
+		mFlag = ARKodeSetInitStep(mArkode_mem, mLastInternalStep);
+		if (check_flag(&mFlag, "ARKodeSetInitStep", 1)) throw CPS::Exception();
+	}
+}
+
+void ODESolver::freeIntegrator() {
+	if (mArkode_mem)
+		ARKodeFree(&mArkode_mem);
+	if (LS)
+		SUNLinSolFree(LS);
+	if (A)
+		SUNMatDestroy(A);
+	mArkode_mem = NULL;
+	LS = NULL;
+	A = NULL;
+}
+
+Real ODESolver::step(Real initial_time) {
+	// Not absolutely necessary; realtype by default double (same as Real)
+	realtype T0 = (realtype) initial_time;
+	realtype Tf = (realtype) initial_time+mTimestep;
+
+	/// Number of integration steps
+	long int nst;
+	/// Number of error test fails
+	long int netf;
+
+	mComponent->attribute<Matrix>("ode_post_state")->set(mComponent->attribute<Matrix>("ode_pre_state")->get());
+
+	if (mPersistentIntegrator && mArkode_mem) {
+		reinitIntegrator(T0);
+	}
+	else {
+		// Better allocate the arkode memory here to prevent numerical problems
+		createIntegrator(T0);
+	}
+
+	if (mPersistentIntegrator) {
+		// Do not integrate beyond the time step with the current inputs
+		mFlag = ARKodeSetStopTime(mArkode_mem, Tf);
+		if (check_flag(&mFlag, "ARKodeSetStopTime", 1)) throw CPS::Exception();
+	}
 
 	// Main integrator loop
 	realtype t = T0;
@@ -181,9 +225,13 @@ Real ODESolver::step(Real initial_time) {
 	if(check_flag(&mFlag, "ARKodeGetNumErrTestFails", 1))
 		return 1;
 
-	ARKodeFree(&mArkode_mem);
-	SUNLinSolFree(LS);
-	SUNMatDestroy(A);
+	if (mPersistentIntegrator) {
+		mFlag = ARKodeGetLastStep(mArkode_mem, &mLastInternalStep);
+		if (check_flag(&mFlag, "ARKodeGetLastStep", 1))
+			mLastInternalStep = 0;
+	}
+	else
+		freeIntegrator();
 
 	// Print statistics:
 	//std::cout << "Number Computing Steps: "<< nst << " Number Error-Test-Fails: " << netf << std::endl;
@@ -228,5 +276,6 @@ int ODESolver::check_flag(void *flagvalue, const std::string funcname, int opt){
 }
 
 ODESolver::~ODESolver() {
+	freeIntegrator();
 	N_VDestroy(mStates);
 }
@@ -7,6 +7,7 @@
  *********************************************************************************/
 
 #include <dpsim/OpenMPLevelScheduler.h>
+#include <cps/AttributeList.h>
 #include <omp.h>
 
 #include <iostream>
@@ -15,6 +16,7 @@ using namespace CPS;
 using namespace DPsim;
 
 OpenMPLevelScheduler::OpenMPLevelScheduler(Int threads, String outMeasurementFile) : mOutMeasurementFile(outMeasurementFile) {
+	mMeasureTaskTimes = !outMeasurementFile.empty();
 	if (threads >= 0)
 		mNumThreads = threads;
 	else
@@ -27,34 +29,35 @@ void OpenMPLevelScheduler::createSchedule(const Task::List& tasks, const Edges&
 	Scheduler::topologicalSort(tasks, inEdges, outEdges, ordered);
 	Scheduler::levelSchedule(ordered, inEdges, outEdges, mLevels);
 
-	if (!mOutMeasurementFile.empty())
+	if (mMeasureTaskTimes || mTrackAllocations)
 		Scheduler::initMeasurements(tasks);
+	Scheduler::initTracing(mNumThreads);
 }
 
 void OpenMPLevelScheduler::step(Real time, Int timeStepCount) {
 	size_t i = 0, level = 0;
-	std::chrono::steady_clock::time_point start, end;
 
-	if (!mOutMeasurementFile.empty()) {
-		#pragma omp parallel shared(time,timeStepCount) private(level, i, start, end) num_threads(mNumThreads)
-		for (level = 0; level < mLevels.size(); level++) {
-			{
+	if (timeTasks()) {
+		#pragma omp parallel shared(time,timeStepCount) private(level, i) num_threads(mNumThreads)
+		{
+			CPS::AttributeList::LookupCheck lookupCheck;
+			for (level = 0; level < mLevels.size(); level++) {
 				#pragma omp for schedule(static)
 				for (i = 0; i < mLevels[level].size(); i++) {
-					start = std::chrono::steady_clock::now();
-					mLevels[level][i]->execute(time, timeStepCount);
-					end = std::chrono::steady_clock::now();
-					updateMeasurement(mLevels[level][i].get(), end-start);
+					if (mLevels[level][i]->isActive(timeStepCount))
+						executeTimedTask(omp_get_thread_num(), mLevels[level][i].get(), time, timeStepCount);
 				}
 			}
 		}
 	} else {
 		#pragma omp parallel shared(time,timeStepCount) private(level, i) num_threads(mNumThreads)
-		for (level = 0; level < mLevels.size(); level++) {
-			{
+		{
+			CPS::AttributeList::LookupCheck lookupCheck;
+			for (level = 0; level < mLevels.size(); level++) {
 				#pragma omp for schedule(static)
 				for (i = 0; i < mLevels[level].size(); i++) {
-					mLevels[level][i]->execute(time, timeStepCount);
+					if (mLevels[level][i]->isActive(timeStepCount))
+						mLevels[level][i]->execute(time, timeStepCount);
 				}
 			}
 		}
@@ -65,4 +68,5 @@ void OpenMPLevelScheduler::stop() {
 	if (!mOutMeasurementFile.empty()) {
 		writeMeasurements(mOutMeasurementFile);
 	}
+	writeTrace();
 }
@@ -52,7 +52,12 @@ void PFSolver::initialize(){
     determinePFBusType();
     composeAdmittanceMatrix();
 
-	mJ.setZero(mNumUnknowns,mNumUnknowns);
+	// The sparsity pattern of the Jacobian only depends on the admittance
+	// matrix, so the symbolic factorization is computed once
+	mJ.resize(mNumUnknowns, mNumUnknowns);
+	createJacobianPattern();
+	mJ.makeCompressed();
+	mJLu.analyzePattern(mJ);
 	mX.setZero(mNumUnknowns);
 	mF.setZero(mNumUnknowns);
 }
@@ -219,6 +224,10 @@ void PFSolver::determinePFBusType() {
     mPQPVBusIndices.insert(mPQPVBusIndices.end(), mPQBusIndices.begin(), mPQBusIndices.end());
     mPQPVBusIndices.insert(mPQPVBusIndices.end(), mPVBusIndices.begin(), mPVBusIndices.end());
 
+	mPQPVBusPositions.assign(mSystem.mNodes.size(), -1);
+	for (UInt a = 0; a < mPQPVBusIndices.size(); a++)
+		mPQPVBusPositions[mPQPVBusIndices[a]] = a;
+
 	mSLog->info("#### Create index vectors for power flow solver:");
     mSLog->info("PQ Buses: {}", logVector(mPQBusIndices));
     mSLog->info("PV Buses: {}", logVector(mPVBusIndices));
@@ -305,12 +314,15 @@ Bool PFSolver::solvePowerflow() {
     for (unsigned i = 1; i < mMaxIterations && !isConverged; ++i) {
 
         calculateJacobian();
-		auto sparseJ = mJ.sparseView();
 
 		// Solve system mJ*mX = mF
-        Eigen::SparseLU<SparseMatrix>lu(sparseJ);
-
-		mX = lu.solve(mF);	/* code */
+		mJLu.factorize(mJ);
+		if (mJLu.info() != Eigen::Success) {
+			mSLog->error("Factorization of the Jacobian failed in iteration {}", i);
+			isConverged = false;
+			break;
+		}
+		mX = mJLu.solve(mF);
 
 		// Calculate new solution based on mX increments obtained from equation system
 		updateSolution();
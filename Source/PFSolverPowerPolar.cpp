@@ -139,102 +139,87 @@ void PFSolverPowerPolar::calculateMismatch() {
     }
 }
 
-void PFSolverPowerPolar::calculateJacobian() {
+void PFSolverPowerPolar::createJacobianPattern() {
     UInt npqpv = mNumPQBuses + mNumPVBuses;
-    double val;
-    UInt k, j;
-    UInt da, db;
-
-    mJ.setZero();
-
-    //J1
-    for (UInt a = 0; a < npqpv; a++) { //rows
-        k = mPQPVBusIndices[a];
-        //diagonal
-        mJ.coeffRef(a, a) = -Q(k) - B(k, k) * sol_V.coeff(k) * sol_V.coeff(k);
+    std::vector<Eigen::Triplet<Real>> entries;
 
-        //non diagonal elements
-        for (UInt b = 0; b < npqpv; b++) {
-            if (b != a) {
-                j = mPQPVBusIndices[b];
-                val = sol_V.coeff(k) * sol_V.coeff(j)
-                        *(G(k, j) * sin(sol_D.coeff(k) - sol_D.coeff(j))
-                        - B(k, j) * cos(sol_D.coeff(k) - sol_D.coeff(j)));
-                //if (val != 0.0)
-                mJ.coeffRef(a, b) = val;
-            }
+    for (UInt a = 0; a < npqpv; a++) {
+        UInt k = mPQPVBusIndices[a];
+
+        // diagonal elements of J1 to J4
+        entries.emplace_back(a, a, 0.);
+        if (a < mNumPQBuses) {
+            entries.emplace_back(a, a + npqpv, 0.);
+            entries.emplace_back(a + npqpv, a, 0.);
+            entries.emplace_back(a + npqpv, a + npqpv, 0.);
         }
-    }
 
-    //J2
-    da = 0;
-    db = npqpv;
-    for (UInt a = 0; a < npqpv; a++) { //rows
-        k = mPQPVBusIndices[a];
-        //diagonal
-        //std::cout << "J2D:" << (a + da) << "," << (a + db) << std::endl;
-        if (a < mNumPQBuses)
-            mJ.coeffRef(a + da, a + db) = P(k) + G(k, k) * sol_V.coeff(k) * sol_V.coeff(k);
-
-        //non diagonal elements
-        for (UInt b = 0; b < mNumPQBuses; b++) {
-            if (b != a) {
-                j = mPQPVBusIndices[b];
-                val = sol_V.coeff(k) * sol_V.coeff(j)
-                        *(G(k, j) * cos(sol_D.coeff(k) - sol_D.coeff(j))
-                        + B(k, j) * sin(sol_D.coeff(k) - sol_D.coeff(j)));
-                //if (val != 0.0)
-                //std::cout << "J2ij:" << (a + da) << "," << (b + db) << std::endl;
-                mJ.coeffRef(a + da, b + db) = val;
-            }
+        // non diagonal elements only exist for connected buses
+        for (CPS::SparseMatrixCompRow::InnerIterator it(mY, k); it; ++it) {
+            Int b = mPQPVBusPositions[it.col()];
+            if (b < 0 || static_cast<UInt>(b) == a)
+                continue;
+
+            entries.emplace_back(a, b, 0.);
+            if (static_cast<UInt>(b) < mNumPQBuses)
+                entries.emplace_back(a, b + npqpv, 0.);
+            if (a < mNumPQBuses)
+                entries.emplace_back(a + npqpv, b, 0.);
+            if (a < mNumPQBuses && static_cast<UInt>(b) < mNumPQBuses)
+                entries.emplace_back(a + npqpv, b + npqpv, 0.);
         }
     }
+    mJ.setFromTriplets(entries.begin(), entries.end());
 
+    mSLog->info("Jacobian has {} non-zeros for {} unknowns", mJ.nonZeros(), mNumUnknowns);
+}
 
-    //J3
-    da = npqpv;
-    db = 0;
-    for (UInt a = 0; a < mNumPQBuses; a++) { //rows
+void PFSolverPowerPolar::calculateJacobian() {
+    UInt npqpv = mNumPQBuses + mNumPVBuses;
+    Real val;
+    UInt k, j;
+
+    // Only the values change, the sparsity pattern of mJ is fixed
+    mJ.coeffs().setZero();
+
+    for (UInt a = 0; a < npqpv; a++) { //rows
         k = mPQPVBusIndices[a];
-        //diagonal
-        //std::cout << "J3:" << (a + da) << "," << (a + db) << std::endl;
-        mJ.coeffRef(a + da, a + db) = P(k) - G(k, k) * sol_V.coeff(k) * sol_V.coeff(k);
-
-        //non diagonal elements
-        for (UInt b = 0; b < npqpv; b++) {
-            if (b != a) {
-                j = mPQPVBusIndices[b];
-                val = sol_V.coeff(k) * sol_V.coeff(j)
-                        *(G(k, j) * cos(sol_D.coeff(k) - sol_D.coeff(j))
-                        + B(k, j) * sin(sol_D.coeff(k) - sol_D.coeff(j)));
-                //if (val != 0.0)
-                //std::cout << "J3:" << (a + da) << "," << (b + db) << std::endl;
-                mJ.coeffRef(a + da, b + db) = -val;
-            }
+
+        //diagonal elements of J1 to J4
+        mJ.coeffRef(a, a) = -Q(k) - B(k, k) * sol_V.coeff(k) * sol_V.coeff(k);
+        if (a < mNumPQBuses) {
+            mJ.coeffRef(a, a + npqpv) = P(k) + G(k, k) * sol_V.coeff(k) * sol_V.coeff(k);
+            mJ.coeffRef(a + npqpv, a) = P(k) - G(k, k) * sol_V.coeff(k) * sol_V.coeff(k);
+            mJ.coeffRef(a + npqpv, a + npqpv) = Q(k) - B(k, k) * sol_V.coeff(k) * sol_V.coeff(k);
         }
-    }
 
-    //J4
-    da = npqpv;
-    db = npqpv;
-    for (UInt a = 0; a < mNumPQBuses; a++) { //rows
-        k = mPQPVBusIndices[a];
-        //diagonal
-        //std::cout << "J4:" << (a + da) << "," << (a + db) << std::endl;
-        mJ.coeffRef(a + da, a + db) = Q(k) - B(k, k) * sol_V.coeff(k) * sol_V.coeff(k);
-
-        //non diagonal elements
-        for (UInt b = 0; b < mNumPQBuses; b++) {
-            if (b != a) {
-                j = mPQPVBusIndices[b];
-                val = sol_V.coeff(k) * sol_V.coeff(j)
-                        *(G(k, j) * sin(sol_D.coeff(k) - sol_D.coeff(j))
-                        - B(k, j) * cos(sol_D.coeff(k) - sol_D.coeff(j)));
-                if (val != 0.0) {
-                    //std::cout << "J4:" << (a + da) << "," << (b + db) << std::endl;
-                    mJ.coeffRef(a + da, b + db) = val;
-                }
-            }
+        //non diagonal elements, only non-zero for buses connected by the admittance matrix
+        for (CPS::SparseMatrixCompRow::InnerIterator it(mY, k); it; ++it) {
+            j = it.col();
+            Int b = mPQPVBusPositions[j];
+            if (b < 0 || static_cast<UInt>(b) == a)
+                continue;
+
+            Real g = it.value().real();
+            Real bkj = it.value().imag();
+            Real vv = sol_V.coeff(k) * sol_V.coeff(j);
+            Real s = sin(sol_D.coeff(k) - sol_D.coeff(j));
+            Real c = cos(sol_D.coeff(k) - sol_D.coeff(j));
+
+            //J1
+            val = vv * (g * s - bkj * c);
+            mJ.coeffRef(a, b) = val;
+            //J4
+            if (a < mNumPQBuses && static_cast<UInt>(b) < mNumPQBuses)
+                mJ.coeffRef(a + npqpv, b + npqpv) = val;
+
+            //J2
+            val = vv * (g * c + bkj * s);
+            if (static_cast<UInt>(b) < mNumPQBuses)
+                mJ.coeffRef(a, b + npqpv) = val;
+            //J3
+            if (a < mNumPQBuses)
+                mJ.coeffRef(a + npqpv, b) = -val;
         }
     }
 }
@@ -362,20 +347,22 @@ void PFSolverPowerPolar::calculateNodalInjection() {
 
 Real PFSolverPowerPolar::P(UInt k) {
     Real val = 0.0;
-    for (UInt j = 0; j < mSystem.mNodes.size(); j++) {
+    for (CPS::SparseMatrixCompRow::InnerIterator it(mY, k); it; ++it) {
+        UInt j = it.col();
         val += sol_V.coeff(j)
-                *(G(k, j) * cos(sol_D.coeff(k) - sol_D.coeff(j))
-                + B(k, j) * sin(sol_D.coeff(k) - sol_D.coeff(j)));
+                *(it.value().real() * cos(sol_D.coeff(k) - sol_D.coeff(j))
+                + it.value().imag() * sin(sol_D.coeff(k) - sol_D.coeff(j)));
     }
     return sol_V.coeff(k) * val;
 }
 
 Real PFSolverPowerPolar::Q(UInt k) {
     Real val = 0.0;
-    for (UInt j = 0; j < mSystem.mNodes.size(); j++) {
+    for (CPS::SparseMatrixCompRow::InnerIterator it(mY, k); it; ++it) {
+        UInt j = it.col();
         val += sol_V.coeff(j)
-                *(G(k, j) * sin(sol_D.coeff(k) - sol_D.coeff(j))
-                - B(k, j) * cos(sol_D.coeff(k) - sol_D.coeff(j)));
+                *(it.value().real() * sin(sol_D.coeff(k) - sol_D.coeff(j))
+                - it.value().imag() * cos(sol_D.coeff(k) - sol_D.coeff(j)));
     }
     return sol_V.coeff(k) * val;
 }
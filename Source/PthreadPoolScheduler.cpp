@@ -124,7 +124,9 @@ void* PthreadPoolScheduler::poolThreadFunction(void* data) {
 
 		t = *static_cast<Task::Ptr*>(p);
 		//std::cout << "worker: pulled " << t->toString() << std::endl;
-		t->execute(sched->mTime, sched->mTimeStepCount);
+		// Skipped tasks are reported as done to release their successors
+		if (t->isActive(sched->mTimeStepCount))
+			t->execute(sched->mTime, sched->mTimeStepCount);
 		if (queue_signalled_push(&sched->mDoneQueue, p) != 1)
 			throw SchedulingException();
 		//std::cout << "worker: done with " << t->toString() << std::endl;
@@ -47,6 +47,14 @@ void Python::Logger::dealloc(Python::Logger* self)
 	Py_TYPE(self)->tp_free((PyObject*) self);
 }
 
+const char* Python::Logger::docDroppedRows =
+"dropped_rows()\n"
+"Number of rows discarded by the asynchronous writer because its ring buffer was full.\n";
+PyObject* Python::Logger::droppedRows(Logger* self, PyObject* args)
+{
+	return PyLong_FromSize_t(self->logger->droppedRows());
+}
+
 const char* Python::Logger::docLogAttribute =
 "log_attribute(comp, attr)\n"
 "Register a source with this Logger, causing it to use values received from "
@@ -107,14 +115,38 @@ PyObject* Python::Logger::logAttribute(Logger* self, PyObject* args, PyObject *k
 
 int Python::Logger::init(Python::Logger *self, PyObject *args, PyObject *kwds)
 {
-	static const char *kwlist[] = {"filename", "down_sampling", nullptr};
+	static const char *kwlist[] = {"filename", "down_sampling", "binary", "async_write", "async_capacity", "back_pressure", nullptr};
 	int downsampling = 1;
+	int binary = 0;
+	int asyncWrite = 0;
+	int asyncCapacity = 4096;
+	const char *backPressureName = "block";
 
-	if (!PyArg_ParseTupleAndKeywords(args, kwds, "s|i", (char **) kwlist, &self->filename, &downsampling)) {
+	if (!PyArg_ParseTupleAndKeywords(args, kwds, "s|ippis", (char **) kwlist, &self->filename, &downsampling, &binary, &asyncWrite, &asyncCapacity, &backPressureName)) {
 		return -1;
 	}
 
-	self->logger = DPsim::DataLogger::make(self->filename, true, downsampling);
+	CPS::String backPressureStr(backPressureName);
+	DPsim::DataLogger::BackPressure backPressure;
+	if (backPressureStr == "block")
+		backPressure = DPsim::DataLogger::BackPressure::Block;
+	else if (backPressureStr == "drop")
+		backPressure = DPsim::DataLogger::BackPressure::Drop;
+	else if (backPressureStr == "report")
+		backPressure = DPsim::DataLogger::BackPressure::Report;
+	else {
+		PyErr_SetString(PyExc_ValueError, "back_pressure must be 'block', 'drop' or 'report'");
+		return -1;
+	}
+
+	if (asyncCapacity < 1) {
+		PyErr_SetString(PyExc_ValueError, "async_capacity must be positive");
+		return -1;
+	}
+
+	self->logger = DPsim::DataLogger::make(self->filename, true, downsampling,
+		binary ? DPsim::DataLogger::Format::Binary : DPsim::DataLogger::Format::CSV);
+	self->logger->doAsyncWrite(asyncWrite, asyncCapacity, backPressure);
 
 	return 0;
 }
@@ -126,11 +158,20 @@ PyMemberDef Python::Logger::members[] = {
 
 PyMethodDef Python::Logger::methods[] = {
 	{"log_attribute", (PyCFunction) Python::Logger::logAttribute, METH_VARARGS | METH_KEYWORDS, Python::Logger::docLogAttribute},
+	{"dropped_rows", (PyCFunction) Python::Logger::droppedRows, METH_NOARGS, Python::Logger::docDroppedRows},
 	{nullptr},
 };
 
 const char* Python::Logger::doc =
-"__init__(filename)\n";
+"__init__(filename, down_sampling=1, binary=False, async_write=False, async_capacity=4096, back_pressure='block')\n"
+"\n"
+":param binary: Write raw doubles to a binary file instead of a CSV file. "
+"Use ``dpsim.BinaryLog`` to read or convert it.\n"
+":param async_write: Write the rows from a separate thread.\n"
+":param async_capacity: Number of rows in the ring buffer of the asynchronous writer.\n"
+":param back_pressure: Behaviour if the ring buffer is full: 'block' waits for the writer, "
+"'drop' discards the row, 'report' discards the row and reports the number of "
+"discarded rows when the logger is closed.\n";
 PyTypeObject Python::Logger::type = {
 	PyVarObject_HEAD_INIT(nullptr, 0)
 	"dpsim.Logger",                          /* tp_name */
@@ -14,6 +14,7 @@
  * along with this program. If not, see <http://www.gnu.org/licenses/>.
  *********************************************************************************/
 
+#include <algorithm>
 #include <chrono>
 #include <cfloat>
 #include <iostream>
@@ -26,8 +27,11 @@
 #include <dpsim/Python/Interface.h>
 #include <dpsim/RealTimeSimulation.h>
 #include <dpsim/SequentialScheduler.h>
+#include <dpsim/ThreadPlacement.h>
 #include <dpsim/ThreadLevelScheduler.h>
 #include <dpsim/ThreadListScheduler.h>
+#include <dpsim/ThreadCriticalPathScheduler.h>
+#include <dpsim/WorkStealingScheduler.h>
 #include <cps/DP/DP_Ph1_Switch.h>
 
 #ifdef WITH_OPENMP
@@ -86,6 +90,8 @@ void Python::Simulation::threadFunction(Python::Simulation *self)
 			catch (Timer::OverrunException) {
 				std::unique_lock<std::mutex> lk(*self->mut);
 
+				self->sim->recordOverrun();
+
 				if (self->failOnOverrun) {
 					newState(self, Simulation::State::overrun);
 					self->cond->notify_one();
@@ -166,11 +172,11 @@ int Python::Simulation::init(Simulation* self, PyObject *args, PyObject *kwds)
 	static const char *kwlist[] = {"name", "system", "timestep", "duration",
 	"start_time", "start_time_us", "sim_type", "solver_type", "single_stepping",
 	"rt", "rt_factor", "start_sync", "init_steady_state", "log_level",
-	"fail_on_overrun", "split_subnets", "tear_components", nullptr};
+	"fail_on_overrun", "split_subnets", "tear_components", "overrun_analysis", nullptr};
 	double timestep = 1e-3, duration = DBL_MAX, rtFactor = 1;
 	const char *name = nullptr;
 	int t = 0, s = 0, rt = 0, ss = 0, st = 0, log_level = 2, initSteadyState = 0, splitSubnets = 1;
-	int failOnOverrun = 0;
+	int failOnOverrun = 0, overrunAnalysis = 0;
 
 	unsigned long startTime = -1;
 	unsigned long startTimeUs = 0;
@@ -182,11 +188,11 @@ int Python::Simulation::init(Simulation* self, PyObject *args, PyObject *kwds)
 	CPS::IdentifiedObject::List tearComponents;
 	PyObject* pyTearComponents = nullptr;
 
-	if (!PyArg_ParseTupleAndKeywords(args, kwds, "sO|ddkkiippdppippO", (char **) kwlist,
+	if (!PyArg_ParseTupleAndKeywords(args, kwds, "sO|ddkkiippdppippOp", (char **) kwlist,
 		&name, &self->pySys, &timestep, &duration,
 		&startTime, &startTimeUs, &s, &t, &ss,
 		&rt, &rtFactor, &st, &initSteadyState, &log_level,
-		&failOnOverrun, &splitSubnets, &pyTearComponents)) {
+		&failOnOverrun, &splitSubnets, &pyTearComponents, &overrunAnalysis)) {
 		return -1;
 	}
 
@@ -264,6 +270,7 @@ int Python::Simulation::init(Simulation* self, PyObject *args, PyObject *kwds)
 		self->sim->doSplitSubnets(splitSubnets);
 		self->sim->setTearingComponents(tearComponents);
 	}
+	self->sim->doOverrunAnalysis(overrunAnalysis);
 	self->channel = new EventChannel();
 
 	return 0;
@@ -636,20 +643,84 @@ PyObject * Python::Simulation::removeEventFD(Simulation *self, PyObject *args) {
 const char *Python::Simulation::docSetScheduler =
 "set_scheduler(scheduler,...)\n"
 "Set the scheduler to be used for parallel simulation, as well as "
-"additional scheduler-specific parameters.\n";
+"additional scheduler-specific parameters.\n"
+"The threads of the thread_* schedulers are placed on the cores of the host "
+"according to `placement` ('none', 'cores', 'compact', 'scatter' or 'numa'). "
+"`cores` is a core list like '0-3,8' for the 'cores' placement, `priority` a "
+"SCHED_FIFO priority and `lock_memory` locks the memory of the process. "
+"Waiting threads spin for `spin_budget` nanoseconds before they block "
+"(default -1: spin without limit).\n";
 PyObject* Python::Simulation::setScheduler(Simulation *self, PyObject *args, PyObject *kwargs)
 {
 	const char *outMeasurementFile = "";
 	const char *inMeasurementFile = "";
+	const char *inMeasurementStatistic = "mean";
+	const char *traceFile = "";
+	const char *placementName = "";
+	const char *cores = "";
 	const char *schedName = nullptr;
 	int threads = -1;
 	bool useConditionVariable = false;
 	bool sortTaskTypes = false;
+	bool pinThreads = false;
+	bool pipelineOutputs = false;
+	bool lockMemory = false;
+	int priority = 0;
+	int spinBudget = -1;
+	double syncCost = 0;
+
+	const char *kwlist[] = {"scheduler", "threads", "out_measurement_file", "in_measurement_file", "use_condition_variable", "sort_task_types", "pin_threads", "in_measurement_statistic", "sync_cost", "trace_file", "pipeline_outputs", "placement", "cores", "priority", "lock_memory", "spin_budget", nullptr};
+
+	if (!PyArg_ParseTupleAndKeywords(args, kwargs, "s|issbbbsdsbssibi", (char **) kwlist, &schedName, &threads, &outMeasurementFile, &inMeasurementFile, &useConditionVariable, &sortTaskTypes, &pinThreads, &inMeasurementStatistic, &syncCost, &traceFile, &pipelineOutputs, &placementName, &cores, &priority, &lockMemory, &spinBudget))
+		return nullptr;
+
+	Scheduler::MeasurementStatistic statistic;
+	if (!strcmp(inMeasurementStatistic, "mean")) {
+		statistic = Scheduler::MeasurementStatistic::Mean;
+	} else if (!strcmp(inMeasurementStatistic, "p50")) {
+		statistic = Scheduler::MeasurementStatistic::P50;
+	} else if (!strcmp(inMeasurementStatistic, "p99")) {
+		statistic = Scheduler::MeasurementStatistic::P99;
+	} else if (!strcmp(inMeasurementStatistic, "p99.9")) {
+		statistic = Scheduler::MeasurementStatistic::P999;
+	} else if (!strcmp(inMeasurementStatistic, "max")) {
+		statistic = Scheduler::MeasurementStatistic::Max;
+	} else {
+		PyErr_SetString(PyExc_ValueError, "invalid measurement statistic");
+		return nullptr;
+	}
+
+	// A core list without a policy pins the threads to the given cores
+	ThreadPlacement::Policy policy;
+	if (!strcmp(placementName, "")) {
+		policy = strlen(cores) > 0 ? ThreadPlacement::Policy::Explicit : ThreadPlacement::Policy::None;
+	} else if (!strcmp(placementName, "none")) {
+		policy = ThreadPlacement::Policy::None;
+	} else if (!strcmp(placementName, "cores")) {
+		policy = ThreadPlacement::Policy::Explicit;
+	} else if (!strcmp(placementName, "compact")) {
+		policy = ThreadPlacement::Policy::Compact;
+	} else if (!strcmp(placementName, "scatter")) {
+		policy = ThreadPlacement::Policy::Scatter;
+	} else if (!strcmp(placementName, "numa")) {
+		policy = ThreadPlacement::Policy::NumaNode;
+	} else {
+		PyErr_SetString(PyExc_ValueError, "invalid thread placement");
+		return nullptr;
+	}
 
-	const char *kwlist[] = {"scheduler", "threads", "out_measurement_file", "in_measurement_file", "use_condition_variable", "sort_task_types", nullptr};
+	ThreadPlacement placement;
+	try {
+		placement = ThreadPlacement(policy, ThreadPlacement::parseCpuList(cores), priority, lockMemory);
+	} catch (const std::invalid_argument& e) {
+		PyErr_SetString(PyExc_ValueError, e.what());
+		return nullptr;
+	}
 
-	if (!PyArg_ParseTupleAndKeywords(args, kwargs, "s|issbb", (char **) kwlist, &schedName, &threads, &outMeasurementFile, &inMeasurementFile, &useConditionVariable, &sortTaskTypes))
+	if (!placement.isDefault() && strncmp(schedName, "thread_", 7)) {
+		PyErr_SetString(PyExc_ValueError, "thread placement requires a thread scheduler");
 		return nullptr;
+	}
 
 	if (!strcmp(schedName, "sequential")) {
 		self->sim->setScheduler(std::make_shared<SequentialScheduler>(outMeasurementFile));
@@ -673,15 +744,35 @@ PyObject* Python::Simulation::setScheduler(Simulation *self, PyObject *args, PyO
 		// TODO sensible default (`nproc`?)
 		if (threads <= 0)
 			threads = 1;
-		self->sim->setScheduler(std::make_shared<ThreadLevelScheduler>(threads, outMeasurementFile, inMeasurementFile, useConditionVariable, sortTaskTypes));
+		self->sim->setScheduler(std::make_shared<ThreadLevelScheduler>(threads, outMeasurementFile, inMeasurementFile, useConditionVariable, sortTaskTypes, placement));
 	} else if (!strcmp(schedName, "thread_list")) {
 		if (threads <= 0)
 			threads = 1;
-		self->sim->setScheduler(std::make_shared<ThreadListScheduler>(threads, outMeasurementFile, inMeasurementFile, useConditionVariable));
+		self->sim->setScheduler(std::make_shared<ThreadListScheduler>(threads, outMeasurementFile, inMeasurementFile, useConditionVariable, placement));
+	} else if (!strcmp(schedName, "thread_critical_path")) {
+		if (threads <= 0)
+			threads = 1;
+		self->sim->setScheduler(std::make_shared<ThreadCriticalPathScheduler>(threads, outMeasurementFile, inMeasurementFile, useConditionVariable, syncCost, placement));
+	} else if (!strcmp(schedName, "work_stealing")) {
+		if (threads <= 0)
+			threads = std::max<int>(std::thread::hardware_concurrency(), 1);
+		self->sim->setScheduler(std::make_shared<WorkStealingScheduler>(threads, outMeasurementFile, pinThreads));
 	} else {
 		PyErr_SetString(PyExc_ValueError, "invalid scheduler");
 		return nullptr;
 	}
+	self->sim->scheduler()->setMeasurementStatistic(statistic);
+	if (strlen(traceFile) > 0)
+		self->sim->scheduler()->doTracing(traceFile);
+	if (pipelineOutputs || spinBudget != -1) {
+		auto threadScheduler = std::dynamic_pointer_cast<ThreadScheduler>(self->sim->scheduler());
+		if (!threadScheduler) {
+			PyErr_SetString(PyExc_ValueError, "pipelined outputs and spin budgets require a thread scheduler");
+			return nullptr;
+		}
+		threadScheduler->doPipelineOutputs(pipelineOutputs);
+		threadScheduler->setSpinBudget(spinBudget);
+	}
 
 	Py_RETURN_NONE;
 }
@@ -746,13 +837,75 @@ PyObject* Python::Simulation::avgStepTime(Simulation *self, void *ctx)
 {
 	std::unique_lock<std::mutex> lk(*self->mut);
 
-	Real tot = 0;
-	for (auto meas : self->sim->stepTimes()) {
-		tot += meas;
+	auto avg = std::chrono::duration<Real>(self->sim->stepTimeStatistics().mean());
+
+	return Py_BuildValue("f", avg.count());
+}
+
+const char *Python::Simulation::docStepTimeStats =
+"step_time_stats\n"
+"Statistics of the step times in seconds: count, mean, stddev, min, max, "
+"p50, p99 and p99.9.\n";
+PyObject* Python::Simulation::stepTimeStats(Simulation *self, void *ctx)
+{
+	std::unique_lock<std::mutex> lk(*self->mut);
+
+	auto& stats = self->sim->stepTimeStatistics();
+	auto seconds = [](Scheduler::TaskTime time) {
+		return std::chrono::duration<Real>(time).count();
+	};
+
+	return Py_BuildValue("{s:K,s:d,s:d,s:d,s:d,s:d,s:d,s:d}",
+		"count", (unsigned long long) stats.count(),
+		"mean", seconds(stats.mean()),
+		"stddev", stats.stddev() * 1e-9,
+		"min", seconds(stats.min()),
+		"max", seconds(stats.max()),
+		"p50", seconds(stats.quantile(0.5)),
+		"p99", seconds(stats.quantile(0.99)),
+		"p99.9", seconds(stats.quantile(0.999)));
+}
+
+const char *Python::Simulation::docStepTimeHistogram =
+"step_time_histogram\n"
+"Non-empty buckets of the step time histogram as a list of "
+"(upper bound in seconds, count).\n";
+PyObject* Python::Simulation::stepTimeHistogram(Simulation *self, void *ctx)
+{
+	std::unique_lock<std::mutex> lk(*self->mut);
+
+	auto& counts = self->sim->stepTimeStatistics().histogram().counts();
+	PyObject *list = PyList_New(0);
+	for (UInt idx = 0; idx < counts.size(); idx++) {
+		if (counts[idx] == 0)
+			continue;
+
+		Real bound = LatencyHistogram::bucketUpperBound(idx) * 1e-9;
+		PyObject *bucket = Py_BuildValue("(dK)", bound, (unsigned long long) counts[idx]);
+		PyList_Append(list, bucket);
+		Py_DECREF(bucket);
+	}
+
+	return list;
+}
+
+const char *Python::Simulation::docOverrunTasks =
+"overrun_tasks\n"
+"Number of real-time overruns per task that exceeded its mean execution "
+"time the most in the overrunning step. Only counted if the simulation "
+"was created with overrun_analysis=True.\n";
+PyObject* Python::Simulation::overrunTasks(Simulation *self, void *ctx)
+{
+	std::unique_lock<std::mutex> lk(*self->mut);
+
+	PyObject *dict = PyDict_New();
+	for (auto& task : self->sim->overrunTasks()) {
+		PyObject *count = PyLong_FromUnsignedLong(task.second);
+		PyDict_SetItemString(dict, task.first.c_str(), count);
+		Py_DECREF(count);
 	}
-	Real avg = tot / self->sim->stepTimes().size();
 
-	return Py_BuildValue("f", avg);
+	return dict;
 }
 
 int Python::Simulation::setFinalTime(Simulation *self, PyObject *val, void *ctx)
@@ -776,6 +929,9 @@ PyGetSetDef Python::Simulation::getset[] = {
 	{(char *) "time",       (getter) Python::Simulation::time,  nullptr, nullptr, nullptr},
 	{(char *) "final_time", (getter) Python::Simulation::finalTime, (setter) Python::Simulation::setFinalTime, nullptr, nullptr},
 	{(char *) "avg_step_time", (getter) Python::Simulation::avgStepTime, nullptr, nullptr, nullptr},
+	{(char *) "step_time_stats", (getter) Python::Simulation::stepTimeStats, nullptr, (char *) Python::Simulation::docStepTimeStats, nullptr},
+	{(char *) "step_time_histogram", (getter) Python::Simulation::stepTimeHistogram, nullptr, (char *) Python::Simulation::docStepTimeHistogram, nullptr},
+	{(char *) "overrun_tasks", (getter) Python::Simulation::overrunTasks, nullptr, (char *) Python::Simulation::docOverrunTasks, nullptr},
 	{nullptr, nullptr, nullptr, nullptr, nullptr}
 };
 
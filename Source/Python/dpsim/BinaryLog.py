@@ -0,0 +1,102 @@
+"""Reader for the binary format of the DataLogger
+
+The file starts with a header:
+
+    char[8]  magic "DPSIMBIN"
+    uint32   format version
+    uint32   number of columns, including the time column
+    per column: uint32 name length, name characters
+
+followed by one record of float64 values per logged time step.
+All numbers are stored in the byte order of the simulation host.
+
+Usage as a converter to the CSV format of the DataLogger:
+
+    python -m dpsim.BinaryLog logs/sim/sim.bin logs/sim/sim.csv
+"""
+
+import struct
+import sys
+
+import numpy
+
+MAGIC = b'DPSIMBIN'
+VERSION = 1
+
+def read_header(f):
+    """Reads the header and returns the column names"""
+    magic = f.read(len(MAGIC))
+    if magic != MAGIC:
+        raise ValueError('Not a DPsim binary log file')
+
+    version, num_columns = struct.unpack('=II', f.read(8))
+    if version != VERSION:
+        raise ValueError('Unsupported binary log version {}'.format(version))
+
+    names = []
+    for _ in range(num_columns):
+        length, = struct.unpack('=I', f.read(4))
+        names.append(f.read(length).decode('utf-8'))
+
+    return names
+
+def read_binary_log(filename):
+    """Returns the column names and a 2D array with one row per time step"""
+    with open(filename, 'rb') as f:
+        names = read_header(f)
+        data = numpy.fromfile(f, dtype=numpy.float64)
+
+    # Drop an incomplete last record of an interrupted simulation
+    num_records = len(data) // len(names)
+    data = data[:num_records * len(names)].reshape(num_records, len(names))
+
+    return names, data
+
+def read_timeseries_dpsim_binary(filename):
+    """Returns a dictionary of villas TimeSeries like read_timeseries_dpsim
+
+    Columns with the suffixes .re and .im are combined into complex series.
+    """
+    from villas.dataprocessing.timeseries import TimeSeries
+
+    names, data = read_binary_log(filename)
+    time = data[:, 0]
+    columns = { name: data[:, idx] for idx, name in enumerate(names) if idx > 0 }
+
+    timeseries = {}
+    for name, values in columns.items():
+        if name.endswith('.re'):
+            base = name[:-3]
+            imag = columns.get(base + '.im')
+            if imag is not None:
+                timeseries[base] = TimeSeries(base, time, values + 1j * imag)
+                continue
+        elif name.endswith('.im') and name[:-3] + '.re' in columns:
+            continue
+
+        timeseries[name] = TimeSeries(name, time, values)
+
+    return timeseries
+
+def convert_to_csv(binary_filename, csv_filename):
+    """Writes a binary log in the CSV format of the DataLogger"""
+    names, data = read_binary_log(binary_filename)
+
+    with open(csv_filename, 'w') as f:
+        f.write('{:>14}'.format(names[0]))
+        for name in names[1:]:
+            f.write(', {:>13}'.format(name))
+        f.write('\n')
+
+        for record in data:
+            f.write('{:>14.6e}'.format(record[0]))
+            for value in record[1:]:
+                f.write(', {:>13.9e}'.format(value))
+            f.write('\n')
+
+if __name__ == '__main__':
+    if len(sys.argv) != 3:
+        print('Usage: {} BINARY_LOG CSV_FILE'.format(sys.argv[0]))
+        sys.exit(1)
+
+    convert_to_csv(sys.argv[1], sys.argv[2])
@@ -58,7 +58,9 @@ void RealTimeSimulation::run(const Timer::StartClock::time_point &startAt) {
 
 	// main loop
 	do {
-		mTimer.sleep();
+		// An overrun is caused by the previous step
+		if (mTimer.sleep() > 0 && mTimeStepCount > 0)
+			recordOverrun();
 		step();
 
 		if (mTimer.ticks() == 1)
@@ -66,6 +68,8 @@ void RealTimeSimulation::run(const Timer::StartClock::time_point &startAt) {
 	} while (mTime < mFinalTime);
 
 	mLog->info("Simulation finished.");
+	for (auto& task : mOverrunTasks)
+		mLog->info("Overruns caused by {}: {}", task.first, task.second);
 
 	mScheduler->stop();
 
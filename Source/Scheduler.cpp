@@ -10,6 +10,7 @@
 
 #include <fstream>
 #include <iostream>
+#include <sstream>
 #include <unordered_map>
 #include <unordered_set>
 
@@ -21,25 +22,47 @@ CPS::AttributeBase::Ptr Scheduler::external;
 void Scheduler::initMeasurements(const Task::List& tasks) {
 	// Fill map here already since it's not protected by a mutex
 	for (auto task : tasks) {
-		mMeasurements[task.get()] = std::vector<TaskTime>();
+		mMeasurements[task.get()].reset();
+		mMeasuredSteps[task.get()] = -1;
+		if (mTrackAllocations)
+			mAllocations[task.get()] = 0;
 	}
 }
 
-void Scheduler::updateMeasurement(Task* ptr, TaskTime time) {
-	mMeasurements[ptr].push_back(time);
+void Scheduler::updateMeasurement(Task* ptr, TaskTime time, Int timeStepCount) {
+	mMeasurements.at(ptr).add(time);
+	mMeasuredSteps.at(ptr) = timeStepCount;
 }
 
 void Scheduler::writeMeasurements(String filename) {
 	std::ofstream os(filename);
-	std::unordered_map<String, TaskTime> averages;
+	std::ofstream hist(filename + ".hist");
+	os << "# task,mean,count,stddev,min,max,p50,p99,p99.9" << std::endl;
+	hist << "# task,upper_bound,count" << std::endl;
 	for (auto& pair : mMeasurements) {
-		averages[pair.first->toString()] = getAveragedMeasurement(pair.first);
-	}
-	// TODO think of nicer output format
-	for (auto pair : averages) {
-		os << pair.first << "," << pair.second.count() << std::endl;
+		String name = pair.first->toString();
+		const TaskStatistics& stats = pair.second;
+		os << name << ","
+			<< stats.mean().count() << ","
+			<< stats.count() << ","
+			<< std::chrono::duration_cast<TaskTime>(std::chrono::duration<Real, std::nano>(stats.stddev())).count() << ","
+			<< stats.min().count() << ","
+			<< stats.max().count() << ","
+			<< stats.quantile(0.5).count() << ","
+			<< stats.quantile(0.99).count() << ","
+			<< stats.quantile(0.999).count() << std::endl;
+
+		auto& counts = stats.histogram().counts();
+		for (UInt idx = 0; idx < counts.size(); idx++) {
+			if (counts[idx] == 0)
+				continue;
+			auto bound = std::chrono::nanoseconds(LatencyHistogram::bucketUpperBound(idx));
+			hist << name << "," << std::chrono::duration_cast<TaskTime>(bound).count()
+				<< "," << counts[idx] << std::endl;
+		}
 	}
 	os.close();
+	hist.close();
 }
 
 void Scheduler::readMeasurements(String filename, std::unordered_map<String, TaskTime::rep>& measurements) {
@@ -47,31 +70,69 @@ void Scheduler::readMeasurements(String filename, std::unordered_map<String, Tas
 	if (!fs.good())
 		throw SchedulingException();
 
-	String name;
+	// Columns after the task name, see writeMeasurements
+	size_t column;
+	switch (mMeasurementStatistic) {
+	case MeasurementStatistic::P50: column = 5; break;
+	case MeasurementStatistic::P99: column = 6; break;
+	case MeasurementStatistic::P999: column = 7; break;
+	case MeasurementStatistic::Max: column = 4; break;
+	default: column = 0;
+	}
+
 	while (fs.good()) {
 		std::string line;
 		std::getline(fs, line);
-		int idx = static_cast<UInt>(line.find(','));
-		if (idx == -1) {
-			if (line.empty())
-				continue;
+		if (line.empty() || line[0] == '#')
+			continue;
+
+		std::vector<String> fields;
+		std::stringstream ss(line);
+		String field;
+		while (std::getline(ss, field, ','))
+			fields.push_back(field);
+		if (fields.size() < 2)
 			throw SchedulingException();
-		}
-		measurements[line.substr(0, idx)] = std::stol(line.substr(idx+1));
+
+		// Files of older versions only contain the mean
+		size_t idx = fields.size() > column + 1 ? column + 1 : 1;
+		measurements[fields[0]] = std::stol(fields[idx]);
 	}
 }
 
 Scheduler::TaskTime Scheduler::getAveragedMeasurement(CPS::Task* task) {
-	TaskTime avg(0), tot(0);
+	return mMeasurements[task].mean();
+}
 
-	for (TaskTime time : mMeasurements[task]) {
-		tot += time;
-	}
+void Scheduler::initTracing(Int threads) {
+	if (!mTraceFile.empty())
+		mTracer.reset(new TaskTracer(threads, mTraceEventsPerThread));
+}
+
+void Scheduler::writeTrace() {
+	if (mTracer)
+		mTracer->writeChromeTrace(mTraceFile);
+}
 
-	if (!mMeasurements[task].empty())
-		avg = tot / mMeasurements[task].size();
+Task* Scheduler::lastStepOutlier(Int timeStepCount, TaskStatistics const** stats) {
+	Task* outlier = nullptr;
+	TaskTime maxExcess = TaskTime::min();
+	for (auto& pair : mMeasurements) {
+		// Skipped tasks still report the time of an earlier step
+		auto step = mMeasuredSteps.find(pair.first);
+		if (step == mMeasuredSteps.end() || step->second != timeStepCount
+			|| mPipelinedTasks.count(pair.first))
+			continue;
 
-	return avg;
+		TaskTime excess = pair.second.last() - pair.second.mean();
+		if (excess > maxExcess) {
+			maxExcess = excess;
+			outlier = pair.first;
+			if (stats)
+				*stats = &pair.second;
+		}
+	}
+	return outlier;
 }
 
 
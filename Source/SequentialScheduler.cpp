@@ -20,8 +20,9 @@ using namespace DPsim;
 #include <unordered_map>
 
 void SequentialScheduler::createSchedule(const Task::List& tasks, const Edges& inEdges, const Edges& outEdges) {
-	if (mOutMeasurementFile.size() != 0)
+	if (mMeasureTaskTimes || mTrackAllocations)
 		Scheduler::initMeasurements(tasks);
+	Scheduler::initTracing(1);
 	Scheduler::topologicalSort(tasks, inEdges, outEdges, mSchedule);
 
 	for (auto task : mSchedule)
@@ -29,16 +30,15 @@ void SequentialScheduler::createSchedule(const Task::List& tasks, const Edges& i
 }
 
 void SequentialScheduler::step(Real time, Int timeStepCount) {
-	if (mOutMeasurementFile.size() != 0) {
+	if (timeTasks()) {
 		for (auto task : mSchedule) {
-			auto start = std::chrono::steady_clock::now();
-			task->execute(time, timeStepCount);
-			auto end = std::chrono::steady_clock::now();
-			updateMeasurement(task.get(), end-start);
+			if (task->isActive(timeStepCount))
+				executeTimedTask(0, task.get(), time, timeStepCount);
 		}
 	} else {
 		for (auto it : mSchedule) {
-			it->execute(time, timeStepCount);
+			if (it->isActive(timeStepCount))
+				it->execute(time, timeStepCount);
 		}
 	}
 }
@@ -46,4 +46,5 @@ void SequentialScheduler::step(Real time, Int timeStepCount) {
 void SequentialScheduler::stop() {
 	if (mOutMeasurementFile.size() != 0)
 		writeMeasurements(mOutMeasurementFile);
+	writeTrace();
 }
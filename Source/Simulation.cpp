@@ -14,6 +14,7 @@
  * along with this program. If not, see <http://www.gnu.org/licenses/>.
  *********************************************************************************/
 
+#include <cerrno>
 #include <chrono>
 #include <iomanip>
 #include <algorithm>
@@ -25,6 +26,7 @@
 #include <cps/Utils.h>
 #include <dpsim/MNASolver.h>
 #include <dpsim/MNASolverSysRecomp.h>
+#include <dpsim/MNASolverLowRank.h>
 #include <dpsim/PFSolverPowerPolar.h>
 #include <dpsim/DiakopticsSolver.h>
 
@@ -57,6 +59,18 @@ Simulation::Simulation(String name,	Logger::Level logLevel) :
 	addAttribute<Bool>("split_subnets", &mSplitSubnets, Flags::read|Flags::write);
 	addAttribute<Real>("time_step", &mTimeStep, Flags::read);
 
+	// Step time statistics in seconds
+	auto seconds = [](Scheduler::TaskTime time) {
+		return std::chrono::duration<Real>(time).count();
+	};
+	addAttribute<Int>("step_count", nullptr, [=](){ return static_cast<Int>(mStepTimeStatistics.count()); }, Flags::read);
+	addAttribute<Real>("step_time_mean", nullptr, [=](){ return seconds(mStepTimeStatistics.mean()); }, Flags::read);
+	addAttribute<Real>("step_time_stddev", nullptr, [=](){ return mStepTimeStatistics.stddev() * 1e-9; }, Flags::read);
+	addAttribute<Real>("step_time_max", nullptr, [=](){ return seconds(mStepTimeStatistics.max()); }, Flags::read);
+	addAttribute<Real>("step_time_p50", nullptr, [=](){ return seconds(mStepTimeStatistics.quantile(0.5)); }, Flags::read);
+	addAttribute<Real>("step_time_p99", nullptr, [=](){ return seconds(mStepTimeStatistics.quantile(0.99)); }, Flags::read);
+	addAttribute<Real>("step_time_p999", nullptr, [=](){ return seconds(mStepTimeStatistics.quantile(0.999)); }, Flags::read);
+
 	Eigen::setNbThreads(1);
 
 	// Logging
@@ -110,6 +124,10 @@ void Simulation::initialize() {
 
 	schedule();
 
+	// Allocate the logger buffers and start the writers before the first step
+	for (auto logger : mLoggers)
+		logger->start();
+
 	mInitialized = true;
 }
 
@@ -145,6 +163,7 @@ void Simulation::createSolvers() {
 			// TODO explicit / implicit integration
 			auto odeSolver = std::make_shared<ODESolver>(
 				odeComp->attribute<String>("name")->get() + "_ODE", odeComp, false, mTimeStep);
+			odeSolver->doPersistentIntegrator(mPersistentODEIntegrator);
 			mSolvers.push_back(odeSolver);
 		}
 	}
@@ -172,13 +191,31 @@ void Simulation::createMNASolver() {
 		if (mTearComponents.size() > 0) {
 			// Tear components available, use diakoptics
 			solver = std::make_shared<DiakopticsSolver<VarType>>(mName,
-				subnets[net], mTearComponents, mTimeStep, mLogLevel);
+				subnets[net], mTearComponents, mTimeStep, mLogLevel, mNodeOrdering);
+		}
+		else if (mLowRankSystemUpdates) {
+			// Apply switch and variable component changes as low-rank corrections
+			auto lowRankSolver = std::make_shared<MnaSolverLowRank<VarType>>(
+				mName + copySuffix, mDomain, mLogLevel);
+			lowRankSolver->setMaxCorrectionRank(mMaxCorrectionRank);
+			lowRankSolver->doSparseRightVector(mSparseRightVector);
+			solver = lowRankSolver;
+			solver->setTimeStep(mTimeStep);
+			solver->setNodeOrdering(mNodeOrdering);
+			solver->doSteadyStateInit(mSteadyStateInit);
+			solver->setSteadStIniTimeLimit(mSteadStIniTimeLimit);
+			solver->setSteadStIniAccLimit(mSteadStIniAccLimit);
+			solver->setSystem(subnets[net]);
+			solver->initialize();
 		}
 		else if (mSystemMatrixRecomputation) {
 			// Recompute system matrix if switches or other components change
-			solver = std::make_shared<MnaSolverSysRecomp<VarType>>(
+			auto sysRecompSolver = std::make_shared<MnaSolverSysRecomp<VarType>>(
 				mName + copySuffix, mDomain, mLogLevel);
+			sysRecompSolver->doSparseRightVector(mSparseRightVector);
+			solver = sysRecompSolver;
 			solver->setTimeStep(mTimeStep);
+			solver->setNodeOrdering(mNodeOrdering);
 			solver->doSteadyStateInit(mSteadyStateInit);
 			solver->setSteadStIniTimeLimit(mSteadStIniTimeLimit);
 			solver->setSteadStIniAccLimit(mSteadStIniAccLimit);
@@ -188,13 +225,20 @@ void Simulation::createMNASolver() {
 		else {
 			// Default case with precomputed system matrices for different configurations
 #ifdef WITH_CUDA
-			solver = std::make_shared<MnaSolverGpu<VarType>>(
+			auto mnaSolver = std::make_shared<MnaSolverGpu<VarType>>(
 				mName + copySuffix, mDomain, mLogLevel);
 #else
-			solver = std::make_shared<MnaSolver<VarType>>(
+			auto mnaSolver = std::make_shared<MnaSolver<VarType>>(
 				mName + copySuffix, mDomain, mLogLevel);
 #endif /* WITH_CUDA */
+			mnaSolver->doLazySwitchedSystems(mLazySwitchedSystems, mSwitchedSystemCacheSize);
+			mnaSolver->doBatchedComponents(mBatchedComponents);
+			mnaSolver->doSparseRightVector(mSparseRightVector);
+			for (auto& state : mExpectedSwitchStates)
+				mnaSolver->addExpectedSwitchState(state);
+			solver = mnaSolver;
 			solver->setTimeStep(mTimeStep);
+			solver->setNodeOrdering(mNodeOrdering);
 			solver->doSteadyStateInit(mSteadyStateInit);
 			solver->doFrequencyParallelization(mFreqParallel);
 			solver->setSteadStIniTimeLimit(mSteadStIniTimeLimit);
@@ -250,6 +294,15 @@ void Simulation::prepSchedule() {
 	if (!mScheduler) {
 		mScheduler = std::make_shared<SequentialScheduler>();
 	}
+	if (mOverrunAnalysis)
+		mScheduler->doTaskTimeMeasurement(true);
+	if (mAllocationCheck) {
+		if (!AllocationTracker::available()) {
+			mLog->error("Allocation check without allocation tracking, build with WITH_ALLOCATION_TRACKING");
+			throw SystemError("Allocation check requires allocation tracking", ENOTSUP);
+		}
+		mScheduler->doAllocationTracking(true);
+	}
 	mScheduler->resolveDeps(mTasks, mTaskInEdges, mTaskOutEdges);
 }
 
@@ -416,14 +469,23 @@ Real Simulation::step() {
 	auto start = std::chrono::steady_clock::now();
 	mEvents.handleEvents(mTime);
 
-	mScheduler->step(mTime, mTimeStepCount);
+	{
+		// Tasks must not look up attributes by name (checked with WITH_LOOKUP_CHECK)
+		CPS::AttributeList::LookupCheck lookupCheck;
+		mScheduler->step(mTime, mTimeStepCount);
+	}
+	if (mAllocationCheck)
+		checkAllocations();
 
 	mTime += mTimeStep;
 	mTimeStepCount++;
 
 	auto end = std::chrono::steady_clock::now();
-	std::chrono::duration<double> diff = end-start;
-	mStepTimes.push_back(diff.count());
+	mStepTimeStatistics.add(end-start);
+	if (mRecordStepTimes) {
+		std::chrono::duration<double> diff = end-start;
+		mStepTimes.push_back(diff.count());
+	}
 	return mTime;
 }
 
@@ -435,6 +497,10 @@ void Simulation::reset() {
 	for (auto l : mLoggers)
 		l->reopen();
 
+	mStepTimes.clear();
+	mStepTimeStatistics.reset();
+	mOverrunTasks.clear();
+
 	// Force reinitialization for next run
 	mInitialized = false;
 }
@@ -444,10 +510,50 @@ void Simulation::logStepTimes(String logName) {
 	Logger::setLogPattern(stepTimeLog, "%v");
 	stepTimeLog->info("step_time");
 
-	Real stepTimeSum = 0;
 	for (auto meas : mStepTimes) {
-		stepTimeSum += meas;
 		stepTimeLog->info("{:f}", meas);
 	}
-	mLog->info("Average step time: {:.6f}", stepTimeSum / mStepTimes.size());
+
+	auto seconds = [](Scheduler::TaskTime time) {
+		return std::chrono::duration<Real>(time).count();
+	};
+	mLog->info("Average step time: {:.6f}", seconds(mStepTimeStatistics.mean()));
+	mLog->info("Step time percentiles: p50 {:.6f}, p99 {:.6f}, p99.9 {:.6f}, max {:.6f}",
+		seconds(mStepTimeStatistics.quantile(0.5)), seconds(mStepTimeStatistics.quantile(0.99)),
+		seconds(mStepTimeStatistics.quantile(0.999)), seconds(mStepTimeStatistics.max()));
+}
+
+void Simulation::checkAllocations() {
+	// Pipelined output tasks of the step may still be running and counting
+	// their allocations
+	mScheduler->finishOutputs();
+
+	// The first steps may still allocate, e.g. when entries are inserted
+	// into sparse vectors
+	if (mTimeStepCount < mAllocationCheckWarmup) {
+		mScheduler->resetTaskAllocations();
+		return;
+	}
+
+	String tasks;
+	for (auto& pair : mScheduler->taskAllocations()) {
+		if (pair.second == 0)
+			continue;
+		mLog->error("Task {} allocated {} times in step {}", pair.first->toString(), pair.second, mTimeStepCount);
+		tasks += (tasks.empty() ? "" : ", ") + pair.first->toString();
+	}
+	if (!tasks.empty())
+		throw AllocationException(tasks);
+}
+
+void Simulation::recordOverrun() {
+	const TaskStatistics* stats = nullptr;
+	Task* task = mScheduler ? mScheduler->lastStepOutlier(mTimeStepCount - 1, &stats) : nullptr;
+	if (!task)
+		return;
+
+	mOverrunTasks[task->toString()]++;
+	mLog->debug("Overrun in step {}: {} took {} ns (mean {} ns)", mTimeStepCount - 1, task->toString(),
+		std::chrono::duration_cast<std::chrono::nanoseconds>(stats->last()).count(),
+		std::chrono::duration_cast<std::chrono::nanoseconds>(stats->mean()).count());
 }
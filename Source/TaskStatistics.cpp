@@ -0,0 +1,124 @@
+/* Copyright 2017-2020 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <dpsim/TaskStatistics.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+using namespace DPsim;
+
+constexpr UInt LatencyHistogram::SubBucketBits;
+constexpr UInt LatencyHistogram::MaxExponent;
+constexpr UInt LatencyHistogram::NumBuckets;
+
+void LatencyHistogram::reset() {
+	mCounts.fill(0);
+}
+
+UInt LatencyHistogram::bucketIndex(std::uint64_t value) {
+	if (value < (1ULL << SubBucketBits))
+		return static_cast<UInt>(value);
+	if (value >= (1ULL << MaxExponent))
+		return NumBuckets - 1;
+
+#ifdef __GNUC__
+	UInt exponent = 63 - __builtin_clzll(value);
+#else
+	UInt exponent = 0;
+	for (std::uint64_t v = value; v > 1; v >>= 1)
+		exponent++;
+#endif
+	// The top SubBucketBits+1 bits of the value select the sub-bucket
+	UInt shift = exponent - SubBucketBits;
+	return static_cast<UInt>((shift << SubBucketBits) + (value >> shift));
+}
+
+std::uint64_t LatencyHistogram::bucketUpperBound(UInt idx) {
+	if (idx < (1U << SubBucketBits))
+		return idx;
+
+	UInt shift = (idx >> SubBucketBits) - 1;
+	std::uint64_t subBucket = idx - (shift << SubBucketBits);
+	return ((subBucket + 1) << shift) - 1;
+}
+
+std::uint64_t LatencyHistogram::quantile(Real q, std::uint64_t count) const {
+	if (count == 0)
+		return 0;
+
+	// Rank of the value, starting from 1
+	std::uint64_t rank = static_cast<std::uint64_t>(std::ceil(q * count));
+	rank = std::min(std::max<std::uint64_t>(rank, 1), count);
+
+	std::uint64_t seen = 0;
+	for (UInt idx = 0; idx < NumBuckets; idx++) {
+		seen += mCounts[idx];
+		if (seen >= rank)
+			return bucketUpperBound(idx);
+	}
+	return bucketUpperBound(NumBuckets - 1);
+}
+
+void TaskStatistics::reset() {
+	mCount = 0;
+	mMean = 0;
+	mM2 = 0;
+	mMin = std::numeric_limits<std::int64_t>::max();
+	mMax = 0;
+	mLast = 0;
+	mHistogram.reset();
+}
+
+void TaskStatistics::add(Duration time) {
+	std::int64_t ns = std::chrono::duration_cast<std::chrono::nanoseconds>(time).count();
+	ns = std::max<std::int64_t>(ns, 0);
+
+	mCount++;
+	Real delta = ns - mMean;
+	mMean += delta / mCount;
+	mM2 += delta * (ns - mMean);
+	mMin = std::min(mMin, ns);
+	mMax = std::max(mMax, ns);
+	mLast = ns;
+	mHistogram.add(static_cast<std::uint64_t>(ns));
+}
+
+static TaskStatistics::Duration fromNanoseconds(std::int64_t ns) {
+	return std::chrono::duration_cast<TaskStatistics::Duration>(std::chrono::nanoseconds(ns));
+}
+
+TaskStatistics::Duration TaskStatistics::mean() const {
+	return fromNanoseconds(std::llround(mMean));
+}
+
+TaskStatistics::Duration TaskStatistics::min() const {
+	return fromNanoseconds(mCount ? mMin : 0);
+}
+
+TaskStatistics::Duration TaskStatistics::max() const {
+	return fromNanoseconds(mMax);
+}
+
+TaskStatistics::Duration TaskStatistics::last() const {
+	return fromNanoseconds(mLast);
+}
+
+Real TaskStatistics::variance() const {
+	return mCount > 1 ? mM2 / (mCount - 1) : 0;
+}
+
+Real TaskStatistics::stddev() const {
+	return std::sqrt(variance());
+}
+
+TaskStatistics::Duration TaskStatistics::quantile(Real q) const {
+	std::uint64_t value = mHistogram.quantile(q, mCount);
+	return fromNanoseconds(std::min<std::int64_t>(static_cast<std::int64_t>(value), mMax));
+}
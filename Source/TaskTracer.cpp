@@ -0,0 +1,75 @@
+/* Copyright 2017-2020 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <dpsim/TaskTracer.h>
+
+#include <fstream>
+#include <iomanip>
+
+using namespace DPsim;
+
+TaskTracer::TaskTracer(Int threads, UInt eventsPerThread) :
+	mStart(std::chrono::steady_clock::now()) {
+	UInt size = 1;
+	while (size < eventsPerThread)
+		size <<= 1;
+	mMask = size - 1;
+
+	for (Int thread = 0; thread < threads; thread++) {
+		mBuffers.emplace_back(new ThreadBuffer());
+		mBuffers.back()->events.resize(size);
+	}
+}
+
+static void writeJsonString(std::ostream& os, const String& str) {
+	os << '"';
+	for (char c : str) {
+		if (c == '"' || c == '\\')
+			os << '\\' << c;
+		else if (static_cast<unsigned char>(c) < 0x20)
+			os << ' ';
+		else
+			os << c;
+	}
+	os << '"';
+}
+
+void TaskTracer::writeChromeTrace(String filename) const {
+	std::ofstream os(filename);
+	os << std::fixed << std::setprecision(3);
+	os << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[" << std::endl;
+
+	Bool first = true;
+	for (size_t thread = 0; thread < mBuffers.size(); thread++) {
+		if (!first)
+			os << "," << std::endl;
+		first = false;
+		os << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":" << thread
+			<< ",\"args\":{\"name\":\"Scheduler thread " << thread << "\"}}";
+	}
+
+	for (size_t thread = 0; thread < mBuffers.size(); thread++) {
+		const ThreadBuffer& buffer = *mBuffers[thread];
+		std::uint64_t size = mMask + 1;
+		std::uint64_t begin = buffer.count > size ? buffer.count - size : 0;
+
+		for (std::uint64_t idx = begin; idx < buffer.count; idx++) {
+			const Event& event = buffer.events[idx & mMask];
+			std::chrono::duration<double, std::micro> start = event.start - mStart;
+			std::chrono::duration<double, std::micro> duration = event.end - event.start;
+
+			os << "," << std::endl << "{\"name\":";
+			writeJsonString(os, event.task->toString());
+			os << ",\"cat\":\"task\",\"ph\":\"X\",\"pid\":0,\"tid\":" << thread
+				<< ",\"ts\":" << start.count() << ",\"dur\":" << duration.count()
+				<< ",\"args\":{\"step\":" << event.timeStepCount << "}}";
+		}
+	}
+
+	os << std::endl << "]}" << std::endl;
+}
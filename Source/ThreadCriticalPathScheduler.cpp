@@ -0,0 +1,170 @@
+/* Copyright 2017-2020 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <dpsim/ThreadCriticalPathScheduler.h>
+
+#include <fstream>
+#include <limits>
+#include <queue>
+
+using namespace CPS;
+using namespace DPsim;
+
+ThreadCriticalPathScheduler::ThreadCriticalPathScheduler(Int threads, String outMeasurementFile, String inMeasurementFile, Bool useConditionVariables, Real syncCost, ThreadPlacement placement) :
+	ThreadScheduler(threads, outMeasurementFile, useConditionVariables, placement), mInMeasurementFile(inMeasurementFile), mSyncCost(syncCost) {
+}
+
+String ThreadCriticalPathScheduler::componentName(const Task::Ptr& task) {
+	String name = task->toString();
+	return name.substr(0, name.rfind('.'));
+}
+
+void ThreadCriticalPathScheduler::createSchedule(const Task::List& tasks, const Edges& inEdges, const Edges& outEdges) {
+	Task::List ordered;
+
+	Scheduler::topologicalSort(tasks, inEdges, outEdges, ordered);
+	Scheduler::initMeasurements(ordered);
+
+	std::unordered_map<Task::Ptr, Real> costs;
+	if (!mInMeasurementFile.empty()) {
+		std::unordered_map<String, TaskTime::rep> measurements;
+		readMeasurements(mInMeasurementFile, measurements);
+
+		// Check that measurements map is complete
+		for (auto task : ordered) {
+			if (measurements.find(task->toString()) == measurements.end())
+				throw SchedulingException();
+			costs[task] = static_cast<Real>(measurements.at(task->toString()));
+		}
+	} else {
+		for (auto task : ordered)
+			costs[task] = 1;
+	}
+
+	// Only consider the edges between scheduled tasks
+	std::unordered_map<Task::Ptr, Int> pendingDeps;
+	for (auto task : ordered)
+		pendingDeps[task] = 0;
+	for (auto task : ordered) {
+		if (outEdges.find(task) == outEdges.end())
+			continue;
+		for (auto after : outEdges.at(task)) {
+			if (pendingDeps.count(after))
+				pendingDeps[after]++;
+		}
+	}
+
+	// Bottom level including the synchronization costs on all outgoing edges
+	std::unordered_map<Task::Ptr, Real> priorities;
+	for (auto it = ordered.rbegin(); it != ordered.rend(); ++it) {
+		auto task = *it;
+		Real maxLevel = 0;
+		if (outEdges.find(task) != outEdges.end()) {
+			for (auto after : outEdges.at(task)) {
+				if (priorities.count(after))
+					maxLevel = std::max(maxLevel, priorities[after] + mSyncCost);
+			}
+		}
+		priorities[task] = costs[task] + maxLevel;
+	}
+
+	auto cmp = [&priorities](const Task::Ptr& p1, const Task::Ptr& p2) -> bool {
+		return priorities[p1] < priorities[p2];
+	};
+	std::priority_queue<Task::Ptr, std::deque<Task::Ptr>, decltype(cmp)> queue(cmp);
+	for (auto task : ordered) {
+		if (pendingDeps[task] == 0)
+			queue.push(task);
+	}
+
+	std::vector<Real> threadTimes(mNumThreads, 0);
+	std::unordered_map<Task::Ptr, Int> taskThreads;
+	std::unordered_map<Task::Ptr, Real> finishTimes;
+	std::unordered_map<String, Int> componentThreads;
+	mPredictedMakespan = 0;
+
+	while (!queue.empty()) {
+		auto task = queue.top();
+		queue.pop();
+
+		auto component = componentThreads.find(componentName(task));
+		Int bestThread = 0;
+		Real bestStart = 0, bestCost = std::numeric_limits<Real>::infinity();
+		for (Int thread = 0; thread < mNumThreads; thread++) {
+			Real start = threadTimes[thread];
+			if (inEdges.find(task) != inEdges.end()) {
+				for (auto before : inEdges.at(task)) {
+					if (!finishTimes.count(before))
+						continue;
+					Real ready = finishTimes[before];
+					if (taskThreads[before] != thread)
+						ready += mSyncCost;
+					start = std::max(start, ready);
+				}
+			}
+
+			Real cost = start;
+			if (component != componentThreads.end() && component->second != thread)
+				cost += mSyncCost;
+			if (cost < bestCost) {
+				bestCost = cost;
+				bestStart = start;
+				bestThread = thread;
+			}
+		}
+
+		scheduleTask(bestThread, task);
+		taskThreads[task] = bestThread;
+		finishTimes[task] = bestStart + costs[task];
+		threadTimes[bestThread] = finishTimes[task];
+		mPredictedMakespan = std::max(mPredictedMakespan, finishTimes[task]);
+		if (component == componentThreads.end())
+			componentThreads[componentName(task)] = bestThread;
+
+		if (outEdges.find(task) != outEdges.end()) {
+			for (auto after : outEdges.at(task)) {
+				if (pendingDeps.count(after) && --pendingDeps[after] == 0)
+					queue.push(after);
+			}
+		}
+	}
+
+	mSLog->info("Predicted makespan: {}", mPredictedMakespan);
+
+	ThreadScheduler::finishSchedule(inEdges);
+}
+
+void ThreadCriticalPathScheduler::step(Real time, Int timeStepCount) {
+	auto start = std::chrono::steady_clock::now();
+	ThreadScheduler::step(time, timeStepCount);
+	auto end = std::chrono::steady_clock::now();
+	mMeasuredMakespan.add(end-start);
+}
+
+void ThreadCriticalPathScheduler::stop() {
+	ThreadScheduler::stop();
+
+	// The prediction is only comparable if the costs are measured times
+	mSLog->info("Predicted makespan: {} ({})", mPredictedMakespan,
+		mInMeasurementFile.empty() ? "task count" : "measured task times");
+	mSLog->info("Measured makespan: mean {}, p50 {}, p99 {}, max {}",
+		mMeasuredMakespan.mean().count(), mMeasuredMakespan.quantile(0.5).count(),
+		mMeasuredMakespan.quantile(0.99).count(), mMeasuredMakespan.max().count());
+
+	// Append the makespans as comments to the task measurements
+	if (!mOutMeasurementFile.empty()) {
+		std::ofstream os(mOutMeasurementFile, std::ios::app);
+		os << "# predicted_makespan," << mPredictedMakespan << std::endl;
+		os << "# measured_makespan,"
+			<< mMeasuredMakespan.mean().count() << ","
+			<< mMeasuredMakespan.count() << ","
+			<< mMeasuredMakespan.quantile(0.5).count() << ","
+			<< mMeasuredMakespan.quantile(0.99).count() << ","
+			<< mMeasuredMakespan.max().count() << std::endl;
+	}
+}
@@ -15,8 +15,8 @@
 using namespace CPS;
 using namespace DPsim;
 
-ThreadLevelScheduler::ThreadLevelScheduler(Int threads, String outMeasurementFile, String inMeasurementFile, Bool useConditionVariable, Bool sortTaskTypes) :
-	ThreadScheduler(threads, outMeasurementFile, useConditionVariable), mInMeasurementFile(inMeasurementFile), mSortTaskTypes(sortTaskTypes) {
+ThreadLevelScheduler::ThreadLevelScheduler(Int threads, String outMeasurementFile, String inMeasurementFile, Bool useConditionVariable, Bool sortTaskTypes, ThreadPlacement placement) :
+	ThreadScheduler(threads, outMeasurementFile, useConditionVariable, placement), mInMeasurementFile(inMeasurementFile), mSortTaskTypes(sortTaskTypes) {
 }
 
 void ThreadLevelScheduler::createSchedule(const Task::List& tasks, const Edges& inEdges, const Edges& outEdges) {
@@ -13,8 +13,8 @@
 using namespace CPS;
 using namespace DPsim;
 
-ThreadListScheduler::ThreadListScheduler(Int threads, String outMeasurementFile, String inMeasurementFile, Bool useConditionVariables) :
-	ThreadScheduler(threads, outMeasurementFile, useConditionVariables), mInMeasurementFile(inMeasurementFile) {
+ThreadListScheduler::ThreadListScheduler(Int threads, String outMeasurementFile, String inMeasurementFile, Bool useConditionVariables, ThreadPlacement placement) :
+	ThreadScheduler(threads, outMeasurementFile, useConditionVariables, placement), mInMeasurementFile(inMeasurementFile) {
 }
 
 void ThreadListScheduler::createSchedule(const Task::List& tasks, const Edges& inEdges, const Edges& outEdges) {
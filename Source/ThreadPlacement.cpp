@@ -0,0 +1,234 @@
+/* Copyright 2017-2020 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <dpsim/ThreadPlacement.h>
+
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+#ifdef __linux__
+  #include <pthread.h>
+  #include <sched.h>
+  #include <sys/mman.h>
+#endif
+
+using namespace DPsim;
+
+ThreadPlacement::ThreadPlacement(Policy policy, std::vector<Int> cores, Int priority, Bool lockMemory) :
+	mPolicy(policy), mCores(cores), mPriority(priority), mLockMemory(lockMemory) {
+	if (priority < 0 || priority > 99)
+		throw std::invalid_argument("Invalid thread priority " + std::to_string(priority));
+	if (policy == Policy::Explicit && cores.empty())
+		throw std::invalid_argument("No cores given for explicit thread placement");
+}
+
+std::vector<Int> ThreadPlacement::parseCpuList(const String& list) {
+	std::vector<Int> cpus;
+	std::stringstream ss(list);
+	String range;
+
+	while (std::getline(ss, range, ',')) {
+		range.erase(std::remove_if(range.begin(), range.end(), ::isspace), range.end());
+		if (range.empty())
+			continue;
+
+		try {
+			size_t pos;
+			size_t dash = range.find('-');
+			Int first = std::stoi(range.substr(0, dash), &pos);
+			if (pos != (dash == String::npos ? range.size() : dash))
+				throw std::invalid_argument(range);
+			Int last = first;
+			if (dash != String::npos) {
+				last = std::stoi(range.substr(dash + 1), &pos);
+				if (pos != range.size() - dash - 1)
+					throw std::invalid_argument(range);
+			}
+			if (first < 0 || last < first)
+				throw std::invalid_argument(range);
+			for (Int cpu = first; cpu <= last; cpu++)
+				cpus.push_back(cpu);
+		} catch (std::logic_error&) {
+			throw std::invalid_argument("Invalid core list \"" + list + "\"");
+		}
+	}
+
+	return cpus;
+}
+
+std::vector<Int> ThreadPlacement::allowedCpus() {
+	std::vector<Int> cpus;
+#ifdef __linux__
+	cpu_set_t cpuset;
+	if (sched_getaffinity(0, sizeof(cpuset), &cpuset) == 0) {
+		for (Int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+			if (CPU_ISSET(cpu, &cpuset))
+				cpus.push_back(cpu);
+		}
+	}
+#endif
+	if (cpus.empty()) {
+		for (Int cpu = 0; cpu < static_cast<Int>(std::thread::hardware_concurrency()); cpu++)
+			cpus.push_back(cpu);
+	}
+	return cpus;
+}
+
+std::vector<std::vector<Int>> ThreadPlacement::numaNodes() {
+	std::vector<Int> allowed = allowedCpus();
+	std::vector<std::vector<Int>> nodes;
+
+	std::ifstream online("/sys/devices/system/node/online");
+	String line;
+	if (online && std::getline(online, line)) {
+		try {
+			for (Int node : parseCpuList(line)) {
+				std::ifstream cpulist("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+				if (!cpulist || !std::getline(cpulist, line))
+					continue;
+
+				std::vector<Int> cpus;
+				for (Int cpu : parseCpuList(line)) {
+					if (std::find(allowed.begin(), allowed.end(), cpu) != allowed.end())
+						cpus.push_back(cpu);
+				}
+				if (!cpus.empty())
+					nodes.push_back(cpus);
+			}
+		} catch (std::invalid_argument&) {
+			nodes.clear();
+		}
+	}
+
+	if (nodes.empty() && !allowed.empty())
+		nodes.push_back(allowed);
+	return nodes;
+}
+
+std::vector<std::vector<Int>> ThreadPlacement::cpuSets(Int threads) const {
+	std::vector<std::vector<Int>> sets(threads);
+	if (mPolicy == Policy::None)
+		return sets;
+	if (mPolicy == Policy::Explicit) {
+		for (Int i = 0; i < threads; i++)
+			sets[i] = { mCores[i % mCores.size()] };
+		return sets;
+	}
+
+	std::vector<std::vector<Int>> nodes = numaNodes();
+	if (nodes.empty())
+		return sets;
+
+	switch (mPolicy) {
+	case Policy::Compact: {
+		std::vector<Int> cpus;
+		for (auto& node : nodes)
+			cpus.insert(cpus.end(), node.begin(), node.end());
+		for (Int i = 0; i < threads; i++)
+			sets[i] = { cpus[i % cpus.size()] };
+		break;
+	}
+	case Policy::Scatter:
+		for (Int i = 0; i < threads; i++) {
+			auto& node = nodes[i % nodes.size()];
+			sets[i] = { node[(i / nodes.size()) % node.size()] };
+		}
+		break;
+	case Policy::NumaNode:
+		for (Int i = 0; i < threads; i++)
+			sets[i] = nodes[i % nodes.size()];
+		break;
+	default:
+		break;
+	}
+	return sets;
+}
+
+Bool ThreadPlacement::apply(std::thread::native_handle_type thread, const std::vector<Int>& cpus) const {
+	Bool success = true;
+#ifdef __linux__
+	if (!cpus.empty()) {
+		cpu_set_t cpuset;
+		CPU_ZERO(&cpuset);
+		for (Int cpu : cpus) {
+			if (cpu < CPU_SETSIZE)
+				CPU_SET(cpu, &cpuset);
+			else
+				success = false;
+		}
+		if (pthread_setaffinity_np(thread, sizeof(cpuset), &cpuset) != 0)
+			success = false;
+	}
+	if (mPriority > 0) {
+		sched_param param;
+		param.sched_priority = mPriority;
+		if (pthread_setschedparam(thread, SCHED_FIFO, &param) != 0)
+			success = false;
+	}
+#else
+	if (!cpus.empty() || mPriority > 0)
+		success = false;
+#endif
+	return success;
+}
+
+Bool ThreadPlacement::applyToCurrentThread(const std::vector<Int>& cpus) const {
+#ifdef __linux__
+	return apply(pthread_self(), cpus);
+#else
+	return cpus.empty() && mPriority == 0;
+#endif
+}
+
+Bool ThreadPlacement::applyMemoryLock() const {
+	if (!mLockMemory)
+		return true;
+#ifdef __linux__
+	return mlockall(MCL_CURRENT | MCL_FUTURE) == 0;
+#else
+	return false;
+#endif
+}
+
+ThreadPlacement::ThreadState ThreadPlacement::currentThreadState() {
+	ThreadState state;
+#ifdef __linux__
+	cpu_set_t cpuset;
+	if (pthread_getaffinity_np(pthread_self(), sizeof(cpuset), &cpuset) == 0) {
+		for (Int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+			if (CPU_ISSET(cpu, &cpuset))
+				state.cpus.push_back(cpu);
+		}
+	}
+	sched_param param;
+	int policy;
+	if (pthread_getschedparam(pthread_self(), &policy, &param) == 0) {
+		state.policy = policy;
+		state.priority = param.sched_priority;
+	}
+#endif
+	return state;
+}
+
+void ThreadPlacement::restoreCurrentThreadState(const ThreadState& state) {
+#ifdef __linux__
+	if (!state.cpus.empty()) {
+		cpu_set_t cpuset;
+		CPU_ZERO(&cpuset);
+		for (Int cpu : state.cpus)
+			CPU_SET(cpu, &cpuset);
+		pthread_setaffinity_np(pthread_self(), sizeof(cpuset), &cpuset);
+	}
+	sched_param param;
+	param.sched_priority = state.priority;
+	pthread_setschedparam(pthread_self(), state.policy, &param);
+#endif
+}
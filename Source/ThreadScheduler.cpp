@@ -7,16 +7,20 @@
  *********************************************************************************/
 
 #include <dpsim/ThreadScheduler.h>
+#include <cps/AttributeList.h>
 
+#include <algorithm>
 #include <iostream>
 
 using namespace CPS;
 using namespace DPsim;
 
-ThreadScheduler::ThreadScheduler(Int threads, String outMeasurementFile, Bool useConditionVariable) :
-	mNumThreads(threads), mOutMeasurementFile(outMeasurementFile), mStartBarrier(threads, useConditionVariable) {
+ThreadScheduler::ThreadScheduler(Int threads, String outMeasurementFile, Bool useConditionVariable, ThreadPlacement placement) :
+	mNumThreads(threads), mOutMeasurementFile(outMeasurementFile), mStartBarrier(threads, useConditionVariable),
+	mPlacement(placement) {
 	if (threads < 1)
 		throw SchedulingException();
+	mMeasureTaskTimes = !outMeasurementFile.empty();
 	mTempSchedules.resize(threads);
 	mSchedules.resize(threads, nullptr);
 }
@@ -24,6 +28,7 @@ ThreadScheduler::ThreadScheduler(Int threads, String outMeasurementFile, Bool us
 ThreadScheduler::~ThreadScheduler() {
 	for (int i = 0; i < mNumThreads; i++)
 		delete[] mSchedules[i];
+	delete[] mOutputSchedule;
 }
 
 void ThreadScheduler::scheduleTask(int thread, CPS::Task::Ptr task) {
@@ -31,7 +36,21 @@ void ThreadScheduler::scheduleTask(int thread, CPS::Task::Ptr task) {
 }
 
 void ThreadScheduler::finishSchedule(const Edges& inEdges) {
+	if (mPipelineOutputs) {
+		for (auto& schedule : mTempSchedules) {
+			for (auto task : schedule) {
+				if (task->isOutputOnly()) {
+					mTempOutputSchedule.push_back(task);
+					mPipelinedTasks.insert(task.get());
+				}
+			}
+			schedule.erase(std::remove_if(schedule.begin(), schedule.end(),
+				[](const Task::Ptr& task) { return task->isOutputOnly(); }), schedule.end());
+		}
+	}
+
 	std::map<CPS::Task::Ptr, Counter*> counters;
+	std::map<CPS::Task::Ptr, ScheduleEntry*> entries;
 	for (int thread = 0; thread < mNumThreads; thread++) {
 	//	std::cout << "Thread " << thread << std::endl;
 	//	for (auto& entry : mSchedules[thread]) {
@@ -45,8 +64,16 @@ void ThreadScheduler::finishSchedule(const Edges& inEdges) {
 			auto& task = mTempSchedules[thread][i];
 			mSchedules[thread][i].task = task.get();
 			counters[task] = &mSchedules[thread][i].endCounter;
+			entries[task] = &mSchedules[thread][i];
 		}
 	}
+	mOutputSchedule = new ScheduleEntry[mTempOutputSchedule.size()];
+	for (size_t i = 0; i < mTempOutputSchedule.size(); i++) {
+		auto& task = mTempOutputSchedule[i];
+		mOutputSchedule[i].task = task.get();
+		counters[task] = &mOutputSchedule[i].endCounter;
+		entries[task] = &mOutputSchedule[i];
+	}
 	for (int thread = 0; thread < mNumThreads; thread++) {
 		for (size_t i = 0; i < mTempSchedules[thread].size(); i++) {
 			auto& task = mTempSchedules[thread][i];
@@ -57,21 +84,68 @@ void ThreadScheduler::finishSchedule(const Edges& inEdges) {
 			}
 		}
 	}
+	// The modifying tasks of the next step wait for the output tasks instead
+	// of the output tasks working on copies of the results
+	for (size_t i = 0; i < mTempOutputSchedule.size(); i++) {
+		auto& task = mTempOutputSchedule[i];
+		if (inEdges.find(task) != inEdges.end()) {
+			for (auto req : inEdges.at(task)) {
+				mOutputSchedule[i].reqCounters.push_back(counters[req]);
+				entries[req]->prevReqCounters.push_back(&mOutputSchedule[i].endCounter);
+			}
+		}
+	}
+
+	Scheduler::initTracing(mTempOutputSchedule.empty() ? mNumThreads : mNumThreads + 1);
+	for (int i = 0; i <= mNumThreads; i++)
+		mWaiters.emplace_back(new Waiter(mSpinBudget));
+
+	// Lock the memory before the threads are started, so that their stacks
+	// are locked as well
+	if (!mPlacement.applyMemoryLock())
+		mSLog->warn("Failed to lock the memory of the process");
+	mCpuSets = mPlacement.cpuSets(mNumThreads);
+	for (int i = 0; i < mNumThreads; i++) {
+		if (mCpuSets[i].empty())
+			continue;
+		String cores;
+		for (Int core : mCpuSets[i])
+			cores += (cores.empty() ? "" : ",") + std::to_string(core);
+		mSLog->info("Thread {} is placed on cores {}", i, cores);
+	}
+
 	for (int i = 1; i < mNumThreads; i++) {
 		mThreads.emplace_back(threadFunction, this, i);
+		if (!mPlacement.apply(mThreads.back().native_handle(), mCpuSets[i]))
+			mSLog->warn("Failed to apply the placement to scheduler thread {}", i);
 	}
+	if (!mTempOutputSchedule.empty())
+		mOutputThread = std::thread(outputThreadFunction, this);
 }
 
 void ThreadScheduler::step(Real time, Int timeStepCount) {
 	mTime = time;
 	mTimeStepCount = timeStepCount;
-	mStartBarrier.wait();
+	if (!mCallerPlaced && !mPlacement.isDefault()) {
+		mCallerState = ThreadPlacement::currentThreadState();
+		mCallerPlaced = true;
+		if (!mPlacement.applyToCurrentThread(mCpuSets[0]))
+			mSLog->warn("Failed to apply the placement to scheduler thread 0");
+	}
+	if (mOutputThread.joinable()) {
+		// Reuse the step information of the step before the last one
+		Int started = mStartedSteps.value();
+		mOutputSchedule[mTempOutputSchedule.size()-1].endCounter.wait(started-1, *mWaiters[0]);
+		mOutputSteps[started % 2] = { time, timeStepCount };
+		mStartedSteps.inc();
+	}
+	mStartBarrier.wait(*mWaiters[0]);
 	doStep(0);
 	// since we don't have a final BarrierTask, wait for all threads to finish
 	// their last task explicitly
 	for (int thread = 1; thread < mNumThreads; thread++) {
 		if (mTempSchedules[thread].size() != 0)
-			mSchedules[thread][mTempSchedules[thread].size()-1].endCounter.wait(mTimeStepCount+1);
+			mSchedules[thread][mTempSchedules[thread].size()-1].endCounter.wait(mTimeStepCount+1, *mWaiters[0]);
 	}
 }
 
@@ -83,14 +157,45 @@ void ThreadScheduler::stop() {
 			mThreads[thread].join();
 		}
 	}
+	if (mOutputThread.joinable()) {
+		finishOutputs();
+		mStopOutputs = true;
+		mStartedSteps.inc();
+		mOutputThread.join();
+	}
+	for (size_t i = 0; i < mWaiters.size(); i++) {
+		const WaitStatistics& stats = mWaiters[i]->statistics();
+		if (stats.immediate + stats.spinHits + stats.blocks > 0)
+			mSLog->info("Thread {} waits: {} immediate, {} spin hits, {} blocks",
+				i, stats.immediate, stats.spinHits, stats.blocks);
+	}
+	if (mCallerPlaced) {
+		ThreadPlacement::restoreCurrentThreadState(mCallerState);
+		mCallerPlaced = false;
+	}
 	if (!mOutMeasurementFile.empty()) {
 		writeMeasurements(mOutMeasurementFile);
 	}
+	writeTrace();
+}
+
+void ThreadScheduler::finishOutputs() {
+	if (mOutputThread.joinable())
+		mOutputSchedule[mTempOutputSchedule.size()-1].endCounter.wait(mStartedSteps.value(), *mWaiters[0]);
+}
+
+WaitStatistics ThreadScheduler::waitStatistics() const {
+	WaitStatistics stats;
+	for (auto& waiter : mWaiters)
+		stats.add(waiter->statistics());
+	return stats;
 }
 
 void ThreadScheduler::threadFunction(ThreadScheduler* sched, Int idx) {
+	// The thread only executes tasks within the steps
+	CPS::AttributeList::LookupCheck lookupCheck;
 	while (true) {
-		sched->mStartBarrier.wait();
+		sched->mStartBarrier.wait(*sched->mWaiters[idx]);
 		if (sched->mJoining)
 			return;
 
@@ -99,24 +204,63 @@ void ThreadScheduler::threadFunction(ThreadScheduler* sched, Int idx) {
 }
 
 void ThreadScheduler::doStep(Int thread) {
-	if (mOutMeasurementFile.empty()) {
+	Waiter& waiter = *mWaiters[thread];
+	if (!timeTasks()) {
 		for (size_t i = 0; i != mTempSchedules[thread].size(); i++) {
 			ScheduleEntry* entry = &mSchedules[thread][i];
-			for (Counter* counter : entry->reqCounters)
-				counter->wait(mTimeStepCount+1);
-			entry->task->execute(mTime, mTimeStepCount);
+			// A skipped task does not modify its attributes, so the tasks
+			// that wait for it need not wait for its dependencies
+			if (entry->task->isActive(mTimeStepCount)) {
+				for (Counter* counter : entry->prevReqCounters)
+					counter->wait(mTimeStepCount, waiter);
+				for (Counter* counter : entry->reqCounters)
+					counter->wait(mTimeStepCount+1, waiter);
+				entry->task->execute(mTime, mTimeStepCount);
+			}
 			entry->endCounter.inc();
 		}
 	} else {
 		for (size_t i = 0; i != mTempSchedules[thread].size(); i++) {
 			ScheduleEntry* entry = &mSchedules[thread][i];
-			for (Counter* counter : entry->reqCounters)
-				counter->wait(mTimeStepCount+1);
-			auto start = std::chrono::steady_clock::now();
-			entry->task->execute(mTime, mTimeStepCount);
-			auto end = std::chrono::steady_clock::now();
-			updateMeasurement(entry->task, end-start);
+			if (entry->task->isActive(mTimeStepCount)) {
+				for (Counter* counter : entry->prevReqCounters)
+					counter->wait(mTimeStepCount, waiter);
+				for (Counter* counter : entry->reqCounters)
+					counter->wait(mTimeStepCount+1, waiter);
+				executeTimedTask(thread, entry->task, mTime, mTimeStepCount);
+			}
 			entry->endCounter.inc();
 		}
 	}
 }
+
+void ThreadScheduler::outputThreadFunction(ThreadScheduler* sched) {
+	Waiter& waiter = *sched->mWaiters[sched->mNumThreads];
+	CPS::AttributeList::LookupCheck lookupCheck;
+	for (Int step = 0; ; step++) {
+		// All started steps are done when stop sets the flag
+		sched->mStartedSteps.wait(step+1, waiter);
+		if (sched->mStopOutputs.load(std::memory_order_acquire))
+			return;
+		sched->doOutputs(step);
+	}
+}
+
+void ThreadScheduler::doOutputs(Int step) {
+	const StepInfo& info = mOutputSteps[step % 2];
+	Waiter& waiter = *mWaiters[mNumThreads];
+
+	for (size_t i = 0; i != mTempOutputSchedule.size(); i++) {
+		ScheduleEntry* entry = &mOutputSchedule[i];
+		if (entry->task->isActive(info.timeStepCount)) {
+			for (Counter* counter : entry->reqCounters)
+				counter->wait(step+1, waiter);
+			if (!timeTasks()) {
+				entry->task->execute(info.time, info.timeStepCount);
+			} else {
+				executeTimedTask(mNumThreads, entry->task, info.time, info.timeStepCount);
+			}
+		}
+		entry->endCounter.inc();
+	}
+}
@@ -44,7 +44,7 @@ Timer::~Timer() {
 #endif
 }
 
-void Timer::sleep() {
+uint64_t Timer::sleep() {
 	uint64_t ticks = 0, overruns;
 
 #ifdef HAVE_TIMERFD
@@ -75,6 +75,8 @@ void Timer::sleep() {
 		if (mFlags & Flags::fail_on_overrun)
 			throw OverrunException{overruns};
 	}
+
+	return overruns;
 }
 
 void Timer::start() {
@@ -0,0 +1,65 @@
+/* Copyright 2017-2020 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <dpsim/Waiter.h>
+
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <thread>
+
+#ifdef __linux__
+  #include <linux/futex.h>
+  #include <sys/syscall.h>
+  #include <unistd.h>
+#endif
+
+using namespace DPsim;
+
+static_assert(sizeof(std::atomic<Int>) == sizeof(int), "futex word must be a plain int");
+
+Waiter::Waiter(Int spinBudget) : mSpinBudget(spinBudget) {
+	if (spinBudget < 0)
+		mSpinIterations = -1;
+	else
+		mSpinIterations = static_cast<std::int64_t>(spinBudget * pausesPerMicrosecond() / 1000);
+}
+
+Real Waiter::pausesPerMicrosecond() {
+	// Calibrated once, as the duration of pause differs widely between
+	// microarchitectures (e.g. about 10 cycles before and 140 cycles since
+	// Skylake). The fastest of several runs is least disturbed.
+	static const Real pauses = [] {
+		const Int count = 10000;
+		Real best = 0;
+		for (Int run = 0; run < 5; run++) {
+			auto start = std::chrono::steady_clock::now();
+			for (Int i = 0; i < count; i++)
+				pause();
+			std::chrono::duration<Real, std::micro> time = std::chrono::steady_clock::now() - start;
+			if (time.count() > 0)
+				best = std::max(best, count / time.count());
+		}
+		return best > 0 ? best : 100;
+	}();
+	return pauses;
+}
+
+void Waiter::block(std::atomic<Int>& word, Int value) {
+#ifdef __linux__
+	syscall(SYS_futex, reinterpret_cast<int*>(&word), FUTEX_WAIT_PRIVATE, value, nullptr, nullptr, 0);
+#else
+	std::this_thread::yield();
+#endif
+}
+
+void Waiter::wakeAll(std::atomic<Int>& word) {
+#ifdef __linux__
+	syscall(SYS_futex, reinterpret_cast<int*>(&word), FUTEX_WAKE_PRIVATE, INT_MAX, nullptr, nullptr, 0);
+#endif
+}
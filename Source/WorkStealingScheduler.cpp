@@ -0,0 +1,259 @@
+/* Copyright 2017-2020 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <dpsim/WorkStealingScheduler.h>
+#include <cps/AttributeList.h>
+
+#include <unordered_map>
+
+using namespace CPS;
+using namespace DPsim;
+
+void WorkStealingScheduler::TaskDeque::resize(UInt capacity) {
+	UInt size = 1;
+	while (size < capacity)
+		size <<= 1;
+	mTasks.reset(new std::atomic<Int>[size]);
+	mMask = size - 1;
+	reset();
+}
+
+void WorkStealingScheduler::TaskDeque::reset() {
+	mTop.store(0, std::memory_order_relaxed);
+	mBottom.store(0, std::memory_order_relaxed);
+}
+
+void WorkStealingScheduler::TaskDeque::push(Int task) {
+	Int bottom = mBottom.load(std::memory_order_relaxed);
+	mTasks[bottom & mMask].store(task, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+	mBottom.store(bottom + 1, std::memory_order_relaxed);
+}
+
+Int WorkStealingScheduler::TaskDeque::pop() {
+	Int bottom = mBottom.load(std::memory_order_relaxed) - 1;
+	mBottom.store(bottom, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	Int top = mTop.load(std::memory_order_relaxed);
+
+	if (top > bottom) {
+		mBottom.store(bottom + 1, std::memory_order_relaxed);
+		return empty;
+	}
+
+	Int task = mTasks[bottom & mMask].load(std::memory_order_relaxed);
+	if (top == bottom) {
+		// Last task, race against the thieves
+		if (!mTop.compare_exchange_strong(top, top + 1,
+				std::memory_order_seq_cst, std::memory_order_relaxed))
+			task = empty;
+		mBottom.store(bottom + 1, std::memory_order_relaxed);
+	}
+	return task;
+}
+
+Int WorkStealingScheduler::TaskDeque::steal() {
+	Int top = mTop.load(std::memory_order_acquire);
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	Int bottom = mBottom.load(std::memory_order_acquire);
+
+	if (top >= bottom)
+		return empty;
+
+	Int task = mTasks[top & mMask].load(std::memory_order_relaxed);
+	if (!mTop.compare_exchange_strong(top, top + 1,
+			std::memory_order_seq_cst, std::memory_order_relaxed))
+		return empty;
+	return task;
+}
+
+WorkStealingScheduler::WorkStealingScheduler(Int threads, String outMeasurementFile, Bool pinThreads) :
+	mNumThreads(threads), mOutMeasurementFile(outMeasurementFile),
+	mPlacement(pinThreads ? ThreadPlacement::Policy::Compact : ThreadPlacement::Policy::None),
+	mStartBarrier(threads), mEndBarrier(threads) {
+	if (threads < 1)
+		throw SchedulingException();
+	mMeasureTaskTimes = !outMeasurementFile.empty();
+	mDeques.reset(new TaskDeque[threads]);
+}
+
+WorkStealingScheduler::~WorkStealingScheduler() {
+	// Don't leave the threads waiting in the barrier if stop was not called
+	joinThreads();
+}
+
+void WorkStealingScheduler::joinThreads() {
+	if (mThreads.empty())
+		return;
+
+	mJoining = true;
+	mStartBarrier.wait();
+	for (auto& thread : mThreads)
+		thread.join();
+	mThreads.clear();
+	mJoining = false;
+}
+
+void WorkStealingScheduler::createSchedule(const Task::List& tasks, const Edges& inEdges, const Edges& outEdges) {
+	Task::List ordered;
+
+	// The schedule may be created again, e.g. for another simulation
+	joinThreads();
+	mTasks.clear();
+	mRootTasks.clear();
+	mPeriodicTasks.clear();
+
+	Scheduler::topologicalSort(tasks, inEdges, outEdges, ordered);
+	if (mMeasureTaskTimes || mTrackAllocations)
+		Scheduler::initMeasurements(ordered);
+	Scheduler::initTracing(mNumThreads);
+
+	// Flatten the graph into index arrays. Edges to tasks that were dropped
+	// by the topological sort (including the root task) are ignored.
+	std::unordered_map<Task::Ptr, Int> indices;
+	for (auto task : ordered) {
+		indices[task] = static_cast<Int>(mTasks.size());
+		mTasks.push_back(task.get());
+	}
+
+	mInDegrees.assign(mTasks.size(), 0);
+	mSuccessorOffsets.clear();
+	mSuccessors.clear();
+	for (auto task : ordered) {
+		mSuccessorOffsets.push_back(static_cast<UInt>(mSuccessors.size()));
+		auto edges = outEdges.find(task);
+		if (edges == outEdges.end())
+			continue;
+
+		for (auto after : edges->second) {
+			auto idx = indices.find(after);
+			if (idx == indices.end())
+				continue;
+			mSuccessors.push_back(idx->second);
+			mInDegrees[idx->second]++;
+		}
+	}
+	mSuccessorOffsets.push_back(static_cast<UInt>(mSuccessors.size()));
+
+	mPendingDeps.reset(new std::atomic<Int>[mTasks.size()]);
+	for (size_t i = 0; i < mTasks.size(); i++) {
+		mPendingDeps[i].store(mInDegrees[i], std::memory_order_relaxed);
+		if (mInDegrees[i] == 0)
+			mRootTasks.push_back(static_cast<Int>(i));
+		if (mTasks[i]->period() > 1)
+			mPeriodicTasks.push_back(static_cast<Int>(i));
+	}
+
+	for (Int thread = 0; thread < mNumThreads; thread++)
+		mDeques[thread].resize(static_cast<UInt>(mTasks.size()));
+
+	for (auto task : ordered)
+		mSLog->info("{}", task->toString());
+
+	std::vector<std::vector<Int>> cpuSets = mPlacement.cpuSets(mNumThreads);
+	for (Int i = 1; i < mNumThreads; i++) {
+		mThreads.emplace_back(threadFunction, this, i);
+		if (!mPlacement.apply(mThreads.back().native_handle(), cpuSets[i]))
+			mSLog->warn("Failed to apply the placement to scheduler thread {}", i);
+	}
+}
+
+void WorkStealingScheduler::step(Real time, Int timeStepCount) {
+	mTime = time;
+	mTimeStepCount = timeStepCount;
+
+	// All threads wait in the start barrier, so the deques can be reset here.
+	// The dependency counters are reset by the thread that releases a task.
+	for (Int thread = 0; thread < mNumThreads; thread++)
+		mDeques[thread].reset();
+
+	// Tasks that are skipped in this step are done right away, so their
+	// successors don't wait for their dependencies. One additional pending
+	// dependency keeps a skipped task from being released by its dependencies.
+	Int remaining = static_cast<Int>(mTasks.size());
+	for (Int task : mPeriodicTasks) {
+		Bool active = mTasks[task]->isActive(timeStepCount);
+		mPendingDeps[task].store(mInDegrees[task] + (active ? 0 : 1), std::memory_order_relaxed);
+	}
+	for (Int task : mPeriodicTasks) {
+		if (mTasks[task]->isActive(timeStepCount))
+			continue;
+		releaseSuccessors(0, task);
+		remaining--;
+	}
+
+	Int roots = 0;
+	for (Int task : mRootTasks) {
+		if (mTasks[task]->isActive(timeStepCount))
+			mDeques[roots++ % mNumThreads].push(task);
+	}
+	mRemainingTasks.store(remaining, std::memory_order_relaxed);
+
+	mStartBarrier.wait();
+	doStep(0);
+	mEndBarrier.wait();
+}
+
+void WorkStealingScheduler::stop() {
+	joinThreads();
+	if (!mOutMeasurementFile.empty()) {
+		writeMeasurements(mOutMeasurementFile);
+	}
+	writeTrace();
+}
+
+void WorkStealingScheduler::threadFunction(WorkStealingScheduler* sched, Int idx) {
+	// The thread only executes tasks within the steps
+	CPS::AttributeList::LookupCheck lookupCheck;
+	while (true) {
+		sched->mStartBarrier.wait();
+		if (sched->mJoining)
+			return;
+
+		sched->doStep(idx);
+		sched->mEndBarrier.wait();
+	}
+}
+
+void WorkStealingScheduler::doStep(Int thread) {
+	TaskDeque& deque = mDeques[thread];
+
+	while (mRemainingTasks.load(std::memory_order_acquire) > 0) {
+		Int task = deque.pop();
+		for (Int i = 1; task == TaskDeque::empty && i < mNumThreads; i++)
+			task = mDeques[(thread + i) % mNumThreads].steal();
+
+		if (task != TaskDeque::empty)
+			executeTask(thread, task);
+		else
+			std::this_thread::yield();
+	}
+}
+
+void WorkStealingScheduler::executeTask(Int thread, Int task) {
+	if (!timeTasks()) {
+		mTasks[task]->execute(mTime, mTimeStepCount);
+	} else {
+		executeTimedTask(thread, mTasks[task], mTime, mTimeStepCount);
+	}
+
+	// Release the successors before the task is counted as done, so that
+	// no thread leaves the step while tasks are still pending
+	releaseSuccessors(thread, task);
+	mRemainingTasks.fetch_sub(1, std::memory_order_release);
+}
+
+void WorkStealingScheduler::releaseSuccessors(Int thread, Int task) {
+	for (UInt i = mSuccessorOffsets[task]; i < mSuccessorOffsets[task+1]; i++) {
+		Int after = mSuccessors[i];
+		if (mPendingDeps[after].fetch_sub(1, std::memory_order_acq_rel) == 1) {
+			mPendingDeps[after].store(mInDegrees[after], std::memory_order_relaxed);
+			mDeques[thread].push(after);
+		}
+	}
+}
@@ -45,9 +45,20 @@ PYBIND11_MODULE(dpsimpy, m) {
 		.def("render_to_file", &DPsim::SystemTopology::renderToFile)
 		.def_readwrite("nodes", &DPsim::SystemTopology::mNodes);
 
-	py::class_<DPsim::DataLogger, std::shared_ptr<DPsim::DataLogger>>(m, "Logger")
+	py::class_<DPsim::DataLogger, std::shared_ptr<DPsim::DataLogger>> logger(m, "Logger");
+
+	// Registered first, so that it can be used as a default argument
+	py::enum_<DPsim::DataLogger::BackPressure>(logger, "BackPressure")
+		.value("Block", DPsim::DataLogger::BackPressure::Block)
+		.value("Drop", DPsim::DataLogger::BackPressure::Drop)
+		.value("Report", DPsim::DataLogger::BackPressure::Report);
+
+	logger
         .def(py::init<std::string>())
-		.def("log_attribute", (void (DPsim::DataLogger::*)(const CPS::String &, const CPS::String &, CPS::IdentifiedObject::Ptr)) &DPsim::DataLogger::addAttribute);
+		.def("log_attribute", (void (DPsim::DataLogger::*)(const CPS::String &, const CPS::String &, CPS::IdentifiedObject::Ptr)) &DPsim::DataLogger::addAttribute)
+		.def("do_async_write", &DPsim::DataLogger::doAsyncWrite, py::arg("value"), py::arg("capacity") = 4096,
+			py::arg("back_pressure") = DPsim::DataLogger::BackPressure::Block)
+		.def("dropped_rows", &DPsim::DataLogger::droppedRows);
 
 	py::class_<CPS::IdentifiedObject, std::shared_ptr<CPS::IdentifiedObject>>(m, "IdentifiedObject")
 		.def("name", &CPS::IdentifiedObject::name);
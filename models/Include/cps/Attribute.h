@@ -8,6 +8,7 @@
 
 #pragma once
 #include <iostream>
+#include <limits>
 
 #include <cps/Definitions.h>
 #include <cps/PtrFactory.h>
@@ -307,6 +308,64 @@ namespace Flags {
 		}
 	};
 
+	/// Attribute that reads a coefficient of a real or complex matrix
+	/// directly from the storage of the matrix.
+	///
+	/// The address of the coefficient is computed from the current data
+	/// pointer and outer stride of the matrix on each read, so the view stays
+	/// valid if the matrix is reallocated. If the matrix is resized so that
+	/// the coefficient does not exist anymore, read() returns NaN.
+	/// Consumers that know this type call read() directly instead of going
+	/// through the getter function of the attribute.
+	class MatrixViewAttribute : public Attribute<Real> {
+	protected:
+		using Index = Matrix::Index;
+
+		/// Real matrix of the coefficient, if it is a real matrix
+		const Matrix *mMatrixReal = nullptr;
+		/// Complex matrix of the coefficient, if it is a complex matrix
+		const MatrixComp *mMatrixComp = nullptr;
+		///
+		Index mRow;
+		///
+		Index mCol;
+		/// Part of a complex coefficient, 0 for the real and 1 for the imaginary part
+		Index mPart;
+
+	public:
+		typedef std::shared_ptr<MatrixViewAttribute> Ptr;
+
+		MatrixViewAttribute(const Matrix *matrix, Index row, Index col,
+			int flags, AttributeBase::Ptr refAttribute) :
+			Attribute<Real>(Getter([this]() { return this->read(); }), flags, refAttribute),
+			mMatrixReal(matrix), mRow(row), mCol(col), mPart(0) { }
+
+		MatrixViewAttribute(const MatrixComp *matrix, Index row, Index col, Index part,
+			int flags, AttributeBase::Ptr refAttribute) :
+			Attribute<Real>(Getter([this]() { return this->read(); }), flags, refAttribute),
+			mMatrixComp(matrix), mRow(row), mCol(col), mPart(part) { }
+
+		/// Returns true if the coefficient exists in the current matrix
+		Bool valid() const {
+			return mMatrixReal
+				? mRow < mMatrixReal->rows() && mCol < mMatrixReal->cols()
+				: mRow < mMatrixComp->rows() && mCol < mMatrixComp->cols();
+		}
+
+		/// Reads the coefficient from the matrix storage
+		Real read() const {
+			if (!valid())
+				return std::numeric_limits<Real>::quiet_NaN();
+
+			// Column major storage. For complex matrices, the real and imaginary
+			// parts of each coefficient are stored next to each other.
+			if (mMatrixReal)
+				return mMatrixReal->data()[mCol * mMatrixReal->outerStride() + mRow];
+			return reinterpret_cast<const Real*>(mMatrixComp->data())
+				[2 * (mCol * mMatrixComp->outerStride() + mRow) + mPart];
+		}
+	};
+
 	template<typename T>
 	class MatrixAttribute : public Attribute<MatrixVar<T>> {
 	protected:
@@ -319,6 +378,9 @@ namespace Flags {
 
 		typename Attribute<T>::Ptr coeff(Index row, Index col) {
 			typename Attribute<T>::Getter get = [this, row, col]() -> T {
+				// Matrices with storage are not copied for a single coefficient
+				if (!(mFlags & Flags::getter))
+					return this->get()(row, col);
 				return this->getByValue()(row, col);
 			};
 			//typename Attribute<T>::Setter set = [](T n) -> void {
@@ -327,11 +389,22 @@ namespace Flags {
 			//	this->set(mat);
 			//};
 			return Attribute<T>::make(get, mFlags, shared_from_this());
-			//T *ptr = &mValue->data()[mValue->cols() * row + col]; // Column major
-			//return Attribute<T>::make(ptr, mFlags, shared_from_this());
 		}
 	};
 
+	/// Coefficients of real matrices with storage are read directly
+	template<>
+	inline Attribute<Real>::Ptr MatrixAttribute<Real>::coeff(Index row, Index col) {
+		if (!(mFlags & Flags::getter))
+			return std::make_shared<MatrixViewAttribute>(mValue, row, col,
+				mFlags & Flags::read, shared_from_this());
+
+		Attribute<Real>::Getter get = [this, row, col]() -> Real {
+			return this->getByValue()(row, col);
+		};
+		return Attribute<Real>::make(get, mFlags, shared_from_this());
+	}
+
 	class MatrixRealAttribute : public Attribute<Matrix> {
 	protected:
 		using Index = typename Matrix::Index;
@@ -342,6 +415,11 @@ namespace Flags {
 		typedef std::shared_ptr<MatrixRealAttribute> Ptr;
 
 		typename Attribute<Real>::Ptr coeff(Index row, Index col) {
+			// Matrices with storage are read directly
+			if (!(mFlags & Flags::getter))
+				return std::make_shared<MatrixViewAttribute>(mValue, row, col,
+					mFlags & Flags::read, shared_from_this());
+
 			typename Attribute<Real>::Getter get = [this, row, col]() -> Real {
 				return this->getByValue()(row, col);
 			};
@@ -351,8 +429,6 @@ namespace Flags {
 			//	this->set(mat);
 			//};
 			return Attribute<Real>::make(get, mFlags, shared_from_this());
-			//T *ptr = &mValue->data()[mValue->cols() * row + col]; // Column major
-			//return Attribute<T>::make(ptr, mFlags, shared_from_this());
 		}
 	};
 
@@ -367,6 +443,9 @@ namespace Flags {
 
 		ComplexAttribute::Ptr coeff(Index row, Index col) {
 			ComplexAttribute::Getter get = [this, row, col]() -> Complex {
+				// Matrices with storage are not copied for a single coefficient
+				if (!(mFlags & Flags::getter))
+					return this->get()(row, col);
 				return this->getByValue()(row, col);
 			};
 			return std::make_shared<ComplexAttribute>(get, mFlags, shared_from_this());
@@ -375,16 +454,23 @@ namespace Flags {
 		}
 
 		Attribute<Real>::Ptr coeffReal(Index row, Index col) {
+			// Matrices with storage are read directly
+			if (!(mFlags & Flags::getter))
+				return std::make_shared<MatrixViewAttribute>(mValue, row, col, 0,
+					mFlags & Flags::read, shared_from_this());
+
 			Attribute<Real>::Getter get = [this, row, col]() -> Real {
 				return this->getByValue()(row,col).real();
 			};
 			return Attribute<Real>::make(get, mFlags, shared_from_this());
-			//Complex *ptr = &mValue->data()[mValue->cols() * row + col]; // Column major
-			//Real *realPart = &reinterpret_cast<Real*>(ptr)[0];
-			//return Attribute<Real>::make(&realPart, mFlags, shared_from_this());
 		}
 
 		Attribute<Real>::Ptr coeffImag(Index row, Index col) {
+			// Matrices with storage are read directly
+			if (!(mFlags & Flags::getter))
+				return std::make_shared<MatrixViewAttribute>(mValue, row, col, 1,
+					mFlags & Flags::read, shared_from_this());
+
 			Attribute<Real>::Getter get = [this, row, col]() -> Real {
 				return this->getByValue()(row,col).imag();;
 			};
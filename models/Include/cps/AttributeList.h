@@ -8,20 +8,92 @@
 
 #pragma once
 
+#include <atomic>
 #include <iostream>
 #include <vector>
 #include <memory>
+#include <mutex>
+#include <set>
 
 #include <cps/Config.h>
 #include <cps/Attribute.h>
+#include <cps/Logger.h>
 
 namespace CPS {
+	/// Typed handle to an attribute, resolved once by name with
+	/// AttributeList::attributeHandle, e.g. in the constructor or during the
+	/// initialization. Per-step code should use handles instead of looking
+	/// up attributes by name, which needs a map lookup and a dynamic cast.
+	///
+	/// The handle refers to the entry of the attribute list, so it follows
+	/// later changes of the entry by setAttributeRef. It must not outlive
+	/// the attribute list.
+	template<typename T>
+	class AttributeHandle {
+	public:
+		AttributeHandle() : mEntry(nullptr) { }
+
+		Attribute<T>* operator->() const { return static_cast<Attribute<T>*>(mEntry->get()); }
+		/// Shared pointer to the current attribute, e.g. for dependencies
+		typename Attribute<T>::Ptr ptr() const { return std::static_pointer_cast<Attribute<T>>(*mEntry); }
+
+		const T& get() const { return (*this)->get(); }
+		void set(const T& value) const { (*this)->set(value); }
+
+		explicit operator bool() const { return mEntry != nullptr; }
+
+	private:
+		friend class AttributeList;
+		AttributeHandle(const AttributeBase::Ptr* entry) : mEntry(entry) { }
+
+		const AttributeBase::Ptr* mEntry;
+	};
+
 	/// Base class of objects having attributes to access member variables.
 	class AttributeList {
 	private:
-		/// Map of all attributes that should be exported to the Python interface
+		/// Map of all attributes that should be exported to the Python interface.
+		/// Entries are never removed, so handles to them stay valid.
 		AttributeBase::Map mAttributes;
 
+#ifdef WITH_LOOKUP_CHECK
+		/// Number of LookupCheck scopes of the calling thread. Each thread
+		/// that executes tasks opens its own scope.
+		static Int& lookupCheckDepth() {
+			static thread_local Int depth = 0;
+			return depth;
+		}
+
+		static std::atomic<UInt>& checkedLookupCount() {
+			static std::atomic<UInt> count(0);
+			return count;
+		}
+
+		/// Reports each attribute name once that is looked up within a
+		/// LookupCheck scope.
+		static void checkLookup(const String &name) {
+			if (lookupCheckDepth() == 0)
+				return;
+
+			checkedLookupCount()++;
+			// Names this thread has already passed on are skipped without
+			// taking the lock
+			static thread_local std::set<String> seen;
+			if (!seen.insert(name).second)
+				return;
+
+			static std::mutex mutex;
+			static std::set<String> reported;
+			std::lock_guard<std::mutex> lock(mutex);
+			if (reported.insert(name).second) {
+				static Logger::Log log = Logger::get("AttributeLookups", Logger::Level::warn, Logger::Level::warn);
+				log->warn("Attribute \"{}\" is looked up by name during a simulation step, use an AttributeHandle", name);
+			}
+		}
+#else
+		static void checkLookup(const String &name) { }
+#endif
+
 	protected:
 		template<typename T, typename... Args>
 		void addAttribute(const String &name, Args&&... args) {
@@ -35,8 +107,32 @@ namespace CPS {
 
 		const AttributeBase::Map & attributes() { return mAttributes; };
 
+		/// Scope in which attribute lookups by name are reported, i.e. the
+		/// steps of a simulation. The scope only covers the thread that opens
+		/// it. Only checked in builds with WITH_LOOKUP_CHECK.
+		class LookupCheck {
+		public:
+#ifdef WITH_LOOKUP_CHECK
+			LookupCheck() { lookupCheckDepth()++; }
+			~LookupCheck() { lookupCheckDepth()--; }
+#else
+			// Not trivial, so that scopes are not reported as unused variables
+			LookupCheck() { }
+#endif
+			/// Number of lookups by name within all scopes so far, always 0
+			/// without WITH_LOOKUP_CHECK
+			static UInt lookupCount() {
+#ifdef WITH_LOOKUP_CHECK
+				return checkedLookupCount();
+#else
+				return 0;
+#endif
+			}
+		};
+
 		/// Return pointer to an attribute.
 		AttributeBase::Ptr attribute(const String &name) {
+			checkLookup(name);
 			auto it = mAttributes.find(name);
 			if (it == mAttributes.end())
 				throw InvalidAttributeException();
@@ -56,6 +152,13 @@ namespace CPS {
 			return attrPtr;
 		}
 
+		/// Return a handle to an attribute, which avoids the lookup on access.
+		template<typename T>
+		AttributeHandle<T> attributeHandle(const String &name) {
+			attribute<T>(name);
+			return AttributeHandle<T>(&mAttributes.find(name)->second);
+		}
+
 		template<typename T, typename... Args>
 		void addAttributeRef(const String& name, std::shared_ptr<AttributeBase> ref, Args&&... args){
 			addAttribute<T>(name, std::forward<Args>(args)...);
@@ -209,6 +209,13 @@ namespace Base {
 		Real mDetLd;
 		/// Determinant of q-axis inductance matrix
 		Real mDetLq;
+		/// Buffers of the flux update in stepFluxStateSpace
+		Matrix mFluxStepA;
+		Matrix mFluxStepF1;
+		Matrix mFluxStepF2Inv;
+		Matrix mFluxStepInput;
+		Matrix mFluxStepStates;
+		LUFactorized mFluxStepLu;
 
 		/// Determines if compensation elements are used
 		Bool mCompensationOn;
@@ -248,6 +255,9 @@ namespace Base {
 
 		///
 		void calcStateSpaceMatrixDQ();
+		/// Updates the fluxes from the stator and rotor voltages with the
+		/// numerical method of the machine at the current speed
+		void stepFluxStateSpace(Real dt);
 		///
 		Real calcHfromJ(Real J, Real omegaNominal, Int polePairNumber);
 
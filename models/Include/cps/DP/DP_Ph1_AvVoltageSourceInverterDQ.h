@@ -49,6 +49,10 @@ namespace Ph1 {
 		std::shared_ptr<Signal::PLL> mPLL;
 		/// Power Controller
 		std::shared_ptr<Signal::PowerControllerVSI> mPowerControllerVSI;
+		/// Angle output of the PLL in the previous step
+		AttributeHandle<Matrix> mPLLOutputPrev;
+		/// Output of the power controller in the current step
+		AttributeHandle<Matrix> mPowerCtrlOutputCurr;
 
 		// ### Electrical Subcomponents ###
 		/// Controlled voltage source
@@ -63,6 +67,8 @@ namespace Ph1 {
 		std::shared_ptr<DP::Ph1::Resistor> mSubResistorC;
 		/// Optional connection transformer
 		std::shared_ptr<DP::Ph1::Transformer> mConnectionTransformer;
+		/// Reference voltage of the controlled voltage source
+		AttributeHandle<Complex> mSubCtrledVoltageRef;
 
 		// ### Inverter Interfacing Variables ###
 		// Control inputs
@@ -82,10 +88,8 @@ namespace Ph1 {
 		Bool mWithConnectionTransformer=false;
 		/// Flag for controller usage
 		Bool mWithControl=true;
-
-		// #### solver ####
-		///
-		std::vector<const Matrix*> mRightVectorStamps;
+		/// Number of simulation time steps between two executions of the power controller
+		UInt mControlPeriod = 1;
 
 	public:
 		/// Defines name amd logging level
@@ -109,19 +113,20 @@ namespace Ph1 {
 		void setInitialStateValues(Real pInit, Real qInit,
 			Real phi_dInit, Real phi_qInit, Real gamma_dInit, Real gamma_qInit);
 		void withControl(Bool controlOn) { mWithControl = controlOn; };
+		/// Execute the power controller only in every given number of time
+		/// steps. Must be set before the initialization.
+		void setControlPeriod(UInt steps);
 
 		// #### MNA section ####
 		/// Initializes internal variables of the component
 		void mnaInitialize(Real omega, Real timeStep, Attribute<Matrix>::Ptr leftVector);
 		/// Stamps system matrix
 		void mnaApplySystemMatrixStamp(Matrix& systemMatrix);
-		/// Stamps right side (source) vector
-		void mnaApplyRightSideVectorStamp(Matrix& rightVector);
 		/// Updates current through the component
 		void mnaUpdateCurrent(const Matrix& leftVector);
 		/// Updates voltage across component
 		void mnaUpdateVoltage(const Matrix& leftVector);
-		/// MNA pre step operations
+		/// MNA pre step operations, the subcomponents are stepped by their own tasks
 		void mnaPreStep(Real time, Int timeStepCount);
 		/// MNA post step operations
 		void mnaPostStep(Real time, Int timeStepCount, Attribute<Matrix>::Ptr &leftVector);
@@ -34,6 +34,16 @@ namespace Ph1 {
 		MatrixComp mEquivCond;
 		/// Coefficient in front of previous voltage value for harmonics
 		MatrixComp mPrevVoltCoeff;
+		/// Executes the steps of many components in batched mode
+		friend class PassiveBatch;
+		/// Stamps the equivalent conductance into a dense or sparse system matrix
+		template <typename MatrixType>
+		void applySystemMatrixStamp(MatrixType& systemMatrix);
+		/// Stamps the equivalent current into a dense or sparse right side vector
+		template <typename VectorType>
+		void applyRightSideVectorStamp(VectorType& rightVector);
+		/// Stamps the equivalent current of one frequency into its column of the right side vector
+		void applyRightSideVectorStampHarm(Matrix& rightVector, UInt freqIdx);
 	public:
 		/// Defines UID, name and logging level
 		Capacitor(String uid, String name, Logger::Level logLevel = Logger::Level::off);
@@ -55,9 +65,11 @@ namespace Ph1 {
 		void mnaInitializeHarm(Real omega, Real timeStep, std::vector<Attribute<Matrix>::Ptr> leftVector);
 		/// Stamps system matrix
 		void mnaApplySystemMatrixStamp(Matrix& systemMatrix);
+		void mnaApplySystemMatrixStamp(SparseMatrixRow& systemMatrix);
 		void mnaApplySystemMatrixStampHarm(Matrix& systemMatrix, Int freqIdx);
 		/// Stamps right side (source) vector
 		void mnaApplyRightSideVectorStamp(Matrix& rightVector);
+		void mnaApplyRightSideVectorStamp(SparseVector& rightVector);
 		void mnaApplyRightSideVectorStampHarm(Matrix& rightVector);
 		/// Update interface voltage from MNA system result
 		void mnaUpdateVoltage(const Matrix& leftVector);
@@ -65,7 +77,7 @@ namespace Ph1 {
 		void mnaApplyRightSideVectorStampHarm(Matrix& sourceVector, Int freqIdx);
 		/// Update interface current from MNA system result
 		void mnaUpdateCurrent(const Matrix& leftVector);
-		void mnaUpdateCurrentHarm();
+		void mnaUpdateCurrentHarm(UInt freqIdx);
 		/// MNA pre step operations
 		void mnaPreStep(Real time, Int timeStepCount);
 		/// MNA post step operations
@@ -100,33 +112,34 @@ namespace Ph1 {
 
 		class MnaPreStepHarm : public CPS::Task {
 		public:
-			MnaPreStepHarm(Capacitor& capacitor)
-				: Task(capacitor.mName + ".MnaPreStepHarm"),
-				mCapacitor(capacitor) {
+			MnaPreStepHarm(Capacitor& capacitor, UInt freqIdx)
+				: Task(capacitor.mName + ".MnaPreStepHarm" + std::to_string(freqIdx)),
+				mCapacitor(capacitor), mFreqIdx(freqIdx) {
 				// actually depends on C, but then we'd have to modify the system matrix anyway
-				mModifiedAttributes.push_back(capacitor.attribute("right_vector"));
+				mModifiedAttributes.push_back(capacitor.mnaRightVectorHarmAttributes()[freqIdx]);
 				mPrevStepDependencies.push_back(capacitor.attribute("i_intf"));
 				mPrevStepDependencies.push_back(capacitor.attribute("v_intf"));
 			}
 			void execute(Real time, Int timeStepCount);
 		private:
 			Capacitor& mCapacitor;
+			UInt mFreqIdx;
 		};
 
 		class MnaPostStepHarm : public CPS::Task {
 		public:
-			MnaPostStepHarm(Capacitor& capacitor, std::vector<Attribute<Matrix>::Ptr> leftVectors)
-				: Task(capacitor.mName + ".MnaPostStepHarm"),
-				mCapacitor(capacitor), mLeftVectors(leftVectors) {
-				for (UInt i = 0; i < mLeftVectors.size(); i++)
-					mAttributeDependencies.push_back(mLeftVectors[i]);
+			MnaPostStepHarm(Capacitor& capacitor, Attribute<Matrix>::Ptr leftVector, UInt freqIdx)
+				: Task(capacitor.mName + ".MnaPostStepHarm" + std::to_string(freqIdx)),
+				mCapacitor(capacitor), mLeftVector(leftVector), mFreqIdx(freqIdx) {
+				mAttributeDependencies.push_back(mLeftVector);
 				mModifiedAttributes.push_back(mCapacitor.attribute("v_intf"));
 				mModifiedAttributes.push_back(mCapacitor.attribute("i_intf"));
 			}
 			void execute(Real time, Int timeStepCount);
 		private:
 			Capacitor& mCapacitor;
-			std::vector< Attribute<Matrix>::Ptr > mLeftVectors;
+			Attribute<Matrix>::Ptr mLeftVector;
+			UInt mFreqIdx;
 		};
 	};
 }
@@ -27,6 +27,9 @@ namespace Ph1 {
 		public SharedFactory<CurrentSource> {
 	protected:
 		Attribute<Complex>::Ptr mCurrentRef;
+		/// Stamps the equivalent current into a dense or sparse right side vector
+		template <typename VectorType>
+		void applyRightSideVectorStamp(VectorType& rightVector);
 	public:
 		/// Defines UID, name and logging level
 		CurrentSource(String uid, String name, Logger::Level loglevel = Logger::Level::off);
@@ -52,6 +55,7 @@ namespace Ph1 {
 		void mnaApplySystemMatrixStamp(Matrix& systemMatrix) { }
 		/// Stamps right side (source) vector
 		void mnaApplyRightSideVectorStamp(Matrix& rightVector);
+		void mnaApplyRightSideVectorStamp(SparseVector& rightVector);
 		///
 		void mnaUpdateVoltage(const Matrix& leftVector);
 
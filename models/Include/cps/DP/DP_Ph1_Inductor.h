@@ -34,8 +34,18 @@ namespace Ph1 {
 		MatrixComp mEquivCond;
 		/// Coefficient in front of previous current value for harmonics
 		MatrixComp mPrevCurrFac;
+		/// Executes the steps of many components in batched mode
+		friend class PassiveBatch;
 		///
 		void initVars(Real timeStep);
+		/// Stamps the equivalent conductance into a dense or sparse system matrix
+		template <typename MatrixType>
+		void applySystemMatrixStamp(MatrixType& systemMatrix);
+		/// Stamps the equivalent current into a dense or sparse right side vector
+		template <typename VectorType>
+		void applyRightSideVectorStamp(VectorType& rightVector);
+		/// Stamps the equivalent current of one frequency into its column of the right side vector
+		void applyRightSideVectorStampHarm(Matrix& rightVector, UInt freqIdx);
 	public:
 		/// Defines UID, name and log level
 		Inductor(String uid, String name, Logger::Level logLevel = Logger::Level::off);
@@ -57,16 +67,18 @@ namespace Ph1 {
 		void mnaInitializeHarm(Real omega, Real timeStep, std::vector<Attribute<Matrix>::Ptr> leftVectors);
 		/// Stamps system matrix
 		void mnaApplySystemMatrixStamp(Matrix& systemMatrix);
+		void mnaApplySystemMatrixStamp(SparseMatrixRow& systemMatrix);
 		void mnaApplySystemMatrixStampHarm(Matrix& systemMatrix, Int freqIdx);
 		/// Stamps right side (source) vector
 		void mnaApplyRightSideVectorStamp(Matrix& rightVector);
+		void mnaApplyRightSideVectorStamp(SparseVector& rightVector);
 		void mnaApplyRightSideVectorStampHarm(Matrix& rightVector);
 		/// Update interface voltage from MNA system results
 		void mnaUpdateVoltage(const Matrix& leftVector);
 		void mnaUpdateVoltageHarm(const Matrix& leftVector, Int freqIdx);
 		/// Update interface current from MNA system results
 		void mnaUpdateCurrent(const Matrix& leftVector);
-		void mnaUpdateCurrentHarm();
+		void mnaUpdateCurrentHarm(UInt freqIdx);
 		/// MNA pre step operations
 		void mnaPreStep(Real time, Int timeStepCount);
 		/// MNA post step operations
@@ -108,33 +120,34 @@ namespace Ph1 {
 
 		class MnaPreStepHarm : public Task {
 		public:
-			MnaPreStepHarm(Inductor& inductor)
-				: Task(inductor.mName + ".MnaPreStepHarm"),
-				mInductor(inductor) {
+			MnaPreStepHarm(Inductor& inductor, UInt freqIdx)
+				: Task(inductor.mName + ".MnaPreStepHarm" + std::to_string(freqIdx)),
+				mInductor(inductor), mFreqIdx(freqIdx) {
 				// actually depends on L, but then we'd have to modify the system matrix anyway
-				mModifiedAttributes.push_back(inductor.attribute("right_vector"));
+				mModifiedAttributes.push_back(inductor.mnaRightVectorHarmAttributes()[freqIdx]);
 				mPrevStepDependencies.push_back(inductor.attribute("v_intf"));
 				mPrevStepDependencies.push_back(inductor.attribute("i_intf"));
 			}
 			void execute(Real time, Int timeStepCount);
 		private:
 			Inductor& mInductor;
+			UInt mFreqIdx;
 		};
 
 		class MnaPostStepHarm : public Task {
 		public:
-			MnaPostStepHarm(Inductor& inductor, std::vector<Attribute<Matrix>::Ptr> leftVectors)
-				: Task(inductor.mName + ".MnaPostStepHarm"),
-				mInductor(inductor), mLeftVectors(leftVectors) {
-				for (UInt i = 0; i < mLeftVectors.size(); i++)
-					mAttributeDependencies.push_back(mLeftVectors[i]);
+			MnaPostStepHarm(Inductor& inductor, Attribute<Matrix>::Ptr leftVector, UInt freqIdx)
+				: Task(inductor.mName + ".MnaPostStepHarm" + std::to_string(freqIdx)),
+				mInductor(inductor), mLeftVector(leftVector), mFreqIdx(freqIdx) {
+				mAttributeDependencies.push_back(mLeftVector);
 				mModifiedAttributes.push_back(mInductor.attribute("v_intf"));
 				mModifiedAttributes.push_back(mInductor.attribute("i_intf"));
 			}
 			void execute(Real time, Int timeStepCount);
 		private:
 			Inductor& mInductor;
-			std::vector< Attribute<Matrix>::Ptr > mLeftVectors;
+			Attribute<Matrix>::Ptr mLeftVector;
+			UInt mFreqIdx;
 		};
 
 
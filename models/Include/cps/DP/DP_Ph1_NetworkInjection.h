@@ -29,10 +29,6 @@ namespace Ph1 {
 		/// Voltage source
 		std::shared_ptr<DP::Ph1::VoltageSource> mSubVoltageSource;
 
-		// #### solver ####
-		/// Vector to collect subcomponent right vector stamps
-		std::vector<const Matrix*> mRightVectorStamps;
-
 	public:
 		/// Defines UID, name and logging level
 		NetworkInjection(String uid, String name, Logger::Level loglevel = Logger::Level::off);
@@ -56,33 +52,15 @@ namespace Ph1 {
 		void mnaInitialize(Real omega, Real timeStep, Attribute<Matrix>::Ptr leftVector);
 		/// Stamps system matrix
 		void mnaApplySystemMatrixStamp(Matrix& systemMatrix);
-		/// Stamps right side (source) vector
-		void mnaApplyRightSideVectorStamp(Matrix& rightVector);
 		/// Returns current through the component
 		void mnaUpdateCurrent(const Matrix& leftVector);
 		/// Updates voltage across component
 		void mnaUpdateVoltage(const Matrix& leftVector);
-		/// MNA pre step operations
-		void mnaPreStep(Real time, Int timeStepCount);
 		/// MNA post step operations
 		void mnaPostStep(Real time, Int timeStepCount, Attribute<Matrix>::Ptr &leftVector);
-		/// Add MNA pre step dependencies
-		void mnaAddPreStepDependencies(AttributeBase::List &prevStepDependencies, AttributeBase::List &attributeDependencies, AttributeBase::List &modifiedAttributes);
 		/// Add MNA post step dependencies
 		void mnaAddPostStepDependencies(AttributeBase::List &prevStepDependencies, AttributeBase::List &attributeDependencies, AttributeBase::List &modifiedAttributes, Attribute<Matrix>::Ptr &leftVector);
 
-		class MnaPreStep : public CPS::Task {
-		public:
-			MnaPreStep(NetworkInjection& networkInjection) :
-				Task(networkInjection.mName + ".MnaPreStep"), mNetworkInjection(networkInjection) {
-					mNetworkInjection.mnaAddPreStepDependencies(mPrevStepDependencies, mAttributeDependencies, mModifiedAttributes);
-			}
-			void execute(Real time, Int timeStepCount) { mNetworkInjection.mnaPreStep(time, timeStepCount); };
-
-		private:
-			NetworkInjection& mNetworkInjection;
-		};
-
 		class MnaPostStep : public CPS::Task {
 		public:
 			MnaPostStep(NetworkInjection& networkInjection, Attribute<Matrix>::Ptr leftVector) :
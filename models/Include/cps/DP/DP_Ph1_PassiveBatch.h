@@ -0,0 +1,137 @@
+/* Copyright 2017-2020 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#pragma once
+
+#include <cps/IdentifiedObject.h>
+#include <cps/Solver/MNAInterface.h>
+#include <cps/DP/DP_Ph1_Capacitor.h>
+#include <cps/DP/DP_Ph1_Inductor.h>
+#include <cps/DP/DP_Ph1_Resistor.h>
+
+namespace CPS {
+namespace DP {
+namespace Ph1 {
+	/// \brief Batch of inductors, capacitors and resistors
+	///
+	/// Executes the pre- and post-steps of many single frequency components
+	/// in one task each instead of two tasks per component. The companion
+	/// model parameters, node indices and states of the components are kept in
+	/// one array per quantity and component type, so that the history currents
+	/// and interface currents are updated in loops the compiler can vectorize.
+	///
+	/// Components have to be initialized by mnaInitialize before they are
+	/// added. From then on, the batch keeps their state and only writes their
+	/// interface voltage and current back after each step.
+	class PassiveBatch :
+		public IdentifiedObject,
+		public MNAInterface,
+		public SharedFactory<PassiveBatch> {
+	private:
+		/// Trapezoidal companion model, which is the same for inductors and
+		/// capacitors except for the coefficients: The history current is
+		/// a * v + b * i of the previous step and the current is g * v plus the
+		/// history current. Complex values are split into real and imaginary part.
+		struct HistoryComponents {
+			std::vector<Real> gRe, gIm, aRe, aIm, bRe, bIm;
+			std::vector<Real> vRe, vIm, iRe, iIm, jRe, jIm;
+			/// Matrix node indices, -1 for ground
+			std::vector<Matrix::Index> node0, node1;
+			/// Interface voltage and current of the components
+			std::vector<Complex*> voltage, current;
+			MNAInterface::List comps;
+
+			void add(const MNAInterface::Ptr& comp, Matrix::Index n0, Matrix::Index n1,
+				Complex* v, Complex* i, Complex g, Complex a, Complex b, Complex j);
+			void updateHistoryCurrents();
+			void stampHistoryCurrents(Matrix& rightVector, Matrix::Index complexOffset);
+			void updateStates(const Matrix& leftVector, Matrix::Index complexOffset);
+		};
+
+		/// Resistors with their resistance r, the current is v / r as in the
+		/// component
+		struct Resistors {
+			std::vector<Real> r, vRe, vIm;
+			std::vector<Matrix::Index> node0, node1;
+			std::vector<Complex*> voltage, current;
+			MNAInterface::List comps;
+
+			void add(const MNAInterface::Ptr& comp, Matrix::Index n0, Matrix::Index n1,
+				Complex* v, Complex* i, Real resistance);
+			void updateStates(const Matrix& leftVector, Matrix::Index complexOffset);
+		};
+
+		HistoryComponents mInductors;
+		HistoryComponents mCapacitors;
+		Resistors mResistors;
+		/// Offset of the imaginary parts in the left and right side vector
+		Matrix::Index mComplexOffset = 0;
+
+		/// Matrix node index of a terminal, -1 for ground
+		static Matrix::Index nodeIndex(SimPowerComp<Complex>& comp, UInt terminal) {
+			return comp.terminalNotGrounded(terminal) ? static_cast<Matrix::Index>(comp.matrixNodeIndex(terminal)) : -1;
+		}
+
+	public:
+		/// Defines name
+		PassiveBatch(String name) : IdentifiedObject(name) { }
+
+		/// Adds the component if it is an inductor, capacitor or resistor of
+		/// exactly this type with a single frequency. Returns false otherwise.
+		Bool add(const MNAInterface::Ptr& comp);
+		///
+		UInt numInductors() const { return static_cast<UInt>(mInductors.comps.size()); }
+		///
+		UInt numCapacitors() const { return static_cast<UInt>(mCapacitors.comps.size()); }
+		///
+		UInt numResistors() const { return static_cast<UInt>(mResistors.comps.size()); }
+		/// Number of components in the batch
+		UInt size() const { return numInductors() + numCapacitors() + numResistors(); }
+
+		// #### MNA section ####
+		/// Creates the tasks of the batch after all components were added
+		void mnaInitialize(Real omega, Real timeStep, Attribute<Matrix>::Ptr leftVector);
+		/// Stamps the system matrix of all components
+		void mnaApplySystemMatrixStamp(Matrix& systemMatrix);
+		/// Adds the history currents of all components to the right side vector
+		void mnaApplyRightSideVectorStamp(Matrix& rightVector);
+		/// MNA pre step operations
+		void mnaPreStep(Real time, Int timeStepCount);
+		/// MNA post step operations
+		void mnaPostStep(Real time, Int timeStepCount, Attribute<Matrix>::Ptr &leftVector);
+		/// Add MNA pre step dependencies
+		void mnaAddPreStepDependencies(AttributeBase::List &prevStepDependencies, AttributeBase::List &attributeDependencies, AttributeBase::List &modifiedAttributes);
+		/// Add MNA post step dependencies
+		void mnaAddPostStepDependencies(AttributeBase::List &prevStepDependencies, AttributeBase::List &attributeDependencies, AttributeBase::List &modifiedAttributes, Attribute<Matrix>::Ptr &leftVector);
+
+		class MnaPreStep : public Task {
+		public:
+			MnaPreStep(PassiveBatch& batch) :
+				Task(batch.mName + ".MnaPreStep"), mBatch(batch) {
+				mBatch.mnaAddPreStepDependencies(mPrevStepDependencies, mAttributeDependencies, mModifiedAttributes);
+			}
+			void execute(Real time, Int timeStepCount) { mBatch.mnaPreStep(time, timeStepCount); };
+		private:
+			PassiveBatch& mBatch;
+		};
+
+		class MnaPostStep : public Task {
+		public:
+			MnaPostStep(PassiveBatch& batch, Attribute<Matrix>::Ptr leftVector) :
+				Task(batch.mName + ".MnaPostStep"), mBatch(batch), mLeftVector(leftVector) {
+				mBatch.mnaAddPostStepDependencies(mPrevStepDependencies, mAttributeDependencies, mModifiedAttributes, mLeftVector);
+			}
+			void execute(Real time, Int timeStepCount) { mBatch.mnaPostStep(time, timeStepCount, mLeftVector); };
+		private:
+			PassiveBatch& mBatch;
+			Attribute<Matrix>::Ptr mLeftVector;
+		};
+	};
+}
+}
+}
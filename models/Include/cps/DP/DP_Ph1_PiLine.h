@@ -40,8 +40,6 @@ namespace Ph1 {
 		std::shared_ptr<Resistor> mSubParallelResistor1;
 		/// Parallel capacitor submodel at Terminal 1
 		std::shared_ptr<Capacitor> mSubParallelCapacitor1;
-		/// Right side vectors of subcomponents
-		std::vector<const Matrix*> mRightVectorStamps;
 	public:
 		/// Defines UID, name and logging level
 		PiLine(String uid, String name, Logger::Level logLevel = Logger::Level::off);
@@ -60,30 +58,15 @@ namespace Ph1 {
 		void mnaInitialize(Real omega, Real timeStep, Attribute<Matrix>::Ptr leftVector);
 		/// Stamps system matrix
 		void mnaApplySystemMatrixStamp(Matrix& systemMatrix);
-		/// Stamps right side (source) vector
-		void mnaApplyRightSideVectorStamp(Matrix& rightVector);
 		/// Updates internal current variable of the component
 		void mnaUpdateCurrent(const Matrix& leftVector);
 		/// Updates internal voltage variable of the component
 		void mnaUpdateVoltage(const Matrix& leftVector);
-		/// MNA pre and post step operations
-		void mnaPreStep(Real time, Int timeStepCount);
+		/// MNA post step operations, the subcomponents are stepped by their own tasks
 		void mnaPostStep(Real time, Int timeStepCount, Attribute<Matrix>::Ptr &leftVector);
-		/// add MNA pre and post step dependencies
-		void mnaAddPreStepDependencies(AttributeBase::List &prevStepDependencies, AttributeBase::List &attributeDependencies, AttributeBase::List &modifiedAttributes);
+		/// add MNA post step dependencies
 		void mnaAddPostStepDependencies(AttributeBase::List &prevStepDependencies, AttributeBase::List &attributeDependencies, AttributeBase::List &modifiedAttributes, Attribute<Matrix>::Ptr &leftVector);
 
-		class MnaPreStep : public Task {
-		public:
-			MnaPreStep(PiLine& line) :
-				Task(line.mName + ".MnaPreStep"), mLine(line) {
-					mLine.mnaAddPreStepDependencies(mPrevStepDependencies, mAttributeDependencies, mModifiedAttributes);
-			}
-			void execute(Real time, Int timeStepCount) { mLine.mnaPreStep(time, timeStepCount); };
-		private:
-			PiLine& mLine;
-		};
-
 		class MnaPostStep : public Task {
 		public:
 			MnaPostStep(PiLine& line, Attribute<Matrix>::Ptr leftVector) :
@@ -49,8 +49,6 @@ namespace Ph1 {
 		std::shared_ptr<DP::Ph1::Capacitor> mSubCapacitor;
 		/// Internal resistance
 		std::shared_ptr<DP::Ph1::Resistor> mSubResistor;
-		/// Right side vectors of subcomponents
-		std::vector<const Matrix*> mRightVectorStamps;
 	public:
 		/// Defines UID, name and logging level
 		RXLoad(String uid, String name,
@@ -72,35 +70,17 @@ namespace Ph1 {
 		void mnaInitialize(Real omega, Real timeStep, Attribute<Matrix>::Ptr leftVector);
 		/// Stamps system matrix
 		void mnaApplySystemMatrixStamp(Matrix& systemMatrix);
-		/// Stamps right side (source) vector
-		void mnaApplyRightSideVectorStamp(Matrix& rightVector);
 		/// Update interface current from MNA system result
 		void mnaUpdateCurrent(const Matrix& leftVector);
 		/// Update interface voltage from MNA system result
 		void mnaUpdateVoltage(const Matrix& leftVector);
-		/// MNA pre step operations
-		void mnaPreStep(Real time, Int timeStepCount);
-		/// MNA post step operations
+		/// MNA post step operations, the subcomponents are stepped by their own tasks
 		void mnaPostStep(Real time, Int timeStepCount, Attribute<Matrix>::Ptr &leftVector);
-		/// Add MNA pre step dependencies
-		void mnaAddPreStepDependencies(AttributeBase::List &prevStepDependencies,
-			AttributeBase::List &attributeDependencies, AttributeBase::List &modifiedAttributes);
 		/// Add MNA post step dependencies
 		void mnaAddPostStepDependencies(AttributeBase::List &prevStepDependencies,
 			AttributeBase::List &attributeDependencies, AttributeBase::List &modifiedAttributes,
 			Attribute<Matrix>::Ptr &leftVector);
 
-		class MnaPreStep : public Task {
-		public:
-			MnaPreStep(RXLoad& load) :
-				Task(load.mName + ".MnaPreStep"), mLoad(load) {
-				mLoad.mnaAddPreStepDependencies(mPrevStepDependencies, mAttributeDependencies, mModifiedAttributes);
-			}
-			void execute(Real time, Int timeStepCount) { mLoad.mnaPreStep(time, timeStepCount); }
-		private:
-			RXLoad& mLoad;
-		};
-
 		class MnaPostStep : public Task {
 		public:
 			MnaPostStep(RXLoad& load, Attribute<Matrix>::Ptr leftVector) :
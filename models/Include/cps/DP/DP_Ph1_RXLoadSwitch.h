@@ -26,8 +26,6 @@ namespace Ph1 {
 		std::shared_ptr<DP::Ph1::Switch> mSubSwitch;
 		/// internal switch is only opened after this time offset
 		Real mSwitchTimeOffset = 1.0;
-		/// Right side vectors of subcomponents
-		std::vector<const Matrix*> mRightVectorStamps;
 
 	public:
 		/// Defines UID, name and logging level
@@ -51,8 +49,6 @@ namespace Ph1 {
 		void mnaInitialize(Real omega, Real timeStep, Attribute<Matrix>::Ptr leftVector);
 		/// Stamps system matrix
 		void mnaApplySystemMatrixStamp(Matrix& systemMatrix);
-		/// Stamps right side (source) vector
-		void mnaApplyRightSideVectorStamp(Matrix& rightVector);
 		/// Update interface current from MNA system result
 		void mnaUpdateCurrent(const Matrix& leftVector) { }
 		/// Update interface voltage from MNA system result
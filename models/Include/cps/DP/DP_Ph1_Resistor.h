@@ -23,6 +23,8 @@ namespace Ph1 {
 		public DAEInterface,
 		public SimPowerComp<Complex>,
 		public SharedFactory<Resistor> {
+		/// Executes the steps of many components in batched mode
+		friend class PassiveBatch;
 	public:
 		/// Defines UID, name and logging level
 		Resistor(String uid, String name, Logger::Level loglevel = Logger::Level::off);
@@ -48,7 +50,7 @@ namespace Ph1 {
 		void mnaUpdateVoltageHarm(const Matrix& leftVector, Int freqIdx);
 		/// Update interface current from MNA system result
 		void mnaUpdateCurrent(const Matrix& leftVector);
-		void mnaUpdateCurrentHarm();
+		void mnaUpdateCurrentHarm(UInt freqIdx);
 		/// MNA pre and post step operations
 		void mnaPostStep(Real time, Int timeStepCount, Attribute<Matrix>::Ptr &leftVector);
 		/// add MNA pre and post step dependencies
@@ -69,18 +71,18 @@ namespace Ph1 {
 
 		class MnaPostStepHarm : public Task {
 		public:
-			MnaPostStepHarm(Resistor& resistor, std::vector<Attribute<Matrix>::Ptr> leftVectors) :
-				Task(resistor.mName + ".MnaPostStepHarm"),
-				mResistor(resistor), mLeftVectors(leftVectors) {
-				for (UInt i = 0; i < mLeftVectors.size(); i++)
-					mAttributeDependencies.push_back(mLeftVectors[i]);
+			MnaPostStepHarm(Resistor& resistor, Attribute<Matrix>::Ptr leftVector, UInt freqIdx) :
+				Task(resistor.mName + ".MnaPostStepHarm" + std::to_string(freqIdx)),
+				mResistor(resistor), mLeftVector(leftVector), mFreqIdx(freqIdx) {
+				mAttributeDependencies.push_back(mLeftVector);
 				mModifiedAttributes.push_back(mResistor.attribute("v_intf"));
 				mModifiedAttributes.push_back(mResistor.attribute("i_intf"));
 			}
 			void execute(Real time, Int timeStepCount);
 		private:
 			Resistor& mResistor;
-			std::vector< Attribute<Matrix>::Ptr > mLeftVectors;
+			Attribute<Matrix>::Ptr mLeftVector;
+			UInt mFreqIdx;
 		};
 
 		// #### MNA Tear Section ####
@@ -42,14 +42,18 @@ namespace Ph1 {
 
 		// #### General MNA section ####
 		void mnaInitialize(Real omega, Real timeStep, Attribute<Matrix>::Ptr leftVector);
+		void mnaInitializeHarm(Real omega, Real timeStep, std::vector<Attribute<Matrix>::Ptr> leftVectors);
 		/// Stamps system matrix
 		void mnaApplySystemMatrixStamp(Matrix& systemMatrix);
+		void mnaApplySystemMatrixStamp(SparseMatrixRow& systemMatrix);
 		/// Stamps right side (source) vector
 		void mnaApplyRightSideVectorStamp(Matrix& rightVector);
 		/// Update interface voltage from MNA system result
 		void mnaUpdateVoltage(const Matrix& leftVector);
+		void mnaUpdateVoltageHarm(const Matrix& leftVector, UInt freqIdx);
 		/// Update interface current from MNA system result
 		void mnaUpdateCurrent(const Matrix& leftVector);
+		void mnaUpdateCurrentHarm(UInt freqIdx);
 		/// MNA post step operations
 		void mnaPostStep(Real time, Int timeStepCount, Attribute<Matrix>::Ptr &leftVector);
 		/// Add MNA post step dependencies
@@ -70,11 +74,36 @@ namespace Ph1 {
 			Attribute<Matrix>::Ptr mLeftVector;
 		};
 
+		class MnaPostStepHarm : public Task {
+		public:
+			MnaPostStepHarm(Switch& switchRef, Attribute<Matrix>::Ptr leftVector, UInt freqIdx) :
+				Task(switchRef.mName + ".MnaPostStepHarm" + std::to_string(freqIdx)),
+				mSwitch(switchRef), mLeftVector(leftVector), mFreqIdx(freqIdx) {
+				mAttributeDependencies.push_back(mLeftVector);
+				mModifiedAttributes.push_back(mSwitch.attribute("v_intf"));
+				mModifiedAttributes.push_back(mSwitch.attribute("i_intf"));
+			}
+			void execute(Real time, Int timeStepCount);
+
+		private:
+			Switch& mSwitch;
+			Attribute<Matrix>::Ptr mLeftVector;
+			UInt mFreqIdx;
+		};
+
 		// #### MNA section for switch ####
 		/// Check if switch is closed
 		Bool mnaIsClosed() { return isClosed(); }
 		/// Stamps system matrix considering the defined switch position
 		void mnaApplySwitchSystemMatrixStamp(Matrix& systemMatrix, Bool closed);
+		void mnaApplySwitchSystemMatrixStamp(SparseMatrixRow& systemMatrix, Bool closed);
+		void mnaApplySwitchSystemMatrixStampHarm(Matrix& systemMatrix, Bool closed, UInt freqIdx);
+
+	private:
+		/// Stamps the conductance of the given switch position for one frequency
+		/// into a dense or sparse system matrix
+		template <typename MatrixType>
+		void applySwitchSystemMatrixStamp(MatrixType& systemMatrix, Bool closed, Int maxFreq, Int freqIdx);
 	};
 }
 }
@@ -43,6 +43,11 @@ namespace Ph1 {
 		std::shared_ptr<VoltageSource> mSubVoltageSource;
 		/// Inner inductor that represents the generator impedance
 		std::shared_ptr<Inductor> mSubInductor;
+		/// Voltage reference of the inner voltage source
+		AttributeHandle<Complex> mSubVoltageSourceRef;
+		/// Right side vectors of the subcomponents
+		AttributeHandle<Matrix> mSubVoltageSourceRightVector;
+		AttributeHandle<Matrix> mSubInductorRightVector;
 		// Logging
 		Matrix mStates;
 	public:
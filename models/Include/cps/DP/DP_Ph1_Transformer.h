@@ -56,33 +56,15 @@ namespace Ph1 {
 		void mnaInitialize(Real omega, Real timeStep, Attribute<Matrix>::Ptr leftVector);
 		/// Stamps system matrix
 		void mnaApplySystemMatrixStamp(Matrix& systemMatrix);
-		/// Stamps right side (source) vector
-		void mnaApplyRightSideVectorStamp(Matrix& rightVector);
 		/// Updates internal current variable of the component
 		void mnaUpdateCurrent(const Matrix& leftVector);
 		/// Updates internal voltage variable of the component
 		void mnaUpdateVoltage(const Matrix& leftVector);
-		/// MNA pre step operations
-		void mnaPreStep(Real time, Int timeStepCount);
-		/// MNA post step operations
+		/// MNA post step operations, the subcomponents are stepped by their own tasks
 		void mnaPostStep(Real time, Int timeStepCount, Attribute<Matrix>::Ptr &leftVector);
-		/// Add MNA pre step dependencies
-		void mnaAddPreStepDependencies(AttributeBase::List &prevStepDependencies, AttributeBase::List &attributeDependencies, AttributeBase::List &modifiedAttributes);
 		/// Add MNA post step dependencies
 		void mnaAddPostStepDependencies(AttributeBase::List &prevStepDependencies, AttributeBase::List &attributeDependencies, AttributeBase::List &modifiedAttributes, Attribute<Matrix>::Ptr &leftVector);
 
-		class MnaPreStep : public Task {
-		public:
-			MnaPreStep(Transformer& transformer) :
-				Task(transformer.mName + ".MnaPreStep"), mTransformer(transformer) {
-					mTransformer.mnaAddPreStepDependencies(mPrevStepDependencies, mAttributeDependencies, mModifiedAttributes);
-			}
-			void execute(Real time, Int timeStepCount) { mTransformer.mnaPreStep(time, timeStepCount); };
-		private:
-			Transformer& mTransformer;
-		};
-
-
 		class MnaPostStep : public Task {
 		public:
 			MnaPostStep(Transformer& transformer, Attribute<Matrix>::Ptr leftVector) :
@@ -67,6 +67,7 @@ namespace Ph1 {
 		void mnaApplyRightSideVectorStampHarm(Matrix& rightVector);
 		/// Returns current through the component
 		void mnaUpdateCurrent(const Matrix& leftVector);
+		void mnaUpdateCurrentHarm(const Matrix& leftVector, UInt freqIdx);
 		/// MNA pre step operations
 		void mnaPreStep(Real time, Int timeStepCount);
 		/// MNA post step operations
@@ -116,17 +117,17 @@ namespace Ph1 {
 
 		class MnaPostStepHarm : public CPS::Task {
 		public:
-			MnaPostStepHarm(VoltageSource& voltageSource, std::vector<Attribute<Matrix>::Ptr> leftVectors) :
-				Task(voltageSource.mName + ".MnaPostStepHarm"),
-				mVoltageSource(voltageSource), mLeftVectors(leftVectors) {
-				for (UInt i = 0; i < mLeftVectors.size(); i++)
-					mAttributeDependencies.push_back(mLeftVectors[i]);
+			MnaPostStepHarm(VoltageSource& voltageSource, Attribute<Matrix>::Ptr leftVector, UInt freqIdx) :
+				Task(voltageSource.mName + ".MnaPostStepHarm" + std::to_string(freqIdx)),
+				mVoltageSource(voltageSource), mLeftVector(leftVector), mFreqIdx(freqIdx) {
+				mAttributeDependencies.push_back(mLeftVector);
 				mModifiedAttributes.push_back(mVoltageSource.attribute("i_intf"));
 			}
 			void execute(Real time, Int timeStepCount);
 		private:
 			VoltageSource& mVoltageSource;
-			std::vector< Attribute<Matrix>::Ptr > mLeftVectors;
+			Attribute<Matrix>::Ptr mLeftVector;
+			UInt mFreqIdx;
 		};
 
 		// #### DAE Section ####
@@ -32,12 +32,12 @@ namespace Ph3 {
 		/// @brief Park transform as described in Krause
 		///
 		/// Balanced case because the zero sequence variable is ignored
-		Matrix abcToDq0Transform(Real theta, MatrixComp& abc);
+		Vector3 abcToDq0Transform(Real theta, const MatrixComp& abc);
 
 		/// @brief Inverse Park transform as described in Krause
 		///
 		/// Balanced case because the zero sequence variable is ignored
-		MatrixComp dq0ToAbcTransform(Real theta, Matrix& dq0);
+		Vector3Comp dq0ToAbcTransform(Real theta, const Matrix& dq0);
 
 		// #### Deprecated ###
 		/// calculate flux states using trapezoidal rule - depcrecated
@@ -61,6 +61,8 @@ namespace CPS {
 	typedef Eigen::Matrix<Complex, Eigen::Dynamic, 1> VectorComp;
 	/// @brief Dense vector for real numbers.
 	typedef Eigen::Matrix<Real, Eigen::Dynamic, 1> Vector;
+	/// @brief Sparse vector for real numbers.
+	typedef Eigen::SparseVector<Real> SparseVector;
 	/// @brief Sparse matrix for real numbers.
 	typedef Eigen::SparseMatrix<Real, Eigen::ColMajor> SparseMatrix;
 	/// @brief Sparse matrix for real numbers (row major).
@@ -75,6 +77,14 @@ namespace CPS {
 	typedef Eigen::Matrix<Complex, Eigen::Dynamic, Eigen::Dynamic, Eigen::ColMajor> MatrixComp;
 	/// @brief Dense matrix for integers.
 	typedef Eigen::Matrix<Int, Eigen::Dynamic, Eigen::Dynamic, Eigen::ColMajor> MatrixInt;
+	/// @brief Fixed size dense matrix for the coupling of three phases.
+	typedef Eigen::Matrix<Real, 3, 3> Matrix3;
+	/// @brief Fixed size dense vector for the values of three phases.
+	typedef Eigen::Matrix<Real, 3, 1> Vector3;
+	/// @brief Fixed size dense matrix for the coupling of three complex phases.
+	typedef Eigen::Matrix<Complex, 3, 3> Matrix3Comp;
+	/// @brief Fixed size dense vector for the values of three complex phases.
+	typedef Eigen::Matrix<Complex, 3, 1> Vector3Comp;
 	///
 	typedef Eigen::PartialPivLU<Matrix> LUFactorized;
 	///
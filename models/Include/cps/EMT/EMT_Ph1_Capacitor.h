@@ -32,6 +32,9 @@ namespace Ph1 {
 		Real mEquivCurrent;
 		/// Equivalent conductance [S]
 		Real mEquivCond;
+		/// Stamps the equivalent current into a dense or sparse right side vector
+		template <typename VectorType>
+		void applyRightSideVectorStamp(VectorType& rightVector);
 	public:
 		/// Defines UID, name and logging level
 		Capacitor(String uid, String name, Logger::Level logLevel = Logger::Level::off);
@@ -52,6 +55,7 @@ namespace Ph1 {
 		void mnaApplySystemMatrixStamp(Matrix& systemMatrix);
 		/// Stamps right side (source) vector
 		void mnaApplyRightSideVectorStamp(Matrix& rightVector);
+		void mnaApplyRightSideVectorStamp(SparseVector& rightVector);
 		/// Update interface voltage from MNA system result
 		void mnaUpdateVoltage(const Matrix& leftVector);
 		/// Update interface current from MNA system result
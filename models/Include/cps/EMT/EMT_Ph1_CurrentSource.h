@@ -26,6 +26,9 @@ namespace Ph1 {
 	private:
 		Attribute<Complex>::Ptr mCurrentRef;
 		Attribute<Real>::Ptr mSrcFreq;
+		/// Stamps the equivalent current into a dense or sparse right side vector
+		template <typename VectorType>
+		void applyRightSideVectorStamp(VectorType& rightVector);
 	public:
 		/// Defines UID, name and logging level
 		CurrentSource(String uid, String name,
@@ -48,6 +51,7 @@ namespace Ph1 {
 		void mnaApplySystemMatrixStamp(Matrix& systemMatrix) { }
 		/// Stamps right side (source) vector
 		void mnaApplyRightSideVectorStamp(Matrix& rightVector);
+		void mnaApplyRightSideVectorStamp(SparseVector& rightVector);
 		///
 		void mnaUpdateVoltage(const Matrix& leftVector);
 
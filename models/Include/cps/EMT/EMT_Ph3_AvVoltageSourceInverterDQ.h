@@ -49,6 +49,12 @@ namespace Ph3 {
 		std::shared_ptr<Signal::PLL> mPLL;
 		/// Power Controller
 		std::shared_ptr<Signal::PowerControllerVSI> mPowerControllerVSI;
+		/// Angle output of the PLL in the previous step
+		AttributeHandle<Matrix> mPLLOutputPrev;
+		/// Output of the power controller in the current step
+		AttributeHandle<Matrix> mPowerCtrlOutputCurr;
+		/// Voltage of the connection node
+		AttributeHandle<Matrix> mConnectionNodeVoltage;
 
 		// ### Electrical Subcomponents ###
 		/// Controlled voltage source
@@ -82,6 +88,8 @@ namespace Ph3 {
 		Bool mWithConnectionTransformer=false;
 		/// Flag for controller usage
 		Bool mWithControl=true;
+		/// Number of simulation time steps between two executions of the power controller
+		UInt mControlPeriod = 1;
 		
 		// #### solver ####
 		///
@@ -110,6 +118,9 @@ namespace Ph3 {
 		void setInitialStateValues(Real pInit, Real qInit,
 			Real phi_dInit, Real phi_qInit, Real gamma_dInit, Real gamma_qInit);
 		void withControl(Bool controlOn) { mWithControl = controlOn; };
+		/// Execute the power controller only in every given number of time
+		/// steps. Must be set before the initialization.
+		void setControlPeriod(UInt steps);
 
 		///
 		Matrix getParkTransformMatrixPowerInvariant(Real theta);
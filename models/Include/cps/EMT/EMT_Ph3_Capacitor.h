@@ -10,6 +10,7 @@
 
 #include <cps/SimPowerComp.h>
 #include <cps/Solver/MNAInterface.h>
+#include <cps/EMT/EMT_Ph3_CompanionKernels.h>
 #include <cps/Base/Base_Ph3_Capacitor.h>
 
 namespace CPS {
@@ -29,9 +30,16 @@ namespace CPS {
 				public SharedFactory<Capacitor> {
 			protected:
 				/// DC equivalent current source [A]
-				Matrix mEquivCurrent = Matrix::Zero(3, 1);
+				Vector3 mEquivCurrent = Vector3::Zero();
 				/// Equivalent conductance [S]
-				Matrix mEquivCond = Matrix::Zero(3, 1);
+				Matrix3 mEquivCond = Matrix3::Zero();
+				/// Matrix rows of the phases of both terminals
+				CompanionKernels::NodeIndices mNodeIndices;
+				/// Entries of the own right side vector stamp
+				CompanionKernels::VectorEntries mRightVectorEntries;
+				/// Stamps the equivalent current into a dense or sparse right side vector
+				template <typename VectorType>
+				void applyRightSideVectorStamp(VectorType& rightVector);
 			public:
 				/// Defines UID, name and logging level
 				Capacitor(String uid, String name, Logger::Level logLevel = Logger::Level::off);
@@ -52,6 +60,7 @@ namespace CPS {
 				void mnaApplySystemMatrixStamp(Matrix& systemMatrix);
 				/// Stamps right side (source) vector
 				void mnaApplyRightSideVectorStamp(Matrix& rightVector);
+				void mnaApplyRightSideVectorStamp(SparseVector& rightVector);
 				/// Update interface voltage from MNA system result
 				void mnaUpdateVoltage(const Matrix& leftVector);
 				/// Update interface current from MNA system result
@@ -0,0 +1,113 @@
+/* Copyright 2017-2020 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#pragma once
+
+#include <array>
+
+#include <cps/SimPowerComp.h>
+
+#if defined(__AVX2__) && defined(__FMA__)
+  #include <immintrin.h>
+#endif
+
+namespace CPS {
+namespace EMT {
+namespace Ph3 {
+	/// \brief Step kernels of three-phase trapezoidal companion models
+	///
+	/// The companion model of a three-phase inductor or capacitor is a 3x3
+	/// conductance G in parallel with a history current source j. Each step
+	/// updates j from the interface voltage and current of the previous step,
+	/// stamps j into the right side vector and computes the new current
+	/// as G * v + j.
+	///
+	/// The matrix-vector products use AVX2 and FMA if the code is compiled for
+	/// them (e.g. with -march=native) and a scalar implementation otherwise.
+	/// The stamp is a scatter to six entries, which is scalar in both cases.
+	class CompanionKernels {
+	public:
+		/// Right side vector rows of the three phases of terminal 0 followed by
+		/// those of terminal 1, -1 for ground
+		typedef std::array<Matrix::Index, 6> NodeIndices;
+		/// Right side vector entries of the rows in NodeIndices, null for ground
+		typedef std::array<Real*, 6> VectorEntries;
+
+		/// Rows of the phases of both terminals of a component
+		static NodeIndices nodeIndices(SimPowerComp<Real>& comp) {
+			NodeIndices nodes;
+			for (UInt terminal = 0; terminal < 2; terminal++) {
+				for (UInt phase = 0; phase < 3; phase++)
+					nodes[3 * terminal + phase] = comp.terminalNotGrounded(terminal) ?
+						static_cast<Matrix::Index>(comp.matrixNodeIndex(terminal, phase)) : -1;
+			}
+			return nodes;
+		}
+
+		/// y = sign * (G * x + z), where y may alias z
+		static void multiplyAdd(const Matrix3& G, const Real* x, const Real* z, Real sign, Real* y) {
+#if defined(__AVX2__) && defined(__FMA__)
+			// The masked lanes are neither read nor written
+			const __m256i mask = _mm256_set_epi64x(0, -1, -1, -1);
+			const Real* g = G.data();
+			__m256d acc = _mm256_maskload_pd(z, mask);
+			acc = _mm256_fmadd_pd(_mm256_maskload_pd(g, mask), _mm256_broadcast_sd(x), acc);
+			acc = _mm256_fmadd_pd(_mm256_maskload_pd(g + 3, mask), _mm256_broadcast_sd(x + 1), acc);
+			acc = _mm256_fmadd_pd(_mm256_maskload_pd(g + 6, mask), _mm256_broadcast_sd(x + 2), acc);
+			_mm256_maskstore_pd(y, mask, _mm256_mul_pd(acc, _mm256_set1_pd(sign)));
+#else
+			const Real y0 = G(0, 0) * x[0] + G(0, 1) * x[1] + G(0, 2) * x[2] + z[0];
+			const Real y1 = G(1, 0) * x[0] + G(1, 1) * x[1] + G(1, 2) * x[2] + z[1];
+			const Real y2 = G(2, 0) * x[0] + G(2, 1) * x[1] + G(2, 2) * x[2] + z[2];
+			y[0] = sign * y0;
+			y[1] = sign * y1;
+			y[2] = sign * y2;
+#endif
+		}
+
+		/// Sets the entries of terminal 0 to j and those of terminal 1 to -j
+		static void stampCurrent(const VectorEntries& entries, const Real* j) {
+			for (int k = 0; k < 3; k++) {
+				if (entries[k])
+					*entries[k] = j[k];
+				if (entries[k + 3])
+					*entries[k + 3] = -j[k];
+			}
+		}
+
+		/// v = v1 - v0 from the left side vector
+		static void terminalVoltage(const Matrix& leftVector, const NodeIndices& nodes, Real* v) {
+			const Real* lv = leftVector.data();
+			for (int k = 0; k < 3; k++)
+				v[k] = (nodes[k + 3] >= 0 ? lv[nodes[k + 3]] : 0.) - (nodes[k] >= 0 ? lv[nodes[k]] : 0.);
+		}
+
+		/// Entries of a dense right side vector
+		static VectorEntries vectorEntries(Matrix& rightVector, const NodeIndices& nodes) {
+			VectorEntries entries;
+			for (int k = 0; k < 6; k++)
+				entries[k] = nodes[k] >= 0 ? &rightVector(nodes[k], 0) : nullptr;
+			return entries;
+		}
+
+		/// Entries of a sparse right side vector. They are inserted first,
+		/// so that the vector is not reallocated while taking their addresses.
+		static VectorEntries vectorEntries(SparseVector& rightVector, const NodeIndices& nodes) {
+			for (int k = 0; k < 6; k++) {
+				if (nodes[k] >= 0)
+					rightVector.coeffRef(nodes[k]);
+			}
+			VectorEntries entries;
+			for (int k = 0; k < 6; k++)
+				entries[k] = nodes[k] >= 0 ? &rightVector.coeffRef(nodes[k]) : nullptr;
+			return entries;
+		}
+	};
+}
+}
+}
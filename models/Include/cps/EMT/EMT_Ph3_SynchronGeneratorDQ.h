@@ -32,12 +32,12 @@ namespace Ph3 {
 		/// @brief Park transform as described in Krause
 		///
 		/// Balanced case because the zero sequence variable is ignored
-		Matrix abcToDq0Transform(Real theta, Matrix& abc);
+		Vector3 abcToDq0Transform(Real theta, const Matrix& abc);
 
 		/// @brief Inverse Park transform as described in Krause
 		///
 		/// Balanced case because the zero sequence variable is ignored
-		Matrix dq0ToAbcTransform(Real theta, Matrix& dq0);
+		Vector3 dq0ToAbcTransform(Real theta, const Matrix& dq0);
 
 	public:
 		virtual ~SynchronGeneratorDQ();
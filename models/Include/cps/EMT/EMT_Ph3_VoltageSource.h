@@ -26,6 +26,10 @@ namespace CPS {
 				public SimPowerComp<Real>,
 				public SharedFactory<VoltageSource> {
 			protected:
+				/// Reference voltage and frequency
+				AttributeHandle<MatrixComp> mVoltageRef;
+				AttributeHandle<Real> mSrcFreq;
+
 				// Updates voltage according to reference phasor and frequency
 				void updateVoltage(Real time);
 			public:
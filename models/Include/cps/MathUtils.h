@@ -116,6 +116,23 @@ namespace CPS {
 			return mat(row, 0);
 		}
 
+		// #### Sparse Vector Operations ####
+		//
+		// Same layout as for dense vectors, but only the touched entries are stored.
+
+		static void setVectorElement(SparseVector& vec, SparseVector::Index row, Complex value, Int maxFreq = 1, Int freqIdx = 0) {
+			Eigen::Index harmonicOffset = vec.rows() / maxFreq;
+			Eigen::Index complexOffset = harmonicOffset / 2;
+			Eigen::Index harmRow = row + harmonicOffset * freqIdx;
+
+			vec.coeffRef(harmRow) = value.real();
+			vec.coeffRef(harmRow + complexOffset) = value.imag();
+		}
+
+		static void setVectorElement(SparseVector& vec, SparseVector::Index row, Real value) {
+			vec.coeffRef(row) = value;
+		}
+
 		// #### Matric Operations ####
 		//
 		// | Re-Re(row,col)_harm1 | Im-Re(row,col)_harm1 | Interharmonics harm1-harm2
@@ -167,6 +184,28 @@ namespace CPS {
 					addToMatrixElement(mat, rows[phase], columns[phase], value);
 		}
 
+		// #### Sparse Matrix Operations ####
+		//
+		// Same layout as for dense matrices. Entries in the sparsity pattern
+		// are updated in place, others are inserted.
+
+		static void addToMatrixElement(SparseMatrixRow& mat, Matrix::Index row, Matrix::Index column, Complex value, Int maxFreq = 1, Int freqIdx = 0) {
+			// Assume square matrix
+			Eigen::Index harmonicOffset = mat.rows() / maxFreq;
+			Eigen::Index complexOffset = harmonicOffset / 2;
+			Eigen::Index harmRow = row + harmonicOffset * freqIdx;
+			Eigen::Index harmCol = column + harmonicOffset * freqIdx;
+
+			mat.coeffRef(harmRow, harmCol) += value.real();
+			mat.coeffRef(harmRow + complexOffset, harmCol + complexOffset) += value.real();
+			mat.coeffRef(harmRow, harmCol + complexOffset) -= value.imag();
+			mat.coeffRef(harmRow + complexOffset, harmCol) += value.imag();
+		}
+
+		static void addToMatrixElement(SparseMatrixRow& mat, Matrix::Index row, Matrix::Index column, Real value) {
+			mat.coeffRef(row, column) += value;
+		}
+
 		// #### Integration Methods ####
 		static Matrix StateSpaceTrapezoidal(Matrix states, Matrix A, Matrix B, Real dt, Matrix u_new, Matrix u_old);
 		static Matrix StateSpaceTrapezoidal(Matrix states, Matrix A, Matrix B, Matrix C, Real dt, Matrix u_new, Matrix u_old);
@@ -32,7 +32,7 @@ namespace Signal {
 		std::shared_ptr<EMT::SimNode> mNode1, mNode2;
 		std::shared_ptr<EMT::Ph1::Resistor> mRes1, mRes2;
 		std::shared_ptr<EMT::Ph1::CurrentSource> mSrc1, mSrc2;
-		Attribute<Complex>::Ptr mSrcCur1, mSrcCur2;
+		AttributeHandle<Complex> mSrcCur1, mSrcCur2;
 
 		// Ringbuffers for the values of previous timesteps
 		// TODO make these matrix attributes
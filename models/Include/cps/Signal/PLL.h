@@ -52,6 +52,9 @@ namespace Signal {
 		Matrix mC = Matrix::Zero(2, 2);
 		/// matrix D of state space model
 		Matrix mD = Matrix::Zero(2, 2);
+
+		/// Input reference, usually a reference to an attribute of the parent
+		AttributeHandle<Real> mInputRef;
 		
 	public:
 		PLL(String name, Logger::Level logLevel = Logger::Level::off);
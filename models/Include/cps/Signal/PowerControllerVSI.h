@@ -23,6 +23,8 @@ namespace Signal {
 	protected:
 		/// Simulation time step
 		Real mTimeStep;
+		/// Number of simulation time steps between two executions of the tasks
+		UInt mControlPeriod = 1;
 
 		// Power parameters
 		Real mPref = 0;
@@ -73,6 +75,12 @@ namespace Signal {
 		/// matrix D of state space model
 		Matrix mD = Matrix::Zero(2, 6);
 
+		// input references, usually references to attributes of the parent
+		AttributeHandle<Real> mVcd;
+		AttributeHandle<Real> mVcq;
+		AttributeHandle<Real> mIrcd;
+		AttributeHandle<Real> mIrcq;
+
 	public:
 		PowerControllerVSI(String name, Logger::Level logLevel = Logger::Level::off);
 		
@@ -83,6 +91,11 @@ namespace Signal {
 		/// Setter for initial state values
 		void setInitialStateValues(Real pInit, Real qInit, Real phi_dInit, Real phi_qInit, Real gamma_dInit, Real gamma_qInit);
 
+		/// Integrate the controller over the given number of simulation time
+		/// steps. Its tasks, or the component calling it, skip the other steps.
+		/// Must be set before the initialization.
+		void setControlPeriod(UInt steps);
+
 		/// Initialize vectors of state space model
 		void initializeStateSpaceModel(Real omega, Real timeStep, Attribute<Matrix>::Ptr leftVector);
 		/// Update B matrix due to its dependence on the input
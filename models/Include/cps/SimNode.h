@@ -109,17 +109,17 @@ namespace CPS {
 		///
 		class MnaPostStepHarm : public Task {
 		public:
-			MnaPostStepHarm(SimNode& node, std::vector<Attribute<Matrix>::Ptr> leftVectors) :
-				Task(node.mName + ".MnaPostStepHarm"),
-				mNode(node), mLeftVectors(leftVectors) {
-				for (UInt i = 0; i < mLeftVectors.size(); i++)
-					mAttributeDependencies.push_back(mLeftVectors[i]);
+			MnaPostStepHarm(SimNode& node, Attribute<Matrix>::Ptr leftVector, UInt freqIdx) :
+				Task(node.mName + ".MnaPostStepHarm" + std::to_string(freqIdx)),
+				mNode(node), mLeftVector(leftVector), mFreqIdx(freqIdx) {
+				mAttributeDependencies.push_back(mLeftVector);
 				mModifiedAttributes.push_back(mNode.attribute("v"));
 			}
 			void execute(Real time, Int timeStepCount);
 		private:
 			SimNode& mNode;
-			std::vector< Attribute<Matrix>::Ptr > mLeftVectors;
+			Attribute<Matrix>::Ptr mLeftVector;
+			UInt mFreqIdx;
 		};
 	};
 
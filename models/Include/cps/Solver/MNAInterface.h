@@ -24,6 +24,7 @@ namespace CPS {
 		/// Initializes variables of components
 		virtual void mnaInitialize(Real omega, Real timeStep) {
 			mMnaTasks.clear();
+			mMnaSubComponents.clear();
 		}
 		virtual void mnaInitialize(Real omega, Real timeStep, Attribute<Matrix>::Ptr leftVector) {
 			mnaInitialize(omega, timeStep);
@@ -38,6 +39,8 @@ namespace CPS {
 		}
 		/// Stamps right side (source) vector
 		virtual void mnaApplyRightSideVectorStamp(Matrix& rightVector) { }
+		/// Stamps sparse right side (source) vector
+		virtual void mnaApplyRightSideVectorStamp(SparseVector& rightVector) { }
 		/// Update interface voltage from MNA system result
 		virtual void mnaUpdateVoltage(const Matrix& leftVector) { }
 		/// Update interface current from MNA system result
@@ -65,16 +68,98 @@ namespace CPS {
 		const Task::List& mnaTasks() {
 			return mMnaTasks;
 		}
+
+		// #### Sparse right side vector ####
+		/// Requests a sparse right side vector stamp from components supporting it.
+		/// Has to be set before mnaInitialize is called.
+		void mnaSetSparseRightVector(Bool value) { mSparseRightVector = value; }
+		/// Returns true if the component stamps into a sparse right side vector
+		Bool mnaHasSparseRightVector() const { return mRightVectorSparse.size() != 0; }
+		/// Sparse contribution ("stamp") to the right side vector
+		const SparseVector& mnaRightVectorSparse() const { return mRightVectorSparse; }
+
+		// #### Frequency parallelization ####
+		/// Right side vector attribute of each frequency, empty if the
+		/// component stamps all frequencies in one pre-step
+		const AttributeBase::List& mnaRightVectorHarmAttributes() const { return mRightVectorHarmAttributes; }
+
+		// #### Subcomponents ####
+		/// Subcomponents that are registered with the solver as separate MNA components.
+		/// The solver collects their right side vector stamps next to the one of this component.
+		const List& mnaSubComponents() const { return mMnaSubComponents; }
+
 	protected:
 		/// Every MNA component modifies its source vector attribute.
+		/// "right_vector" refers to the dense stamp mRightVector. It stays
+		/// empty for components with a sparse stamp, see mnaInitializeRightVector.
 		MNAInterface() {
 			addAttribute<Matrix>("right_vector", &mRightVector, Flags::read);
 		}
 
+		/// Creates an empty right side vector stamp for a system with the given number of rows.
+		/// The stamp is sparse if the solver requested it and dense otherwise. A sparse
+		/// stamp is only available through mnaRightVectorSparse, the "right_vector"
+		/// attribute is then an empty matrix. Reading or logging it requires dense stamps.
+		void mnaInitializeRightVector(Matrix::Index rows) {
+			if (mSparseRightVector) {
+				mRightVector = Matrix();
+				mRightVectorSparse.resize(rows);
+			}
+			else {
+				mRightVectorSparse.resize(0);
+				mRightVector = Matrix::Zero(rows, 1);
+			}
+		}
+		/// Updates the sparse or dense right side vector stamp of this component
+		void mnaUpdateRightVector() {
+			if (mRightVectorSparse.size() != 0)
+				mnaApplyRightSideVectorStamp(mRightVectorSparse);
+			else
+				mnaApplyRightSideVectorStamp(mRightVector);
+		}
+
+		/// Adds an attribute "right_vector_<k>" for each frequency k. They all
+		/// refer to the harmonic stamp, of which the pre-step of frequency k
+		/// only writes column k. Pre-steps modify the attribute of their
+		/// frequency, so that the solve of a frequency only waits for them.
+		void mnaAddRightVectorHarmAttributes(UInt numFreqs) {
+			mRightVectorHarmAttributes.clear();
+			for (UInt freq = 0; freq < numFreqs; freq++) {
+				String name = "right_vector_" + std::to_string(freq);
+				addAttribute<Matrix>(name, &mRightVector, Flags::read);
+				mRightVectorHarmAttributes.push_back(attribute(name));
+			}
+		}
+
+		/// Initializes a subcomponent and registers it as separate MNA component.
+		/// Its tasks become part of the tasks of this component, so it is scheduled
+		/// with its own dependencies instead of being stepped by this component,
+		/// and its stamp is not added to the right side vector of this component.
+		void mnaInitializeSubComponent(const Ptr& subComp, Real omega, Real timeStep, Attribute<Matrix>::Ptr leftVector) {
+			subComp->mnaSetSparseRightVector(mSparseRightVector);
+			subComp->mnaInitialize(omega, timeStep, leftVector);
+			mMnaTasks.insert(mMnaTasks.end(), subComp->mnaTasks().begin(), subComp->mnaTasks().end());
+			mMnaSubComponents.push_back(subComp);
+		}
+		/// Stamps the system matrix of all registered subcomponents
+		void mnaApplySubComponentSystemMatrixStamps(Matrix& systemMatrix) {
+			for (auto& subComp : mMnaSubComponents)
+				subComp->mnaApplySystemMatrixStamp(systemMatrix);
+		}
+
 		/// List of tasks that relate to using MNA for this component (usually pre-step and/or post-step)
 		Task::List mMnaTasks;
+		/// Subcomponents registered with mnaInitializeSubComponent
+		List mMnaSubComponents;
 		/// This component's contribution ("stamp") to the right-side vector.
-		/// TODO performance improvements from a sparse representation, at least during copying / summation?
 		Matrix mRightVector;
+		/// Attributes of the columns of mRightVector in frequency-parallel mode
+		AttributeBase::List mRightVectorHarmAttributes;
+		/// Sparse variant of mRightVector which only holds the entries touched by this component.
+		/// It is used instead of mRightVector by components that initialize their stamp with
+		/// mnaInitializeRightVector if the solver requested it via mnaSetSparseRightVector.
+		SparseVector mRightVectorSparse;
+		/// Determines if a sparse right side vector stamp was requested
+		Bool mSparseRightVector = false;
 	};
 }
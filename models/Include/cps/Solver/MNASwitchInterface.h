@@ -24,6 +24,11 @@ namespace CPS {
 		virtual Bool mnaIsClosed() = 0;
 		/// Stamps system matrix considering the defined switch position
 		virtual void mnaApplySwitchSystemMatrixStamp(Matrix& systemMatrix, Bool closed) { }
+		/// Stamps the system matrix of a single frequency in frequency-parallel
+		/// mode considering the defined switch position
+		virtual void mnaApplySwitchSystemMatrixStampHarm(Matrix& systemMatrix, Bool closed, UInt freqIdx) {
+			mnaApplySwitchSystemMatrixStamp(systemMatrix, closed);
+		}
 		/// Stamps (sparse) system matrix considering the defined switch position
 		virtual void mnaApplySwitchSystemMatrixStamp(SparseMatrixRow& systemMatrix, Bool closed) {
 			Matrix mat = Matrix(systemMatrix);
@@ -36,6 +36,21 @@ namespace CPS {
 			return mName;
 		}
 
+		/// Number of time steps between two executions of the task
+		UInt period() const { return mPeriod; }
+		/// Execute the task only in every period-th time step. In the other
+		/// steps, the schedulers skip the task and the waits for its
+		/// dependencies, so dependent tasks use its last results.
+		void setPeriod(UInt period) { mPeriod = period > 0 ? period : 1; }
+		/// True if the task is executed in the given time step
+		Bool isActive(Int timeStepCount) const {
+			return mPeriod == 1 || static_cast<UInt>(timeStepCount) % mPeriod == 0;
+		}
+
+		/// True if the task only reads results and passes them on, e.g. to a
+		/// file or an interface, so that no other task depends on its effects
+		Bool isOutputOnly() const { return mOutputOnly; }
+
 		const std::vector<AttributeBase::Ptr>& getAttributeDependencies() {
 			return mAttributeDependencies;
 		}
@@ -51,6 +66,8 @@ namespace CPS {
 	protected:
 		Task(std::string name) : mName(name) {}
 		std::string mName;
+		UInt mPeriod = 1;
+		Bool mOutputOnly = false;
 		std::vector<AttributeBase::Ptr> mAttributeDependencies;
 		std::vector<AttributeBase::Ptr> mModifiedAttributes;
 		std::vector<AttributeBase::Ptr> mPrevStepDependencies;
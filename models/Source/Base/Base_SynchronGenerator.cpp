@@ -293,6 +293,33 @@ void Base::SynchronGenerator::calcStateSpaceMatrixDQ() {
 	}
 }
 
+void Base::SynchronGenerator::stepFluxStateSpace(Real dt) {
+	// Math::StateSpaceEuler or Math::StateSpaceTrapezoidal with
+	// A = omega_base * (FluxStateSpaceMat + OmegaFluxMat * omega) and
+	// u = omega_base * v_sr, but with buffers instead of temporaries
+	const Matrix::Index n = mPsisr.rows();
+	mFluxStepA = mBase_OmElec * (mFluxStateSpaceMat + mOmegaFluxMat * mOmMech);
+	mFluxStepInput = mBase_OmElec * mVsr;
+
+	if (mNumericalMethod == NumericalMethod::Euler) {
+		mFluxStepStates.noalias() = mFluxStepA * mPsisr;
+		mPsisr += dt * (mFluxStepStates + mFluxStepInput);
+		return;
+	}
+
+	mFluxStepF1 = Matrix::Identity(n, n) + (dt / 2.) * mFluxStepA;
+	mFluxStepLu.compute(Matrix::Identity(n, n) - (dt / 2.) * mFluxStepA);
+	// PartialPivLU::inverse allocates for the permutation, so the inverse
+	// is solved in place from the factors
+	mFluxStepF2Inv = mFluxStepLu.permutationP() * Matrix::Identity(n, n);
+	mFluxStepLu.matrixLU().triangularView<Eigen::UnitLower>().solveInPlace(mFluxStepF2Inv);
+	mFluxStepLu.matrixLU().triangularView<Eigen::Upper>().solveInPlace(mFluxStepF2Inv);
+	mFluxStepA.noalias() = mFluxStepF2Inv * mFluxStepF1;
+	mFluxStepStates.noalias() = mFluxStepA * mPsisr;
+	mFluxStepStates.noalias() += (mFluxStepF2Inv * dt) * mFluxStepInput;
+	mPsisr = mFluxStepStates;
+}
+
 Real Base::SynchronGenerator::calcHfromJ(Real J, Real omegaNominal, Int polePairNumber) {
 	return J * 0.5 * omegaNominal*omegaNominal / polePairNumber;
 }
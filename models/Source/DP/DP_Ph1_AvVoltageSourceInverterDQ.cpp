@@ -38,6 +38,7 @@ DP::Ph1::AvVoltageSourceInverterDQ::AvVoltageSourceInverterDQ(String uid, String
 	mSubComponents.push_back(mSubCapacitorF);
 	mSubComponents.push_back(mSubInductorF);
 	mSubComponents.push_back(mSubCtrledVoltageSource);
+	mSubCtrledVoltageRef = mSubCtrledVoltageSource->attributeHandle<Complex>("V_ref");
 
 	mSLog->info("Electrical subcomponents: ");
 	for (auto subcomp: mSubComponents)
@@ -46,6 +47,8 @@ DP::Ph1::AvVoltageSourceInverterDQ::AvVoltageSourceInverterDQ(String uid, String
 	// Create control sub components
 	mPLL = Signal::PLL::make(mName + "_PLL", mLogLevel);
 	mPowerControllerVSI = Signal::PowerControllerVSI::make(mName + "_PowerControllerVSI", mLogLevel);
+	mPLLOutputPrev = mPLL->attributeHandle<Matrix>("output_prev");
+	mPowerCtrlOutputCurr = mPowerControllerVSI->attributeHandle<Matrix>("output_curr");
 
 	// general variables of inverter
 	addAttribute<Real>("Omega_nom", &mOmegaN, Flags::read | Flags::write);
@@ -148,6 +151,11 @@ void DP::Ph1::AvVoltageSourceInverterDQ::setInitialStateValues(Real pInit, Real
 	mPowerControllerVSI->setInitialStateValues(pInit, qInit, phi_dInit, phi_qInit, gamma_dInit, gamma_qInit);
 }
 
+void DP::Ph1::AvVoltageSourceInverterDQ::setControlPeriod(UInt steps) {
+	mControlPeriod = steps > 0 ? steps : 1;
+	mPowerControllerVSI->setControlPeriod(mControlPeriod);
+}
+
 void DP::Ph1::AvVoltageSourceInverterDQ::initializeFromNodesAndTerminals(Real frequency) {
 
 	// set initial interface quantities
@@ -243,19 +251,12 @@ void DP::Ph1::AvVoltageSourceInverterDQ::mnaInitialize(Real omega, Real timeStep
 	// initialize electrical subcomponents with MNA interface
 	for (auto subcomp: mSubComponents)
 		if (auto mnasubcomp = std::dynamic_pointer_cast<MNAInterface>(subcomp))
-			mnasubcomp->mnaInitialize(omega, timeStep, leftVector);
+			mnaInitializeSubComponent(mnasubcomp, omega, timeStep, leftVector);
 
 	// initialize state space controller
 	mPowerControllerVSI->initializeStateSpaceModel(omega, timeStep, leftVector);
 	mPLL->setSimulationParameters(timeStep);
 
-	// collect right side vectors of subcomponents
-	mRightVectorStamps.push_back(&mSubCapacitorF->attribute<Matrix>("right_vector")->get());
-	mRightVectorStamps.push_back(&mSubInductorF->attribute<Matrix>("right_vector")->get());
-	mRightVectorStamps.push_back(&mSubCtrledVoltageSource->attribute<Matrix>("right_vector")->get());
-	if (mWithConnectionTransformer)
-		mRightVectorStamps.push_back(&mConnectionTransformer->attribute<Matrix>("right_vector")->get());
-
 	// collect tasks
 	mMnaTasks.push_back(std::make_shared<MnaPreStep>(*this));
 	mMnaTasks.push_back(std::make_shared<MnaPostStep>(*this, leftVector));
@@ -263,21 +264,11 @@ void DP::Ph1::AvVoltageSourceInverterDQ::mnaInitialize(Real omega, Real timeStep
 	// TODO: these are actually no MNA tasks
 	mMnaTasks.push_back(std::make_shared<ControlPreStep>(*this));
 	mMnaTasks.push_back(std::make_shared<ControlStep>(*this));
-
-	mRightVector = Matrix::Zero(leftVector->get().rows(), 1);
 }
 
 
 void DP::Ph1::AvVoltageSourceInverterDQ::mnaApplySystemMatrixStamp(Matrix& systemMatrix) {
-	for (auto subcomp: mSubComponents)
-		if (auto mnasubcomp = std::dynamic_pointer_cast<MNAInterface>(subcomp))
-			mnasubcomp->mnaApplySystemMatrixStamp(systemMatrix);
-}
-
-void DP::Ph1::AvVoltageSourceInverterDQ::mnaApplyRightSideVectorStamp(Matrix& rightVector) {
-	rightVector.setZero();
-	for (auto stamp : mRightVectorStamps)
-		rightVector += *stamp;
+	mnaApplySubComponentSystemMatrixStamps(systemMatrix);
 }
 
 void DP::Ph1::AvVoltageSourceInverterDQ::addControlPreStepDependencies(AttributeBase::List &prevStepDependencies, AttributeBase::List &attributeDependencies, AttributeBase::List &modifiedAttributes) {
@@ -289,7 +280,9 @@ void DP::Ph1::AvVoltageSourceInverterDQ::addControlPreStepDependencies(Attribute
 void DP::Ph1::AvVoltageSourceInverterDQ::controlPreStep(Real time, Int timeStepCount) {
 	// add pre-step of subcomponents
 	mPLL->signalPreStep(time, timeStepCount);
-	mPowerControllerVSI->signalPreStep(time, timeStepCount);
+	// the power controller is integrated over its control period
+	if (timeStepCount % mControlPeriod == 0)
+		mPowerControllerVSI->signalPreStep(time, timeStepCount);
 }
 
 void DP::Ph1::AvVoltageSourceInverterDQ::addControlStepDependencies(AttributeBase::List &prevStepDependencies, AttributeBase::List &attributeDependencies, AttributeBase::List &modifiedAttributes) {
@@ -299,14 +292,15 @@ void DP::Ph1::AvVoltageSourceInverterDQ::addControlStepDependencies(AttributeBas
 	// add step dependencies of component itself
 	attributeDependencies.push_back(attribute("i_intf"));
 	attributeDependencies.push_back(attribute("v_intf"));
+	attributeDependencies.push_back(mSubResistorC->attribute("i_intf"));
 	modifiedAttributes.push_back(attribute("Vsref"));
 }
 
 void DP::Ph1::AvVoltageSourceInverterDQ::controlStep(Real time, Int timeStepCount) {
 	// Transformation interface forward
 	Complex vcdq, ircdq;
-	vcdq = Math::rotatingFrame2to1(mVirtualNodes[3]->singleVoltage(), mPLL->attribute<Matrix>("output_prev")->get()(0, 0), mThetaN);
-	ircdq = Math::rotatingFrame2to1(-1. * mSubResistorC->attribute<MatrixComp>("i_intf")->get()(0, 0), mPLL->attribute<Matrix>("output_prev")->get()(0, 0), mThetaN);
+	vcdq = Math::rotatingFrame2to1(mVirtualNodes[3]->singleVoltage(), mPLLOutputPrev.get()(0, 0), mThetaN);
+	ircdq = Math::rotatingFrame2to1(-1. * mSubResistorC->intfCurrent()(0, 0), mPLLOutputPrev.get()(0, 0), mThetaN);
 	mVcd = vcdq.real();
 	mVcq = vcdq.imag();
 	mIrcd = ircdq.real();
@@ -314,67 +308,52 @@ void DP::Ph1::AvVoltageSourceInverterDQ::controlStep(Real time, Int timeStepCoun
 
 	// add step of subcomponents
 	mPLL->signalStep(time, timeStepCount);
-	mPowerControllerVSI->signalStep(time, timeStepCount);
+	if (timeStepCount % mControlPeriod == 0)
+		mPowerControllerVSI->signalStep(time, timeStepCount);
 
 	// Transformation interface backward
-	mVsref(0,0) = Math::rotatingFrame2to1(Complex(mPowerControllerVSI->attribute<Matrix>("output_curr")->get()(0, 0), mPowerControllerVSI->attribute<Matrix>("output_curr")->get()(1, 0)), mThetaN, mPLL->attribute<Matrix>("output_prev")->get()(0, 0));
+	mVsref(0,0) = Math::rotatingFrame2to1(Complex(mPowerCtrlOutputCurr.get()(0, 0), mPowerCtrlOutputCurr.get()(1, 0)), mThetaN, mPLLOutputPrev.get()(0, 0));
 
 	// Update nominal system angle
 	mThetaN = mThetaN + mTimeStep * mOmegaN;
 }
 
 void DP::Ph1::AvVoltageSourceInverterDQ::mnaAddPreStepDependencies(AttributeBase::List &prevStepDependencies, AttributeBase::List &attributeDependencies, AttributeBase::List &modifiedAttributes) {
-	// add pre-step dependencies of subcomponents
-	for (auto subcomp: mSubComponents)
-		if (auto mnasubcomp = std::dynamic_pointer_cast<MNAInterface>(subcomp))
-			mnasubcomp->mnaAddPreStepDependencies(prevStepDependencies, attributeDependencies, modifiedAttributes);
-	// add pre-step dependencies of component itself
 	prevStepDependencies.push_back(attribute("Vsref"));
 	prevStepDependencies.push_back(attribute("i_intf"));
 	prevStepDependencies.push_back(attribute("v_intf"));
 	attributeDependencies.push_back(mPowerControllerVSI->attribute<Matrix>("output_prev"));
 	attributeDependencies.push_back(mPLL->attribute<Matrix>("output_prev"));
+	// the pre-step of the controlled source stamps the new reference
+	modifiedAttributes.push_back(mSubCtrledVoltageSource->attribute("V_ref"));
 	modifiedAttributes.push_back(attribute("right_vector"));
 }
 
 void DP::Ph1::AvVoltageSourceInverterDQ::mnaPreStep(Real time, Int timeStepCount) {
-	// pre-steo of subcomponents - controlled source
 	if (mWithControl)
-		mSubCtrledVoltageSource->setParameters(mVsref(0,0));
-	// pre-step of subcomponents - others
-	for (auto subcomp: mSubComponents)
-		if (auto mnasubcomp = std::dynamic_pointer_cast<MNAInterface>(subcomp))
-			mnasubcomp->mnaPreStep(time, timeStepCount);
-	// pre-step of component itself
-	mnaApplyRightSideVectorStamp(mRightVector);
+		mSubCtrledVoltageRef.set(mVsref(0,0));
 }
 
 void DP::Ph1::AvVoltageSourceInverterDQ::mnaAddPostStepDependencies(AttributeBase::List &prevStepDependencies, AttributeBase::List &attributeDependencies, AttributeBase::List &modifiedAttributes, Attribute<Matrix>::Ptr &leftVector) {
-	// add post-step dependencies of subcomponents
-	for (auto subcomp: mSubComponents)
-		if (auto mnasubcomp = std::dynamic_pointer_cast<MNAInterface>(subcomp))
-			mnasubcomp->mnaAddPostStepDependencies(prevStepDependencies, attributeDependencies, modifiedAttributes, leftVector);
-	// add post-step dependencies of component itself
+	if (mWithConnectionTransformer)
+		attributeDependencies.push_back(mConnectionTransformer->attribute("i_intf"));
+	else
+		attributeDependencies.push_back(mSubResistorC->attribute("i_intf"));
 	attributeDependencies.push_back(leftVector);
 	modifiedAttributes.push_back(attribute("v_intf"));
 	modifiedAttributes.push_back(attribute("i_intf"));
 }
 
 void DP::Ph1::AvVoltageSourceInverterDQ::mnaPostStep(Real time, Int timeStepCount, Attribute<Matrix>::Ptr &leftVector) {
-	// post-step of subcomponents
-	for (auto subcomp: mSubComponents)
-		if (auto mnasubcomp = std::dynamic_pointer_cast<MNAInterface>(subcomp))
-			mnasubcomp->mnaPostStep(time, timeStepCount, leftVector);
-	// post-step of component itself
 	mnaUpdateCurrent(*leftVector);
 	mnaUpdateVoltage(*leftVector);
 }
 
 void DP::Ph1::AvVoltageSourceInverterDQ::mnaUpdateCurrent(const Matrix& leftvector) {
 	if (mWithConnectionTransformer)
-		mIntfCurrent = mConnectionTransformer->attribute<MatrixComp>("i_intf")->get();
+		mIntfCurrent = mConnectionTransformer->intfCurrent();
 	else
-		mIntfCurrent = mSubResistorC->attribute<MatrixComp>("i_intf")->get();
+		mIntfCurrent = mSubResistorC->intfCurrent();
 }
 
 void DP::Ph1::AvVoltageSourceInverterDQ::mnaUpdateVoltage(const Matrix& leftVector) {
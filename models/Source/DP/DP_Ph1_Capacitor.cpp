@@ -76,7 +76,7 @@ void DP::Ph1::Capacitor::mnaInitialize(Real omega, Real timeStep, Attribute<Matr
 		mIntfCurrent(0, freq) = mEquivCond(freq,0) * mIntfVoltage(0,freq) + mEquivCurrent(freq,0);
 	}
 
-	mRightVector = Matrix::Zero(leftVector->get().rows(), 1);
+	mnaInitializeRightVector(leftVector->get().rows());
 	mMnaTasks.push_back(std::make_shared<MnaPreStep>(*this));
 	mMnaTasks.push_back(std::make_shared<MnaPostStep>(*this, leftVector));
 
@@ -108,12 +108,17 @@ void DP::Ph1::Capacitor::mnaInitializeHarm(Real omega, Real timeStep, std::vecto
 		mIntfCurrent(0, freq) = mEquivCond(freq,0) * mIntfVoltage(0,freq) + mEquivCurrent(freq,0);
 	}
 
-	mMnaTasks.push_back(std::make_shared<MnaPreStepHarm>(*this));
-	mMnaTasks.push_back(std::make_shared<MnaPostStepHarm>(*this, leftVectors));
+	// One task per frequency so that the harmonics can run on different threads
+	mnaAddRightVectorHarmAttributes(mNumFreqs);
+	for (UInt freq = 0; freq < mNumFreqs; freq++) {
+		mMnaTasks.push_back(std::make_shared<MnaPreStepHarm>(*this, freq));
+		mMnaTasks.push_back(std::make_shared<MnaPostStepHarm>(*this, leftVectors[freq], freq));
+	}
 	mRightVector = Matrix::Zero(leftVectors[0]->get().rows(), mNumFreqs);
 }
 
-void DP::Ph1::Capacitor::mnaApplySystemMatrixStamp(Matrix& systemMatrix) {
+template <typename MatrixType>
+void DP::Ph1::Capacitor::applySystemMatrixStamp(MatrixType& systemMatrix) {
 	for (UInt freq = 0; freq < mNumFreqs; freq++) {
 		if (terminalNotGrounded(0))
 			Math::addToMatrixElement(systemMatrix, matrixNodeIndex(0), matrixNodeIndex(0), mEquivCond(freq,0), mNumFreqs, freq);
@@ -140,6 +145,14 @@ void DP::Ph1::Capacitor::mnaApplySystemMatrixStamp(Matrix& systemMatrix) {
 	}
 }
 
+void DP::Ph1::Capacitor::mnaApplySystemMatrixStamp(Matrix& systemMatrix) {
+	applySystemMatrixStamp(systemMatrix);
+}
+
+void DP::Ph1::Capacitor::mnaApplySystemMatrixStamp(SparseMatrixRow& systemMatrix) {
+	applySystemMatrixStamp(systemMatrix);
+}
+
 void DP::Ph1::Capacitor::mnaApplySystemMatrixStampHarm(Matrix& systemMatrix, Int freqIdx) {
 	if (terminalNotGrounded(0))
 		Math::addToMatrixElement(systemMatrix, matrixNodeIndex(0), matrixNodeIndex(0), mEquivCond(freqIdx,0));
@@ -165,7 +178,8 @@ void DP::Ph1::Capacitor::mnaApplySystemMatrixStampHarm(Matrix& systemMatrix, Int
 	}
 }
 
-void DP::Ph1::Capacitor::mnaApplyRightSideVectorStamp(Matrix& rightVector) {
+template <typename VectorType>
+void DP::Ph1::Capacitor::applyRightSideVectorStamp(VectorType& rightVector) {
 	for (UInt freq = 0; freq < mNumFreqs; freq++) {
 		//mCureqr = mCurrr + mGcr * mDeltavr + mGci * mDeltavi;
 		//mCureqi = mCurri + mGcr * mDeltavi - mGci * mDeltavr;
@@ -188,18 +202,29 @@ void DP::Ph1::Capacitor::mnaApplyRightSideVectorStamp(Matrix& rightVector) {
 	}
 }
 
-void DP::Ph1::Capacitor::mnaApplyRightSideVectorStampHarm(Matrix& rightVector) {
-	for (UInt freq = 0; freq < mNumFreqs; freq++) {
-		//mCureqr = mCurrr + mGcr * mDeltavr + mGci * mDeltavi;
-		//mCureqi = mCurri + mGcr * mDeltavi - mGci * mDeltavr;
-		mEquivCurrent(freq,0) = -mIntfCurrent(0,freq)
-			+ -mPrevVoltCoeff(freq,0) * mIntfVoltage(0,freq);
+void DP::Ph1::Capacitor::mnaApplyRightSideVectorStamp(Matrix& rightVector) {
+	applyRightSideVectorStamp(rightVector);
+}
 
-		if (terminalNotGrounded(0))
-			Math::setVectorElement(rightVector, matrixNodeIndex(0), mEquivCurrent(freq,0), 1, 0, freq);
-		if (terminalNotGrounded(1))
-			Math::setVectorElement(rightVector, matrixNodeIndex(1), -mEquivCurrent(freq,0), 1, 0, freq);
-	}
+void DP::Ph1::Capacitor::mnaApplyRightSideVectorStamp(SparseVector& rightVector) {
+	applyRightSideVectorStamp(rightVector);
+}
+
+void DP::Ph1::Capacitor::applyRightSideVectorStampHarm(Matrix& rightVector, UInt freqIdx) {
+	//mCureqr = mCurrr + mGcr * mDeltavr + mGci * mDeltavi;
+	//mCureqi = mCurri + mGcr * mDeltavi - mGci * mDeltavr;
+	mEquivCurrent(freqIdx,0) = -mIntfCurrent(0,freqIdx)
+		+ -mPrevVoltCoeff(freqIdx,0) * mIntfVoltage(0,freqIdx);
+
+	if (terminalNotGrounded(0))
+		Math::setVectorElement(rightVector, matrixNodeIndex(0), mEquivCurrent(freqIdx,0), 1, 0, freqIdx);
+	if (terminalNotGrounded(1))
+		Math::setVectorElement(rightVector, matrixNodeIndex(1), -mEquivCurrent(freqIdx,0), 1, 0, freqIdx);
+}
+
+void DP::Ph1::Capacitor::mnaApplyRightSideVectorStampHarm(Matrix& rightVector) {
+	for (UInt freq = 0; freq < mNumFreqs; freq++)
+		applyRightSideVectorStampHarm(rightVector, freq);
 }
 
 void DP::Ph1::Capacitor::mnaApplyRightSideVectorStampHarm(Matrix& rightVector, Int freq) {
@@ -222,7 +247,7 @@ void DP::Ph1::Capacitor::mnaAddPreStepDependencies(AttributeBase::List &prevStep
 }
 
 void DP::Ph1::Capacitor::mnaPreStep(Real time, Int timeStepCount) {
-	this->mnaApplyRightSideVectorStamp(this->mRightVector);
+	this->mnaUpdateRightVector();
 }
 
 void DP::Ph1::Capacitor::mnaAddPostStepDependencies(AttributeBase::List &prevStepDependencies, AttributeBase::List &attributeDependencies, AttributeBase::List &modifiedAttributes, Attribute<Matrix>::Ptr &leftVector) {
@@ -237,13 +262,12 @@ void DP::Ph1::Capacitor::mnaPostStep(Real time, Int timeStepCount, Attribute<Mat
 }
 
 void DP::Ph1::Capacitor::MnaPreStepHarm::execute(Real time, Int timeStepCount) {
-	mCapacitor.mnaApplyRightSideVectorStampHarm(mCapacitor.mRightVector);
+	mCapacitor.applyRightSideVectorStampHarm(mCapacitor.mRightVector, mFreqIdx);
 }
 
 void DP::Ph1::Capacitor::MnaPostStepHarm::execute(Real time, Int timeStepCount) {
-	for (UInt freq = 0; freq < mCapacitor.mNumFreqs; freq++)
-		mCapacitor.mnaUpdateVoltageHarm(*mLeftVectors[freq], freq);
-	mCapacitor.mnaUpdateCurrentHarm();
+	mCapacitor.mnaUpdateVoltageHarm(*mLeftVector, mFreqIdx);
+	mCapacitor.mnaUpdateCurrentHarm(mFreqIdx);
 }
 
 void DP::Ph1::Capacitor::mnaUpdateVoltage(const Matrix& leftVector) {
@@ -277,9 +301,7 @@ void DP::Ph1::Capacitor::mnaUpdateCurrent(const Matrix& leftVector) {
 	}
 }
 
-void DP::Ph1::Capacitor::mnaUpdateCurrentHarm() {
-	for (UInt freq = 0; freq < mNumFreqs; freq++) {
-		mIntfCurrent(0,freq) = mEquivCond(freq,0) * mIntfVoltage(0,freq) + mEquivCurrent(freq,0);
-		SPDLOG_LOGGER_DEBUG(mSLog, "Current {:s}", Logger::phasorToString(mIntfCurrent(0,freq)));
-	}
+void DP::Ph1::Capacitor::mnaUpdateCurrentHarm(UInt freqIdx) {
+	mIntfCurrent(0,freqIdx) = mEquivCond(freqIdx,0) * mIntfVoltage(0,freqIdx) + mEquivCurrent(freqIdx,0);
+	SPDLOG_LOGGER_DEBUG(mSLog, "Current {:s}", Logger::phasorToString(mIntfCurrent(0,freqIdx)));
 }
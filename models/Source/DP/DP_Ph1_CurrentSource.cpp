@@ -62,14 +62,15 @@ void DP::Ph1::CurrentSource::mnaInitialize(Real omega, Real timeStep, Attribute<
 	mIntfCurrent(0,0) = mCurrentRef->get();
 	mMnaTasks.push_back(std::make_shared<MnaPreStep>(*this));
 	mMnaTasks.push_back(std::make_shared<MnaPostStep>(*this, leftVector));
-	mRightVector = Matrix::Zero(leftVector->get().rows(), 1);
+	mnaInitializeRightVector(leftVector->get().rows());
 }
 
 void DP::Ph1::CurrentSource::MnaPreStep::execute(Real time, Int timeStepCount) {
-	mCurrentSource.mnaApplyRightSideVectorStamp(mCurrentSource.mRightVector);
+	mCurrentSource.mnaUpdateRightVector();
 }
 
-void DP::Ph1::CurrentSource::mnaApplyRightSideVectorStamp(Matrix& rightVector) {
+template <typename VectorType>
+void DP::Ph1::CurrentSource::applyRightSideVectorStamp(VectorType& rightVector) {
 	mIntfCurrent(0,0) = mCurrentRef->get();
 
 	if (terminalNotGrounded(0))
@@ -78,6 +79,14 @@ void DP::Ph1::CurrentSource::mnaApplyRightSideVectorStamp(Matrix& rightVector) {
 		Math::setVectorElement(rightVector, matrixNodeIndex(1), mIntfCurrent(0,0));
 }
 
+void DP::Ph1::CurrentSource::mnaApplyRightSideVectorStamp(Matrix& rightVector) {
+	applyRightSideVectorStamp(rightVector);
+}
+
+void DP::Ph1::CurrentSource::mnaApplyRightSideVectorStamp(SparseVector& rightVector) {
+	applyRightSideVectorStamp(rightVector);
+}
+
 void DP::Ph1::CurrentSource::MnaPostStep::execute(Real time, Int timeStepCount) {
 	mCurrentSource.mnaUpdateVoltage(*mLeftVector);
 }
@@ -86,7 +86,7 @@ void DP::Ph1::Inductor::mnaInitialize(Real omega, Real timeStep, Attribute<Matri
 
 	mMnaTasks.push_back(std::make_shared<MnaPreStep>(*this));
 	mMnaTasks.push_back(std::make_shared<MnaPostStep>(*this, leftVector));
-	mRightVector = Matrix::Zero(leftVector->get().rows(), 1);
+	mnaInitializeRightVector(leftVector->get().rows());
 
 	mSLog->info(
 		"\n--- MNA initialization ---"
@@ -105,12 +105,17 @@ void DP::Ph1::Inductor::mnaInitializeHarm(Real omega, Real timeStep, std::vector
 
 	initVars(timeStep);
 
-	mMnaTasks.push_back(std::make_shared<MnaPreStepHarm>(*this));
-	mMnaTasks.push_back(std::make_shared<MnaPostStepHarm>(*this, leftVectors));
+	// One task per frequency so that the harmonics can run on different threads
+	mnaAddRightVectorHarmAttributes(mNumFreqs);
+	for (UInt freq = 0; freq < mNumFreqs; freq++) {
+		mMnaTasks.push_back(std::make_shared<MnaPreStepHarm>(*this, freq));
+		mMnaTasks.push_back(std::make_shared<MnaPostStepHarm>(*this, leftVectors[freq], freq));
+	}
 	mRightVector = Matrix::Zero(leftVectors[0]->get().rows(), mNumFreqs);
 }
 
-void DP::Ph1::Inductor::mnaApplySystemMatrixStamp(Matrix& systemMatrix) {
+template <typename MatrixType>
+void DP::Ph1::Inductor::applySystemMatrixStamp(MatrixType& systemMatrix) {
 	for (UInt freq = 0; freq < mNumFreqs; freq++) {
 		if (terminalNotGrounded(0))
 			Math::addToMatrixElement(systemMatrix, matrixNodeIndex(0), matrixNodeIndex(0), mEquivCond(freq,0), mNumFreqs, freq);
@@ -137,6 +142,14 @@ void DP::Ph1::Inductor::mnaApplySystemMatrixStamp(Matrix& systemMatrix) {
 	}
 }
 
+void DP::Ph1::Inductor::mnaApplySystemMatrixStamp(Matrix& systemMatrix) {
+	applySystemMatrixStamp(systemMatrix);
+}
+
+void DP::Ph1::Inductor::mnaApplySystemMatrixStamp(SparseMatrixRow& systemMatrix) {
+	applySystemMatrixStamp(systemMatrix);
+}
+
 void DP::Ph1::Inductor::mnaApplySystemMatrixStampHarm(Matrix& systemMatrix, Int freqIdx) {
 		if (terminalNotGrounded(0))
 			Math::addToMatrixElement(systemMatrix, matrixNodeIndex(0), matrixNodeIndex(0), mEquivCond(freqIdx,0));
@@ -162,7 +175,8 @@ void DP::Ph1::Inductor::mnaApplySystemMatrixStampHarm(Matrix& systemMatrix, Int
 		}
 }
 
-void DP::Ph1::Inductor::mnaApplyRightSideVectorStamp(Matrix& rightVector) {
+template <typename VectorType>
+void DP::Ph1::Inductor::applyRightSideVectorStamp(VectorType& rightVector) {
 	for (UInt freq = 0; freq < mNumFreqs; freq++) {
 		// Calculate equivalent current source for next time step
 		mEquivCurrent(freq,0) =
@@ -184,18 +198,29 @@ void DP::Ph1::Inductor::mnaApplyRightSideVectorStamp(Matrix& rightVector) {
 	}
 }
 
-void DP::Ph1::Inductor::mnaApplyRightSideVectorStampHarm(Matrix& rightVector) {
-	for (UInt freq = 0; freq < mNumFreqs; freq++) {
-		// Calculate equivalent current source for next time step
-		mEquivCurrent(freq,0) =
-			mEquivCond(freq,0) * mIntfVoltage(0,freq)
-			+ mPrevCurrFac(freq,0) * mIntfCurrent(0,freq);
+void DP::Ph1::Inductor::mnaApplyRightSideVectorStamp(Matrix& rightVector) {
+	applyRightSideVectorStamp(rightVector);
+}
 
-		if (terminalNotGrounded(0))
-			Math::setVectorElement(rightVector, matrixNodeIndex(0), mEquivCurrent(freq,0), 1, 0, freq);
-		if (terminalNotGrounded(1))
-			Math::setVectorElement(rightVector, matrixNodeIndex(1), -mEquivCurrent(freq,0), 1, 0, freq);
-	}
+void DP::Ph1::Inductor::mnaApplyRightSideVectorStamp(SparseVector& rightVector) {
+	applyRightSideVectorStamp(rightVector);
+}
+
+void DP::Ph1::Inductor::applyRightSideVectorStampHarm(Matrix& rightVector, UInt freqIdx) {
+	// Calculate equivalent current source for next time step
+	mEquivCurrent(freqIdx,0) =
+		mEquivCond(freqIdx,0) * mIntfVoltage(0,freqIdx)
+		+ mPrevCurrFac(freqIdx,0) * mIntfCurrent(0,freqIdx);
+
+	if (terminalNotGrounded(0))
+		Math::setVectorElement(rightVector, matrixNodeIndex(0), mEquivCurrent(freqIdx,0), 1, 0, freqIdx);
+	if (terminalNotGrounded(1))
+		Math::setVectorElement(rightVector, matrixNodeIndex(1), -mEquivCurrent(freqIdx,0), 1, 0, freqIdx);
+}
+
+void DP::Ph1::Inductor::mnaApplyRightSideVectorStampHarm(Matrix& rightVector) {
+	for (UInt freq = 0; freq < mNumFreqs; freq++)
+		applyRightSideVectorStampHarm(rightVector, freq);
 }
 
 void DP::Ph1::Inductor::mnaAddPreStepDependencies(AttributeBase::List &prevStepDependencies, AttributeBase::List &attributeDependencies, AttributeBase::List &modifiedAttributes) {
@@ -206,7 +231,7 @@ void DP::Ph1::Inductor::mnaAddPreStepDependencies(AttributeBase::List &prevStepD
 }
 
 void DP::Ph1::Inductor::mnaPreStep(Real time, Int timeStepCount) {
-	this->mnaApplyRightSideVectorStamp(this->mRightVector);
+	this->mnaUpdateRightVector();
 }
 
 void DP::Ph1::Inductor::mnaAddPostStepDependencies(AttributeBase::List &prevStepDependencies, AttributeBase::List &attributeDependencies, AttributeBase::List &modifiedAttributes, Attribute<Matrix>::Ptr &leftVector) {
@@ -221,13 +246,12 @@ void DP::Ph1::Inductor::mnaPostStep(Real time, Int timeStepCount, Attribute<Matr
 }
 
 void DP::Ph1::Inductor::MnaPreStepHarm::execute(Real time, Int timeStepCount) {
-	mInductor.mnaApplyRightSideVectorStampHarm(mInductor.mRightVector);
+	mInductor.applyRightSideVectorStampHarm(mInductor.mRightVector, mFreqIdx);
 }
 
 void DP::Ph1::Inductor::MnaPostStepHarm::execute(Real time, Int timeStepCount) {
-	for (UInt freq = 0; freq < mInductor.mNumFreqs; freq++)
-		mInductor.mnaUpdateVoltageHarm(*mLeftVectors[freq], freq);
-	mInductor.mnaUpdateCurrentHarm();
+	mInductor.mnaUpdateVoltageHarm(*mLeftVector, mFreqIdx);
+	mInductor.mnaUpdateCurrentHarm(mFreqIdx);
 }
 
 void DP::Ph1::Inductor::mnaUpdateVoltage(const Matrix& leftVector) {
@@ -261,11 +285,9 @@ void DP::Ph1::Inductor::mnaUpdateCurrent(const Matrix& leftVector) {
 	}
 }
 
-void DP::Ph1::Inductor::mnaUpdateCurrentHarm() {
-	for (UInt freq = 0; freq < mNumFreqs; freq++) {
-		mIntfCurrent(0,freq) = mEquivCond(freq,0) * mIntfVoltage(0,freq) + mEquivCurrent(freq,0);
-		SPDLOG_LOGGER_DEBUG(mSLog, "Current {:s}", Logger::phasorToString(mIntfCurrent(0,freq)));
-	}
+void DP::Ph1::Inductor::mnaUpdateCurrentHarm(UInt freqIdx) {
+	mIntfCurrent(0,freqIdx) = mEquivCond(freqIdx,0) * mIntfVoltage(0,freqIdx) + mEquivCurrent(freqIdx,0);
+	SPDLOG_LOGGER_DEBUG(mSLog, "Current {:s}", Logger::phasorToString(mIntfCurrent(0,freqIdx)));
 }
 
 // #### Tear Methods ####
@@ -0,0 +1,196 @@
+/* Copyright 2017-2020 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <cps/DP/DP_Ph1_PassiveBatch.h>
+
+#include <typeinfo>
+
+using namespace CPS;
+
+Bool DP::Ph1::PassiveBatch::add(const MNAInterface::Ptr& comp) {
+	// Derived classes may change the behaviour of the components
+	if (typeid(*comp) == typeid(Inductor)) {
+		auto ind = std::static_pointer_cast<Inductor>(comp);
+		if (ind->mNumFreqs != 1)
+			return false;
+		mInductors.add(comp, nodeIndex(*ind, 0), nodeIndex(*ind, 1),
+			&ind->mIntfVoltage(0,0), &ind->mIntfCurrent(0,0), ind->mEquivCond(0,0),
+			ind->mEquivCond(0,0), ind->mPrevCurrFac(0,0), ind->mEquivCurrent(0,0));
+		return true;
+	}
+	if (typeid(*comp) == typeid(Capacitor)) {
+		auto cap = std::static_pointer_cast<Capacitor>(comp);
+		if (cap->mNumFreqs != 1)
+			return false;
+		mCapacitors.add(comp, nodeIndex(*cap, 0), nodeIndex(*cap, 1),
+			&cap->mIntfVoltage(0,0), &cap->mIntfCurrent(0,0), cap->mEquivCond(0,0),
+			-cap->mPrevVoltCoeff(0,0), -1., cap->mEquivCurrent(0,0));
+		return true;
+	}
+	if (typeid(*comp) == typeid(Resistor)) {
+		auto res = std::static_pointer_cast<Resistor>(comp);
+		if (res->mNumFreqs != 1)
+			return false;
+		mResistors.add(comp, nodeIndex(*res, 0), nodeIndex(*res, 1),
+			&res->mIntfVoltage(0,0), &res->mIntfCurrent(0,0), res->mResistance);
+		return true;
+	}
+	return false;
+}
+
+void DP::Ph1::PassiveBatch::HistoryComponents::add(const MNAInterface::Ptr& comp, Matrix::Index n0, Matrix::Index n1,
+	Complex* v, Complex* i, Complex g, Complex a, Complex b, Complex j) {
+	gRe.push_back(g.real()); gIm.push_back(g.imag());
+	aRe.push_back(a.real()); aIm.push_back(a.imag());
+	bRe.push_back(b.real()); bIm.push_back(b.imag());
+	vRe.push_back(v->real()); vIm.push_back(v->imag());
+	iRe.push_back(i->real()); iIm.push_back(i->imag());
+	jRe.push_back(j.real()); jIm.push_back(j.imag());
+	node0.push_back(n0);
+	node1.push_back(n1);
+	voltage.push_back(v);
+	current.push_back(i);
+	comps.push_back(comp);
+}
+
+void DP::Ph1::PassiveBatch::Resistors::add(const MNAInterface::Ptr& comp, Matrix::Index n0, Matrix::Index n1,
+	Complex* v, Complex* i, Real resistance) {
+	r.push_back(resistance);
+	vRe.push_back(v->real()); vIm.push_back(v->imag());
+	node0.push_back(n0);
+	node1.push_back(n1);
+	voltage.push_back(v);
+	current.push_back(i);
+	comps.push_back(comp);
+}
+
+void DP::Ph1::PassiveBatch::HistoryComponents::updateHistoryCurrents() {
+	const std::size_t n = comps.size();
+	const Real *ar = aRe.data(), *ai = aIm.data(), *br = bRe.data(), *bi = bIm.data();
+	const Real *vr = vRe.data(), *vi = vIm.data(), *ir = iRe.data(), *ii = iIm.data();
+	Real *jr = jRe.data(), *ji = jIm.data();
+
+	for (std::size_t k = 0; k < n; k++) {
+		// Same order of operations as the sum of the complex products
+		jr[k] = (ar[k] * vr[k] - ai[k] * vi[k]) + (br[k] * ir[k] - bi[k] * ii[k]);
+		ji[k] = (ar[k] * vi[k] + ai[k] * vr[k]) + (br[k] * ii[k] + bi[k] * ir[k]);
+	}
+}
+
+void DP::Ph1::PassiveBatch::HistoryComponents::stampHistoryCurrents(Matrix& rightVector, Matrix::Index complexOffset) {
+	Real* rv = rightVector.data();
+	for (std::size_t k = 0; k < comps.size(); k++) {
+		if (node0[k] >= 0) {
+			rv[node0[k]] += jRe[k];
+			rv[node0[k] + complexOffset] += jIm[k];
+		}
+		if (node1[k] >= 0) {
+			rv[node1[k]] -= jRe[k];
+			rv[node1[k] + complexOffset] -= jIm[k];
+		}
+	}
+}
+
+void DP::Ph1::PassiveBatch::HistoryComponents::updateStates(const Matrix& leftVector, Matrix::Index complexOffset) {
+	const std::size_t n = comps.size();
+	const Real* lv = leftVector.data();
+
+	// v1 - v0
+	for (std::size_t k = 0; k < n; k++) {
+		vRe[k] = (node1[k] >= 0 ? lv[node1[k]] : 0.) - (node0[k] >= 0 ? lv[node0[k]] : 0.);
+		vIm[k] = (node1[k] >= 0 ? lv[node1[k] + complexOffset] : 0.) - (node0[k] >= 0 ? lv[node0[k] + complexOffset] : 0.);
+	}
+
+	const Real *gr = gRe.data(), *gi = gIm.data(), *jr = jRe.data(), *ji = jIm.data();
+	const Real *vr = vRe.data(), *vi = vIm.data();
+	Real *ir = iRe.data(), *ii = iIm.data();
+	for (std::size_t k = 0; k < n; k++) {
+		ir[k] = gr[k] * vr[k] - gi[k] * vi[k] + jr[k];
+		ii[k] = gr[k] * vi[k] + gi[k] * vr[k] + ji[k];
+	}
+
+	for (std::size_t k = 0; k < n; k++) {
+		*voltage[k] = { vr[k], vi[k] };
+		*current[k] = { ir[k], ii[k] };
+	}
+}
+
+void DP::Ph1::PassiveBatch::Resistors::updateStates(const Matrix& leftVector, Matrix::Index complexOffset) {
+	const std::size_t n = comps.size();
+	const Real* lv = leftVector.data();
+
+	for (std::size_t k = 0; k < n; k++) {
+		vRe[k] = (node1[k] >= 0 ? lv[node1[k]] : 0.) - (node0[k] >= 0 ? lv[node0[k]] : 0.);
+		vIm[k] = (node1[k] >= 0 ? lv[node1[k] + complexOffset] : 0.) - (node0[k] >= 0 ? lv[node0[k] + complexOffset] : 0.);
+	}
+
+	for (std::size_t k = 0; k < n; k++) {
+		*voltage[k] = { vRe[k], vIm[k] };
+		*current[k] = { vRe[k] / r[k], vIm[k] / r[k] };
+	}
+}
+
+// #### MNA functions ####
+
+void DP::Ph1::PassiveBatch::mnaInitialize(Real omega, Real timeStep, Attribute<Matrix>::Ptr leftVector) {
+	MNAInterface::mnaInitialize(omega, timeStep);
+
+	mRightVector = Matrix::Zero(leftVector->get().rows(), 1);
+	mComplexOffset = leftVector->get().rows() / 2;
+
+	if (numInductors() + numCapacitors() > 0)
+		mMnaTasks.push_back(std::make_shared<MnaPreStep>(*this));
+	mMnaTasks.push_back(std::make_shared<MnaPostStep>(*this, leftVector));
+}
+
+void DP::Ph1::PassiveBatch::mnaApplySystemMatrixStamp(Matrix& systemMatrix) {
+	for (auto comp : mInductors.comps)
+		comp->mnaApplySystemMatrixStamp(systemMatrix);
+	for (auto comp : mCapacitors.comps)
+		comp->mnaApplySystemMatrixStamp(systemMatrix);
+	for (auto comp : mResistors.comps)
+		comp->mnaApplySystemMatrixStamp(systemMatrix);
+}
+
+void DP::Ph1::PassiveBatch::mnaApplyRightSideVectorStamp(Matrix& rightVector) {
+	mInductors.updateHistoryCurrents();
+	mCapacitors.updateHistoryCurrents();
+	mInductors.stampHistoryCurrents(rightVector, mComplexOffset);
+	mCapacitors.stampHistoryCurrents(rightVector, mComplexOffset);
+}
+
+void DP::Ph1::PassiveBatch::mnaAddPreStepDependencies(AttributeBase::List &prevStepDependencies, AttributeBase::List &attributeDependencies, AttributeBase::List &modifiedAttributes) {
+	for (auto comps : { &mInductors.comps, &mCapacitors.comps }) {
+		for (auto comp : *comps) {
+			prevStepDependencies.push_back(comp->attribute("v_intf"));
+			prevStepDependencies.push_back(comp->attribute("i_intf"));
+		}
+	}
+	modifiedAttributes.push_back(attribute("right_vector"));
+}
+
+void DP::Ph1::PassiveBatch::mnaPreStep(Real time, Int timeStepCount) {
+	mRightVector.setZero();
+	mnaApplyRightSideVectorStamp(mRightVector);
+}
+
+void DP::Ph1::PassiveBatch::mnaAddPostStepDependencies(AttributeBase::List &prevStepDependencies, AttributeBase::List &attributeDependencies, AttributeBase::List &modifiedAttributes, Attribute<Matrix>::Ptr &leftVector) {
+	attributeDependencies.push_back(leftVector);
+	for (auto comps : { &mInductors.comps, &mCapacitors.comps, &mResistors.comps }) {
+		for (auto comp : *comps) {
+			modifiedAttributes.push_back(comp->attribute("v_intf"));
+			modifiedAttributes.push_back(comp->attribute("i_intf"));
+		}
+	}
+}
+
+void DP::Ph1::PassiveBatch::mnaPostStep(Real time, Int timeStepCount, Attribute<Matrix>::Ptr &leftVector) {
+	mInductors.updateStates(leftVector->get(), mComplexOffset);
+	mCapacitors.updateStates(leftVector->get(), mComplexOffset);
+	mResistors.updateStates(leftVector->get(), mComplexOffset);
+}
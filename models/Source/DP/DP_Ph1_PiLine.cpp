@@ -106,104 +106,30 @@ void DP::Ph1::PiLine::initializeFromNodesAndTerminals(Real frequency) {
 void DP::Ph1::PiLine::mnaInitialize(Real omega, Real timeStep, Attribute<Matrix>::Ptr leftVector) {
 	MNAInterface::mnaInitialize(omega, timeStep);
 	updateMatrixNodeIndices();
-	MNAInterface::List subComps({mSubSeriesResistor, mSubSeriesInductor});
-
-	mSubSeriesResistor->mnaInitialize(omega, timeStep, leftVector);
-	mSubSeriesInductor->mnaInitialize(omega, timeStep, leftVector);
-	mRightVectorStamps.push_back(&mSubSeriesInductor->attribute<Matrix>("right_vector")->get());
-
-	mSubParallelResistor0->mnaInitialize(omega, timeStep, leftVector);
-	mSubParallelResistor1->mnaInitialize(omega, timeStep, leftVector);
-	subComps.push_back(mSubParallelResistor0);
-	subComps.push_back(mSubParallelResistor1);
 
+	mnaInitializeSubComponent(mSubSeriesResistor, omega, timeStep, leftVector);
+	mnaInitializeSubComponent(mSubSeriesInductor, omega, timeStep, leftVector);
+	mnaInitializeSubComponent(mSubParallelResistor0, omega, timeStep, leftVector);
+	mnaInitializeSubComponent(mSubParallelResistor1, omega, timeStep, leftVector);
 	if (mParallelCap >= 0) {
-		mSubParallelCapacitor0->mnaInitialize(omega, timeStep, leftVector);
-		mSubParallelCapacitor1->mnaInitialize(omega, timeStep, leftVector);
-		mRightVectorStamps.push_back(&mSubParallelCapacitor0->attribute<Matrix>("right_vector")->get());
-		mRightVectorStamps.push_back(&mSubParallelCapacitor1->attribute<Matrix>("right_vector")->get());
-		subComps.push_back(mSubParallelCapacitor0);
-		subComps.push_back(mSubParallelCapacitor1);
+		mnaInitializeSubComponent(mSubParallelCapacitor0, omega, timeStep, leftVector);
+		mnaInitializeSubComponent(mSubParallelCapacitor1, omega, timeStep, leftVector);
 	}
-	mMnaTasks.push_back(std::make_shared<MnaPreStep>(*this));
 	mMnaTasks.push_back(std::make_shared<MnaPostStep>(*this, leftVector));
-	mRightVector = Matrix::Zero(leftVector->get().rows(), 1);
 }
 
 void DP::Ph1::PiLine::mnaApplySystemMatrixStamp(Matrix& systemMatrix) {
-	mSubSeriesResistor->mnaApplySystemMatrixStamp(systemMatrix);
-	mSubSeriesInductor->mnaApplySystemMatrixStamp(systemMatrix);
-
-	mSubParallelResistor0->mnaApplySystemMatrixStamp(systemMatrix);
-	mSubParallelResistor1->mnaApplySystemMatrixStamp(systemMatrix);
-
-	if (mParallelCap >= 0) {
-		mSubParallelCapacitor0->mnaApplySystemMatrixStamp(systemMatrix);
-		mSubParallelCapacitor1->mnaApplySystemMatrixStamp(systemMatrix);
-	}
-}
-
-void DP::Ph1::PiLine::mnaApplyRightSideVectorStamp(Matrix& rightVector) {
-	rightVector.setZero();
-	for (auto stamp : mRightVectorStamps)
-		rightVector += *stamp;
-}
-
-void DP::Ph1::PiLine::mnaAddPreStepDependencies(AttributeBase::List &prevStepDependencies, AttributeBase::List &attributeDependencies, AttributeBase::List &modifiedAttributes) {
-	// add pre-step dependencies of subcomponents
-	this->mSubSeriesInductor->mnaAddPreStepDependencies(prevStepDependencies, attributeDependencies, modifiedAttributes);
-	if (this->mParallelCap >= 0) {
-		this->mSubParallelCapacitor0->mnaAddPreStepDependencies(prevStepDependencies, attributeDependencies, modifiedAttributes);
-		this->mSubParallelCapacitor1->mnaAddPreStepDependencies(prevStepDependencies, attributeDependencies, modifiedAttributes);
-	}
-	// add pre-step dependencies of component itself
-	prevStepDependencies.push_back(this->attribute("i_intf"));
-	prevStepDependencies.push_back(this->attribute("v_intf"));
-	modifiedAttributes.push_back(this->attribute("right_vector"));
-}
-
-void DP::Ph1::PiLine::mnaPreStep(Real time, Int timeStepCount) {
-	// pre-step of subcomponents
-	this->mSubSeriesInductor->mnaPreStep(time, timeStepCount);
-	if (this->mParallelCap >= 0) {
-		this->mSubParallelCapacitor0->mnaPreStep(time, timeStepCount);
-		this->mSubParallelCapacitor1->mnaPreStep(time, timeStepCount);
-	}
-	// pre-step of component itself
-	this->mnaApplyRightSideVectorStamp(this->mRightVector);
+	mnaApplySubComponentSystemMatrixStamps(systemMatrix);
 }
 
 void DP::Ph1::PiLine::mnaAddPostStepDependencies(AttributeBase::List &prevStepDependencies, AttributeBase::List &attributeDependencies, AttributeBase::List &modifiedAttributes, Attribute<Matrix>::Ptr &leftVector) {
-	// add post-step dependencies of subcomponents
-	this->mSubSeriesResistor->mnaAddPostStepDependencies(prevStepDependencies, attributeDependencies, modifiedAttributes, leftVector);
-	this->mSubSeriesInductor->mnaAddPostStepDependencies(prevStepDependencies, attributeDependencies, modifiedAttributes, leftVector);
-	if (this->mParallelCap >= 0) {
-		this->mSubParallelCapacitor0->mnaAddPostStepDependencies(prevStepDependencies, attributeDependencies, modifiedAttributes, leftVector);
-		this->mSubParallelCapacitor1->mnaAddPostStepDependencies(prevStepDependencies, attributeDependencies, modifiedAttributes, leftVector);
-	}
-
-	this->mSubParallelResistor0->mnaAddPostStepDependencies(prevStepDependencies, attributeDependencies, modifiedAttributes, leftVector);
-	this->mSubParallelResistor1->mnaAddPostStepDependencies(prevStepDependencies, attributeDependencies, modifiedAttributes, leftVector);
-
-	// add post-step dependencies of component itself
 	attributeDependencies.push_back(leftVector);
+	attributeDependencies.push_back(mSubSeriesInductor->attribute("i_intf"));
 	modifiedAttributes.push_back(this->attribute("v_intf"));
 	modifiedAttributes.push_back(this->attribute("i_intf"));
 }
 
 void DP::Ph1::PiLine::mnaPostStep(Real time, Int timeStepCount, Attribute<Matrix>::Ptr &leftVector) {
-	// post-step of subcomponents
-	this->mSubSeriesResistor->mnaPostStep(time, timeStepCount, leftVector);
-	this->mSubSeriesInductor->mnaPostStep(time, timeStepCount, leftVector);
-	if (this->mParallelCap >= 0) {
-		this->mSubParallelCapacitor0->mnaPostStep(time, timeStepCount, leftVector);
-		this->mSubParallelCapacitor1->mnaPostStep(time, timeStepCount, leftVector);
-	}
-
-	this->mSubParallelResistor0->mnaPostStep(time, timeStepCount, leftVector);
-	this->mSubParallelResistor1->mnaPostStep(time, timeStepCount, leftVector);
-
-	// post-step of component itself
 	this->mnaUpdateVoltage(*leftVector);
 	this->mnaUpdateCurrent(*leftVector);
 }
@@ -110,39 +110,18 @@ void DP::Ph1::RXLoad::mnaInitialize(Real omega, Real timeStep, Attribute<Matrix>
 	MNAInterface::mnaInitialize(omega, timeStep);
 	updateMatrixNodeIndices();
 
-	if (mSubResistor) {
-		mSubResistor->mnaInitialize(omega, timeStep, leftVector);
-	}
-	if (mSubInductor) {
-		mSubInductor->mnaInitialize(omega, timeStep, leftVector);
-		mRightVectorStamps.push_back(&mSubInductor->attribute<Matrix>("right_vector")->get());
-	}
-	if (mSubCapacitor) {
-		mSubCapacitor->mnaInitialize(omega, timeStep, leftVector);
-		mRightVectorStamps.push_back(&mSubInductor->attribute<Matrix>("right_vector")->get());
-	}
-
-	mMnaTasks.push_back(std::make_shared<MnaPreStep>(*this));
-	mMnaTasks.push_back(std::make_shared<MnaPostStep>(*this, leftVector));
-	mRightVector = Matrix::Zero(leftVector->get().rows(), 1);
-}
-
-void DP::Ph1::RXLoad::mnaApplyRightSideVectorStamp(Matrix& rightVector) {
 	if (mSubResistor)
-		mSubResistor->mnaApplyRightSideVectorStamp(rightVector);
+		mnaInitializeSubComponent(mSubResistor, omega, timeStep, leftVector);
 	if (mSubInductor)
-		mSubInductor->mnaApplyRightSideVectorStamp(rightVector);
+		mnaInitializeSubComponent(mSubInductor, omega, timeStep, leftVector);
 	if (mSubCapacitor)
-		mSubCapacitor->mnaApplyRightSideVectorStamp(rightVector);
+		mnaInitializeSubComponent(mSubCapacitor, omega, timeStep, leftVector);
+
+	mMnaTasks.push_back(std::make_shared<MnaPostStep>(*this, leftVector));
 }
 
 void DP::Ph1::RXLoad::mnaApplySystemMatrixStamp(Matrix& systemMatrix) {
-	if (mSubResistor)
-		mSubResistor->mnaApplySystemMatrixStamp(systemMatrix);
-	if (mSubInductor)
-		mSubInductor->mnaApplySystemMatrixStamp(systemMatrix);
-	if (mSubCapacitor)
-		mSubCapacitor->mnaApplySystemMatrixStamp(systemMatrix);
+	mnaApplySubComponentSystemMatrixStamps(systemMatrix);
 }
 
 void DP::Ph1::RXLoad::mnaUpdateVoltage(const Matrix& leftVector) {
@@ -159,53 +138,16 @@ void DP::Ph1::RXLoad::mnaUpdateCurrent(const Matrix& leftVector) {
 		mIntfCurrent(0, 0) += mSubCapacitor->intfCurrent()(0,0);
 }
 
-void DP::Ph1::RXLoad::mnaAddPreStepDependencies(AttributeBase::List &prevStepDependencies, AttributeBase::List &attributeDependencies, AttributeBase::List &modifiedAttributes) {
-	// add pre-step dependencies of subcomponents
-	if (mSubInductor)
-		mSubInductor->mnaAddPreStepDependencies(prevStepDependencies, attributeDependencies, modifiedAttributes);
-	if (mSubCapacitor)
-		mSubCapacitor->mnaAddPreStepDependencies(prevStepDependencies, attributeDependencies, modifiedAttributes);
-
-	// add pre-step dependencies of component itself
-	modifiedAttributes.push_back(this->attribute("right_vector"));
-}
-
-void DP::Ph1::RXLoad::mnaPreStep(Real time, Int timeStepCount) {
-	// pre-step of subcomponents
-	if (mSubInductor)
-		mSubInductor->mnaPreStep(time, timeStepCount);
-	if (mSubCapacitor)
-		mSubCapacitor->mnaPreStep(time, timeStepCount);
-
-	// pre-step of component itself
-	mnaApplyRightSideVectorStamp(mRightVector);
-}
-
 void DP::Ph1::RXLoad::mnaAddPostStepDependencies(AttributeBase::List &prevStepDependencies, AttributeBase::List &attributeDependencies, AttributeBase::List &modifiedAttributes, Attribute<Matrix>::Ptr &leftVector) {
-	// add post-step dependencies of subcomponents
-	if (mSubResistor)
-		mSubResistor->mnaAddPostStepDependencies(prevStepDependencies, attributeDependencies, modifiedAttributes, leftVector);
-	if (mSubInductor)
-		mSubInductor->mnaAddPostStepDependencies(prevStepDependencies, attributeDependencies, modifiedAttributes, leftVector);
-	if (mSubCapacitor)
-		mSubCapacitor->mnaAddPostStepDependencies(prevStepDependencies, attributeDependencies, modifiedAttributes, leftVector);
-
-	// add post-step dependencies of component itself
+	// the interface current is the sum of the subcomponent currents
+	for (auto subComp : mnaSubComponents())
+		attributeDependencies.push_back(subComp->attribute("i_intf"));
 	attributeDependencies.push_back(leftVector);
 	modifiedAttributes.push_back(attribute("v_intf"));
 	modifiedAttributes.push_back(attribute("i_intf"));
 }
 
 void DP::Ph1::RXLoad::mnaPostStep(Real time, Int timeStepCount, Attribute<Matrix>::Ptr &leftVector) {
-	// post-step of subcomponents
-	if (mSubResistor)
-		mSubResistor->mnaPostStep(time, timeStepCount, leftVector);
-	if (mSubInductor)
-		mSubInductor->mnaPostStep(time, timeStepCount, leftVector);
-	if (mSubCapacitor)
-		mSubCapacitor->mnaPostStep(time, timeStepCount, leftVector);
-
-	// post-step of component itself
 	mnaUpdateVoltage(*leftVector);
 	mnaUpdateCurrent(*leftVector);
 }
@@ -76,22 +76,13 @@ void DP::Ph1::RXLoadSwitch::mnaInitialize(Real omega, Real timeStep, Attribute<M
 	MNAInterface::mnaInitialize(omega, timeStep);
 	updateMatrixNodeIndices();
 
-	mSubRXLoad->mnaInitialize(omega, timeStep, leftVector);
-	mSubSwitch->mnaInitialize(omega, timeStep, leftVector);
-	// get sub component right vector
-	mRightVectorStamps.push_back(&mSubRXLoad->attribute<Matrix>("right_vector")->get());
+	mnaInitializeSubComponent(mSubRXLoad, omega, timeStep, leftVector);
+	mnaInitializeSubComponent(mSubSwitch, omega, timeStep, leftVector);
 
-	mRightVector = Matrix::Zero(leftVector->get().rows(), 1);
 	mMnaTasks.push_back(std::make_shared<MnaPreStep>(*this));
 	mMnaTasks.push_back(std::make_shared<MnaPostStep>(*this, leftVector));
 }
 
-void DP::Ph1::RXLoadSwitch::mnaApplyRightSideVectorStamp(Matrix& rightVector) {
-	rightVector.setZero();
-	for (auto stamp : mRightVectorStamps)
-		rightVector += *stamp;
-}
-
 void DP::Ph1::RXLoadSwitch::mnaApplySystemMatrixStamp(Matrix& systemMatrix) {
 	mSubRXLoad->mnaApplySystemMatrixStamp(systemMatrix);
 	mSubSwitch->mnaApplySystemMatrixStamp(systemMatrix);
@@ -104,42 +95,27 @@ void DP::Ph1::RXLoadSwitch::mnaApplySwitchSystemMatrixStamp(Matrix& systemMatrix
 
 void DP::Ph1::RXLoadSwitch::mnaAddPreStepDependencies(AttributeBase::List &prevStepDependencies,
 	AttributeBase::List &attributeDependencies, AttributeBase::List &modifiedAttributes) {
-	// add pre-step dependencies of subcomponents
-	this->mSubRXLoad->mnaAddPreStepDependencies(prevStepDependencies, attributeDependencies, modifiedAttributes);
-
-	// add pre-step dependencies of component
 	prevStepDependencies.push_back(attribute("i_intf"));
 	prevStepDependencies.push_back(attribute("v_intf"));
+	// the switch state has to be updated before the system is solved
 	modifiedAttributes.push_back(attribute("right_vector"));
 }
 
 void DP::Ph1::RXLoadSwitch::mnaPreStep(Real time, Int timeStepCount) {
-	mSubRXLoad->mnaPreStep(time, timeStepCount);
-
-	// pre-step of component itself
 	updateSwitchState(time);
-	mnaApplyRightSideVectorStamp(mRightVector);
 }
 
 void DP::Ph1::RXLoadSwitch::mnaAddPostStepDependencies(AttributeBase::List &prevStepDependencies,
 	AttributeBase::List &attributeDependencies, AttributeBase::List &modifiedAttributes, Attribute<Matrix>::Ptr &leftVector) {
-	// add post-step dependencies of subcomponents
-	mSubRXLoad->mnaAddPostStepDependencies(prevStepDependencies, attributeDependencies, modifiedAttributes, leftVector);
-	mSubSwitch->mnaAddPostStepDependencies(prevStepDependencies, attributeDependencies, modifiedAttributes, leftVector);
-
-	// add post-step dependencies of component itself
-	attributeDependencies.push_back(leftVector);
+	attributeDependencies.push_back(mSubRXLoad->attribute("v_intf"));
+	attributeDependencies.push_back(mSubRXLoad->attribute("i_intf"));
 	modifiedAttributes.push_back(attribute("v_intf"));
 	modifiedAttributes.push_back(attribute("i_intf"));
 }
 
 void DP::Ph1::RXLoadSwitch::mnaPostStep(Real time, Int timeStepCount, Attribute<Matrix>::Ptr &leftVector) {
-	// post-step of subcomponents
-	this->mSubRXLoad->mnaPostStep(time, timeStepCount, leftVector);
-	this->mSubSwitch->mnaPostStep(time, timeStepCount, leftVector);
-
-	mIntfVoltage = mSubRXLoad->attributeMatrixComp("v_intf")->get();
-	mIntfCurrent = mSubRXLoad->attributeMatrixComp("i_intf")->get();
+	mIntfVoltage = mSubRXLoad->intfVoltage();
+	mIntfCurrent = mSubRXLoad->intfCurrent();
 }
 
 void DP::Ph1::RXLoadSwitch::updateSwitchState(Real time) {
@@ -66,7 +66,9 @@ void DP::Ph1::Resistor::mnaInitializeHarm(Real omega, Real timeStep, std::vector
 	MNAInterface::mnaInitialize(omega, timeStep);
 	updateMatrixNodeIndices();
 
-	mMnaTasks.push_back(std::make_shared<MnaPostStepHarm>(*this, leftVectors));
+	// One task per frequency so that the harmonics can run on different threads
+	for (UInt freq = 0; freq < mNumFreqs; freq++)
+		mMnaTasks.push_back(std::make_shared<MnaPostStepHarm>(*this, leftVectors[freq], freq));
 }
 
 void DP::Ph1::Resistor::mnaApplySystemMatrixStamp(Matrix& systemMatrix) {
@@ -132,9 +134,8 @@ void DP::Ph1::Resistor::mnaPostStep(Real time, Int timeStepCount, Attribute<Matr
 }
 
 void DP::Ph1::Resistor::MnaPostStepHarm::execute(Real time, Int timeStepCount) {
-	for (UInt freq = 0; freq < mResistor.mNumFreqs; freq++)
-		mResistor.mnaUpdateVoltageHarm(*mLeftVectors[freq], freq);
-	mResistor.mnaUpdateCurrentHarm();
+	mResistor.mnaUpdateVoltageHarm(*mLeftVector, mFreqIdx);
+	mResistor.mnaUpdateCurrentHarm(mFreqIdx);
 }
 
 void DP::Ph1::Resistor::mnaUpdateVoltage(const Matrix& leftVector) {
@@ -168,11 +169,9 @@ void DP::Ph1::Resistor::mnaUpdateVoltageHarm(const Matrix& leftVector, Int freqI
 	SPDLOG_LOGGER_DEBUG(mSLog, "Voltage {:s}", Logger::phasorToString(mIntfVoltage(0,freqIdx)));
 }
 
-void DP::Ph1::Resistor::mnaUpdateCurrentHarm() {
-	for (UInt freq = 0; freq < mNumFreqs; freq++) {
-		mIntfCurrent(0,freq) = mIntfVoltage(0,freq) / mResistance;
-		SPDLOG_LOGGER_DEBUG(mSLog, "Current {:s}", Logger::phasorToString(mIntfCurrent(0,freq)));
-	}
+void DP::Ph1::Resistor::mnaUpdateCurrentHarm(UInt freqIdx) {
+	mIntfCurrent(0,freqIdx) = mIntfVoltage(0,freqIdx) / mResistance;
+	SPDLOG_LOGGER_DEBUG(mSLog, "Current {:s}", Logger::phasorToString(mIntfCurrent(0,freqIdx)));
 }
 
 void DP::Ph1::Resistor::mnaTearApplyMatrixStamp(Matrix& tearMatrix) {
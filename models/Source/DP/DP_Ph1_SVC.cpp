@@ -139,6 +139,13 @@ void DP::Ph1::SVC::mnaApplySystemMatrixStamp(Matrix& systemMatrix) {
 	mSubInductorSwitch->mnaApplySystemMatrixStamp(systemMatrix);
 }
 
+void DP::Ph1::SVC::mnaApplySystemMatrixStamp(SparseMatrixRow& systemMatrix) {
+	mSubInductor->mnaApplySystemMatrixStamp(systemMatrix);
+	mSubCapacitor->mnaApplySystemMatrixStamp(systemMatrix);
+	mSubCapacitorSwitch->mnaApplySystemMatrixStamp(systemMatrix);
+	mSubInductorSwitch->mnaApplySystemMatrixStamp(systemMatrix);
+}
+
 void DP::Ph1::SVC::mnaApplyRightSideVectorStamp(Matrix& rightVector) {
 	mSubInductor->mnaApplyRightSideVectorStamp(rightVector);
 	mSubCapacitor->mnaApplyRightSideVectorStamp(rightVector);
@@ -53,50 +53,33 @@ void DP::Ph1::Switch::mnaInitialize(Real omega, Real timeStep, Attribute<Matrix>
 	mMnaTasks.push_back(std::make_shared<MnaPostStep>(*this, leftVector));
 }
 
-void DP::Ph1::Switch::mnaApplySystemMatrixStamp(Matrix& systemMatrix) {
-	Complex conductance = (mIsClosed) ?
-		Complex( 1./mClosedResistance, 0 ) : Complex( 1./mOpenResistance, 0 );
-
-	// Set diagonal entries
-	if (terminalNotGrounded(0))
-		Math::addToMatrixElement(systemMatrix, matrixNodeIndex(0), matrixNodeIndex(0), conductance);
-	if (terminalNotGrounded(1))
-		Math::addToMatrixElement(systemMatrix, matrixNodeIndex(1), matrixNodeIndex(1), conductance);
-	// Set off diagonal entries
-	if (terminalNotGrounded(0) && terminalNotGrounded(1)) {
-		Math::addToMatrixElement(systemMatrix, matrixNodeIndex(0), matrixNodeIndex(1), -conductance);
-		Math::addToMatrixElement(systemMatrix, matrixNodeIndex(1), matrixNodeIndex(0), -conductance);
-	}
+void DP::Ph1::Switch::mnaInitializeHarm(Real omega, Real timeStep, std::vector<Attribute<Matrix>::Ptr> leftVectors) {
+	MNAInterface::mnaInitialize(omega, timeStep);
+	updateMatrixNodeIndices();
 
-	mSLog->info("-- Stamp ---");
-	if (terminalNotGrounded(0))
-		mSLog->info("Add {:s} to system at ({:d},{:d})", Logger::complexToString(conductance), matrixNodeIndex(0), matrixNodeIndex(0));
-	if (terminalNotGrounded(1))
-		mSLog->info("Add {:s} to system at ({:d},{:d})", Logger::complexToString(conductance), matrixNodeIndex(1), matrixNodeIndex(1));
-	if (terminalNotGrounded(0) && terminalNotGrounded(1)) {
-		mSLog->info("Add {:s} to system at ({:d},{:d})", Logger::complexToString(-conductance), matrixNodeIndex(0), matrixNodeIndex(1));
-		mSLog->info("Add {:s} to system at ({:d},{:d})", Logger::complexToString(-conductance), matrixNodeIndex(1), matrixNodeIndex(0));
-	}
+	for (UInt freq = 0; freq < mNumFreqs; freq++)
+		mMnaTasks.push_back(std::make_shared<MnaPostStepHarm>(*this, leftVectors[freq], freq));
 }
 
-void DP::Ph1::Switch::mnaApplySwitchSystemMatrixStamp(Matrix& systemMatrix, Bool closed) {
+template <typename MatrixType>
+void DP::Ph1::Switch::applySwitchSystemMatrixStamp(MatrixType& systemMatrix, Bool closed, Int maxFreq, Int freqIdx) {
 	Complex conductance = (closed) ?
 		Complex( 1./mClosedResistance, 0 ) :
 		Complex( 1./mOpenResistance, 0 );
 
 	// Set diagonal entries
 	if (terminalNotGrounded(0))
-		Math::addToMatrixElement(systemMatrix, matrixNodeIndex(0), matrixNodeIndex(0), conductance);
+		Math::addToMatrixElement(systemMatrix, matrixNodeIndex(0), matrixNodeIndex(0), conductance, maxFreq, freqIdx);
 	if (terminalNotGrounded(1))
-		Math::addToMatrixElement(systemMatrix, matrixNodeIndex(1), matrixNodeIndex(1), conductance);
+		Math::addToMatrixElement(systemMatrix, matrixNodeIndex(1), matrixNodeIndex(1), conductance, maxFreq, freqIdx);
 
 	// Set off diagonal entries
 	if (terminalNotGrounded(0) && terminalNotGrounded(1)) {
-		Math::addToMatrixElement(systemMatrix, matrixNodeIndex(0), matrixNodeIndex(1), -conductance);
-		Math::addToMatrixElement(systemMatrix, matrixNodeIndex(1), matrixNodeIndex(0), -conductance);
+		Math::addToMatrixElement(systemMatrix, matrixNodeIndex(0), matrixNodeIndex(1), -conductance, maxFreq, freqIdx);
+		Math::addToMatrixElement(systemMatrix, matrixNodeIndex(1), matrixNodeIndex(0), -conductance, maxFreq, freqIdx);
 	}
 
-	mSLog->info("-- Stamp ---");
+	mSLog->info("-- Stamp frequency {:d} ---", freqIdx);
 	if (terminalNotGrounded(0))
 		mSLog->info("Add {:s} to system at ({:d},{:d})", Logger::complexToString(conductance), matrixNodeIndex(0), matrixNodeIndex(0));
 	if (terminalNotGrounded(1))
@@ -107,19 +90,61 @@ void DP::Ph1::Switch::mnaApplySwitchSystemMatrixStamp(Matrix& systemMatrix, Bool
 	}
 }
 
+void DP::Ph1::Switch::mnaApplySystemMatrixStamp(Matrix& systemMatrix) {
+	mnaApplySwitchSystemMatrixStamp(systemMatrix, mIsClosed);
+}
+
+void DP::Ph1::Switch::mnaApplySystemMatrixStamp(SparseMatrixRow& systemMatrix) {
+	mnaApplySwitchSystemMatrixStamp(systemMatrix, mIsClosed);
+}
+
+void DP::Ph1::Switch::mnaApplySwitchSystemMatrixStamp(Matrix& systemMatrix, Bool closed) {
+	// The system holds all frequencies, the switch is resistive for each of them
+	for (UInt freq = 0; freq < mNumFreqs; freq++)
+		applySwitchSystemMatrixStamp(systemMatrix, closed, mNumFreqs, freq);
+}
+
+void DP::Ph1::Switch::mnaApplySwitchSystemMatrixStamp(SparseMatrixRow& systemMatrix, Bool closed) {
+	for (UInt freq = 0; freq < mNumFreqs; freq++)
+		applySwitchSystemMatrixStamp(systemMatrix, closed, mNumFreqs, freq);
+}
+
+void DP::Ph1::Switch::mnaApplySwitchSystemMatrixStampHarm(Matrix& systemMatrix, Bool closed, UInt freqIdx) {
+	// The system only holds the given frequency
+	applySwitchSystemMatrixStamp(systemMatrix, closed, 1, 0);
+}
+
 void DP::Ph1::Switch::mnaApplyRightSideVectorStamp(Matrix& rightVector) { }
 
 void DP::Ph1::Switch::mnaUpdateVoltage(const Matrix& leftVector) {
 	// Voltage across component is defined as V1 - V0
-	mIntfVoltage(0, 0) = 0;
-	if (terminalNotGrounded(1)) mIntfVoltage(0,0) = Math::complexFromVectorElement(leftVector, matrixNodeIndex(1,0));
-	if (terminalNotGrounded(0)) mIntfVoltage(0,0) = mIntfVoltage(0,0) - Math::complexFromVectorElement(leftVector, matrixNodeIndex(0));
+	for (UInt freq = 0; freq < mNumFreqs; freq++) {
+		mIntfVoltage(0,freq) = 0;
+		if (terminalNotGrounded(1))
+			mIntfVoltage(0,freq) = Math::complexFromVectorElement(leftVector, matrixNodeIndex(1), mNumFreqs, freq);
+		if (terminalNotGrounded(0))
+			mIntfVoltage(0,freq) = mIntfVoltage(0,freq) - Math::complexFromVectorElement(leftVector, matrixNodeIndex(0), mNumFreqs, freq);
+	}
 }
 
 void DP::Ph1::Switch::mnaUpdateCurrent(const Matrix& leftVector) {
-	mIntfCurrent(0,0) = (mIsClosed) ?
-		mIntfVoltage(0,0) / mClosedResistance :
-		mIntfVoltage(0,0) / mOpenResistance;
+	for (UInt freq = 0; freq < mNumFreqs; freq++)
+		mIntfCurrent(0,freq) = (mIsClosed) ?
+			mIntfVoltage(0,freq) / mClosedResistance :
+			mIntfVoltage(0,freq) / mOpenResistance;
+}
+
+void DP::Ph1::Switch::mnaUpdateVoltageHarm(const Matrix& leftVector, UInt freqIdx) {
+	// Voltage across component is defined as V1 - V0
+	mIntfVoltage(0,freqIdx) = 0;
+	if (terminalNotGrounded(1)) mIntfVoltage(0,freqIdx) = Math::complexFromVectorElement(leftVector, matrixNodeIndex(1));
+	if (terminalNotGrounded(0)) mIntfVoltage(0,freqIdx) = mIntfVoltage(0,freqIdx) - Math::complexFromVectorElement(leftVector, matrixNodeIndex(0));
+}
+
+void DP::Ph1::Switch::mnaUpdateCurrentHarm(UInt freqIdx) {
+	mIntfCurrent(0,freqIdx) = (mIsClosed) ?
+		mIntfVoltage(0,freqIdx) / mClosedResistance :
+		mIntfVoltage(0,freqIdx) / mOpenResistance;
 }
 
 void DP::Ph1::Switch::mnaAddPostStepDependencies(AttributeBase::List &prevStepDependencies,
@@ -135,3 +160,8 @@ void DP::Ph1::Switch::mnaPostStep(Real time, Int timeStepCount, Attribute<Matrix
 	mnaUpdateVoltage(*leftVector);
 	mnaUpdateCurrent(*leftVector);
 }
+
+void DP::Ph1::Switch::MnaPostStepHarm::execute(Real time, Int timeStepCount) {
+	mSwitch.mnaUpdateVoltageHarm(*mLeftVector, mFreqIdx);
+	mSwitch.mnaUpdateCurrentHarm(mFreqIdx);
+}
@@ -187,6 +187,9 @@ void DP::Ph1::SynchronGeneratorTrStab::mnaInitialize(Real omega, Real timeStep,
 
 	mSubVoltageSource->mnaInitialize(omega, timeStep, leftVector);
 	mSubInductor->mnaInitialize(omega, timeStep, leftVector);
+	mSubVoltageSourceRef = mSubVoltageSource->attributeHandle<Complex>("V_ref");
+	mSubVoltageSourceRightVector = mSubVoltageSource->attributeHandle<Matrix>("right_vector");
+	mSubInductorRightVector = mSubInductor->attributeHandle<Matrix>("right_vector");
 	mTimeStep = timeStep;
 	mRightVector = Matrix::Zero(leftVector->get().rows(), 1);
 	for (auto task : mSubVoltageSource->mnaTasks()) {
@@ -212,13 +215,13 @@ void DP::Ph1::SynchronGeneratorTrStab::mnaApplyRightSideVectorStamp(Matrix& righ
 
 void DP::Ph1::SynchronGeneratorTrStab::MnaPreStep::execute(Real time, Int timeStepCount) {
 	mGenerator.step(time);
-	mGenerator.mSubVoltageSource->attribute<Complex>("V_ref")->set(mGenerator.mEp);
+	mGenerator.mSubVoltageSourceRef.set(mGenerator.mEp);
 }
 
 void DP::Ph1::SynchronGeneratorTrStab::AddBStep::execute(Real time, Int timeStepCount) {
 	mGenerator.mRightVector =
-		mGenerator.mSubInductor->attribute<Matrix>("right_vector")->get()
-		+ mGenerator.mSubVoltageSource->attribute<Matrix>("right_vector")->get();
+		mGenerator.mSubInductorRightVector.get()
+		+ mGenerator.mSubVoltageSourceRightVector.get();
 }
 
 void DP::Ph1::SynchronGeneratorTrStab::MnaPostStep::execute(Real time, Int timeStepCount) {
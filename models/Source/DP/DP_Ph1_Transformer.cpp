@@ -116,21 +116,11 @@ void DP::Ph1::Transformer::mnaInitialize(Real omega, Real timeStep, Attribute<Ma
 	MNAInterface::mnaInitialize(omega, timeStep);
 	updateMatrixNodeIndices();
 
-	mRightVector = Matrix::Zero(leftVector->get().rows(), 1);
-	auto subComponents = MNAInterface::List({mSubInductor, mSubSnubResistor});
-
+	mnaInitializeSubComponent(mSubInductor, omega, timeStep, leftVector);
+	mnaInitializeSubComponent(mSubSnubResistor, omega, timeStep, leftVector);
 	if (mSubResistor)
-		subComponents.push_back(mSubResistor);
-
-	for (auto comp : subComponents) {
-		comp->mnaInitialize(omega, timeStep, leftVector);
-
-		for (auto task : comp->mnaTasks())
-			mMnaTasks.push_back(task);
-
-	}
+		mnaInitializeSubComponent(mSubResistor, omega, timeStep, leftVector);
 
-	mMnaTasks.push_back(std::make_shared<MnaPreStep>(*this));
 	mMnaTasks.push_back(std::make_shared<MnaPostStep>(*this, leftVector));
 
 	mSLog->info(
@@ -152,12 +142,7 @@ void DP::Ph1::Transformer::mnaApplySystemMatrixStamp(Matrix& systemMatrix) {
 	}
 
 	// Add inductive part to system matrix
-	mSubInductor->mnaApplySystemMatrixStamp(systemMatrix);
-	mSubSnubResistor->mnaApplySystemMatrixStamp(systemMatrix);
-
-	if (mNumVirtualNodes == 3) {
-		mSubResistor->mnaApplySystemMatrixStamp(systemMatrix);
-	}
+	mnaApplySubComponentSystemMatrixStamps(systemMatrix);
 
 	if (terminalNotGrounded(0)) {
 		mSLog->info("Add {:s} to system at ({:d},{:d})", Logger::complexToString(Complex(-1.0, 0)),
@@ -173,45 +158,14 @@ void DP::Ph1::Transformer::mnaApplySystemMatrixStamp(Matrix& systemMatrix) {
 	}
 }
 
-void DP::Ph1::Transformer::mnaApplyRightSideVectorStamp(Matrix& rightVector) {
-	mSubInductor->mnaApplyRightSideVectorStamp(rightVector);
-}
-
-void DP::Ph1::Transformer::mnaAddPreStepDependencies(AttributeBase::List &prevStepDependencies, AttributeBase::List &attributeDependencies, AttributeBase::List &modifiedAttributes) {
-	// add pre-step dependencies of subcomponents
-	this->mSubInductor->mnaAddPreStepDependencies(prevStepDependencies, attributeDependencies, modifiedAttributes);
-	// add pre-step dependencies of component itself
-	prevStepDependencies.push_back(this->attribute("i_intf"));
-	prevStepDependencies.push_back(this->attribute("v_intf"));
-	modifiedAttributes.push_back(this->attribute("right_vector"));
-}
-
-void DP::Ph1::Transformer::mnaPreStep(Real time, Int timeStepCount) {
-	// pre-step of subcomponents
-	this->mSubInductor->mnaPreStep(time, timeStepCount);
-	// pre-step of component itself
-	this->mnaApplyRightSideVectorStamp(this->mRightVector);
-}
-
 void DP::Ph1::Transformer::mnaAddPostStepDependencies(AttributeBase::List &prevStepDependencies, AttributeBase::List &attributeDependencies, AttributeBase::List &modifiedAttributes, Attribute<Matrix>::Ptr &leftVector) {
-	// add post-step dependencies of subcomponents
-	if (mSubResistor)
-		this->mSubResistor->mnaAddPostStepDependencies(prevStepDependencies, attributeDependencies, modifiedAttributes, leftVector);
-	this->mSubInductor->mnaAddPostStepDependencies(prevStepDependencies, attributeDependencies, modifiedAttributes, leftVector);
-	this->mSubSnubResistor->mnaAddPostStepDependencies(prevStepDependencies, attributeDependencies, modifiedAttributes, leftVector);
-	// add post-step dependencies of component itself
 	attributeDependencies.push_back(leftVector);
+	attributeDependencies.push_back(this->mSubInductor->attribute("i_intf"));
 	modifiedAttributes.push_back(this->attribute("v_intf"));
 	modifiedAttributes.push_back(this->attribute("i_intf"));
 }
 
 void DP::Ph1::Transformer::mnaPostStep(Real time, Int timeStepCount, Attribute<Matrix>::Ptr &leftVector) {
-	// post-step of subcomponents
-	if (mSubResistor)
-		this->mSubResistor->mnaPostStep(time, timeStepCount, leftVector);
-	this->mSubInductor->mnaPostStep(time, timeStepCount, leftVector);
-	this->mSubSnubResistor->mnaPostStep(time, timeStepCount, leftVector);
-	// post-step of component itself
 	this->mnaUpdateVoltage(*leftVector);
 	this->mnaUpdateCurrent(*leftVector);
 }
@@ -91,7 +91,8 @@ void DP::Ph1::VoltageSource::mnaInitializeHarm(Real omega, Real timeStep, std::v
 	mIntfVoltage(0,0) = mVoltageRef->get();
 
 	mMnaTasks.push_back(std::make_shared<MnaPreStepHarm>(*this));
-	mMnaTasks.push_back(std::make_shared<MnaPostStepHarm>(*this, leftVectors));
+	for (UInt freq = 0; freq < mNumFreqs; freq++)
+		mMnaTasks.push_back(std::make_shared<MnaPostStepHarm>(*this, leftVectors[freq], freq));
 	mRightVector = Matrix::Zero(leftVectors[0]->get().rows(), mNumFreqs);
 }
 
@@ -183,7 +184,7 @@ void DP::Ph1::VoltageSource::mnaPostStep(Real time, Int timeStepCount, Attribute
 }
 
 void DP::Ph1::VoltageSource::MnaPostStepHarm::execute(Real time, Int timeStepCount) {
-	mVoltageSource.mnaUpdateCurrent(*mLeftVectors[0]);
+	mVoltageSource.mnaUpdateCurrentHarm(*mLeftVector, mFreqIdx);
 }
 
 void DP::Ph1::VoltageSource::mnaUpdateCurrent(const Matrix& leftVector) {
@@ -192,6 +193,10 @@ void DP::Ph1::VoltageSource::mnaUpdateCurrent(const Matrix& leftVector) {
 	}
 }
 
+void DP::Ph1::VoltageSource::mnaUpdateCurrentHarm(const Matrix& leftVector, UInt freqIdx) {
+	mIntfCurrent(0,freqIdx) = Math::complexFromVectorElement(leftVector, mVirtualNodes[0]->matrixNodeIndex());
+}
+
 void DP::Ph1::VoltageSource::daeResidual(double ttime, const double state[], const double dstate_dt[], double resid[], std::vector<int>& off){
 	/* new state vector definintion:
 		state[0]=node0_voltage
@@ -118,22 +118,23 @@ void DP::Ph3::SynchronGeneratorDQ::MnaPostStep::execute(Real time, Int timeStepC
 	mSynGen.mnaUpdateVoltage(*mLeftVector);
 }
 
-Matrix DP::Ph3::SynchronGeneratorDQ::abcToDq0Transform(Real theta, MatrixComp& abcVector) {
+Vector3 DP::Ph3::SynchronGeneratorDQ::abcToDq0Transform(Real theta, const MatrixComp& abcVector) {
 	// Balanced case because we do not return the zero sequence component
 	Complex alpha(cos(2. / 3. * PI), sin(2. / 3. * PI));
 	Complex thetaCompInv(cos(-theta), sin(-theta));
 
-	MatrixComp abcToPnz(3, 3);
+	Matrix3Comp abcToPnz;
 	abcToPnz <<
 		1, 1, 1,
 		1, alpha, pow(alpha, 2),
 		1, pow(alpha, 2), alpha;
 	abcToPnz = (1. / 3.) * abcToPnz;
 
-	MatrixComp pnzVector(3, 1);
-	pnzVector = abcToPnz * abcVector * thetaCompInv;
+	// Fixed size copy, so that the products need no temporaries
+	Vector3Comp abc = abcVector;
+	Vector3Comp pnzVector = abcToPnz * abc * thetaCompInv;
 
-	Matrix dq0Vector(3, 1);
+	Vector3 dq0Vector;
 	dq0Vector <<
 		pnzVector(1, 0).real(),
 		pnzVector(1, 0).imag(),
@@ -142,26 +143,25 @@ Matrix DP::Ph3::SynchronGeneratorDQ::abcToDq0Transform(Real theta, MatrixComp& a
 	return dq0Vector;
 }
 
-MatrixComp DP::Ph3::SynchronGeneratorDQ::dq0ToAbcTransform(Real theta, Matrix& dq0) {
+Vector3Comp DP::Ph3::SynchronGeneratorDQ::dq0ToAbcTransform(Real theta, const Matrix& dq0) {
 	// Balanced case because we do not consider the zero sequence component
 	Complex alpha(cos(2. / 3. * PI), sin(2. / 3. * PI));
 	Complex thetaComp(cos(theta), sin(theta));
 	// Matrix to transform from symmetrical components to ABC
-	MatrixComp pnzToAbc(3, 3);
+	Matrix3Comp pnzToAbc;
 	pnzToAbc <<
 		1, 1, 1,
 		1, pow(alpha, 2), alpha,
 		1, alpha, pow(alpha, 2);
 	// Symmetrical components vector
-	MatrixComp pnzVector(3, 1);
+	Vector3Comp pnzVector;
 	// Picking only d and q for positive sequence component
 	pnzVector <<
 		0,
 		Complex(dq0(0,0), dq0(1,0)),
 		0;
 	// ABC vector
-	MatrixComp abcCompVector(3, 1);
-	abcCompVector = pnzToAbc * pnzVector * thetaComp;
+	Vector3Comp abcCompVector = pnzToAbc * pnzVector * thetaComp;
 
 	return abcCompVector;
 }
@@ -47,8 +47,7 @@ void DP::Ph3::SynchronGeneratorDQTrapez::stepInPerUnit(Real time) {
 	for (Int i = 0; i < mMultisamplingRate; i++) {
 	// Calculate per unit values and
 	// transform per unit voltages from abc to dq0
-	mVdq0 = abcToDq0Transform(mThetaMech, mIntfVoltage);
-	mVdq0 = mVdq0 / mBase_V;
+	mVdq0 = abcToDq0Transform(mThetaMech, mIntfVoltage) / mBase_V;
 	mVsr(0,0) = mVdq0(0,0);
 	mVsr(3,0) = mVdq0(1,0);
 	mVsr(6,0) = mVdq0(2,0);
@@ -75,18 +74,10 @@ void DP::Ph3::SynchronGeneratorDQTrapez::stepInPerUnit(Real time) {
 	mOmMech = mOmMech + mTimeStep * (1./(2.*mInertia) * (mMechTorque - mElecTorque));
 
 	// Update of fluxes
-	if (mNumericalMethod == NumericalMethod::Euler) {
-		mPsisr = Math::StateSpaceEuler(mPsisr,
-			mBase_OmElec*(mFluxStateSpaceMat + mOmegaFluxMat*mOmMech),
-			mBase_OmElec*mVsr, mTimeStep / mMultisamplingRate);
-	} else {
-		mPsisr = Math::StateSpaceTrapezoidal(mPsisr,
-			mBase_OmElec*(mFluxStateSpaceMat + mOmegaFluxMat*mOmMech),
-			mBase_OmElec*mVsr, mTimeStep / mMultisamplingRate);
-	}
+	stepFluxStateSpace(mTimeStep / mMultisamplingRate);
 
 	// Calculate new currents from fluxes
-	mIsr = mFluxToCurrentMat * mPsisr;
+	mIsr.noalias() = mFluxToCurrentMat * mPsisr;
 	}
 
 	mIdq0(0,0) = mIsr(0,0);
@@ -54,7 +54,7 @@ void EMT::Ph1::Capacitor::mnaInitialize(Real omega, Real timeStep, Attribute<Mat
 	// Update internal state
 	mEquivCurrent = -mIntfCurrent(0,0) + -mEquivCond * mIntfVoltage(0,0);
 
-	mRightVector = Matrix::Zero(leftVector->get().rows(), 1);
+	mnaInitializeRightVector(leftVector->get().rows());
 	mMnaTasks.push_back(std::make_shared<MnaPreStep>(*this));
 	mMnaTasks.push_back(std::make_shared<MnaPostStep>(*this, leftVector));
 }
@@ -70,7 +70,8 @@ void EMT::Ph1::Capacitor::mnaApplySystemMatrixStamp(Matrix& systemMatrix) {
 	}
 }
 
-void EMT::Ph1::Capacitor::mnaApplyRightSideVectorStamp(Matrix& rightVector) {
+template <typename VectorType>
+void EMT::Ph1::Capacitor::applyRightSideVectorStamp(VectorType& rightVector) {
 	mEquivCurrent = -mIntfCurrent(0,0) + -mEquivCond * mIntfVoltage(0,0);
 	if (terminalNotGrounded(0))
 		Math::setVectorElement(rightVector, matrixNodeIndex(0), mEquivCurrent);
@@ -78,8 +79,16 @@ void EMT::Ph1::Capacitor::mnaApplyRightSideVectorStamp(Matrix& rightVector) {
 		Math::setVectorElement(rightVector, matrixNodeIndex(1), -mEquivCurrent);
 }
 
+void EMT::Ph1::Capacitor::mnaApplyRightSideVectorStamp(Matrix& rightVector) {
+	applyRightSideVectorStamp(rightVector);
+}
+
+void EMT::Ph1::Capacitor::mnaApplyRightSideVectorStamp(SparseVector& rightVector) {
+	applyRightSideVectorStamp(rightVector);
+}
+
 void EMT::Ph1::Capacitor::MnaPreStep::execute(Real time, Int timeStepCount) {
-	mCapacitor.mnaApplyRightSideVectorStamp(mCapacitor.mRightVector);
+	mCapacitor.mnaUpdateRightVector();
 }
 
 void EMT::Ph1::Capacitor::MnaPostStep::execute(Real time, Int timeStepCount) {
@@ -42,10 +42,11 @@ void EMT::Ph1::CurrentSource::mnaInitialize(Real omega, Real timeStep, Attribute
 	mIntfCurrent(0,0) = Math::abs(mCurrentRef->get()) * cos(Math::phase(mCurrentRef->get()));
 	mMnaTasks.push_back(std::make_shared<MnaPreStep>(*this));
 	mMnaTasks.push_back(std::make_shared<MnaPostStep>(*this, leftVector));
-	mRightVector = Matrix::Zero(leftVector->get().rows(), 1);
+	mnaInitializeRightVector(leftVector->get().rows());
 }
 
-void EMT::Ph1::CurrentSource::mnaApplyRightSideVectorStamp(Matrix& rightVector) {
+template <typename VectorType>
+void EMT::Ph1::CurrentSource::applyRightSideVectorStamp(VectorType& rightVector) {
 	if (terminalNotGrounded(0))
 		Math::setVectorElement(rightVector, matrixNodeIndex(0), -mIntfCurrent(0,0));
 
@@ -53,6 +54,14 @@ void EMT::Ph1::CurrentSource::mnaApplyRightSideVectorStamp(Matrix& rightVector)
 		Math::setVectorElement(rightVector, matrixNodeIndex(1), mIntfCurrent(0,0));
 }
 
+void EMT::Ph1::CurrentSource::mnaApplyRightSideVectorStamp(Matrix& rightVector) {
+	applyRightSideVectorStamp(rightVector);
+}
+
+void EMT::Ph1::CurrentSource::mnaApplyRightSideVectorStamp(SparseVector& rightVector) {
+	applyRightSideVectorStamp(rightVector);
+}
+
 void EMT::Ph1::CurrentSource::updateState(Real time) {
 	Complex currentRef = mCurrentRef->get();
 	Real srcFreq = mSrcFreq->get();
@@ -64,7 +73,7 @@ void EMT::Ph1::CurrentSource::updateState(Real time) {
 
 void EMT::Ph1::CurrentSource::MnaPreStep::execute(Real time, Int timeStepCount) {
 	mCurrentSource.updateState(time);
-	mCurrentSource.mnaApplyRightSideVectorStamp(mCurrentSource.mRightVector);
+	mCurrentSource.mnaUpdateRightVector();
 }
 
 void EMT::Ph1::CurrentSource::MnaPostStep::execute(Real time, Int timeStepCount) {
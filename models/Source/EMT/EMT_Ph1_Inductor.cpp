@@ -56,7 +56,7 @@ void EMT::Ph1::Inductor::mnaInitialize(Real omega, Real timeStep, Attribute<Matr
 
 	mMnaTasks.push_back(std::make_shared<MnaPreStep>(*this));
 	mMnaTasks.push_back(std::make_shared<MnaPostStep>(*this, leftVector));
-	mRightVector = Matrix::Zero(leftVector->get().rows(), 1);
+	mnaInitializeRightVector(leftVector->get().rows());
 }
 
 void EMT::Ph1::Inductor::mnaApplySystemMatrixStamp(Matrix& systemMatrix) {
@@ -70,7 +70,8 @@ void EMT::Ph1::Inductor::mnaApplySystemMatrixStamp(Matrix& systemMatrix) {
 	}
 }
 
-void EMT::Ph1::Inductor::mnaApplyRightSideVectorStamp(Matrix& rightVector) {
+template <typename VectorType>
+void EMT::Ph1::Inductor::applyRightSideVectorStamp(VectorType& rightVector) {
 	// Update internal state
 	mEquivCurrent = mEquivCond * mIntfVoltage(0,0) + mIntfCurrent(0,0);
 	if (terminalNotGrounded(0))
@@ -79,8 +80,16 @@ void EMT::Ph1::Inductor::mnaApplyRightSideVectorStamp(Matrix& rightVector) {
 		Math::setVectorElement(rightVector, matrixNodeIndex(1), -mEquivCurrent);
 }
 
+void EMT::Ph1::Inductor::mnaApplyRightSideVectorStamp(Matrix& rightVector) {
+	applyRightSideVectorStamp(rightVector);
+}
+
+void EMT::Ph1::Inductor::mnaApplyRightSideVectorStamp(SparseVector& rightVector) {
+	applyRightSideVectorStamp(rightVector);
+}
+
 void EMT::Ph1::Inductor::MnaPreStep::execute(Real time, Int timeStepCount) {
-	mInductor.mnaApplyRightSideVectorStamp(mInductor.mRightVector);
+	mInductor.mnaUpdateRightVector();
 }
 
 void EMT::Ph1::Inductor::MnaPostStep::execute(Real time, Int timeStepCount) {
@@ -47,6 +47,8 @@ EMT::Ph3::AvVoltageSourceInverterDQ::AvVoltageSourceInverterDQ(String uid, Strin
 	// Create control sub components
 	mPLL = Signal::PLL::make(mName + "_PLL", mLogLevel);
 	mPowerControllerVSI = Signal::PowerControllerVSI::make(mName + "_PowerControllerVSI", mLogLevel);
+	mPLLOutputPrev = mPLL->attributeHandle<Matrix>("output_prev");
+	mPowerCtrlOutputCurr = mPowerControllerVSI->attributeHandle<Matrix>("output_curr");
 
 	// general variables of inverter
 	addAttribute<Real>("Omega_nom", &mOmegaN, Flags::read | Flags::write);
@@ -149,6 +151,11 @@ void EMT::Ph3::AvVoltageSourceInverterDQ::setInitialStateValues(Real pInit, Real
 	mPowerControllerVSI->setInitialStateValues(pInit, qInit, phi_dInit, phi_qInit, gamma_dInit, gamma_qInit);
 }
 
+void EMT::Ph3::AvVoltageSourceInverterDQ::setControlPeriod(UInt steps) {
+	mControlPeriod = steps > 0 ? steps : 1;
+	mPowerControllerVSI->setControlPeriod(mControlPeriod);
+}
+
 void EMT::Ph3::AvVoltageSourceInverterDQ::initializeFromNodesAndTerminals(Real frequency) {
 
 	// use complex interface quantities for initialization calculations
@@ -261,6 +268,10 @@ void EMT::Ph3::AvVoltageSourceInverterDQ::mnaInitialize(Real omega, Real timeSte
 		if (auto mnasubcomp = std::dynamic_pointer_cast<MNAInterface>(subcomp))
 			mnasubcomp->mnaInitialize(omega, timeStep, leftVector);
 
+	// without transformer, the resistor Rc is connected to the terminal
+	auto connectionNode = mWithConnectionTransformer ? mVirtualNodes[3] : node(0);
+	mConnectionNodeVoltage = connectionNode->attributeHandle<Matrix>("v");
+
 	// initialize state space controller
 	mPowerControllerVSI->initializeStateSpaceModel(omega, timeStep, leftVector);
 	mPLL->setSimulationParameters(timeStep);
@@ -305,7 +316,9 @@ void EMT::Ph3::AvVoltageSourceInverterDQ::addControlPreStepDependencies(Attribut
 void EMT::Ph3::AvVoltageSourceInverterDQ::controlPreStep(Real time, Int timeStepCount) {
 	// add pre-step of subcomponents
 	mPLL->signalPreStep(time, timeStepCount);
-	mPowerControllerVSI->signalPreStep(time, timeStepCount);
+	// the power controller is integrated over its control period
+	if (timeStepCount % mControlPeriod == 0)
+		mPowerControllerVSI->signalPreStep(time, timeStepCount);
 }
 
 void EMT::Ph3::AvVoltageSourceInverterDQ::addControlStepDependencies(AttributeBase::List &prevStepDependencies, AttributeBase::List &attributeDependencies, AttributeBase::List &modifiedAttributes) {
@@ -361,9 +374,9 @@ Matrix EMT::Ph3::AvVoltageSourceInverterDQ::getInverseParkTransformMatrixPowerIn
 void EMT::Ph3::AvVoltageSourceInverterDQ::controlStep(Real time, Int timeStepCount) {
 	// Transformation interface forward
 	Matrix vcdq, ircdq;
-	Real theta = mPLL->attribute<Matrix>("output_prev")->get()(0, 0);
-	vcdq = parkTransformPowerInvariant(theta, mVirtualNodes[3]->attribute<Matrix>("v")->get());
-	ircdq = parkTransformPowerInvariant(theta, - mSubResistorC->attribute<Matrix>("i_intf")->get());
+	Real theta = mPLLOutputPrev.get()(0, 0);
+	vcdq = parkTransformPowerInvariant(theta, mConnectionNodeVoltage.get());
+	ircdq = parkTransformPowerInvariant(theta, - mSubResistorC->intfCurrent());
 	
 	mVcd = vcdq(0, 0);
 	mVcq = vcdq(1, 0);
@@ -372,10 +385,11 @@ void EMT::Ph3::AvVoltageSourceInverterDQ::controlStep(Real time, Int timeStepCou
 
 	// add step of subcomponents
 	mPLL->signalStep(time, timeStepCount);
-	mPowerControllerVSI->signalStep(time, timeStepCount);
+	if (timeStepCount % mControlPeriod == 0)
+		mPowerControllerVSI->signalStep(time, timeStepCount);
 
 	// Transformation interface backward
-	mVsref = inverseParkTransformPowerInvariant(mPLL->attribute<Matrix>("output_prev")->get()(0, 0), mPowerControllerVSI->attribute<Matrix>("output_curr")->get());
+	mVsref = inverseParkTransformPowerInvariant(mPLLOutputPrev.get()(0, 0), mPowerCtrlOutputCurr.get());
 
 	// Update nominal system angle
 	mThetaN = mThetaN + mTimeStep * mOmegaN;
@@ -430,9 +444,9 @@ void EMT::Ph3::AvVoltageSourceInverterDQ::mnaPostStep(Real time, Int timeStepCou
 
 void EMT::Ph3::AvVoltageSourceInverterDQ::mnaUpdateCurrent(const Matrix& leftvector) {
 	if (mWithConnectionTransformer)
-		mIntfCurrent = mConnectionTransformer->attribute<Matrix>("i_intf")->get();
+		mIntfCurrent = mConnectionTransformer->intfCurrent();
 	else
-		mIntfCurrent = mSubResistorC->attribute<Matrix>("i_intf")->get();
+		mIntfCurrent = mSubResistorC->intfCurrent();
 }
 
 void EMT::Ph3::AvVoltageSourceInverterDQ::mnaUpdateVoltage(const Matrix& leftVector) {
@@ -14,7 +14,6 @@ EMT::Ph3::Capacitor::Capacitor(String uid, String name, Logger::Level logLevel)
 	: SimPowerComp<Real>(uid, name, logLevel) {
 	mPhaseType = PhaseType::ABC;
 	setTerminalNumber(2);
-	mEquivCurrent = Matrix::Zero(3, 1);
 	mIntfVoltage = Matrix::Zero(3, 1);
 	mIntfCurrent = Matrix::Zero(3, 1);
 
@@ -67,7 +66,11 @@ void EMT::Ph3::Capacitor::mnaInitialize(Real omega, Real timeStep, Attribute<Mat
 	// Update internal state
 	mEquivCurrent = - mIntfCurrent + - mEquivCond * mIntfVoltage;
 
-	mRightVector = Matrix::Zero(leftVector->get().rows(), 1);
+	mnaInitializeRightVector(leftVector->get().rows());
+	mNodeIndices = CompanionKernels::nodeIndices(*this);
+	mRightVectorEntries = mnaHasSparseRightVector() ?
+		CompanionKernels::vectorEntries(mRightVectorSparse, mNodeIndices) :
+		CompanionKernels::vectorEntries(mRightVector, mNodeIndices);
 	mMnaTasks.push_back(std::make_shared<MnaPreStep>(*this));
 	mMnaTasks.push_back(std::make_shared<MnaPostStep>(*this, leftVector));
 
@@ -127,8 +130,9 @@ void EMT::Ph3::Capacitor::mnaApplySystemMatrixStamp(Matrix& systemMatrix) {
 			Logger::matrixToString(mEquivCond));
 }
 
-void EMT::Ph3::Capacitor::mnaApplyRightSideVectorStamp(Matrix& rightVector) {
-	mEquivCurrent = -mIntfCurrent + -mEquivCond * mIntfVoltage;
+template <typename VectorType>
+void EMT::Ph3::Capacitor::applyRightSideVectorStamp(VectorType& rightVector) {
+	CompanionKernels::multiplyAdd(mEquivCond, mIntfVoltage.data(), mIntfCurrent.data(), -1., mEquivCurrent.data());
 	if (terminalNotGrounded(0)) {
 		Math::setVectorElement(rightVector, matrixNodeIndex(0, 0), mEquivCurrent(0, 0));
 		Math::setVectorElement(rightVector, matrixNodeIndex(0, 1), mEquivCurrent(1, 0));
@@ -144,6 +148,14 @@ void EMT::Ph3::Capacitor::mnaApplyRightSideVectorStamp(Matrix& rightVector) {
 		Logger::matrixToString(mEquivCurrent));
 }
 
+void EMT::Ph3::Capacitor::mnaApplyRightSideVectorStamp(Matrix& rightVector) {
+	applyRightSideVectorStamp(rightVector);
+}
+
+void EMT::Ph3::Capacitor::mnaApplyRightSideVectorStamp(SparseVector& rightVector) {
+	applyRightSideVectorStamp(rightVector);
+}
+
 void EMT::Ph3::Capacitor::mnaAddPreStepDependencies(AttributeBase::List &prevStepDependencies, AttributeBase::List &attributeDependencies, AttributeBase::List &modifiedAttributes) {
 	// actually depends on C, but then we'd have to modify the system matrix anyway	
 	prevStepDependencies.push_back(attribute("i_intf"));
@@ -152,7 +164,9 @@ void EMT::Ph3::Capacitor::mnaAddPreStepDependencies(AttributeBase::List &prevSte
 }
 
 void EMT::Ph3::Capacitor::mnaPreStep(Real time, Int timeStepCount) {
-	mnaApplyRightSideVectorStamp(mRightVector);
+	// Same as mnaUpdateRightVector, but with the precomputed entries of the stamp
+	CompanionKernels::multiplyAdd(mEquivCond, mIntfVoltage.data(), mIntfCurrent.data(), -1., mEquivCurrent.data());
+	CompanionKernels::stampCurrent(mRightVectorEntries, mEquivCurrent.data());
 }
 
 void EMT::Ph3::Capacitor::mnaAddPostStepDependencies(AttributeBase::List &prevStepDependencies, AttributeBase::List &attributeDependencies, AttributeBase::List &modifiedAttributes, Attribute<Matrix>::Ptr &leftVector) {
@@ -168,24 +182,12 @@ void EMT::Ph3::Capacitor::mnaPostStep(Real time, Int timeStepCount, Attribute<Ma
 
 void EMT::Ph3::Capacitor::mnaUpdateVoltage(const Matrix& leftVector) {
 	// v1 - v0
-	mIntfVoltage = Matrix::Zero(3,1);
-	if (terminalNotGrounded(1)) {
-		mIntfVoltage(0, 0) = Math::realFromVectorElement(leftVector, matrixNodeIndex(1, 0));
-		mIntfVoltage(1, 0) = Math::realFromVectorElement(leftVector, matrixNodeIndex(1, 1));
-		mIntfVoltage(2, 0) = Math::realFromVectorElement(leftVector, matrixNodeIndex(1, 2));
-	}
-	if (terminalNotGrounded(0)) {
-		mIntfVoltage(0, 0) = mIntfVoltage(0, 0) - Math::realFromVectorElement(leftVector, matrixNodeIndex(0, 0));
-		mIntfVoltage(1, 0) = mIntfVoltage(1, 0) - Math::realFromVectorElement(leftVector, matrixNodeIndex(0, 1));
-		mIntfVoltage(2, 0) = mIntfVoltage(2, 0) - Math::realFromVectorElement(leftVector, matrixNodeIndex(0, 2));
-	}
+	CompanionKernels::terminalVoltage(leftVector, mNodeIndices, mIntfVoltage.data());
 }
 
 void EMT::Ph3::Capacitor::mnaUpdateCurrent(const Matrix& leftVector) {
-	mIntfCurrent = mEquivCond * mIntfVoltage + mEquivCurrent;
-	mSLog->debug(
-		"\nCurrent: {:s}",
-		Logger::matrixToString(mIntfCurrent)
-	);
+	CompanionKernels::multiplyAdd(mEquivCond, mIntfVoltage.data(), mEquivCurrent.data(), 1., mIntfCurrent.data());
+	if (mSLog->should_log(spdlog::level::debug))
+		mSLog->debug("\nCurrent: {:s}", Logger::matrixToString(mIntfCurrent));
 }
 
@@ -14,7 +14,6 @@ EMT::Ph3::Inductor::Inductor(String uid, String name, Logger::Level logLevel)
 	: SimPowerComp<Real>(uid, name, logLevel) {
 	mPhaseType = PhaseType::ABC;
 	setTerminalNumber(2);
-	mEquivCurrent = Matrix::Zero(3, 1);
 	mIntfVoltage = Matrix::Zero(3, 1);
 	mIntfCurrent = Matrix::Zero(3, 1);
 
@@ -71,7 +70,11 @@ void EMT::Ph3::Inductor::mnaInitialize(Real omega, Real timeStep, Attribute<Matr
 
 	mMnaTasks.push_back(std::make_shared<MnaPreStep>(*this));
 	mMnaTasks.push_back(std::make_shared<MnaPostStep>(*this, leftVector));
-	mRightVector = Matrix::Zero(leftVector->get().rows(), 1);
+	mnaInitializeRightVector(leftVector->get().rows());
+	mNodeIndices = CompanionKernels::nodeIndices(*this);
+	mRightVectorEntries = mnaHasSparseRightVector() ?
+		CompanionKernels::vectorEntries(mRightVectorSparse, mNodeIndices) :
+		CompanionKernels::vectorEntries(mRightVector, mNodeIndices);
 
 	mSLog->info(
 		"\n--- MNA initialization ---"
@@ -139,9 +142,10 @@ void EMT::Ph3::Inductor::mnaApplySystemMatrixStamp(Matrix& systemMatrix) {
 		Logger::matrixToString(mEquivCond));
 }
 
-void EMT::Ph3::Inductor::mnaApplyRightSideVectorStamp(Matrix& rightVector) {
+template <typename VectorType>
+void EMT::Ph3::Inductor::applyRightSideVectorStamp(VectorType& rightVector) {
 	// Update internal state
-	mEquivCurrent = mEquivCond * mIntfVoltage + mIntfCurrent;
+	CompanionKernels::multiplyAdd(mEquivCond, mIntfVoltage.data(), mIntfCurrent.data(), 1., mEquivCurrent.data());
 	if (terminalNotGrounded(0)) {
 		Math::setVectorElement(rightVector, matrixNodeIndex(0, 0), mEquivCurrent(0, 0));
 		Math::setVectorElement(rightVector, matrixNodeIndex(0, 1), mEquivCurrent(1, 0));
@@ -158,6 +162,14 @@ void EMT::Ph3::Inductor::mnaApplyRightSideVectorStamp(Matrix& rightVector) {
 	mSLog->flush();
 }
 
+void EMT::Ph3::Inductor::mnaApplyRightSideVectorStamp(Matrix& rightVector) {
+	applyRightSideVectorStamp(rightVector);
+}
+
+void EMT::Ph3::Inductor::mnaApplyRightSideVectorStamp(SparseVector& rightVector) {
+	applyRightSideVectorStamp(rightVector);
+}
+
 void EMT::Ph3::Inductor::mnaAddPreStepDependencies(AttributeBase::List &prevStepDependencies, AttributeBase::List &attributeDependencies, AttributeBase::List &modifiedAttributes) {
 	// actually depends on L, but then we'd have to modify the system matrix anyway
 	prevStepDependencies.push_back(attribute("v_intf"));
@@ -166,7 +178,9 @@ void EMT::Ph3::Inductor::mnaAddPreStepDependencies(AttributeBase::List &prevStep
 }
 
 void EMT::Ph3::Inductor::mnaPreStep(Real time, Int timeStepCount) {
-	mnaApplyRightSideVectorStamp(mRightVector);
+	// Same as mnaUpdateRightVector, but with the precomputed entries of the stamp
+	CompanionKernels::multiplyAdd(mEquivCond, mIntfVoltage.data(), mIntfCurrent.data(), 1., mEquivCurrent.data());
+	CompanionKernels::stampCurrent(mRightVectorEntries, mEquivCurrent.data());
 }
 
 void EMT::Ph3::Inductor::mnaAddPostStepDependencies(AttributeBase::List &prevStepDependencies, AttributeBase::List &attributeDependencies, AttributeBase::List &modifiedAttributes, Attribute<Matrix>::Ptr &leftVector) {
@@ -182,29 +196,16 @@ void EMT::Ph3::Inductor::mnaPostStep(Real time, Int timeStepCount, Attribute<Mat
 
 void EMT::Ph3::Inductor::mnaUpdateVoltage(const Matrix& leftVector) {
 	// v1 - v0
-	mIntfVoltage = Matrix::Zero(3, 1);
-	if (terminalNotGrounded(1)) {
-		mIntfVoltage(0, 0) = Math::realFromVectorElement(leftVector, matrixNodeIndex(1, 0));
-		mIntfVoltage(1, 0) = Math::realFromVectorElement(leftVector, matrixNodeIndex(1, 1));
-		mIntfVoltage(2, 0) = Math::realFromVectorElement(leftVector, matrixNodeIndex(1, 2));
-	}
-	if (terminalNotGrounded(0)) {
-		mIntfVoltage(0, 0) = mIntfVoltage(0, 0) - Math::realFromVectorElement(leftVector, matrixNodeIndex(0, 0));
-		mIntfVoltage(1, 0) = mIntfVoltage(1, 0) - Math::realFromVectorElement(leftVector, matrixNodeIndex(0, 1));
-		mIntfVoltage(2, 0) = mIntfVoltage(2, 0) - Math::realFromVectorElement(leftVector, matrixNodeIndex(0, 2));
-	}
-	mSLog->debug(
-		"\nUpdate Voltage: {:s}",
-		Logger::matrixToString(mIntfVoltage)
-	);
+	CompanionKernels::terminalVoltage(leftVector, mNodeIndices, mIntfVoltage.data());
+	if (mSLog->should_log(spdlog::level::debug))
+		mSLog->debug("\nUpdate Voltage: {:s}", Logger::matrixToString(mIntfVoltage));
 }
 
 void EMT::Ph3::Inductor::mnaUpdateCurrent(const Matrix& leftVector) {
-	mIntfCurrent = mEquivCond * mIntfVoltage + mEquivCurrent;
-	mSLog->debug(
-		"\nUpdate Current: {:s}",
-		Logger::matrixToString(mIntfCurrent)
-	);
-	mSLog->flush();
+	CompanionKernels::multiplyAdd(mEquivCond, mIntfVoltage.data(), mEquivCurrent.data(), 1., mIntfCurrent.data());
+	if (mSLog->should_log(spdlog::level::debug)) {
+		mSLog->debug("\nUpdate Current: {:s}", Logger::matrixToString(mIntfCurrent));
+		mSLog->flush();
+	}
 }
 
@@ -141,121 +141,38 @@ void EMT::Ph3::PiLine::initializeFromNodesAndTerminals(Real frequency) {
 void EMT::Ph3::PiLine::mnaInitialize(Real omega, Real timeStep, Attribute<Matrix>::Ptr leftVector) {
 	MNAInterface::mnaInitialize(omega, timeStep);
 	updateMatrixNodeIndices();
-	MNAInterface::List subComps({ mSubSeriesResistor, mSubSeriesInductor });
+	mNodeIndices = CompanionKernels::nodeIndices(*this);
 
-	mSubSeriesResistor->mnaInitialize(omega, timeStep, leftVector);
-	mSubSeriesInductor->mnaInitialize(omega, timeStep, leftVector);
-	mRightVectorStamps.push_back(&mSubSeriesInductor->attribute<Matrix>("right_vector")->get());
-
-	mSubParallelResistor0->mnaInitialize(omega, timeStep, leftVector);
-	mSubParallelResistor1->mnaInitialize(omega, timeStep, leftVector);
-	subComps.push_back(mSubParallelResistor0);
-	subComps.push_back(mSubParallelResistor1);
-	
+	mnaInitializeSubComponent(mSubSeriesResistor, omega, timeStep, leftVector);
+	mnaInitializeSubComponent(mSubSeriesInductor, omega, timeStep, leftVector);
+	mnaInitializeSubComponent(mSubParallelResistor0, omega, timeStep, leftVector);
+	mnaInitializeSubComponent(mSubParallelResistor1, omega, timeStep, leftVector);
 	if (mParallelCap(0,0) > 0) {
-		mSubParallelCapacitor0->mnaInitialize(omega, timeStep, leftVector);
-		mSubParallelCapacitor1->mnaInitialize(omega, timeStep, leftVector);
-		mRightVectorStamps.push_back(&mSubParallelCapacitor0->attribute<Matrix>("right_vector")->get());
-		mRightVectorStamps.push_back(&mSubParallelCapacitor1->attribute<Matrix>("right_vector")->get());
-		subComps.push_back(mSubParallelCapacitor0);
-		subComps.push_back(mSubParallelCapacitor1);
+		mnaInitializeSubComponent(mSubParallelCapacitor0, omega, timeStep, leftVector);
+		mnaInitializeSubComponent(mSubParallelCapacitor1, omega, timeStep, leftVector);
 	}
-	mMnaTasks.push_back(std::make_shared<MnaPreStep>(*this));
 	mMnaTasks.push_back(std::make_shared<MnaPostStep>(*this, leftVector));
-	mRightVector = Matrix::Zero(leftVector->get().rows(), 1);
 }
 
 void EMT::Ph3::PiLine::mnaApplySystemMatrixStamp(Matrix& systemMatrix) {
-	mSubSeriesResistor->mnaApplySystemMatrixStamp(systemMatrix);
-	mSubSeriesInductor->mnaApplySystemMatrixStamp(systemMatrix);
-
-	mSubParallelResistor0->mnaApplySystemMatrixStamp(systemMatrix);
-	mSubParallelResistor1->mnaApplySystemMatrixStamp(systemMatrix);
-
-	if (mParallelCap(0,0) > 0) {
-		mSubParallelCapacitor0->mnaApplySystemMatrixStamp(systemMatrix);
-		mSubParallelCapacitor1->mnaApplySystemMatrixStamp(systemMatrix);
-	}
-}
-
-void EMT::Ph3::PiLine::mnaApplyRightSideVectorStamp(Matrix& rightVector) {
-	rightVector.setZero();
-	for (auto stamp : mRightVectorStamps)
-		rightVector += *stamp;
-}
-
-void EMT::Ph3::PiLine::mnaAddPreStepDependencies(AttributeBase::List &prevStepDependencies, AttributeBase::List &attributeDependencies, AttributeBase::List &modifiedAttributes){
-	// add pre-step dependencies of subcomponents
-	mSubSeriesResistor->mnaAddPreStepDependencies(prevStepDependencies, attributeDependencies, modifiedAttributes);
-	mSubSeriesInductor->mnaAddPreStepDependencies(prevStepDependencies, attributeDependencies, modifiedAttributes);
-	mSubParallelResistor0->mnaAddPreStepDependencies(prevStepDependencies, attributeDependencies, modifiedAttributes);
-	mSubParallelResistor1->mnaAddPreStepDependencies(prevStepDependencies, attributeDependencies, modifiedAttributes);
-	
-	if (mParallelCap(0, 0) > 0) {
-		mSubParallelCapacitor0->mnaAddPreStepDependencies(prevStepDependencies, attributeDependencies, modifiedAttributes);
-		mSubParallelCapacitor1->mnaAddPreStepDependencies(prevStepDependencies, attributeDependencies, modifiedAttributes);
-	}
-	// add pre-step dependencies of component itself
-	prevStepDependencies.push_back(attribute("i_intf"));
-	prevStepDependencies.push_back(attribute("v_intf"));
-	modifiedAttributes.push_back(attribute("right_vector"));
-}
-
-void EMT::Ph3::PiLine::mnaPreStep(Real time, Int timeStepCount) {
-	// pre-step of subcomponents
-	mSubSeriesInductor->mnaPreStep(time, timeStepCount);
-	if (mParallelCap(0, 0) > 0) {
-		mSubParallelCapacitor0->mnaPreStep(time, timeStepCount);
-		mSubParallelCapacitor1->mnaPreStep(time, timeStepCount);
-	}
-	// pre-step of component itself
-	mnaApplyRightSideVectorStamp(mRightVector);
+	mnaApplySubComponentSystemMatrixStamps(systemMatrix);
 }
 
 void EMT::Ph3::PiLine::mnaAddPostStepDependencies(AttributeBase::List &prevStepDependencies, AttributeBase::List &attributeDependencies, AttributeBase::List &modifiedAttributes, Attribute<Matrix>::Ptr &leftVector) {
-	// add post-step dependencies of subcomponents
-	mSubSeriesResistor->mnaAddPostStepDependencies(prevStepDependencies, attributeDependencies, modifiedAttributes, leftVector);
-	mSubSeriesInductor->mnaAddPostStepDependencies(prevStepDependencies, attributeDependencies, modifiedAttributes, leftVector);
-	if (mParallelCap(0, 0) > 0) {
-		mSubParallelCapacitor0->mnaAddPostStepDependencies(prevStepDependencies, attributeDependencies, modifiedAttributes, leftVector);
-		mSubParallelCapacitor1->mnaAddPostStepDependencies(prevStepDependencies, attributeDependencies, modifiedAttributes, leftVector);
-	}
-	mSubParallelResistor0->mnaAddPostStepDependencies(prevStepDependencies, attributeDependencies, modifiedAttributes, leftVector);
-	mSubParallelResistor1->mnaAddPostStepDependencies(prevStepDependencies, attributeDependencies, modifiedAttributes, leftVector);
-	// add post-step dependencies of component itself
 	attributeDependencies.push_back(leftVector);
+	attributeDependencies.push_back(mSubSeriesInductor->attribute("i_intf"));
 	modifiedAttributes.push_back(attribute("v_intf"));
 	modifiedAttributes.push_back(attribute("i_intf"));
 }
 
 void EMT::Ph3::PiLine::mnaPostStep(Real time, Int timeStepCount, Attribute<Matrix>::Ptr &leftVector) {
-	// post-step of subcomponents
-	mSubSeriesResistor->mnaPostStep(time, timeStepCount, leftVector);
-	mSubSeriesInductor->mnaPostStep(time, timeStepCount, leftVector);
-	if (mParallelCap(0, 0) > 0) {
-		mSubParallelCapacitor0->mnaPostStep(time, timeStepCount, leftVector);
-		mSubParallelCapacitor1->mnaPostStep(time, timeStepCount, leftVector);
-	}
-	mSubParallelResistor0->mnaPostStep(time, timeStepCount, leftVector);
-	mSubParallelResistor1->mnaPostStep(time, timeStepCount, leftVector);
-	// post-step of component itself
 	mnaUpdateVoltage(*leftVector);
 	mnaUpdateCurrent(*leftVector);
 }
 
 void EMT::Ph3::PiLine::mnaUpdateVoltage(const Matrix& leftVector) {
 	// v1 - v0
-	mIntfVoltage = Matrix::Zero(3, 1);
-	if (terminalNotGrounded(1)) {
-		mIntfVoltage(0, 0) = Math::realFromVectorElement(leftVector, matrixNodeIndex(1, 0));
-		mIntfVoltage(1, 0) = Math::realFromVectorElement(leftVector, matrixNodeIndex(1, 1));
-		mIntfVoltage(2, 0) = Math::realFromVectorElement(leftVector, matrixNodeIndex(1, 2));
-	}
-	if (terminalNotGrounded(0)) {
-		mIntfVoltage(0, 0) = mIntfVoltage(0, 0) - Math::realFromVectorElement(leftVector, matrixNodeIndex(0, 0));
-		mIntfVoltage(1, 0) = mIntfVoltage(1, 0) - Math::realFromVectorElement(leftVector, matrixNodeIndex(0, 1));
-		mIntfVoltage(2, 0) = mIntfVoltage(2, 0) - Math::realFromVectorElement(leftVector, matrixNodeIndex(0, 2));
-	}
+	CompanionKernels::terminalVoltage(leftVector, mNodeIndices, mIntfVoltage.data());
 }
 
 void EMT::Ph3::PiLine::mnaUpdateCurrent(const Matrix& leftVector) {
@@ -115,9 +115,9 @@ void EMT::Ph3::SynchronGeneratorDQ::MnaPostStep::execute(Real time, Int timeStep
 	mSynGen.mnaUpdateVoltage(*mLeftVector);
 }
 
-Matrix EMT::Ph3::SynchronGeneratorDQ::abcToDq0Transform(Real theta, Matrix& abcVector) {
-	Matrix dq0Vector(3, 1);
-	Matrix abcToDq0(3, 3);
+Vector3 EMT::Ph3::SynchronGeneratorDQ::abcToDq0Transform(Real theta, const Matrix& abcVector) {
+	Vector3 dq0Vector;
+	Matrix3 abcToDq0;
 
 	// Park transform according to Kundur
 	abcToDq0 <<
@@ -125,14 +125,16 @@ Matrix EMT::Ph3::SynchronGeneratorDQ::abcToDq0Transform(Real theta, Matrix& abcV
 		-2./3.*sin(theta), -2./3.*sin(theta - 2.*PI/3.), -2./3.*sin(theta + 2.*PI/3.),
 		 1./3., 			1./3., 						  1./3.;
 
-	dq0Vector = abcToDq0 * abcVector;
+	// Fixed size copy, so that the product needs no temporary
+	Vector3 abc = abcVector;
+	dq0Vector = abcToDq0 * abc;
 
 	return dq0Vector;
 }
 
-Matrix EMT::Ph3::SynchronGeneratorDQ::dq0ToAbcTransform(Real theta, Matrix& dq0Vector) {
-	Matrix abcVector(3, 1);
-	Matrix dq0ToAbc(3, 3);
+Vector3 EMT::Ph3::SynchronGeneratorDQ::dq0ToAbcTransform(Real theta, const Matrix& dq0Vector) {
+	Vector3 abcVector;
+	Matrix3 dq0ToAbc;
 
 	// Park transform according to Kundur
 	dq0ToAbc <<
@@ -140,7 +142,8 @@ Matrix EMT::Ph3::SynchronGeneratorDQ::dq0ToAbcTransform(Real theta, Matrix& dq0V
 		cos(theta - 2.*PI/3.), -sin(theta - 2.*PI/3.), 1.,
 		cos(theta + 2.*PI/3.), -sin(theta + 2.*PI/3.), 1.;
 
-	abcVector = dq0ToAbc * dq0Vector;
+	Vector3 dq0 = dq0Vector;
+	abcVector = dq0ToAbc * dq0;
 
 	return abcVector;
 }
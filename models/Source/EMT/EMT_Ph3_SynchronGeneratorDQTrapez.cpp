@@ -71,13 +71,10 @@ void EMT::Ph3::SynchronGeneratorDQTrapez::stepInPerUnit(Real time) {
 	mOmMech = mOmMech + mTimeStep * (1./(2.*mInertia) * (mMechTorque - mElecTorque));
 
 	// Update of fluxes
-	if (mNumericalMethod == NumericalMethod::Euler)
-		mPsisr = Math::StateSpaceEuler(mPsisr, mBase_OmElec*(mFluxStateSpaceMat + mOmegaFluxMat*mOmMech), mBase_OmElec*mVsr, mTimeStep);
-	else
-		mPsisr = Math::StateSpaceTrapezoidal(mPsisr, mBase_OmElec*(mFluxStateSpaceMat + mOmegaFluxMat*mOmMech), mBase_OmElec*mVsr, mTimeStep);
+	stepFluxStateSpace(mTimeStep);
 
 	// Calculate new currents from fluxes
-	mIsr = mFluxToCurrentMat * mPsisr;
+	mIsr.noalias() = mFluxToCurrentMat * mPsisr;
 
 	mIdq0(0, 0) = mIsr(0, 0);
 	mIdq0(1, 0) = mIsr(3, 0);
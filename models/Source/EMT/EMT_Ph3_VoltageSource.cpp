@@ -22,6 +22,8 @@ EMT::Ph3::VoltageSource::VoltageSource(String uid, String name, Logger::Level lo
 
 	addAttribute<MatrixComp>("V_ref", Flags::read | Flags::write);  // rms-value, phase-to-phase
 	addAttribute<Real>("f_src", Flags::read | Flags::write);
+	mVoltageRef = attributeHandle<MatrixComp>("V_ref");
+	mSrcFreq = attributeHandle<Real>("f_src");
 }
 
 void EMT::Ph3::VoltageSource::setParameters(MatrixComp voltageRef, Real srcFreq) {
@@ -118,22 +120,22 @@ void EMT::Ph3::VoltageSource::mnaApplyRightSideVectorStamp(Matrix& rightVector)
 }
 
 void EMT::Ph3::VoltageSource::updateVoltage(Real time) {
-	if (attribute<Real>("f_src")->get() < 0) {
-		mIntfVoltage = RMS3PH_TO_PEAK1PH * attribute<MatrixComp>("V_ref")->get().real();
+	const MatrixComp& voltageRef = mVoltageRef.get();
+	const Real srcFreq = mSrcFreq.get();
+	if (srcFreq < 0) {
+		mIntfVoltage = RMS3PH_TO_PEAK1PH * voltageRef.real();
 	}
 	else {
-		mIntfVoltage(0, 0) =
-			RMS3PH_TO_PEAK1PH * Math::abs(attribute<MatrixComp>("V_ref")->get()(0, 0)) * cos(time * 2. * PI * attribute<Real>("f_src")->get() + Math::phase(attribute<MatrixComp>("V_ref")->get())(0, 0));
-		mIntfVoltage(1, 0) =
-			RMS3PH_TO_PEAK1PH * Math::abs(attribute<MatrixComp>("V_ref")->get()(1, 0)) * cos(time * 2. * PI * attribute<Real>("f_src")->get() + Math::phase(attribute<MatrixComp>("V_ref")->get())(1, 0));
-		mIntfVoltage(2, 0) =
-			RMS3PH_TO_PEAK1PH * Math::abs(attribute<MatrixComp>("V_ref")->get()(2, 0)) * cos(time * 2. * PI * attribute<Real>("f_src")->get() + Math::phase(attribute<MatrixComp>("V_ref")->get())(2, 0));
+		for (Matrix::Index k = 0; k < 3; k++)
+			mIntfVoltage(k, 0) =
+				RMS3PH_TO_PEAK1PH * Math::abs(voltageRef(k, 0)) * cos(time * 2. * PI * srcFreq + Math::phase(voltageRef(k, 0)));
 	}
 
-	mSLog->debug(
-		"\nUpdate Voltage: {:s}",
-		Logger::matrixToString(mIntfVoltage)
-	);
+	if (mSLog->should_log(spdlog::level::debug))
+		mSLog->debug(
+			"\nUpdate Voltage: {:s}",
+			Logger::matrixToString(mIntfVoltage)
+		);
 }
 
 void EMT::Ph3::VoltageSource::mnaAddPreStepDependencies(AttributeBase::List &prevStepDependencies, AttributeBase::List &attributeDependencies, AttributeBase::List &modifiedAttributes) {
@@ -45,6 +45,8 @@ SP::Ph1::AvVoltageSourceInverterDQ::AvVoltageSourceInverterDQ(String uid, String
 	// Create control sub components
 	mPLL = Signal::PLL::make(mName + "_PLL", mLogLevel);
 	mPowerControllerVSI = Signal::PowerControllerVSI::make(mName + "_PowerControllerVSI", mLogLevel);
+	mPLLOutputPrev = mPLL->attributeHandle<Matrix>("output_prev");
+	mPowerCtrlOutputCurr = mPowerControllerVSI->attributeHandle<Matrix>("output_curr");
 
 	// general variables of inverter
 	addAttribute<Real>("Omega_nom", &mOmegaN, Flags::read | Flags::write);
@@ -147,6 +149,11 @@ void SP::Ph1::AvVoltageSourceInverterDQ::setInitialStateValues(Real pInit, Real
 	mPowerControllerVSI->setInitialStateValues(pInit, qInit, phi_dInit, phi_qInit, gamma_dInit, gamma_qInit);
 }
 
+void SP::Ph1::AvVoltageSourceInverterDQ::setControlPeriod(UInt steps) {
+	mControlPeriod = steps > 0 ? steps : 1;
+	mPowerControllerVSI->setControlPeriod(mControlPeriod);
+}
+
 void SP::Ph1::AvVoltageSourceInverterDQ::initializeFromNodesAndTerminals(Real frequency) {
 
 	// set initial interface quantities
@@ -288,7 +295,9 @@ void SP::Ph1::AvVoltageSourceInverterDQ::addControlPreStepDependencies(Attribute
 void SP::Ph1::AvVoltageSourceInverterDQ::controlPreStep(Real time, Int timeStepCount) {
 	// add pre-step of subcomponents
 	mPLL->signalPreStep(time, timeStepCount);
-	mPowerControllerVSI->signalPreStep(time, timeStepCount);
+	// the power controller is integrated over its control period
+	if (timeStepCount % mControlPeriod == 0)
+		mPowerControllerVSI->signalPreStep(time, timeStepCount);
 }
 
 void SP::Ph1::AvVoltageSourceInverterDQ::addControlStepDependencies(AttributeBase::List &prevStepDependencies, AttributeBase::List &attributeDependencies, AttributeBase::List &modifiedAttributes) {
@@ -304,8 +313,8 @@ void SP::Ph1::AvVoltageSourceInverterDQ::addControlStepDependencies(AttributeBas
 void SP::Ph1::AvVoltageSourceInverterDQ::controlStep(Real time, Int timeStepCount) {
 	// Transformation interface forward
 	Complex vcdq, ircdq;
-	vcdq = Math::rotatingFrame2to1(mVirtualNodes[3]->singleVoltage(), mPLL->attribute<Matrix>("output_prev")->get()(0, 0), mThetaN);
-	ircdq = Math::rotatingFrame2to1(-1. * mSubResistorC->attribute<MatrixComp>("i_intf")->get()(0, 0), mPLL->attribute<Matrix>("output_prev")->get()(0, 0), mThetaN);
+	vcdq = Math::rotatingFrame2to1(mVirtualNodes[3]->singleVoltage(), mPLLOutputPrev.get()(0, 0), mThetaN);
+	ircdq = Math::rotatingFrame2to1(-1. * mSubResistorC->intfCurrent()(0, 0), mPLLOutputPrev.get()(0, 0), mThetaN);
 	mVcd = vcdq.real();
 	mVcq = vcdq.imag();
 	mIrcd = ircdq.real();
@@ -313,10 +322,11 @@ void SP::Ph1::AvVoltageSourceInverterDQ::controlStep(Real time, Int timeStepCoun
 
 	// add step of subcomponents
 	mPLL->signalStep(time, timeStepCount);
-	mPowerControllerVSI->signalStep(time, timeStepCount);
+	if (timeStepCount % mControlPeriod == 0)
+		mPowerControllerVSI->signalStep(time, timeStepCount);
 
 	// Transformation interface backward
-	mVsref(0,0) = Math::rotatingFrame2to1(Complex(mPowerControllerVSI->attribute<Matrix>("output_curr")->get()(0, 0), mPowerControllerVSI->attribute<Matrix>("output_curr")->get()(1, 0)), mThetaN, mPLL->attribute<Matrix>("output_prev")->get()(0, 0));
+	mVsref(0,0) = Math::rotatingFrame2to1(Complex(mPowerCtrlOutputCurr.get()(0, 0), mPowerCtrlOutputCurr.get()(1, 0)), mThetaN, mPLLOutputPrev.get()(0, 0));
 
 	// Update nominal system angle
 	mThetaN = mThetaN + mTimeStep * mOmegaN;
@@ -371,9 +381,9 @@ void SP::Ph1::AvVoltageSourceInverterDQ::mnaPostStep(Real time, Int timeStepCoun
 
 void SP::Ph1::AvVoltageSourceInverterDQ::mnaUpdateCurrent(const Matrix& leftvector) {
 	if (mWithConnectionTransformer)
-		mIntfCurrent = mConnectionTransformer->attribute<MatrixComp>("i_intf")->get();
+		mIntfCurrent = mConnectionTransformer->intfCurrent();
 	else
-		mIntfCurrent = mSubResistorC->attribute<MatrixComp>("i_intf")->get();
+		mIntfCurrent = mSubResistorC->intfCurrent();
 }
 
 void SP::Ph1::AvVoltageSourceInverterDQ::mnaUpdateVoltage(const Matrix& leftVector) {
@@ -36,11 +36,11 @@ DecouplingLine::DecouplingLine(String name, SimNode<Complex>::Ptr node1, SimNode
 	mSrc1 = CurrentSource::make(name + "_i1", logLevel);
 	mSrc1->setParameters(0);
 	mSrc1->connect({node1, SimNode<Complex>::GND});
-	mSrcCur1 = mSrc1->attributeComplex("I_ref");
+	mSrcCur1 = mSrc1->attributeHandle<Complex>("I_ref");
 	mSrc2 = CurrentSource::make(name + "_i2", logLevel);
 	mSrc2->setParameters(0);
 	mSrc2->connect({node2, SimNode<Complex>::GND});
-	mSrcCur2 = mSrc2->attributeComplex("I_ref");
+	mSrcCur2 = mSrc2->attributeHandle<Complex>("I_ref");
 }
 
 DecouplingLine::DecouplingLine(String name, Logger::Level logLevel) :
@@ -55,8 +55,8 @@ DecouplingLine::DecouplingLine(String name, Logger::Level logLevel) :
 	mSrc1 = CurrentSource::make(name + "_i1", logLevel);
 	mSrc2 = CurrentSource::make(name + "_i2", logLevel);
 
-	mSrcCur1 = mSrc1->attributeComplex("I_ref");
-	mSrcCur2 = mSrc2->attributeComplex("I_ref");
+	mSrcCur1 = mSrc1->attributeHandle<Complex>("I_ref");
+	mSrcCur2 = mSrc2->attributeHandle<Complex>("I_ref");
 }
 
 void DecouplingLine::setParameters(SimNode<Complex>::Ptr node1, SimNode<Complex>::Ptr node2,
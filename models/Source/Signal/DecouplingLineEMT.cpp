@@ -24,8 +24,8 @@ DecouplingLineEMT::DecouplingLineEMT(String name, Logger::Level logLevel) :
 	mSrc1 = CurrentSource::make(name + "_i1", logLevel);
 	mSrc2 = CurrentSource::make(name + "_i2", logLevel);
 
-	mSrcCur1 = mSrc1->attributeComplex("I_ref");
-	mSrcCur2 = mSrc2->attributeComplex("I_ref");
+	mSrcCur1 = mSrc1->attributeHandle<Complex>("I_ref");
+	mSrcCur2 = mSrc2->attributeHandle<Complex>("I_ref");
 }
 
 void DecouplingLineEMT::setParameters(SimNode<Real>::Ptr node1, SimNode<Real>::Ptr node2,
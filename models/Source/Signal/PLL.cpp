@@ -23,6 +23,8 @@ PLL::PLL(String name, Logger::Level logLevel) :
     addAttribute<Matrix>("input_curr", &mInputCurr, Flags::read | Flags::write);
     addAttribute<Matrix>("state_curr", &mStateCurr, Flags::read | Flags::write);
     addAttribute<Matrix>("output_curr", &mOutputCurr, Flags::read | Flags::write);
+
+    mInputRef = attributeHandle<Real>("input_ref");
 }
 
 
@@ -81,13 +83,13 @@ void PLL::signalPreStep(Real time, Int timeStepCount) {
 }
 
 void PLL::signalAddStepDependencies(AttributeBase::List &prevStepDependencies, AttributeBase::List &attributeDependencies, AttributeBase::List &modifiedAttributes) {
-	attributeDependencies.push_back(attribute("input_ref"));
+	attributeDependencies.push_back(mInputRef.ptr());
 	modifiedAttributes.push_back(attribute("input_curr"));
     modifiedAttributes.push_back(attribute("output_curr"));
 };
 
 void PLL::signalStep(Real time, Int timeStepCount) {
-    mInputCurr(1,0) = attribute<Real>("input_ref")->get();
+    mInputCurr(1,0) = mInputRef.get();
 
     mSLog->info("Time {}:", time);
     mSLog->info("Input values: inputCurr = ({}, {}), inputPrev = ({}, {}), stateCurr = ({}, {}), statePrev = ({}, {})", mInputCurr(0,0), mInputCurr(1,0), mInputPrev(0,0), mInputPrev(1,0), mStateCurr(0,0), mStateCurr(1,0), mStatePrev(0,0), mStatePrev(1,0));
@@ -29,6 +29,11 @@ PowerControllerVSI::PowerControllerVSI(String name, Logger::Level logLevel) :
 	addAttribute<Real>("Vc_q", Flags::read | Flags::write);
 	addAttribute<Real>("Irc_d", Flags::read | Flags::write);
 	addAttribute<Real>("Irc_q", Flags::read | Flags::write);
+
+	mVcd = attributeHandle<Real>("Vc_d");
+	mVcq = attributeHandle<Real>("Vc_q");
+	mIrcd = attributeHandle<Real>("Irc_d");
+	mIrcq = attributeHandle<Real>("Irc_q");
 }
 
 void PowerControllerVSI::setParameters(Real Pref, Real Qref) {
@@ -109,15 +114,21 @@ void PowerControllerVSI::setInitialStateValues(Real pInit, Real qInit,
 	mSLog->info("Gamma_dInit = {}, Gamma_qInit = {}", gamma_dInit, gamma_qInit);
 }
 
+void PowerControllerVSI::setControlPeriod(UInt steps) {
+	mControlPeriod = steps > 0 ? steps : 1;
+	mSLog->info("Control period = {} time steps", mControlPeriod);
+}
+
 void PowerControllerVSI::initializeStateSpaceModel(Real omega, Real timeStep, Attribute<Matrix>::Ptr leftVector) {
-	mTimeStep = timeStep;
+	// The states are integrated over the time between two executions
+	mTimeStep = timeStep * mControlPeriod;
 	mOmegaCutoff = omega;
 
 	// update B matrix due to its dependence on Irc
 	updateBMatrixStateSpaceModel();
 
 	// initialization of input
-	mInputCurr << mPref, mQref, attribute<Real>("Vc_d")->get(), attribute<Real>("Vc_q")->get(), attribute<Real>("Irc_d")->get(), attribute<Real>("Irc_q")->get();
+	mInputCurr << mPref, mQref, mVcd.get(), mVcq.get(), mIrcd.get(), mIrcq.get();
 	mSLog->info("Initialization of input: \n" + Logger::matrixToString(mInputCurr));
 
 	// initialization of states
@@ -143,10 +154,10 @@ void PowerControllerVSI::signalPreStep(Real time, Int timeStepCount) {
 }
 
 void PowerControllerVSI::signalAddStepDependencies(AttributeBase::List &prevStepDependencies, AttributeBase::List &attributeDependencies, AttributeBase::List &modifiedAttributes) {
-	attributeDependencies.push_back(attribute("Vc_d"));
-	attributeDependencies.push_back(attribute("Vc_q"));
-	attributeDependencies.push_back(attribute("Irc_d"));
-	attributeDependencies.push_back(attribute("Irc_q"));
+	attributeDependencies.push_back(mVcd.ptr());
+	attributeDependencies.push_back(mVcq.ptr());
+	attributeDependencies.push_back(mIrcd.ptr());
+	attributeDependencies.push_back(mIrcq.ptr());
 	modifiedAttributes.push_back(attribute("input_curr"));
     modifiedAttributes.push_back(attribute("output_curr"));
 };
@@ -156,7 +167,7 @@ void PowerControllerVSI::signalStep(Real time, Int timeStepCount) {
 	updateBMatrixStateSpaceModel();
 
 	// get current inputs
-	mInputCurr << mPref, mQref, attribute<Real>("Vc_d")->get(), attribute<Real>("Vc_q")->get(), attribute<Real>("Irc_d")->get(), attribute<Real>("Irc_q")->get();
+	mInputCurr << mPref, mQref, mVcd.get(), mVcq.get(), mIrcd.get(), mIrcq.get();
     mSLog->debug("Time {}\n: inputCurr = \n{}\n , inputPrev = \n{}\n , statePrev = \n{}", time, mInputCurr, mInputPrev, mStatePrev);
 
 	// calculate new states
@@ -169,12 +180,15 @@ void PowerControllerVSI::signalStep(Real time, Int timeStepCount) {
 }
 
 void PowerControllerVSI::updateBMatrixStateSpaceModel() {
-	mB.coeffRef(0, 2) = mOmegaCutoff * attribute<Real>("Irc_d")->get();
-	mB.coeffRef(0, 3) = mOmegaCutoff * attribute<Real>("Irc_q")->get();
-	mB.coeffRef(1, 2) = -mOmegaCutoff * attribute<Real>("Irc_q")->get();
-	mB.coeffRef(1, 3) = mOmegaCutoff * attribute<Real>("Irc_d")->get();
+	mB.coeffRef(0, 2) = mOmegaCutoff * mIrcd.get();
+	mB.coeffRef(0, 3) = mOmegaCutoff * mIrcq.get();
+	mB.coeffRef(1, 2) = -mOmegaCutoff * mIrcq.get();
+	mB.coeffRef(1, 3) = mOmegaCutoff * mIrcd.get();
 }
 
 Task::List PowerControllerVSI::getTasks() {
-	return Task::List({std::make_shared<PreStep>(*this), std::make_shared<Step>(*this)});
+	Task::List tasks({std::make_shared<PreStep>(*this), std::make_shared<Step>(*this)});
+	for (auto task : tasks)
+		task->setPeriod(mControlPeriod);
+	return tasks;
 }
\ No newline at end of file
@@ -95,15 +95,14 @@ void SimNode<Real>::mnaInitializeHarm(std::vector<Attribute<Matrix>::Ptr> leftVe
 
 template <>
 void SimNode<Complex>::mnaInitializeHarm(std::vector<Attribute<Matrix>::Ptr> leftVectors) {
-	mMnaTasks = {
-		std::make_shared<MnaPostStepHarm>(*this, leftVectors)
-	};
+	mMnaTasks.clear();
+	for (UInt freq = 0; freq < mNumFreqs; freq++)
+		mMnaTasks.push_back(std::make_shared<MnaPostStepHarm>(*this, leftVectors[freq], freq));
 }
 
 template <>
 void SimNode<Complex>::MnaPostStepHarm::execute(Real time, Int timeStepCount) {
-	for (UInt freq = 0; freq < mNode.mNumFreqs; freq++)
-		mNode.mnaUpdateVoltageHarm(*mLeftVectors[freq], freq);
+	mNode.mnaUpdateVoltageHarm(*mLeftVector, mFreqIdx);
 }
 
 template <>